@@ -205,6 +205,8 @@ VLayoutGeneratorPtr VCommandLine::DefaultGenerator() const
     diag.SetUnitePages(IsOptionSet(LONG_OPTION_UNITE));
     diag.SetSaveLength(IsOptionSet(LONG_OPTION_SAVELENGTH));
     diag.SetPreferOneSheetSolution(IsOptionSet(LONG_OPTION_PREFER_ONE_SHEET_SOLUTION));
+    diag.SetMultiStart(IsOptionSet(LONG_OPTION_MULTI_START));
+    diag.SetNoFitPolygon(IsOptionSet(LONG_OPTION_NO_FIT_POLYGON));
     diag.SetGroup(OptGroup());
 
     if (IsOptionSet(LONG_OPTION_IGNORE_MARGINS))
@@ -281,6 +283,18 @@ bool VCommandLine::IsTestModeEnabled() const
     return r;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool VCommandLine::IsCheckIncremental() const
+{
+    return IsTestModeEnabled() && IsOptionSet(LONG_OPTION_CHECK_INCREMENTAL);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VCommandLine::IsCheckParallel() const
+{
+    return IsTestModeEnabled() && IsOptionSet(LONG_OPTION_CHECK_PARALLEL);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 bool VCommandLine::IsPedantic() const
 {
@@ -431,6 +445,17 @@ qreal VCommandLine::ExportYScale() const
     return ys;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+qreal VCommandLine::ExportDpi() const
+{
+    qreal dpi = PrintDPI;
+    if (IsOptionSet(LONG_OPTION_EXPDPI))
+    {
+        dpi = qBound(10., OptionValue(LONG_OPTION_EXPDPI).toDouble(), 2400.);
+    }
+    return dpi;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QString VCommandLine::OptExportSuchDetails() const
 {
@@ -543,6 +568,36 @@ QString VCommandLine::OptGradationHeight() const
     const_cast<VCommandLine*>(this)->parser.showHelp(V_EX_USAGE);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool VCommandLine::IsGradingBatch() const
+{
+    return IsOptionSet(LONG_OPTION_GRADATIONSIZES) || IsOptionSet(LONG_OPTION_GRADATIONHEIGHTS);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QStringList VCommandLine::OptGradationSizes() const
+{
+    if (IsOptionSet(LONG_OPTION_GRADATIONSIZES))
+    {
+        return GradationValues(LONG_OPTION_GRADATIONSIZES, VMeasurement::WholeListSizes(Unit::Cm),
+                               translate("VCommandLine", "Invalid gradation sizes value."));
+    }
+
+    return IsSetGradationSize() ? QStringList(OptGradationSize()) : QStringList();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QStringList VCommandLine::OptGradationHeights() const
+{
+    if (IsOptionSet(LONG_OPTION_GRADATIONHEIGHTS))
+    {
+        return GradationValues(LONG_OPTION_GRADATIONHEIGHTS, VMeasurement::WholeListHeights(Unit::Cm),
+                               translate("VCommandLine", "Invalid gradation heights value."));
+    }
+
+    return IsSetGradationHeight() ? QStringList(OptGradationHeight()) : QStringList();
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QMarginsF VCommandLine::TiledPageMargins() const
 {
@@ -643,6 +698,17 @@ void VCommandLine::InitCommandLineOptions()
          translate("VCommandLine", "Set height value for pattern file, that was opened with multisize measurements "
          "(export mode). Valid values: %1cm.").arg(VMeasurement::WholeListHeights(Unit::Cm).join(QStringLiteral(", "))),
          translate("VCommandLine", "The height value")},
+        {LONG_OPTION_GRADATIONSIZES,
+         translate("VCommandLine", "Export several sizes of a pattern that was opened with multisize measurements in "
+         "one run (export mode). The value is a comma separated list of sizes or ranges, for example 40-48,52. The "
+         "pattern is loaded once and recalculated for each combination of sizes and heights. Use placeholders "
+         "{size} and {height} in the base filename, otherwise they will be appended to it."),
+         translate("VCommandLine", "The size values")},
+        {LONG_OPTION_GRADATIONHEIGHTS,
+         translate("VCommandLine", "Export several heights of a pattern that was opened with multisize measurements "
+         "in one run (export mode). The value is a comma separated list of heights or ranges, for example "
+         "158-182. Can be combined with \"%1\".").arg(LONG_OPTION_GRADATIONSIZES),
+         translate("VCommandLine", "The height values")},
         {LONG_OPTION_USER_MATERIAL,
          translate("VCommandLine", "Use this option to override user material defined in pattern. The value must be in "
          "form <number>@<user matrial name>. The number should be in range from 1 to %1. For example, 1@Fabric2. The "
@@ -693,6 +759,10 @@ void VCommandLine::InitCommandLineOptions()
         {LONG_OPTION_EXPYSCALE,
          translate("VCommandLine", "Set vertical scale factor from 0.01 to 3.0 (default = 1.0, export mode)."),
          translate("VCommandLine", "Vertical scale")},
+        {LONG_OPTION_EXPDPI,
+         translate("VCommandLine", "Set resolution of raster export (PNG) in dots per inch from 10 to 2400 (default = "
+         "96, export mode)."),
+         translate("VCommandLine", "The resolution")},
     //=================================================================================================================
         {LONG_OPTION_FOLLOW_GRAINLINE,
          translate("VCommandLine", "Order detail to follow grainline direction (export mode).")},
@@ -709,6 +779,12 @@ void VCommandLine::InitCommandLineOptions()
          "supports only a maximum of 32768x32768 px images.")},
         {LONG_OPTION_PREFER_ONE_SHEET_SOLUTION,
          translate("VCommandLine", "Prefer one sheet layout solution (export mode).")},
+        {LONG_OPTION_MULTI_START,
+         translate("VCommandLine", "Run several nesting strategies in parallel and keep the best layout (export "
+                   "mode).")},
+        {LONG_OPTION_NO_FIT_POLYGON,
+         translate("VCommandLine", "Place pieces with help of no-fit polygons instead of matching edges (export "
+                   "mode).")},
     //=================================================================================================================
         {{SINGLE_OPTION_SAVELENGTH, LONG_OPTION_SAVELENGTH},
          translate("VCommandLine", "Save length of the sheet if set (export mode). The option tells the program to use "
@@ -728,6 +804,12 @@ void VCommandLine::InitCommandLineOptions()
          translate("VCommandLine", "Run the program in a test mode. The program in this mode loads a single pattern "
          "file and silently quit without showing the main window. The key have priority before key '%1'.")
          .arg(LONG_OPTION_BASENAME)},
+        {LONG_OPTION_CHECK_INCREMENTAL,
+         translate("VCommandLine", "Have effect only in test mode. Edit formulas of the pattern and check that "
+         "recalculation of changed tools gives the same result as recalculation of the whole pattern.")},
+        {LONG_OPTION_CHECK_PARALLEL,
+         translate("VCommandLine", "Have effect only in test mode. Check that recalculation of independent pattern "
+         "pieces in parallel gives the same result as recalculation one by one.")},
         {LONG_OPTION_PENDANTIC,
          translate("VCommandLine", "Make all parsing warnings into errors. Have effect only in console mode. Use to "
          "force Valentina to immediately terminate if a pattern contains a parsing warning.")},
@@ -798,6 +880,67 @@ QStringList VCommandLine::OptionValues(const QString &option) const
     return parser.values(option);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GradationValues parse a comma separated list of gradation values. An item can be a single value or a range
+ * "from-to" that includes all valid values between them.
+ */
+QStringList VCommandLine::GradationValues(const QString &option, const QStringList &validValues,
+                                          const QString &error) const
+{
+    QStringList values;
+    auto AddValue = [&values](const QString &value)
+    {
+        if (not values.contains(value))
+        {
+            values.append(value);
+        }
+    };
+
+    bool valid = true;
+    const QStringList items = OptionValue(option).split(QChar(','));
+    for (auto &item : items)
+    {
+        const QStringList range = item.split(QChar('-'));
+        if (range.size() == 1 && validValues.contains(item.trimmed()))
+        {
+            AddValue(item.trimmed());
+        }
+        else if (range.size() == 2 && validValues.contains(range.at(0).trimmed())
+                 && validValues.contains(range.at(1).trimmed()))
+        {
+            const int from = range.at(0).toInt();
+            const int to = range.at(1).toInt();
+            valid = from <= to;
+
+            for (auto &value : validValues)
+            {
+                if (value.toInt() >= from && value.toInt() <= to)
+                {
+                    AddValue(value);
+                }
+            }
+        }
+        else
+        {
+            valid = false;
+        }
+
+        if (not valid)
+        {
+            break;
+        }
+    }
+
+    if (valid && not values.isEmpty())
+    {
+        return values;
+    }
+
+    qCritical() << error << "\n";
+    const_cast<VCommandLine*>(this)->parser.showHelp(V_EX_USAGE);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 int VCommandLine::OptNestingTime() const
 {
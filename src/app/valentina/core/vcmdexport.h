@@ -56,6 +56,13 @@ public:
     //case test mode enabled
     bool IsTestModeEnabled() const;
 
+    //@brief In test mode edit formulas of the pattern and check that incremental recalculation gives the same data as
+    //full recalculation.
+    bool IsCheckIncremental() const;
+
+    //@brief In test mode check that parallel recalculation of pattern pieces gives the same data as sequential.
+    bool IsCheckParallel() const;
+
     //@brief Make all parsing warnings into errors. Have effect only in console mode. Use to force Valentina to
     //immediately terminate if a pattern contains a parsing warning.
     bool IsPedantic() const;
@@ -90,6 +97,7 @@ public:
 
     qreal ExportXScale() const;
     qreal ExportYScale() const;
+    qreal ExportDpi() const;
 
     //@brief returns the piece name regex or empty string if not set
     QString OptExportSuchDetails() const;
@@ -120,6 +128,16 @@ public:
 
     QString OptGradationSize() const;
     QString OptGradationHeight() const;
+
+    //@brief tests if user asked to export several sizes or heights of a multisize pattern in one run
+    bool IsGradingBatch() const;
+
+    //@brief returns sizes for batch grading export, expands ranges like 40-56. Falls back to the single size value.
+    QStringList OptGradationSizes() const;
+
+    //@brief returns heights for batch grading export, expands ranges like 158-182. Falls back to the single height
+    //value.
+    QStringList OptGradationHeights() const;
     
     QMarginsF TiledPageMargins() const;
     VAbstractLayoutDialog::PaperSizeTemplate OptTiledPaperSize() const;
@@ -153,6 +171,7 @@ private:
     bool IsOptionSet(const QString &option) const;
     QString OptionValue(const QString &option) const;
     QStringList OptionValues(const QString &option) const;
+    QStringList GradationValues(const QString &option, const QStringList &validValues, const QString &error) const;
 
     int   OptNestingTime() const;
     qreal OptEfficiencyCoefficient() const;
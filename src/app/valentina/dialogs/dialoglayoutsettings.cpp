@@ -304,6 +304,30 @@ void DialogLayoutSettings::SetPreferOneSheetSolution(bool prefer)
     ui->checkBoxOneSheetSolution->setChecked(prefer);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool DialogLayoutSettings::IsMultiStart() const
+{
+    return ui->checkBoxMultiStart->isChecked();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::SetMultiStart(bool multiStart)
+{
+    ui->checkBoxMultiStart->setChecked(multiStart);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool DialogLayoutSettings::IsNoFitPolygon() const
+{
+    return ui->checkBoxNoFitPolygon->isChecked();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::SetNoFitPolygon(bool noFitPolygon)
+{
+    ui->checkBoxNoFitPolygon->setChecked(noFitPolygon);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 bool DialogLayoutSettings::IsUnitePages() const
 {
@@ -613,6 +637,8 @@ void DialogLayoutSettings::DialogAccepted()
     generator->SetAutoCropWidth(GetAutoCropWidth());
     generator->SetSaveLength(IsSaveLength());
     generator->SetPreferOneSheetSolution(IsPreferOneSheetSolution());
+    generator->SetMultiStart(IsMultiStart());
+    generator->SetPlacementEngine(IsNoFitPolygon() ? PlacementEngine::NoFitPolygon : PlacementEngine::EdgeMatching);
     generator->SetUnitePages(IsUnitePages());
     generator->SetStripOptimization(IsStripOptimization());
     generator->SetMultiplier(GetMultiplier());
@@ -709,6 +735,8 @@ void DialogLayoutSettings::RestoreDefaults()
     SetEfficiencyCoefficient(VSettings::GetDefEfficiencyCoefficient());
     SetNestQuantity(VSettings::GetDefLayoutNestQuantity());
     SetPreferOneSheetSolution(VSettings::GetDefLayoutPreferOneSheetSolution());
+    SetMultiStart(VSettings::GetDefLayoutMultiStart());
+    SetNoFitPolygon(VSettings::GetDefLayoutNoFitPolygon());
 
     CorrectMaxFileds();
     IgnoreAllFields(ui->checkBoxIgnoreFileds->isChecked());
@@ -1034,6 +1062,8 @@ void DialogLayoutSettings::ReadSettings()
     SetAutoCropWidth(settings->GetLayoutAutoCropWidth());
     SetSaveLength(settings->GetLayoutSaveLength());
     SetPreferOneSheetSolution(settings->GetLayoutPreferOneSheetSolution());
+    SetMultiStart(settings->GetLayoutMultiStart());
+    SetNoFitPolygon(settings->GetLayoutNoFitPolygon());
     SetUnitePages(settings->GetLayoutUnitePages());
     SetFields(settings->GetFields(GetDefPrinterFields()));
     SetIgnoreAllFields(settings->GetIgnoreAllFields());
@@ -1062,6 +1092,8 @@ void DialogLayoutSettings::WriteSettings() const
     settings->SetLayoutAutoCropWidth(GetAutoCropWidth());
     settings->SetLayoutSaveLength(IsSaveLength());
     settings->SetLayoutPreferOneSheetSolution(IsPreferOneSheetSolution());
+    settings->SetLayoutMultiStart(IsMultiStart());
+    settings->SetLayoutNoFitPolygon(IsNoFitPolygon());
     settings->SetLayoutUnitePages(IsUnitePages());
     settings->SetFields(GetFields());
     settings->SetIgnoreAllFields(IsIgnoreAllFields());
@@ -88,6 +88,12 @@ public:
     bool IsPreferOneSheetSolution() const;
     void SetPreferOneSheetSolution(bool prefer);
 
+    bool IsMultiStart() const;
+    void SetMultiStart(bool multiStart);
+
+    bool IsNoFitPolygon() const;
+    void SetNoFitPolygon(bool noFitPolygon);
+
     bool IsUnitePages() const;
     void SetUnitePages(bool save);
 
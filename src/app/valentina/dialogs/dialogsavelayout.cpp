@@ -767,6 +767,21 @@ qreal DialogSaveLayout::GetYScale() const
     return ui->doubleSpinBoxVerticalScale->value() / 100.;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetDpi set resolution of raster formats. The dialog has no control for it, only command line changes it.
+ */
+void DialogSaveLayout::SetDpi(qreal dpi)
+{
+    m_dpi = dpi;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal DialogSaveLayout::GetDpi() const
+{
+    return m_dpi;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void DialogSaveLayout::showEvent(QShowEvent *event)
 {
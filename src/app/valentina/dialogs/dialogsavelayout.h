@@ -30,6 +30,7 @@
 #define DIALOGSAVELAYOUT_H
 
 #include "../vgeometry/vgeometrydef.h"
+#include "../vmisc/defglobal.h"
 #include "vabstractlayoutdialog.h"
 #include "../vlayout/vlayoutdef.h"
 
@@ -92,6 +93,9 @@ public:
     void  SetYScale(qreal scale);
     qreal GetYScale() const;
 
+    void  SetDpi(qreal dpi);
+    qreal GetDpi() const;
+
 protected:
     virtual void showEvent(QShowEvent *event) override;
     void InitTemplates(QComboBox *comboBoxTemplates);
@@ -111,6 +115,7 @@ private:
     Draw m_mode;
     bool m_tiledExportMode;
     bool m_scaleConnected{true};
+    qreal m_dpi{PrintDPI};
 
     static bool havePdf;
     static bool tested;
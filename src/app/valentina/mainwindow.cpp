@@ -61,6 +61,7 @@
 #include "../vtools/undocommands/undogroup.h"
 #include "dialogs/vwidgetdetails.h"
 #include "../vpatterndb/vpiecepath.h"
+#include "../vpatterndb/vcalculatorcache.h"
 #include "../qmuparser/qmuparsererror.h"
 #include "../vtools/dialogs/support/dialogeditlabel.h"
 #include "../vformat/vpatternrecipe.h"
@@ -544,7 +545,9 @@ bool MainWindow::LoadMeasurements(const QString &path)
 //---------------------------------------------------------------------------------------------------------------------
 bool MainWindow::UpdateMeasurements(const QString &path, int size, int height)
 {
-    QSharedPointer<VMeasurements> m = OpenMeasurementFile(path);
+    // Batch grading export reads the file once and only reads values of a new size and height
+    QSharedPointer<VMeasurements> m = m_gradingMeasurements.isNull() ? OpenMeasurementFile(path)
+                                                                     : m_gradingMeasurements;
 
     if (m->isNull())
     {
@@ -3157,6 +3160,7 @@ void MainWindow::Clear()
     qCDebug(vMainWindow, "Returned to Draw mode.");
     setCurrentFile(QString());// Keep before cleaning a pattern data to prevent a crash
     pattern->Clear();
+    VCalculatorCache::Instance()->Clear();
     qCDebug(vMainWindow, "Clearing pattern.");
     if (not qApp->GetPatternPath().isEmpty() && not doc->MPath().isEmpty())
     {
@@ -5508,7 +5512,7 @@ void MainWindow::ZoomFirstShow()
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-bool MainWindow::DoExport(const VCommandLinePtr &expParams)
+bool MainWindow::DoExport(const VCommandLinePtr &expParams, const QString &baseName)
 {
     QVector<DetailForLayout> details;
     if(not qApp->getOpeningPattern())
@@ -5540,14 +5544,15 @@ bool MainWindow::DoExport(const VCommandLinePtr &expParams)
     {
         try
         {
-            m_dialogSaveLayout = QSharedPointer<DialogSaveLayout>(new DialogSaveLayout(1, Draw::Modeling,
-                                                                                       expParams->OptBaseName(), this));
+            m_dialogSaveLayout = QSharedPointer<DialogSaveLayout>(new DialogSaveLayout(1, Draw::Modeling, baseName,
+                                                                                       this));
             m_dialogSaveLayout->SetDestinationPath(expParams->OptDestinationPath());
             m_dialogSaveLayout->SelectFormat(static_cast<LayoutExportFormats>(expParams->OptExportType()));
             m_dialogSaveLayout->SetBinaryDXFFormat(expParams->IsBinaryDXF());
             m_dialogSaveLayout->SetTextAsPaths(expParams->IsTextAsPaths());
             m_dialogSaveLayout->SetXScale(expParams->ExportXScale());
             m_dialogSaveLayout->SetYScale(expParams->ExportYScale());
+            m_dialogSaveLayout->SetDpi(expParams->ExportDpi());
 
             if (static_cast<LayoutExportFormats>(expParams->OptExportType()) == LayoutExportFormats::PDFTiled)
             {
@@ -5578,13 +5583,13 @@ bool MainWindow::DoExport(const VCommandLinePtr &expParams)
             try
             {
                 m_dialogSaveLayout = QSharedPointer<DialogSaveLayout>(new DialogSaveLayout(scenes.size(), Draw::Layout,
-                                                                                           expParams->OptBaseName(),
-                                                                                           this));
+                                                                                           baseName, this));
                 m_dialogSaveLayout->SetDestinationPath(expParams->OptDestinationPath());
                 m_dialogSaveLayout->SelectFormat(static_cast<LayoutExportFormats>(expParams->OptExportType()));
                 m_dialogSaveLayout->SetBinaryDXFFormat(expParams->IsBinaryDXF());
                 m_dialogSaveLayout->SetXScale(expParams->ExportXScale());
                 m_dialogSaveLayout->SetYScale(expParams->ExportYScale());
+                m_dialogSaveLayout->SetDpi(expParams->ExportDpi());
 
                 if (static_cast<LayoutExportFormats>(expParams->OptExportType()) == LayoutExportFormats::PDFTiled)
                 {
@@ -5620,12 +5625,11 @@ bool MainWindow::DoExport(const VCommandLinePtr &expParams)
 /**
  * @brief DoFMExport process export final measurements
  * @param expParams command line options
+ * @param filePath destination path of csv file
  * @return true if succesfull
  */
-bool MainWindow::DoFMExport(const VCommandLinePtr &expParams)
+bool MainWindow::DoFMExport(const VCommandLinePtr &expParams, const QString &filePath)
 {
-    QString filePath = expParams->OptExportFMTo();
-
     if (filePath.isEmpty())
     {
         qCCritical(vMainWindow, "%s\n\n%s", qUtf8Printable(tr("Export final measurements error.")),
@@ -5634,10 +5638,11 @@ bool MainWindow::DoFMExport(const VCommandLinePtr &expParams)
         return false;
     }
 
-    QFileInfo info(filePath);
+    QString path = filePath;
+    QFileInfo info(path);
     if (info.isRelative())
     {
-        filePath = QDir::currentPath() + QLatin1Char('/') + filePath;
+        path = QDir::currentPath() + QLatin1Char('/') + path;
     }
 
     const QString codecName = expParams->OptCSVCodecName();
@@ -5656,8 +5661,139 @@ bool MainWindow::DoFMExport(const VCommandLinePtr &expParams)
         separator = VCommonSettings::GetDefCSVSeparator();
     }
 
-    return ExportFMeasurementsToCSVData(filePath, expParams->IsCSVWithHeader(), mib, separator);
+    return ExportFMeasurementsToCSVData(path, expParams->IsCSVWithHeader(), mib, separator);
+
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief DoGradingExport export several sizes and heights of a multisize pattern in one run.
+ *
+ * The pattern and its measurements are read only once. Each combination only reads new measurement values and
+ * recalculates the pattern. Heights are the outer loop, so most combinations change only the size and need one
+ * recalculation.
+ * @param expParams command line options
+ * @return true if succesfull
+ */
+bool MainWindow::DoGradingExport(const VCommandLinePtr &expParams)
+{
+    if (qApp->patternType() != MeasurementsType::Multisize)
+    {
+        qCCritical(vMainWindow, "%s",
+                   qUtf8Printable(tr("Couldn't export grading. Need a file with multisize measurements.")));
+        qApp->exit(V_EX_DATAERR);
+        return false;
+    }
+
+    QStringList sizes = expParams->OptGradationSizes();
+    if (sizes.isEmpty())
+    {
+        sizes.append(QString());// Keep current size
+    }
+
+    QStringList heights = expParams->OptGradationHeights();
+    if (heights.isEmpty())
+    {
+        heights.append(QString());// Keep current height
+    }
+
+    m_gradingMeasurements = OpenMeasurementFile(AbsoluteMPath(qApp->GetPatternPath(), doc->MPath()));
+    if (m_gradingMeasurements.isNull() || m_gradingMeasurements->isNull())
+    {
+        m_gradingMeasurements.clear();
+        qApp->exit(V_EX_NOINPUT);
+        return false;
+    }
+
+    auto ExportCombination = [this, expParams](const QString &size, const QString &height)
+    {
+        if ((not height.isEmpty() && not SetHeight(height)) || (not size.isEmpty() && not SetSize(size)))
+        {
+            qApp->exit(V_EX_DATAERR);
+            return false;
+        }
+
+        const QString sizeName = size.isEmpty() ? QString::number(pattern->size()) : size;
+        const QString heightName = height.isEmpty() ? QString::number(pattern->height()) : height;
+        qCDebug(vMainWindow, "Grading export. Size %s, height %s.", qUtf8Printable(sizeName),
+                qUtf8Printable(heightName));
+
+        if (expParams->IsExportEnabled()
+                && not DoExport(expParams, GradedFileName(expParams->OptBaseName(), sizeName, heightName, false)))
+        {
+            return false;
+        }
+
+        if (expParams->IsExportFMEnabled()
+                && not DoFMExport(expParams, GradedFileName(expParams->OptExportFMTo(), sizeName, heightName, true)))
+        {
+            return false;
+        }
+
+        return true;
+    };
+
+    bool result = true;
+    for (int i = 0; i < heights.size() && result; ++i)
+    {
+        for (int j = 0; j < sizes.size() && result; ++j)
+        {
+            result = ExportCombination(sizes.at(j), heights.at(i));
+        }
+    }
+
+    m_gradingMeasurements.clear();
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GradedFileName fill placeholders {size} and {height} in a file name. Values of dimensions without a
+ * placeholder are appended to the name, so each combination of a size and a height gets own file.
+ * @param name file name template.
+ * @param size size value.
+ * @param height height value.
+ * @param keepSuffix keep file suffix after appended values.
+ * @return file name of the graded result.
+ */
+QString MainWindow::GradedFileName(const QString &name, const QString &size, const QString &height, bool keepSuffix)
+{
+    const QString sizePlaceholder = QStringLiteral("{size}");
+    const QString heightPlaceholder = QStringLiteral("{height}");
+
+    QString fileName = name;
+    QString values;
+
+    if (fileName.contains(sizePlaceholder))
+    {
+        fileName.replace(sizePlaceholder, size);
+    }
+    else
+    {
+        values += QLatin1Char('_') + size;
+    }
+
+    if (fileName.contains(heightPlaceholder))
+    {
+        fileName.replace(heightPlaceholder, height);
+    }
+    else
+    {
+        values += QLatin1Char('_') + height;
+    }
+
+    if (values.isEmpty())
+    {
+        return fileName;
+    }
+
+    const QString suffix = QFileInfo(name).suffix();
+    if (keepSuffix && not suffix.isEmpty())
+    {
+        return fileName.insert(fileName.size() - suffix.size() - 1, values);
+    }
 
+    return fileName + values;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -5781,6 +5917,17 @@ void MainWindow::ProcessCMD()
             return; // process only one input file
         }
 
+        if (cmd->IsGradingBatch())
+        {
+            if (not cmd->IsTestModeEnabled() && not DoGradingExport(cmd))
+            {
+                return;
+            }
+
+            qApp->exit(V_EX_OK);// close program after processing in console mode
+            return;
+        }
+
         bool hSetted = true;
         bool sSetted = true;
         if (cmd->IsSetGradationSize())
@@ -5799,14 +5946,30 @@ void MainWindow::ProcessCMD()
             return;
         }
 
+        if (cmd->IsCheckIncremental() && not doc->CheckIncrementalParse())
+        {
+            qCCritical(vMainWindow, "%s",
+                       qUtf8Printable(tr("Recalculation of changed tools gives different result.")));
+            qApp->exit(V_EX_DATAERR);
+            return;
+        }
+
+        if (cmd->IsCheckParallel() && not doc->CheckParallelParse())
+        {
+            qCCritical(vMainWindow, "%s",
+                       qUtf8Printable(tr("Parallel recalculation of pattern pieces gives different result.")));
+            qApp->exit(V_EX_DATAERR);
+            return;
+        }
+
         if (not cmd->IsTestModeEnabled())
         {
-            if (cmd->IsExportEnabled() && not DoExport(cmd))
+            if (cmd->IsExportEnabled() && not DoExport(cmd, cmd->OptBaseName()))
             {
                 return;
             }
 
-            if (cmd->IsExportFMEnabled() && not DoFMExport(cmd))
+            if (cmd->IsExportFMEnabled() && not DoFMExport(cmd, cmd->OptExportFMTo()))
             {
                 return;
             }
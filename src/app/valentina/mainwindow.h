@@ -285,6 +285,9 @@ private:
 
     QList<QPointer<WatermarkWindow>> m_watermarkEditors{};
 
+    /** @brief m_gradingMeasurements measurements read once for batch grading export. */
+    QSharedPointer<VMeasurements> m_gradingMeasurements{};
+
     void               SetDefaultHeight();
     void               SetDefaultSize();
 
@@ -363,8 +366,11 @@ private:
     bool               UpdateMeasurements(const QString &path, int size, int height);
 
     void               ReopenFilesAfterCrash(QStringList &args);
-    bool               DoExport(const VCommandLinePtr& expParams);
-    bool               DoFMExport(const VCommandLinePtr& expParams);
+    bool               DoExport(const VCommandLinePtr& expParams, const QString &baseName);
+    bool               DoFMExport(const VCommandLinePtr& expParams, const QString &filePath);
+    bool               DoGradingExport(const VCommandLinePtr& expParams);
+    static QString     GradedFileName(const QString &name, const QString &size, const QString &height,
+                                      bool keepSuffix);
 
     bool               SetSize(const QString &text);
     bool               SetHeight(const QString & text);
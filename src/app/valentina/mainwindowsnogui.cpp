@@ -39,6 +39,7 @@
 #include "../vformat/vmeasurements.h"
 #include "../vformat/vwatermark.h"
 #include "../vlayout/vlayoutgenerator.h"
+#include "../vlayout/vlayoutexporter.h"
 #include "dialogs/dialoglayoutprogress.h"
 #include "dialogs/dialogsavelayout.h"
 #include "dialogs/dialoglayoutscale.h"
@@ -66,6 +67,7 @@
 #include <QPrinterInfo>
 #include <QtConcurrent>
 #include <functional>
+#include <algorithm>
 #include <QPageSize>
 
 #if defined(Q_OS_WIN32) && QT_VERSION >= QT_VERSION_CHECK(5, 7, 0)
@@ -283,138 +285,76 @@ bool MainWindowsNoGUI::GenerateLayout(VLayoutGenerator& lGenerator)
         return false;
     };
 
-    bool rotationUsed = false;
-    int rotatate = 1;
     lGenerator.SetShift(-1); // Trigger first shift calulation
     lGenerator.SetRotate(false);
-    int papersCount = INT_MAX;
     qreal efficiency = 0;
     bool hasResult = false;
 
-    QCoreApplication::processEvents();
-
-    forever
+    auto SaveLayout = [this, &progress, &lGenerator, &efficiency, &hasResult]()
     {
-        if (IsTimeout())
+        if (VApplication::IsGUIMode())
         {
-            break;
+            progress->Efficiency(efficiency);
         }
 
-        lGenerator.Generate(timer, lGenerator.GetNestingTimeMSecs(), nestingState);
-
-        if (IsTimeout())
-        {
-            break;
-        }
-
-        switch (lGenerator.State())
-        {
-            case LayoutErrors::NoError:
-                if (lGenerator.PapersCount() <= papersCount)
-                {
-                    const qreal layoutEfficiency = lGenerator.LayoutEfficiency();
-                    if (efficiency < layoutEfficiency || lGenerator.PapersCount() < papersCount)
-                    {
-                        efficiency = layoutEfficiency;
-                        if (VApplication::IsGUIMode())
-                        {
-                            progress->Efficiency(efficiency);
-                        }
-
-                        CleanLayout();
-                        papers = lGenerator.GetPapersItems();// Blank sheets
-                        details = lGenerator.GetAllDetailsItems();// All details items
-                        detailsOnLayout = lGenerator.GetAllDetails();// All details items
-                        shadows = CreateShadows(papers);
-                        isLayoutPortrait = lGenerator.IsPortrait();
-                        scenes = CreateScenes(papers, shadows, details);
+        CleanLayout();
+        papers = lGenerator.GetPapersItems();// Blank sheets
+        details = lGenerator.GetAllDetailsItems();// All details items
+        detailsOnLayout = lGenerator.GetAllDetails();// All details items
+        shadows = CreateShadows(papers);
+        isLayoutPortrait = lGenerator.IsPortrait();
+        scenes = CreateScenes(papers, shadows, details);
 #if !defined(V_NO_ASSERT)
-                       //Uncomment to debug, shows global contour
-//                        gcontours = lGenerator.GetGlobalContours(); // uncomment for debugging
-//                        InsertGlobalContours(scenes, gcontours); // uncomment for debugging
+        //Uncomment to debug, shows global contour
+//        gcontours = lGenerator.GetGlobalContours(); // uncomment for debugging
+//        InsertGlobalContours(scenes, gcontours); // uncomment for debugging
 #endif
-                        if (VApplication::IsGUIMode())
-                        {
-                            PrepareSceneList(PreviewQuatilty::Fast);
-                        }
-                        ignorePrinterFields = not lGenerator.IsUsePrinterFields();
-                        margins = lGenerator.GetPrinterFields();
-                        paperSize = QSizeF(lGenerator.GetPaperWidth(), lGenerator.GetPaperHeight());
-                        isAutoCropLength = lGenerator.GetAutoCropLength();
-                        isAutoCropWidth = lGenerator.GetAutoCropWidth();
-                        isUnitePages = lGenerator.IsUnitePages();
-                        isLayoutStale = false;
-                        papersCount = lGenerator.PapersCount();
-                        hasResult = true;
-                        qDebug() << "Layout efficiency: " << efficiency;
-                    }
-                    else
-                    {
-                        if (lGenerator.IsRotationNeeded())
-                        {
-                            lGenerator.SetRotate(true);
-                            lGenerator.SetRotationNumber(++rotatate);
-                            rotationUsed = true;
-                        }
-                    }
-                }
-                else
-                {
-                    if (lGenerator.IsRotationNeeded())
-                    {
-                        lGenerator.SetRotate(true);
-                        lGenerator.SetRotationNumber(++rotatate);
-                        rotationUsed = true;
-                    }
-                }
-                lGenerator.SetShift(lGenerator.GetShift()/2.0);
-                break;
-            case LayoutErrors::EmptyPaperError:
-                if (lGenerator.IsRotationNeeded())
-                {
-                    if (not rotationUsed)
-                    {
-                        lGenerator.SetRotate(true);
-                        lGenerator.SetRotationNumber(++rotatate);
-                        rotationUsed = true;
-                    }
-                    else
-                    {
-                        lGenerator.SetShift(lGenerator.GetShift()/2.0);
-                        rotationUsed = false;
-                    }
-                }
-                else
-                {
-                    lGenerator.SetShift(lGenerator.GetShift()/2.0);
-                }
-                break;
-            case LayoutErrors::Timeout:
-            case LayoutErrors::PrepareLayoutError:
-            case LayoutErrors::ProcessStoped:
-            case LayoutErrors::TerminatedByException:
-            default:
-                break;
+        if (VApplication::IsGUIMode())
+        {
+            PrepareSceneList(PreviewQuatilty::Fast);
         }
+        ignorePrinterFields = not lGenerator.IsUsePrinterFields();
+        margins = lGenerator.GetPrinterFields();
+        paperSize = QSizeF(lGenerator.GetPaperWidth(), lGenerator.GetPaperHeight());
+        isAutoCropLength = lGenerator.GetAutoCropLength();
+        isAutoCropWidth = lGenerator.GetAutoCropWidth();
+        isUnitePages = lGenerator.IsUnitePages();
+        isTextAsPaths = lGenerator.IsTestAsPaths();
+        isLayoutStale = false;
+        hasResult = true;
+        qDebug() << "Layout efficiency: " << efficiency;
+    };
 
-        nestingState = lGenerator.State();
+    QCoreApplication::processEvents();
 
-        if (nestingState == LayoutErrors::PrepareLayoutError || nestingState == LayoutErrors::ProcessStoped
-                || nestingState == LayoutErrors::TerminatedByException
-                || (nestingState == LayoutErrors::NoError && not qFuzzyIsNull(lGenerator.GetEfficiencyCoefficient())
-                    && efficiency >= lGenerator.GetEfficiencyCoefficient()))
+    if (lGenerator.IsMultiStart())
+    {
+        lGenerator.GenerateMultiStart(timer, lGenerator.GetNestingTimeMSecs(), [&progress](qreal value)
         {
-            if (not lGenerator.IsPreferOneSheetSolution() || lGenerator.PapersCount() == 1)
+            if (VApplication::IsGUIMode())
             {
-                break;
+                progress->Efficiency(value);
             }
-        }
+        });
+        nestingState = lGenerator.State();
 
-        if (IsTimeout())
+        if (nestingState == LayoutErrors::NoError)
         {
-            break;
+            efficiency = lGenerator.LayoutEfficiency();
+            SaveLayout();
         }
     }
+    else
+    {
+        lGenerator.Search(timer, lGenerator.GetNestingTimeMSecs(), [&efficiency, &lGenerator, SaveLayout]()
+        {
+            efficiency = lGenerator.LayoutEfficiency();
+            SaveLayout();
+        });
+
+        nestingState = lGenerator.State();
+        IsTimeout();
+    }
 
     if (VApplication::IsGUIMode())
     {
@@ -506,54 +446,127 @@ void MainWindowsNoGUI::ExportData(const QVector<VLayoutPiece> &listDetails)
 {
     const LayoutExportFormats format = m_dialogSaveLayout->Format();
 
-    if (format == LayoutExportFormats::DXF_AC1006_AAMA ||
-        format == LayoutExportFormats::DXF_AC1009_AAMA ||
-        format == LayoutExportFormats::DXF_AC1012_AAMA ||
-        format == LayoutExportFormats::DXF_AC1014_AAMA ||
-        format == LayoutExportFormats::DXF_AC1015_AAMA ||
-        format == LayoutExportFormats::DXF_AC1018_AAMA ||
-        format == LayoutExportFormats::DXF_AC1021_AAMA ||
-        format == LayoutExportFormats::DXF_AC1024_AAMA ||
-        format == LayoutExportFormats::DXF_AC1027_AAMA ||
-        format == LayoutExportFormats::DXF_AC1006_ASTM ||
-        format == LayoutExportFormats::DXF_AC1009_ASTM ||
-        format == LayoutExportFormats::DXF_AC1012_ASTM ||
-        format == LayoutExportFormats::DXF_AC1014_ASTM ||
-        format == LayoutExportFormats::DXF_AC1015_ASTM ||
-        format == LayoutExportFormats::DXF_AC1018_ASTM ||
-        format == LayoutExportFormats::DXF_AC1021_ASTM ||
-        format == LayoutExportFormats::DXF_AC1024_ASTM ||
-        format == LayoutExportFormats::DXF_AC1027_ASTM)
-    {
-        if (m_dialogSaveLayout->Mode() == Draw::Layout)
+    if (m_dialogSaveLayout->Mode() == Draw::Layout)
+    {
+        if (VLayoutExporter::IsSupported(format))
         {
-            for (int i = 0; i < detailsOnLayout.size(); ++i)
-            {
-                const QString name = m_dialogSaveLayout->Path() + '/' + m_dialogSaveLayout->FileName() +
-                        QString::number(i+1) + DialogSaveLayout::ExportFormatSuffix(m_dialogSaveLayout->Format());
-
-                QGraphicsRectItem *paper = qgraphicsitem_cast<QGraphicsRectItem *>(papers.at(i));
-                SCASSERT(paper != nullptr)
-
-                ExportApparelLayout(detailsOnLayout.at(i), name, paper->rect().size().toSize());
-            }
+            ExportLayoutSheets();
         }
         else
         {
-            ExportDetailsAsApparelLayout(listDetails);
+            ExportFlatLayout(scenes, papers, shadows, details, ignorePrinterFields, margins);
         }
     }
+    else if (format == LayoutExportFormats::DXF_AC1006_AAMA ||
+             format == LayoutExportFormats::DXF_AC1009_AAMA ||
+             format == LayoutExportFormats::DXF_AC1012_AAMA ||
+             format == LayoutExportFormats::DXF_AC1014_AAMA ||
+             format == LayoutExportFormats::DXF_AC1015_AAMA ||
+             format == LayoutExportFormats::DXF_AC1018_AAMA ||
+             format == LayoutExportFormats::DXF_AC1021_AAMA ||
+             format == LayoutExportFormats::DXF_AC1024_AAMA ||
+             format == LayoutExportFormats::DXF_AC1027_AAMA ||
+             format == LayoutExportFormats::DXF_AC1006_ASTM ||
+             format == LayoutExportFormats::DXF_AC1009_ASTM ||
+             format == LayoutExportFormats::DXF_AC1012_ASTM ||
+             format == LayoutExportFormats::DXF_AC1014_ASTM ||
+             format == LayoutExportFormats::DXF_AC1015_ASTM ||
+             format == LayoutExportFormats::DXF_AC1018_ASTM ||
+             format == LayoutExportFormats::DXF_AC1021_ASTM ||
+             format == LayoutExportFormats::DXF_AC1024_ASTM ||
+             format == LayoutExportFormats::DXF_AC1027_ASTM)
+    {
+        ExportDetailsAsApparelLayout(listDetails);
+    }
     else
     {
-        if (m_dialogSaveLayout->Mode() == Draw::Layout)
+        ExportDetailsAsFlatLayout(listDetails);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ExportLayoutSheets export sheets of the layout without rendering scenes.
+ *
+ * Pieces are painted directly on a paint device of the format. Scenes are still used for preview and for formats that
+ * go through a printer (PS, EPS, tiled PDF).
+ *
+ * Each sheet gets own exporter and own paint device, pieces are only read, so sheets are written in parallel. Time of
+ * each sheet goes to the debug log.
+ */
+void MainWindowsNoGUI::ExportLayoutSheets() const
+{
+    const QString path = m_dialogSaveLayout->Path();
+    bool usedNotExistedDir = CreateLayoutPath(path);
+    if (not usedNotExistedDir)
+    {
+        qCritical() << tr("Can't create a path");
+        return;
+    }
+
+    qApp->ValentinaSettings()->SetPathLayout(path);
+    const LayoutExportFormats format = m_dialogSaveLayout->Format();
+
+    VLayoutExporter exporter;
+    exporter.SetMargins(margins);
+    exporter.SetXScale(m_dialogSaveLayout->GetXScale());
+    exporter.SetYScale(m_dialogSaveLayout->GetYScale());
+    exporter.SetTitle(FileName());
+    exporter.SetDescription(doc->GetDescription().toHtmlEscaped());
+    exporter.SetTextAsPaths(isTextAsPaths); // Must match the preview, pieces on scenes were created with this value
+    exporter.SetIgnorePrinterMargins(ignorePrinterFields);
+    exporter.SetBinaryDxfFormat(m_dialogSaveLayout->IsBinaryDXFFormat());
+    exporter.SetDpi(m_dialogSaveLayout->GetDpi());
+
+    // Graphics items belong to the main thread. Take sizes of sheets before starting workers.
+    QVector<int> sheets;
+    QVector<QRectF> rects(detailsOnLayout.size());
+    for (int i = 0; i < detailsOnLayout.size(); ++i)
+    {
+        if (auto *paper = qgraphicsitem_cast<QGraphicsRectItem *>(papers.at(i)))
         {
-            ExportFlatLayout(scenes, papers, shadows, details, ignorePrinterFields, margins);
+            rects[i] = paper->rect();
+            sheets.append(i);
+        }
+    }
+
+    const QString baseName = path + '/' + m_dialogSaveLayout->FileName();
+    const QString suffix = DialogSaveLayout::ExportFormatSuffix(format);
+
+    std::function<void (int)> ExportSheet = [this, exporter, format, &rects, baseName, suffix](int i)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        VLayoutExporter sheetExporter = exporter;
+        sheetExporter.SetFileName(baseName + QString::number(i+1) + suffix);
+        sheetExporter.SetImageRect(rects.at(i));
+
+        if (sheetExporter.Export(format, detailsOnLayout.at(i)))
+        {
+            qDebug() << "Sheet" << i+1 << "exported in" << timer.elapsed() << "ms";
         }
         else
         {
-            ExportDetailsAsFlatLayout(listDetails);
+            qCritical() << tr("Creating file '%1' failed!").arg(sheetExporter.FileName());
         }
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (sheets.size() > 1)
+    {
+        QtConcurrent::blockingMap(sheets, ExportSheet);
     }
+    else
+    {
+        std::for_each(sheets.cbegin(), sheets.cend(), ExportSheet);
+    }
+
+    qDebug() << "Layout exported in" << timer.elapsed() << "ms";
+
+    RemoveLayoutPath(path, usedNotExistedDir);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -1061,7 +1074,20 @@ QVector<VLayoutPiece> MainWindowsNoGUI::PrepareDetailsForLayout(const QVector<De
     {
         VAbstractTool *tool = qobject_cast<VAbstractTool*>(VAbstractPattern::getTool(data.id));
         SCASSERT(tool != nullptr)
-        return VLayoutPiece::Create(data.piece, data.id, tool->getData());
+
+        // Reuse the geometry the piece tool calculated on the last recalculation if the piece didn't change since then.
+        // The tool drops it when the pattern is recalculated.
+        VPieceGeometry geometry;
+        if (auto *pieceTool = qobject_cast<VToolSeamAllowance*>(tool))
+        {
+            geometry = pieceTool->Geometry();
+            if (not geometry.IsActual(data.piece, tool->getData()))
+            {
+                geometry = VPieceGeometry();
+            }
+        }
+
+        return VLayoutPiece::Create(data.piece, data.id, tool->getData(), geometry);
     };
 
     QProgressDialog progress(tr("Preparing details for layout"), QString(), 0, details.size());
@@ -1246,12 +1272,18 @@ void MainWindowsNoGUI::PngFile(const QString &name, QGraphicsRectItem *paper, QG
                                const QMarginsF &margins) const
 {
     const QRectF r = paper->rect();
+    const qreal dpiScale = m_dialogSaveLayout->GetDpi() / PrintDPI;
     // Create the image with the exact size of the shrunk scene
-    QImage image(QSize(qFloor(r.width() * m_dialogSaveLayout->GetXScale() + margins.left() + margins.right()),
-                       qFloor(r.height() * m_dialogSaveLayout->GetYScale() + margins.top() + margins.bottom())),
+    QImage image(QSize(qFloor((r.width() * m_dialogSaveLayout->GetXScale() + margins.left() + margins.right())
+                              * dpiScale),
+                       qFloor((r.height() * m_dialogSaveLayout->GetYScale() + margins.top() + margins.bottom())
+                              * dpiScale)),
                  QImage::Format_ARGB32);
+    image.setDotsPerMeterX(qRound(m_dialogSaveLayout->GetDpi() / 0.0254));
+    image.setDotsPerMeterY(qRound(m_dialogSaveLayout->GetDpi() / 0.0254));
     image.fill(Qt::white);
     QPainter painter(&image);
+    painter.scale(dpiScale, dpiScale);
     painter.translate(margins.left(), margins.top());
     painter.setRenderHint(QPainter::Antialiasing, true);
     painter.setPen(QPen(Qt::black, qApp->Settings()->WidthMainLine(), Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
@@ -159,6 +159,7 @@ private:
     bool isAutoCropLength;
     bool isAutoCropWidth;
     bool isUnitePages;
+    bool isTextAsPaths{false};
 
     QString layoutPrinterName;
 
@@ -211,6 +212,8 @@ private:
                      const QList<QList<QGraphicsItem *> > &details,
                      bool ignorePrinterFields, const QMarginsF &margins) const;
 
+    void ExportLayoutSheets() const;
+
     void ExportApparelLayout(const QVector<VLayoutPiece> &details, const QString &name, const QSize &size) const;
 
     void ExportDetailsAsApparelLayout(QVector<VLayoutPiece> listDetails);
@@ -53,12 +53,13 @@
 #include "../vgeometry/vcubicbezierpath.h"
 #include "../core/vapplication.h"
 #include "../vpatterndb/vpiecenode.h"
-#include "../vpatterndb/calculator.h"
+#include "../vpatterndb/vcalculatorcache.h"
 #include "../vpatterndb/floatItemData/vpiecelabeldata.h"
 #include "../vpatterndb/floatItemData/vpatternlabeldata.h"
 #include "../vpatterndb/floatItemData/vgrainlinedata.h"
 #include "../vpatterndb/vpiecepath.h"
 #include "../vpatterndb/vnodedetail.h"
+#include "../vgeometry/vabstractcurve.h"
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
 #include "../vmisc/backport/qscopeguard.h"
@@ -75,13 +76,25 @@
 #include <QFuture>
 #include <QtConcurrentRun>
 #include <QTimer>
+#include <QJsonDocument>
+#include <QLoggingCategory>
+#include <QSet>
+#include <QThreadPool>
 #include <functional>
+#include <iterator>
+
+// Enable debug messages to check each incremental parse against a full lite parse
+Q_LOGGING_CATEGORY(vIncrementalParse, "v.incrementalparse", QtInfoMsg)
 
 const QString VPattern::AttrReadOnly    = QStringLiteral("readOnly");
 const QString VPattern::AttrLabelPrefix = QStringLiteral("labelPrefix");
 
 namespace
 {
+// Data of a pattern piece parsed in the current thread. Used only while parsing independent pattern pieces at the same
+// time.
+thread_local VContainer *parseShard = nullptr;
+
 //---------------------------------------------------------------------------------------------------------------------
 QString FileComment()
 {
@@ -105,6 +118,40 @@ QString DefLabelLanguage()
     }
     return def;
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+void AddVariables(VContainer &data, const QVector<QSharedPointer<VInternalVariable>> &variables)
+{
+    for (const auto &variable : variables)
+    {
+        if (not data.DataVariables()->contains(variable->GetName()))
+        {
+            data.AddVariable(variable);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void LogDataDifference(QLoggingCategory::CategoryFunction category, const QStringList &expected,
+                       const QStringList &got)
+{
+    QStringList missing;
+    std::set_difference(expected.constBegin(), expected.constEnd(), got.constBegin(), got.constEnd(),
+                        std::back_inserter(missing));
+    QStringList unexpected;
+    std::set_difference(got.constBegin(), got.constEnd(), expected.constBegin(), expected.constEnd(),
+                        std::back_inserter(unexpected));
+
+    for (const auto &line : qAsConst(missing))
+    {
+        qCWarning(category, "Expected: %s", qUtf8Printable(line));
+    }
+
+    for (const auto &line : qAsConst(unexpected))
+    {
+        qCWarning(category, "Got: %s", qUtf8Printable(line));
+    }
+}
 } // anonymous namespace
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -175,6 +222,15 @@ void VPattern::Parse(const Document &parse)
     static const QStringList tags({TagDraw, TagIncrements, TagPreviewCalculations});
     PrepareForParse(parse);
 
+    const qint64 pointsRequests = VAbstractCurve::PointsRequests();
+    const qint64 pointsFlattenings = VAbstractCurve::PointsFlattenings();
+    const qint64 formulaHits = VCalculatorCache::Instance()->Hits();
+    const qint64 formulaMisses = VCalculatorCache::Instance()->Misses();
+
+    const QHash<QString, int> drawBatches = ParallelDrawBatches(parse);
+    QVector<QDomElement> batch;
+    int batchIndex = -1;
+
     QDomNode domNode = documentElement().firstChild();
     while (domNode.isNull() == false)
     {
@@ -198,14 +254,23 @@ void VPattern::Parse(const Document &parse)
                                 ChangeActivPP(GetParametrString(domElement, AttrName));
                             }
                             patternPieces << GetParametrString(domElement, AttrName);
+                            ParseDrawElement(domElement, parse);
                         }
                         else
                         {
-                            ChangeActivPP(GetParametrString(domElement, AttrName), Document::LiteParse);
+                            const int index = drawBatches.value(GetParametrString(domElement, AttrName), -1);
+                            if (index == -1 || index != batchIndex)
+                            {
+                                ParseDrawBatch(batch, parse);
+                                batch.clear();
+                            }
+                            batch.append(domElement);
+                            batchIndex = index;
                         }
-                        ParseDrawElement(domElement, parse);
                         break;
                     case 1: // TagIncrements
+                        ParseDrawBatch(batch, parse);
+                        batch.clear();
                         if (parse != Document::LiteParse)
                         {
                             qCDebug(vXML, "Tag increments.");
@@ -213,6 +278,8 @@ void VPattern::Parse(const Document &parse)
                         }
                         break;
                     case 2: // TagPreviewCalculations
+                        ParseDrawBatch(batch, parse);
+                        batch.clear();
                         if (parse != Document::LiteParse)
                         {
                             qCDebug(vXML, "Tag prewiew calculations.");
@@ -227,6 +294,13 @@ void VPattern::Parse(const Document &parse)
         }
         domNode = domNode.nextSibling();
     }
+    ParseDrawBatch(batch, parse);
+
+    qCDebug(vXML, "Curve points were requested %lld times, %lld of them were calculated.",
+            VAbstractCurve::PointsRequests() - pointsRequests, VAbstractCurve::PointsFlattenings() - pointsFlattenings);
+    qCDebug(vCalculatorCache, "Compiled formulas were reused %lld times, %lld formulas were parsed.",
+            VCalculatorCache::Instance()->Hits() - formulaHits, VCalculatorCache::Instance()->Misses() - formulaMisses);
+
     if (qApp->IsGUIMode())
     {
         QTimer::singleShot(1000, Qt::VeryCoarseTimer, this, SLOT(RefreshPieceGeometry()));
@@ -307,6 +381,13 @@ void VPattern::UpdateToolData(const quint32 &id, VContainer *data)
     Q_ASSERT_X(id != 0, Q_FUNC_INFO, "id == 0"); //-V712 //-V654
     SCASSERT(data != nullptr)
     ToolExists(id);
+
+    if (m_incrementalParse)
+    {
+        // Objects and variables were updated in place. The tool already sees new values.
+        return;
+    }
+
     VDataTool *tool = tools.value(id);
     SCASSERT(tool != nullptr)
     tool->VDataTool::setData(data);
@@ -539,15 +620,22 @@ void VPattern::LiteParseTree(const Document &parse)
     try
     {
         emit SetEnabledGUI(true);
+        InvalidatePiecesGeometry();
         switch (parse)
         {
             case Document::LitePPParse:
                 ParseCurrentPP();
                 break;
             case Document::FullLiteParse:
-            case Document::LiteParse:
+                m_graph.Update(this, GetCompleteData(), nullptr);
                 Parse(parse);
                 break;
+            case Document::LiteParse:
+                if (not IncrementalLiteParse())
+                {
+                    Parse(parse);
+                }
+                break;
             case Document::FullParse:
                 qCWarning(vXML, "Lite parsing doesn't support full parsing");
                 break;
@@ -700,8 +788,9 @@ VNodeDetail VPattern::ParseDetailNode(const QDomElement &domElement) const
  * @brief ParseDrawElement parse draw tag.
  * @param node node.
  * @param parse parser file mode.
+ * @param blocks tags to parse. Empty list means all tags.
  */
-void VPattern::ParseDrawElement(const QDomNode &node, const Document &parse)
+void VPattern::ParseDrawElement(const QDomNode &node, const Document &parse, const QStringList &blocks)
 {
     QStringList tags = QStringList() << TagCalculation << TagModeling << TagDetails << TagGroups;
     QDomNode domNode = node.firstChild();
@@ -710,13 +799,13 @@ void VPattern::ParseDrawElement(const QDomNode &node, const Document &parse)
         if (domNode.isElement())
         {
             const QDomElement domElement = domNode.toElement();
-            if (domElement.isNull() == false)
+            if (domElement.isNull() == false && (blocks.isEmpty() || blocks.contains(domElement.tagName())))
             {
                 switch (tags.indexOf(domElement.tagName()))
                 {
                     case 0: // TagCalculation
                         qCDebug(vXML, "Tag calculation.");
-                        data->ClearCalculationGObjects();
+                        ParseData()->ClearCalculationGObjects();
                         ParseDrawMode(domElement, parse, Draw::Calculation);
                         break;
                     case 1: // TagModeling
@@ -741,6 +830,228 @@ void VPattern::ParseDrawElement(const QDomNode &node, const Document &parse)
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ParseData return container parsing should work with. Each worker parsing a pattern piece has own container.
+ */
+VContainer *VPattern::ParseData() const
+{
+    return parseShard != nullptr ? parseShard : data;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ParallelDrawBatches return index of batch for each pattern piece that can be parsed in parallel with others.
+ * @param parse parser file mode.
+ */
+QHash<QString, int> VPattern::ParallelDrawBatches(const Document &parse) const
+{
+    QHash<QString, int> drawBatches;
+
+    // Full parse creates tools and scene items. They must be created in the main thread.
+    if (parse == Document::FullParse || not m_parallelParse || m_graph.IsEmpty()
+            || QThreadPool::globalInstance()->maxThreadCount() < 2)
+    {
+        return drawBatches;
+    }
+
+    const QVector<QStringList> batches = m_graph.DrawBatches();
+    for (int i = 0; i < batches.size(); ++i)
+    {
+        for (const auto &draw : batches.at(i))
+        {
+            drawBatches.insert(draw, i);
+        }
+    }
+    return drawBatches;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ModelingIds return ids of modeling objects and piece paths a pattern piece creates.
+ * @param draw draw tag.
+ */
+QVector<quint32> VPattern::ModelingIds(const QDomElement &draw)
+{
+    QVector<quint32> ids;
+    const QDomElement modeling = draw.firstChildElement(TagModeling);
+    QDomElement element = modeling.firstChildElement();
+    while (not element.isNull())
+    {
+        const quint32 id = GetParametrUInt(element, AttrId, NULL_ID_STR);
+        if (id != NULL_ID)
+        {
+            ids.append(id);
+        }
+        element = element.nextSiblingElement();
+    }
+    return ids;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ParseDrawBatch parse pattern pieces that don't use objects and variables of each other.
+ *
+ * Calculation and modeling tags of each pattern piece are parsed in a worker thread into own copy of data. Each copy
+ * gets own tables of modeling objects and piece paths, workers never write to tables shared with other containers.
+ * A copy also lacks calculation objects of other pattern pieces from the batch. If the dependency graph missed a
+ * reference the worker fails and the batch is parsed sequentially. After that the main thread copies modeling objects
+ * and paths of each pattern piece to the shared tables and parses details and groups in document order. Each pattern
+ * piece gets variables of the previous pattern pieces from the batch, so the data is the same as after sequential
+ * parsing.
+ * @param draws draw tags in document order.
+ * @param parse parser file mode.
+ */
+void VPattern::ParseDrawBatch(const QVector<QDomElement> &draws, const Document &parse)
+{
+    auto ParseSequentially = [this, &draws, parse]()
+    {
+        for (const auto &draw : draws)
+        {
+            ChangeActivPP(GetParametrString(draw, AttrName), Document::LiteParse);
+            ParseDrawElement(draw, parse);
+        }
+    };
+
+    if (draws.size() <= 1)
+    {
+        ParseSequentially();
+        return;
+    }
+
+    qCDebug(vXML, "Parsing %d pattern pieces in parallel.", draws.size());
+
+    const VContainer base = *data;
+
+    // Lite parse updates objects in place. A worker doesn't get objects of other pattern pieces from the batch, so a
+    // pattern piece that uses them fails instead of reading objects another worker writes.
+    QVector<QVector<quint32>> drawObjects(draws.size());
+    {
+        QHash<quint32, int> toolDraws;
+        for (int i = 0; i < draws.size(); ++i)
+        {
+            const QVector<VToolRecord> localHistory = getLocalHistory(GetParametrString(draws.at(i), AttrName));
+            for (const auto &record : localHistory)
+            {
+                toolDraws.insert(record.getId(), i);
+            }
+        }
+
+        const QHash<quint32, QSharedPointer<VGObject>> *objects = base.CalculationGObjects();
+        for (auto object = objects->constBegin(); object != objects->constEnd(); ++object)
+        {
+            auto draw = toolDraws.constFind(object.value()->getIdTool());
+            if (draw != toolDraws.constEnd())
+            {
+                drawObjects[draw.value()].append(object.key());
+            }
+        }
+    }
+
+    auto RestoreObjects = [&base, &drawObjects](VContainer &container, int draw)
+    {
+        for (int i = 0; i < drawObjects.size(); ++i)
+        {
+            if (i != draw)
+            {
+                for (auto id : drawObjects.at(i))
+                {
+                    container.UpdateGObject(id, base.GetGObject(id));
+                }
+            }
+        }
+    };
+
+    QVector<VContainer> shards;
+    shards.reserve(draws.size());
+    QVector<int> indexes;
+    indexes.reserve(draws.size());
+    for (int i = 0; i < draws.size(); ++i)
+    {
+        shards.append(base);
+        shards.last().DetachModeling();
+        for (int j = 0; j < draws.size(); ++j)
+        {
+            if (j != i)
+            {
+                for (auto id : drawObjects.at(j))
+                {
+                    shards.last().RemoveGObject(id);
+                }
+            }
+        }
+        indexes.append(i);
+    }
+
+    VContainer *shardsData = shards.data();
+    std::function<void (int)> ParseShard = [this, &draws, shardsData, parse](int i)
+    {
+        parseShard = shardsData + i;
+        auto ResetShard = qScopeGuard([]() {parseShard = nullptr;});
+        ParseDrawElement(draws.at(i), parse, QStringList({TagCalculation, TagModeling}));
+    };
+
+    try
+    {
+        QtConcurrent::blockingMap(indexes, ParseShard);
+    }
+    catch (const QException &)
+    {
+        // Wrong formula can be fixed only by user in the main thread. Repeat the batch sequentially to get the same
+        // dialogs and errors as without workers.
+        qCDebug(vXML, "Parallel parsing failed. Parsing pattern pieces sequentially.");
+        m_parallelParseFailed = true;
+        *data = base;
+        ParseSequentially();
+        return;
+    }
+
+    QVector<QSharedPointer<VInternalVariable>> previous;
+    for (int i = 0; i < draws.size(); ++i)
+    {
+        VContainer &shard = shards[i];
+        const QString name = GetParametrString(draws.at(i), AttrName);
+
+        data->MergeModeling(shard, ModelingIds(draws.at(i)));
+        shard.ShareModeling(*data);
+        RestoreObjects(shard, i);
+
+        QVector<QSharedPointer<VInternalVariable>> own;
+        const QHash<QString, QSharedPointer<VInternalVariable>> *variables = shard.DataVariables();
+        for (auto variable = variables->constBegin(); variable != variables->constEnd(); ++variable)
+        {
+            if (not base.DataVariables()->contains(variable.key()))
+            {
+                own.append(variable.value());
+            }
+        }
+
+        AddVariables(shard, previous);
+
+        // Tools got data with detached tables from the worker
+        const QVector<VToolRecord> localHistory = getLocalHistory(name);
+        for (const auto &record : localHistory)
+        {
+            if (VDataTool *tool = tools.value(record.getId(), nullptr))
+            {
+                VContainer toolData = tool->getData();
+                toolData.ShareModeling(*data);
+                RestoreObjects(toolData, i);
+                AddVariables(toolData, previous);
+                tool->VDataTool::setData(&toolData);
+            }
+        }
+        previous += own;
+
+        ChangeActivPP(name, Document::LiteParse);
+        parseShard = &shard;
+        auto ResetShard = qScopeGuard([]() {parseShard = nullptr;});
+        ParseDrawElement(draws.at(i), parse, QStringList({TagDetails, TagGroups}));
+    }
+
+    *data = shards.last();
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief ParseDrawMode parse draw tag with draw mode.
@@ -753,14 +1064,6 @@ void VPattern::ParseDrawMode(const QDomNode &node, const Document &parse, const
     SCASSERT(sceneDraw != nullptr)
     SCASSERT(sceneDetail != nullptr)
     VMainGraphicsScene *scene = mode == Draw::Calculation ? sceneDraw : sceneDetail;
-    static const QStringList tags({TagPoint,
-                                   TagLine,
-                                   TagSpline,
-                                   TagArc,
-                                   TagTools,
-                                   TagOperation,
-                                   TagElArc,
-                                   TagPath});
     const QDomNodeList nodeList = node.childNodes();
     const qint32 num = nodeList.size();
     for (qint32 i = 0; i < num; ++i)
@@ -768,44 +1071,7 @@ void VPattern::ParseDrawMode(const QDomNode &node, const Document &parse, const
         QDomElement domElement = nodeList.at(i).toElement();
         if (domElement.isNull() == false)
         {
-            switch (tags.indexOf(domElement.tagName()))
-            {
-                case 0: // TagPoint
-                    qCDebug(vXML, "Tag point.");
-                    ParsePointElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
-                    break;
-                case 1: // TagLine
-                    qCDebug(vXML, "Tag line.");
-                    ParseLineElement(scene, domElement, parse);
-                    break;
-                case 2: // TagSpline
-                    qCDebug(vXML, "Tag spline.");
-                    ParseSplineElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
-                    break;
-                case 3: // TagArc
-                    qCDebug(vXML, "Tag arc.");
-                    ParseArcElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
-                    break;
-                case 4: // TagTools
-                    qCDebug(vXML, "Tag tools.");
-                    ParseToolsElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
-                    break;
-                case 5: // TagOperation
-                    qCDebug(vXML, "Tag operation.");
-                    ParseOperationElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
-                    break;
-                case 6: // TagElArc
-                    qCDebug(vXML, "Tag elliptical arc.");
-                    ParseEllipticalArcElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
-                    break;
-                case 7: // TagPath
-                    qCDebug(vXML, "Tag path.");
-                    ParsePathElement(scene, domElement, parse);
-                    break;
-                default:
-                    VException e(tr("Wrong tag name '%1'.").arg(domElement.tagName()));
-                    throw e;
-            }
+            ParseDrawModeElement(scene, domElement, parse);
         }
     }
 
@@ -815,6 +1081,63 @@ void VPattern::ParseDrawMode(const QDomNode &node, const Document &parse, const
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ParseDrawModeElement parse one tool from calculation or modeling tag.
+ * @param scene scene.
+ * @param domElement tag in xml tree.
+ * @param parse parser file mode.
+ */
+void VPattern::ParseDrawModeElement(VMainGraphicsScene *scene, QDomElement &domElement, const Document &parse)
+{
+    static const QStringList tags({TagPoint,
+                                   TagLine,
+                                   TagSpline,
+                                   TagArc,
+                                   TagTools,
+                                   TagOperation,
+                                   TagElArc,
+                                   TagPath});
+    switch (tags.indexOf(domElement.tagName()))
+    {
+        case 0: // TagPoint
+            qCDebug(vXML, "Tag point.");
+            ParsePointElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
+            break;
+        case 1: // TagLine
+            qCDebug(vXML, "Tag line.");
+            ParseLineElement(scene, domElement, parse);
+            break;
+        case 2: // TagSpline
+            qCDebug(vXML, "Tag spline.");
+            ParseSplineElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
+            break;
+        case 3: // TagArc
+            qCDebug(vXML, "Tag arc.");
+            ParseArcElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
+            break;
+        case 4: // TagTools
+            qCDebug(vXML, "Tag tools.");
+            ParseToolsElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
+            break;
+        case 5: // TagOperation
+            qCDebug(vXML, "Tag operation.");
+            ParseOperationElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
+            break;
+        case 6: // TagElArc
+            qCDebug(vXML, "Tag elliptical arc.");
+            ParseEllipticalArcElement(scene, domElement, parse, domElement.attribute(AttrType, QString()));
+            break;
+        case 7: // TagPath
+            qCDebug(vXML, "Tag path.");
+            ParsePathElement(scene, domElement, parse);
+            break;
+        default:
+            VException e(tr("Wrong tag name '%1'.").arg(domElement.tagName()));
+            throw e;
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief ParseDetailElement parse detail tag.
@@ -852,7 +1175,7 @@ void VPattern::ParseDetailElement(QDomElement &domElement, const Document &parse
 
         initData.scene = sceneDetail;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1014,7 +1337,7 @@ QVector<VPieceNode> VPattern::ParseDetailNodes(const QDomElement &domElement, qr
         }
     }
 
-    return VNodeDetail::Convert(data, oldNodes, width, closed);
+    return VNodeDetail::Convert(ParseData(), oldNodes, width, closed);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -1324,7 +1647,7 @@ void VPattern::ParseLineElement(VMainGraphicsScene *scene, const QDomElement &do
         initData.lineColor = GetParametrString(domElement, AttrLineColor, ColorBlack);
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1357,6 +1680,374 @@ void VPattern::ParseCurrentPP()
     emit CheckLayout();
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief InvalidatePiecesGeometry drop geometry that piece tools keep for layout export.
+ *
+ * Recalculation can change objects a piece depends on without refreshing the piece tool, for example when the tool
+ * is not in the list of dirty tools or the change comes from settings.
+ */
+void VPattern::InvalidatePiecesGeometry()
+{
+    for (auto *tool : qAsConst(tools))
+    {
+        if (auto *pieceTool = qobject_cast<VToolSeamAllowance *>(tool))
+        {
+            pieceTool->InvalidateGeometry();
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IncrementalLiteParse recalculate only tools affected by the last change.
+ *
+ * Objects and variables are shared between data of all tools in a pattern piece, so recalculating a tool in data of
+ * the last tool updates them in place for everyone.
+ * @return false if the change can't be handled incrementally. Full lite parse is needed in this case.
+ */
+bool VPattern::IncrementalLiteParse()
+{
+    if (m_graph.IsEmpty())
+    {
+        m_graph.Update(this, GetCompleteData(), nullptr);
+        return false;
+    }
+
+    QVector<quint32> dirty;
+    if (not m_graph.Update(this, GetCompleteData(), &dirty))
+    {
+        qCDebug(vIncrementalParse, "Structure of the pattern changed. Falling back to full lite parse.");
+        return false;
+    }
+
+    qCDebug(vIncrementalParse, "Recalculating %d tools.", dirty.size());
+
+    if (dirty.isEmpty())
+    {
+        return true;
+    }
+
+    emit PreParseState();
+    m_parsing = true;
+
+    if (not RecalculateTools(dirty))
+    {
+        m_parsing = false;
+        return false;
+    }
+
+    if (qApp->IsGUIMode())
+    {
+        QTimer::singleShot(1000, Qt::VeryCoarseTimer, this, SLOT(RefreshPieceGeometry()));
+    }
+    else if (qApp->CommandLine()->IsTestModeEnabled())
+    {
+        RefreshPieceGeometry();
+    }
+    emit CheckLayout();
+    m_parsing = false;
+
+    if (vIncrementalParse().isDebugEnabled())
+    {
+        VerifyIncrementalParse();
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RecalculateTools lite parse tools from the list.
+ * @param dirty tool ids in document order.
+ * @return false if a tool added or removed objects or variables.
+ */
+bool VPattern::RecalculateTools(const QVector<quint32> &dirty)
+{
+    const VContainer current = *data;
+    m_incrementalParse = true;
+    auto RestoreData = qScopeGuard([this, current]()
+    {
+        *data = current;
+        m_incrementalParse = false;
+    });
+
+    QString draw;
+    for (auto id : dirty)
+    {
+        if (m_graph.DrawName(id) != draw)
+        {
+            draw = m_graph.DrawName(id);
+            const VDataTool *lastTool = tools.value(m_graph.LastTool(draw), nullptr);
+            if (lastTool == nullptr)
+            {
+                return false;
+            }
+
+            *data = lastTool->getData();
+            //Delete special variables if exist
+            data->RemoveVariable(currentLength);
+            data->RemoveVariable(currentSeamAllowance);
+            ChangeActivPP(draw, Document::LiteParse);
+        }
+
+        QDomElement domElement = elementById(id);
+        if (domElement.isNull())
+        {
+            return false;
+        }
+
+        const int objects = data->CalculationGObjects()->size();
+        const int variables = data->DataVariables()->size();
+        const int pieces = data->DataPieces()->size();
+
+        const QString block = domElement.parentNode().toElement().tagName();
+        if (block == TagCalculation)
+        {
+            ParseDrawModeElement(sceneDraw, domElement, Document::LiteParse);
+        }
+        else if (block == TagModeling)
+        {
+            ParseDrawModeElement(sceneDetail, domElement, Document::LiteParse);
+        }
+        else if (block == TagDetails)
+        {
+            // A piece keeps its own seam allowance variable, let it store the data
+            m_incrementalParse = false;
+            ParseDetailElement(domElement, Document::LiteParse);
+            m_incrementalParse = true;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (objects != data->CalculationGObjects()->size() || variables != data->DataVariables()->size()
+                || pieces != data->DataPieces()->size())
+        {
+            qCDebug(vIncrementalParse, "Tool %u changed structure of data.", id);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief DataFingerprint return text description of calculated data. Used to compare two ways of parsing.
+ */
+QStringList VPattern::DataFingerprint() const
+{
+    QStringList fingerprint;
+
+    for (const auto &draw : patternPieces)
+    {
+        const VDataTool *lastTool = tools.value(m_graph.LastTool(draw), nullptr);
+        if (lastTool == nullptr)
+        {
+            continue;
+        }
+
+        const VContainer toolData = lastTool->getData();
+
+        const QHash<quint32, QSharedPointer<VGObject> > *objects = toolData.CalculationGObjects();
+        for (auto i = objects->constBegin(); i != objects->constEnd(); ++i)
+        {
+            QString line = draw + QChar(':') + QString::number(i.key()) + QChar(' ') + i.value()->name() + QChar(' ')
+                    + QString::fromUtf8(QJsonDocument(i.value()->ToJson()).toJson(QJsonDocument::Compact));
+
+            const QSharedPointer<VAbstractCurve> curve = i.value().dynamicCast<VAbstractCurve>();
+            if (not curve.isNull())
+            {
+                line += QChar(' ') + QString::number(curve->GetLength(), 'g', 10) + QChar(' ')
+                        + QString::number(curve->GetPoints().size());
+            }
+            fingerprint.append(line);
+        }
+
+        const QHash<QString, QSharedPointer<VInternalVariable>> *variables = toolData.DataVariables();
+        for (auto i = variables->constBegin(); i != variables->constEnd(); ++i)
+        {
+            if (i.key() != currentLength && i.key() != currentSeamAllowance)
+            {
+                fingerprint.append(draw + QChar(':') + i.key() + QChar('=')
+                                   + QString::number(i.value()->GetValue(), 'g', 10));
+            }
+        }
+    }
+
+    const VContainer completeData = GetCompleteData();
+    const QHash<quint32, VPiece> *pieces = completeData.DataPieces();
+    for (auto i = pieces->constBegin(); i != pieces->constEnd(); ++i)
+    {
+        QStringList points;
+        const QVector<QPointF> mainPath = i.value().MainPathPoints(&completeData);
+        for (const auto &point : mainPath)
+        {
+            points.append(QString::number(point.x(), 'g', 10) + QChar(';') + QString::number(point.y(), 'g', 10));
+        }
+        fingerprint.append(QString::number(i.key()) + QChar(' ') + i.value().GetName() + QChar(' ')
+                           + points.join(QChar(' ')));
+    }
+
+    fingerprint.sort();
+    return fingerprint;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VerifyIncrementalParse compare data after incremental parse with data after full lite parse.
+ * @return true if data is the same.
+ */
+bool VPattern::VerifyIncrementalParse()
+{
+    const QStringList incremental = DataFingerprint();
+    Parse(Document::LiteParse);
+    const QStringList full = DataFingerprint();
+
+    if (incremental == full)
+    {
+        qCDebug(vIncrementalParse, "Incremental parse gives the same data as full lite parse.");
+        return true;
+    }
+
+    qCWarning(vIncrementalParse, "Incremental parse gives different data than full lite parse.");
+    LogDataDifference(vIncrementalParse, full, incremental);
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CheckParallelParse compare lite parse of independent pattern pieces in parallel with sequential lite parse.
+ *
+ * Used in test mode. Workers are used even if the machine has only one core.
+ * @return true if both ways give the same data.
+ */
+bool VPattern::CheckParallelParse()
+{
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const int maxThreadCount = pool->maxThreadCount();
+    pool->setMaxThreadCount(qMax(maxThreadCount, 2));
+    auto RestoreState = qScopeGuard([this, pool, maxThreadCount]()
+    {
+        pool->setMaxThreadCount(maxThreadCount);
+        m_parallelParse = true;
+    });
+
+    try
+    {
+        m_graph.Update(this, GetCompleteData(), nullptr);
+
+        m_parallelParse = true;
+        m_parallelParseFailed = false;
+        Parse(Document::LiteParse);
+        const QStringList parallel = DataFingerprint();
+
+        if (m_parallelParseFailed)
+        {
+            qCWarning(vXML, "Pattern pieces from one batch depend on each other.");
+            return false;
+        }
+
+        m_parallelParse = false;
+        Parse(Document::LiteParse);
+        const QStringList sequential = DataFingerprint();
+
+        if (parallel == sequential)
+        {
+            qCDebug(vXML, "Parallel parse gives the same data as sequential parse.");
+            return true;
+        }
+
+        qCWarning(vXML, "Parallel parse gives different data than sequential parse.");
+        LogDataDifference(vXML, sequential, parallel);
+    }
+    catch (VException &e)
+    {
+        qCCritical(vXML, "%s\n\n%s\n\n%s", qUtf8Printable(tr("Error parsing file.")),
+                   qUtf8Printable(e.ErrorMessage()), qUtf8Printable(e.DetailedInformation()));
+    }
+
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CheckIncrementalParse edit formulas of the pattern and compare incremental lite parse with full lite parse.
+ *
+ * Used in test mode. One by one changes the length formula of the first point in each pattern piece, recalculates
+ * changed tools and compares the result with lite parse of the whole pattern. Then does the same for reverting the
+ * change. The document stays as it was loaded.
+ * @return true if both ways give the same data for all changes.
+ */
+bool VPattern::CheckIncrementalParse()
+{
+    QVector<VFormulaField> fields;
+    QSet<QString> draws;
+    const QVector<VFormulaField> expressions = ListExpressions();
+    for (const auto &field : expressions)
+    {
+        if (field.attribute != AttrLength || field.element.tagName() != TagPoint)
+        {
+            continue;
+        }
+
+        QDomElement draw = field.element;
+        while (not draw.isNull() && draw.tagName() != TagDraw)
+        {
+            draw = draw.parentNode().toElement();
+        }
+
+        const QString name = GetParametrString(draw, AttrName);
+        if (not draw.isNull() && not draws.contains(name))
+        {
+            draws.insert(name);
+            fields.append(field);
+        }
+    }
+
+    auto CheckChange = [this]()
+    {
+        if (IncrementalLiteParse())
+        {
+            return VerifyIncrementalParse();
+        }
+
+        // Patterns with union tools always fall back to full lite parse, nothing to compare.
+        qCDebug(vIncrementalParse, "Change was not handled incrementally.");
+        Parse(Document::LiteParse);
+        return true;
+    };
+
+    bool ok = true;
+    try
+    {
+        m_graph.Update(this, GetCompleteData(), nullptr);
+
+        for (const auto &field : qAsConst(fields))
+        {
+            QDomElement element = field.element;
+            qCDebug(vIncrementalParse, "Changing formula of tool %s.",
+                    qUtf8Printable(element.attribute(AttrId)));
+
+            element.setAttribute(field.attribute, QChar('(') + field.expression + QStringLiteral(")+0.1"));
+            ok = CheckChange() && ok;
+
+            element.setAttribute(field.attribute, field.expression);
+            ok = CheckChange() && ok;
+        }
+    }
+    catch (VException &e)
+    {
+        qCCritical(vXML, "%s\n\n%s\n\n%s", qUtf8Printable(tr("Error parsing file.")),
+                   qUtf8Printable(e.ErrorMessage()), qUtf8Printable(e.DetailedInformation()));
+        return false;
+    }
+
+    return ok;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QString VPattern::GetLabelBase(quint32 index) const
 {
@@ -1440,7 +2131,7 @@ void VPattern::ParseToolBasePoint(VMainGraphicsScene *scene, const QDomElement &
         VToolBasePointInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1471,7 +2162,7 @@ void VPattern::ParseToolEndLine(VMainGraphicsScene *scene, QDomElement &domEleme
         VToolEndLineInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1520,7 +2211,7 @@ void VPattern::ParseToolAlongLine(VMainGraphicsScene *scene, QDomElement &domEle
         VToolAlongLineInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1564,7 +2255,7 @@ void VPattern::ParseToolShoulderPoint(VMainGraphicsScene *scene, QDomElement &do
         VToolShoulderPointInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1609,7 +2300,7 @@ void VPattern::ParseToolNormal(VMainGraphicsScene *scene, QDomElement &domElemen
         VToolNormalInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1654,7 +2345,7 @@ void VPattern::ParseToolBisector(VMainGraphicsScene *scene, QDomElement &domElem
         VToolBisectorInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1699,7 +2390,7 @@ void VPattern::ParseToolLineIntersect(VMainGraphicsScene *scene, const QDomEleme
         VToolLineIntersectInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1730,7 +2421,7 @@ void VPattern::ParseToolPointOfContact(VMainGraphicsScene *scene, QDomElement &d
         VToolPointOfContactInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1773,7 +2464,7 @@ void VPattern::ParseNodePoint(const QDomElement &domElement, const Document &par
     {
         VAbstractNodeInitData initData;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
         initData.scene = sceneDetail;
@@ -1821,7 +2512,7 @@ void VPattern::ParsePinPoint(const QDomElement &domElement, const Document &pars
     {
         VToolPinInitData initData;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1859,7 +2550,7 @@ void VPattern::ParsePlaceLabel(QDomElement &domElement, const Document &parse)
     {
         VToolPlaceLabelInitData initData;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1933,7 +2624,7 @@ void VPattern::ParseToolHeight(VMainGraphicsScene *scene, const QDomElement &dom
         VToolHeightInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1963,7 +2654,7 @@ void VPattern::ParseToolTriangle(VMainGraphicsScene *scene, const QDomElement &d
         VToolTriangleInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -1995,7 +2686,7 @@ void VPattern::ParseToolPointOfIntersection(VMainGraphicsScene *scene, const QDo
         VToolPointOfIntersectionInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2024,7 +2715,7 @@ void VPattern::ParseToolCutSpline(VMainGraphicsScene *scene, QDomElement &domEle
         VToolCutSplineInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2067,7 +2758,7 @@ void VPattern::ParseToolCutSplinePath(VMainGraphicsScene *scene, QDomElement &do
         VToolCutSplinePathInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2110,7 +2801,7 @@ void VPattern::ParseToolCutArc(VMainGraphicsScene *scene, QDomElement &domElemen
         VToolCutArcInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2154,7 +2845,7 @@ void VPattern::ParseToolLineIntersectAxis(VMainGraphicsScene *scene, QDomElement
         VToolLineIntersectAxisInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2204,7 +2895,7 @@ void VPattern::ParseToolCurveIntersectAxis(VMainGraphicsScene *scene, QDomElemen
         VToolCurveIntersectAxisInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2252,7 +2943,7 @@ void VPattern::ParseToolPointOfIntersectionArcs(VMainGraphicsScene *scene, const
         VToolPointOfIntersectionArcsInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2283,7 +2974,7 @@ void VPattern::ParseToolPointOfIntersectionCircles(VMainGraphicsScene *scene, QD
         VToolPointOfIntersectionCirclesInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2326,7 +3017,7 @@ void VPattern::ParseToolPointOfIntersectionCurves(VMainGraphicsScene *scene, QDo
         VToolPointOfIntersectionCurvesInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2358,7 +3049,7 @@ void VPattern::ParseToolPointFromCircleAndTangent(VMainGraphicsScene *scene, QDo
         VToolPointFromCircleAndTangentInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2398,7 +3089,7 @@ void VPattern::ParseToolPointFromArcAndTangent(VMainGraphicsScene *scene, const
         VToolPointFromArcAndTangentInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2428,7 +3119,7 @@ void VPattern::ParseToolTrueDarts(VMainGraphicsScene *scene, const QDomElement &
         VToolTrueDartsInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2475,7 +3166,7 @@ void VPattern::ParseOldToolSpline(VMainGraphicsScene *scene, QDomElement &domEle
         VToolSplineInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2490,8 +3181,8 @@ void VPattern::ParseOldToolSpline(VMainGraphicsScene *scene, QDomElement &domEle
         const QString color = GetParametrString(domElement, AttrColor, ColorBlack);
         const quint32 duplicate = GetParametrUInt(domElement, AttrDuplicate, QChar('0'));
 
-        const auto p1 = data->GeometricObject<VPointF>(point1);
-        const auto p4 = data->GeometricObject<VPointF>(point4);
+        const auto p1 = ParseData()->GeometricObject<VPointF>(point1);
+        const auto p4 = ParseData()->GeometricObject<VPointF>(point4);
 
         auto* spline = new VSpline(*p1, *p4, angle1, angle2, kAsm1, kAsm2, kCurve);
         if (duplicate > 0)
@@ -2524,7 +3215,7 @@ void VPattern::ParseToolSpline(VMainGraphicsScene *scene, QDomElement &domElemen
         VToolSplineInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2594,7 +3285,7 @@ void VPattern::ParseToolCubicBezier(VMainGraphicsScene *scene, const QDomElement
         VToolCubicBezierInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2610,10 +3301,10 @@ void VPattern::ParseToolCubicBezier(VMainGraphicsScene *scene, const QDomElement
         const quint32 duplicate = GetParametrUInt(domElement, AttrDuplicate, QChar('0'));
         const qreal approximationScale = GetParametrDouble(domElement, AttrAScale, QChar('0'));
 
-        auto p1 = data->GeometricObject<VPointF>(point1);
-        auto p2 = data->GeometricObject<VPointF>(point2);
-        auto p3 = data->GeometricObject<VPointF>(point3);
-        auto p4 = data->GeometricObject<VPointF>(point4);
+        auto p1 = ParseData()->GeometricObject<VPointF>(point1);
+        auto p2 = ParseData()->GeometricObject<VPointF>(point2);
+        auto p3 = ParseData()->GeometricObject<VPointF>(point3);
+        auto p4 = ParseData()->GeometricObject<VPointF>(point4);
 
         initData.spline = new VCubicBezier(*p1, *p2, *p3, *p4);
         if (duplicate > 0)
@@ -2646,7 +3337,7 @@ void VPattern::ParseOldToolSplinePath(VMainGraphicsScene *scene, QDomElement &do
         VToolSplinePathInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2671,7 +3362,7 @@ void VPattern::ParseOldToolSplinePath(VMainGraphicsScene *scene, QDomElement &do
                     const qreal angle = GetParametrDouble(element, AttrAngle, QChar('0'));
                     const qreal kAsm2 = GetParametrDouble(element, AttrKAsm2, QStringLiteral("1.0"));
                     const quint32 pSpline = GetParametrUInt(element, AttrPSpline, NULL_ID_STR);
-                    const VPointF p = *data->GeometricObject<VPointF>(pSpline);
+                    const VPointF p = *ParseData()->GeometricObject<VPointF>(pSpline);
 
                     QLineF line(0, 0, 100, 0);
                     line.setAngle(angle+180);
@@ -2718,7 +3409,7 @@ void VPattern::ParseToolSplinePath(VMainGraphicsScene *scene, const QDomElement
         VToolSplinePathInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2744,7 +3435,7 @@ void VPattern::ParseToolSplinePath(VMainGraphicsScene *scene, const QDomElement
 
                 if (parse == Document::FullParse)
                 {
-                    IncrementReferens(data->GeometricObject<VPointF>(pSpline)->getIdTool());
+                    IncrementReferens(ParseData()->GeometricObject<VPointF>(pSpline)->getIdTool());
                 }
             }
         }
@@ -2810,7 +3501,7 @@ void VPattern::ParseToolCubicBezierPath(VMainGraphicsScene *scene, const QDomEle
         VToolCubicBezierPathInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2832,7 +3523,7 @@ void VPattern::ParseToolCubicBezierPath(VMainGraphicsScene *scene, const QDomEle
                 if (element.tagName() == AttrPathPoint)
                 {
                     const quint32 pSpline = GetParametrUInt(element, AttrPSpline, NULL_ID_STR);
-                    const VPointF p = *data->GeometricObject<VPointF>(pSpline);
+                    const VPointF p = *ParseData()->GeometricObject<VPointF>(pSpline);
                     points.append(p);
                     if (parse == Document::FullParse)
                     {
@@ -2870,7 +3561,7 @@ void VPattern::ParseNodeSpline(const QDomElement &domElement, const Document &pa
     {
         VAbstractNodeInitData initData;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2880,7 +3571,7 @@ void VPattern::ParseNodeSpline(const QDomElement &domElement, const Document &pa
             const auto obj = initData.data->GetGObject(initData.idObject);
             if (obj->getType() == GOType::Spline)
             {
-                VSpline *spl = new VSpline(*data->GeometricObject<VSpline>(initData.idObject));
+                VSpline *spl = new VSpline(*ParseData()->GeometricObject<VSpline>(initData.idObject));
                 spl->setIdObject(initData.idObject);
                 spl->setMode(Draw::Modeling);
                 initData.data->UpdateGObject(initData.id, spl);
@@ -2918,7 +3609,7 @@ void VPattern::ParseNodeSplinePath(const QDomElement &domElement, const Document
     {
         VAbstractNodeInitData initData;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -2968,7 +3659,7 @@ void VPattern::ParseToolArc(VMainGraphicsScene *scene, QDomElement &domElement,
         VToolArcInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -3020,7 +3711,7 @@ void VPattern::ParseToolEllipticalArc(VMainGraphicsScene *scene, QDomElement &do
         VToolEllipticalArcInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -3077,7 +3768,7 @@ void VPattern::ParseNodeEllipticalArc(const QDomElement &domElement, const Docum
     {
         VAbstractNodeInitData initData;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -3116,7 +3807,7 @@ void VPattern::ParseNodeArc(const QDomElement &domElement, const Document &parse
     {
         VAbstractNodeInitData initData;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -3126,7 +3817,7 @@ void VPattern::ParseNodeArc(const QDomElement &domElement, const Document &parse
         VArc *arc = nullptr;
         try
         {
-            arc = new VArc(*data->GeometricObject<VArc>(initData.idObject));
+            arc = new VArc(*ParseData()->GeometricObject<VArc>(initData.idObject));
         }
         catch (const VExceptionBadId &e)
         { // Possible case. Parent was deleted, but the node object is still here.
@@ -3157,7 +3848,7 @@ void VPattern::ParseToolArcWithLength(VMainGraphicsScene *scene, QDomElement &do
         VToolArcWithLengthInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -3209,7 +3900,7 @@ void VPattern::ParseToolRotation(VMainGraphicsScene *scene, QDomElement &domElem
         VToolRotationInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -3255,7 +3946,7 @@ void VPattern::ParseToolFlippingByLine(VMainGraphicsScene *scene, QDomElement &d
         VToolFlippingByLineInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -3287,7 +3978,7 @@ void VPattern::ParseToolFlippingByAxis(VMainGraphicsScene *scene, QDomElement &d
         VToolFlippingByAxisInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -3319,7 +4010,7 @@ void VPattern::ParseToolMove(VMainGraphicsScene *scene, QDomElement &domElement,
         VToolMoveInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -3372,8 +4063,7 @@ qreal VPattern::EvalFormula(VContainer *data, const QString &formula, bool *ok)
     {
         try
         {
-            QScopedPointer<Calculator> cal(new Calculator());
-            const qreal result = cal->EvalFormula(data->DataVariables(), formula);
+            const qreal result = VCalculatorCache::Instance()->EvalFormula(data, formula);
 
             (qIsInf(result) || qIsNaN(result)) ? *ok = false : *ok = true;
             return result;
@@ -3796,7 +4486,7 @@ void VPattern::ParseToolsElement(VMainGraphicsScene *scene, const QDomElement &d
                 initData.version = GetParametrUInt(domElement, AttrVersion, QChar('1'));
                 initData.scene = scene;
                 initData.doc = this;
-                initData.data = data;
+                initData.data = ParseData();
                 initData.parse = parse;
                 initData.typeCreation = Source::FromFile;
 
@@ -3860,7 +4550,7 @@ void VPattern::ParsePathElement(VMainGraphicsScene *scene, QDomElement &domEleme
         VToolPiecePathInitData initData;
         initData.scene = scene;
         initData.doc = this;
-        initData.data = data;
+        initData.data = ParseData();
         initData.parse = parse;
         initData.typeCreation = Source::FromFile;
 
@@ -4429,6 +5119,7 @@ void VPattern::PrepareForParse(const Document &parse)
         tools.clear();
         cursor = 0;
         history.clear();
+        m_graph.Clear();
     }
     else if (parse == Document::LiteParse || parse == Document::FullLiteParse)
     {
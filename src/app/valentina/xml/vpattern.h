@@ -33,6 +33,7 @@
 #include "../ifc/xml/vtoolrecord.h"
 #include "../vpatterndb/vcontainer.h"
 #include "../ifc/xml/vpatternconverter.h"
+#include "vtooldependencygraph.h"
 
 class VMainGraphicsScene;
 class VNodeDetail;
@@ -114,6 +115,9 @@ public:
 
     void LiteParseIncrements();
 
+    bool CheckIncrementalParse();
+    bool CheckParallelParse();
+
     static const QString AttrReadOnly;
     static const QString AttrLabelPrefix;
 
@@ -146,10 +150,28 @@ private:
      * finish */
     bool m_parsing{false};
 
+    /** @brief m_graph dependencies between tools. Used to recalculate only changed part of a pattern. */
+    VToolDependencyGraph m_graph{};
+
+    /** @brief m_parallelParse false to parse all pattern pieces in the main thread. Used to check parallel parse. */
+    bool m_parallelParse{true};
+
+    /** @brief m_parallelParseFailed true if a batch of pattern pieces had to be parsed again sequentially. */
+    bool m_parallelParseFailed{false};
+
+    /** @brief m_incrementalParse true while recalculating dirty tools. Tools keep data they already have. */
+    bool m_incrementalParse{false};
+
     VNodeDetail    ParseDetailNode(const QDomElement &domElement) const;
 
-    void           ParseDrawElement(const QDomNode& node, const Document &parse);
+    void           ParseDrawElement(const QDomNode& node, const Document &parse,
+                                    const QStringList &blocks = QStringList());
+    void           ParseDrawBatch(const QVector<QDomElement> &draws, const Document &parse);
+    QHash<QString, int> ParallelDrawBatches(const Document &parse) const;
+    static QVector<quint32> ModelingIds(const QDomElement &draw);
+    VContainer    *ParseData() const;
     void           ParseDrawMode(const QDomNode& node, const Document &parse, const Draw &mode);
+    void           ParseDrawModeElement(VMainGraphicsScene *scene, QDomElement &domElement, const Document &parse);
     void           ParseDetailElement(QDomElement &domElement, const Document &parse);
     void           ParseDetailInternals(const QDomElement &domElement, VPiece &detail) const;
     QVector<VPieceNode> ParseDetailNodes(const QDomElement &domElement, qreal width, bool closed) const;
@@ -186,6 +208,11 @@ private:
     template <typename T>
     QRectF         ToolBoundingRect(const QRectF &rec, quint32 id) const;
     void           ParseCurrentPP();
+    bool           IncrementalLiteParse();
+    bool           RecalculateTools(const QVector<quint32> &dirty);
+    void           InvalidatePiecesGeometry();
+    QStringList    DataFingerprint() const;
+    bool           VerifyIncrementalParse();
     QString        GetLabelBase(quint32 index)const;
 
     void ParseToolBasePoint(VMainGraphicsScene *scene, const QDomElement &domElement, const Document &parse);
@@ -0,0 +1,713 @@
+/************************************************************************
+ **
+ **  @file   vtooldependencygraph.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vtooldependencygraph.h"
+#include "../ifc/ifcdef.h"
+#include "../ifc/xml/vabstractpattern.h"
+#include "../vmisc/def.h"
+#include "../vgeometry/vgobject.h"
+#include "../vpatterndb/vcontainer.h"
+#include "../vpatterndb/vpiece.h"
+#include "../vpatterndb/vtranslatevars.h"
+#include "../vpatterndb/variables/vcurvevariable.h"
+#include "../vpatterndb/variables/vlineangle.h"
+#include "../vpatterndb/variables/vlinelength.h"
+#include "../vtools/tools/drawTools/operation/vabstractoperation.h"
+#include "../vtools/tools/vtoolseamallowance.h"
+#include "../vtools/tools/vtooluniondetails.h"
+#include "../qmuparser/qmuparsererror.h"
+#include "../qmuparser/qmutokenparser.h"
+
+#include <QDomElement>
+#include <QSet>
+#include <QTextStream>
+#include <algorithm>
+
+namespace
+{
+// Keeps the token cache from growing without limits in a long session.
+const int maxCachedFormulas = 1 << 14;
+
+//---------------------------------------------------------------------------------------------------------------------
+QString SaveNode(const QDomNode &node)
+{
+    QString text;
+    QTextStream stream(&text);
+    node.save(stream, 0);
+    return text;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool IsToolsBlock(const QString &tagName)
+{
+    return tagName == VAbstractPattern::TagCalculation || tagName == VAbstractPattern::TagModeling ||
+            tagName == VAbstractPattern::TagDetails;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+quint32 ToolId(const QDomElement &element)
+{
+    bool ok = false;
+    const quint32 id = element.attribute(VDomDocument::AttrId).toUInt(&ok);
+    return ok ? id : NULL_ID;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool IsIdentifier(const QString &token)
+{
+    // Operators are tokens too
+    return not token.isEmpty() && (token.at(0).isLetter() || token.at(0) == QChar('_') || token.at(0) == QChar('#')
+                                   || token.at(0) == QChar('@'));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ToolElement return the element of a tool that contains the element.
+ *
+ * Tool elements are direct children of calculation, modeling and details blocks. Formulas of a tool can live in
+ * nested elements (nodes of a piece, points of a spline path).
+ */
+QDomElement ToolElement(QDomElement element)
+{
+    while (not element.isNull())
+    {
+        const QDomElement parent = element.parentNode().toElement();
+        if (parent.isNull())
+        {
+            return QDomElement();
+        }
+
+        if (IsToolsBlock(parent.tagName()))
+        {
+            return element;
+        }
+        element = parent;
+    }
+    return QDomElement();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ReferenceAttributes return names of attributes that keep an id of an object.
+ *
+ * The list follows the pattern schema. Update it together with the schema when a tool gets a new reference.
+ */
+const QSet<QString> &ReferenceAttributes()
+{
+    static const QSet<QString> attributes
+    {
+        QStringLiteral("arc"), QStringLiteral("axisP1"), QStringLiteral("axisP2"), QStringLiteral("baseLineP1"),
+        QStringLiteral("baseLineP2"), QStringLiteral("basePoint"), QStringLiteral("bottomPin"),
+        QStringLiteral("bottomRightPin"), QStringLiteral("c1Center"), QStringLiteral("c2Center"),
+        QStringLiteral("cCenter"), QStringLiteral("center"), QStringLiteral("centerPin"), QStringLiteral("curve"),
+        QStringLiteral("curve1"), QStringLiteral("curve2"), QStringLiteral("dartP1"), QStringLiteral("dartP2"),
+        QStringLiteral("dartP3"), QStringLiteral("elArc"), QStringLiteral("end"), QStringLiteral("firstArc"),
+        QStringLiteral("firstPoint"), QStringLiteral("idObject"), QStringLiteral("idTool"), QStringLiteral("p1Line"),
+        QStringLiteral("p1Line1"), QStringLiteral("p1Line2"), QStringLiteral("p2Line"), QStringLiteral("p2Line1"),
+        QStringLiteral("p2Line2"), QStringLiteral("pShoulder"), QStringLiteral("pSpline"), QStringLiteral("path"),
+        QStringLiteral("point1"), QStringLiteral("point2"), QStringLiteral("point3"), QStringLiteral("point4"),
+        QStringLiteral("secondArc"), QStringLiteral("secondPoint"), QStringLiteral("spline"),
+        QStringLiteral("splinePath"), QStringLiteral("start"), QStringLiteral("tangent"),
+        QStringLiteral("thirdPoint"), QStringLiteral("topLeftPin"), QStringLiteral("topPin")
+    };
+    return attributes;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ValueAttributes return names of attributes that can have an integer value, but never keep an id.
+ *
+ * Numbers, flags and enums from the pattern schema.
+ */
+const QSet<QString> &ValueAttributes()
+{
+    static const QSet<QString> attributes
+    {
+        // Numbers
+        QStringLiteral("closed"), QStringLiteral("cuttingNumber"), QStringLiteral("duplicate"),
+        QStringLiteral("fontSize"), QStringLiteral("indexD1"), QStringLiteral("indexD2"), QStringLiteral("kAsm1"),
+        QStringLiteral("kAsm2"), QStringLiteral("kCurve"), QStringLiteral("mx"), QStringLiteral("mx1"),
+        QStringLiteral("mx2"), QStringLiteral("my"), QStringLiteral("my1"), QStringLiteral("my2"),
+        QStringLiteral("quantity"), QStringLiteral("sfIncrement"), QStringLiteral("x"), QStringLiteral("y"),
+        QStringLiteral("builtInPassmarkCuttingNumber"), QStringLiteral("leftPassmarkCuttingNumber"),
+        QStringLiteral("rightPassmarkCuttingNumber"), QStringLiteral("singlePassmarkCuttingNumber"),
+        // Flags
+        QStringLiteral("allowCollapse"), QStringLiteral("bold"), QStringLiteral("bufferInLayout"),
+        QStringLiteral("bufferSoftExcluded"), QStringLiteral("checkUniqueness"), QStringLiteral("custom"),
+        QStringLiteral("cut"), QStringLiteral("excluded"), QStringLiteral("firstToCountour"),
+        QStringLiteral("forbidFlipping"), QStringLiteral("forceFlipping"), QStringLiteral("hideMainPath"),
+        QStringLiteral("inLayout"), QStringLiteral("italic"), QStringLiteral("lastToCountour"),
+        QStringLiteral("manualPassmarkLength"), QStringLiteral("nestTogethWithNext"), QStringLiteral("onFold"),
+        QStringLiteral("passmark"), QStringLiteral("reverse"), QStringLiteral("seamAllowance"),
+        QStringLiteral("seamAllowanceBuiltIn"), QStringLiteral("showLabel"), QStringLiteral("showLabel1"),
+        QStringLiteral("showLabel2"), QStringLiteral("showSecondPassmark"), QStringLiteral("softExcluded"),
+        QStringLiteral("united"), QStringLiteral("visible"),
+        // Enums
+        QStringLiteral("aScale"), QStringLiteral("alignment"), QStringLiteral("angle"), QStringLiteral("arrows"),
+        QStringLiteral("axisType"), QStringLiteral("builtInPassmarkCuttingMode"),
+        QStringLiteral("builtInPassmarkCuttingStop"), QStringLiteral("checkStop"), QStringLiteral("crossPoint"),
+        QStringLiteral("cuttingMode"), QStringLiteral("cuttingTime"), QStringLiteral("cuttingVelocityReduction"),
+        QStringLiteral("gravity"), QStringLiteral("hCrossPoint"), QStringLiteral("leftPassmarkCuttingMode"),
+        QStringLiteral("leftPassmarkCuttingStop"), QStringLiteral("number"), QStringLiteral("passmarkAngle"),
+        QStringLiteral("passmarkLine"), QStringLiteral("placeLabelType"), QStringLiteral("priority"),
+        QStringLiteral("rightPassmarkCuttingMode"), QStringLiteral("rightPassmarkCuttingStop"),
+        QStringLiteral("singlePassmarkCuttingMode"), QStringLiteral("singlePassmarkCuttingStop"),
+        QStringLiteral("type"), QStringLiteral("vCrossPoint"), QStringLiteral("version")
+    };
+    return attributes;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CollectReferences collect ids an element of a tool refers to.
+ *
+ * Only attributes from ReferenceAttributes() are references. Formula attributes are skipped, their dependencies come
+ * from tokens. Items of a destination list are objects the tool creates.
+ * @return false if the element has an attribute with an integer value we know nothing about. Such attribute can be a
+ * reference, the caller cannot trust the graph.
+ */
+bool CollectReferences(const QDomElement &element, const QSet<QString> &formulas, bool root,
+                       QVector<quint32> &references)
+{
+    const bool destination = element.tagName() == VAbstractOperation::TagItem &&
+            element.parentNode().toElement().tagName() == VAbstractOperation::TagDestination;
+
+    bool known = true;
+    const QDomNamedNodeMap attributes = element.attributes();
+    for (int i = 0; i < attributes.size(); ++i)
+    {
+        const QDomAttr attribute = attributes.item(i).toAttr();
+        if ((root && attribute.name() == VDomDocument::AttrId) || formulas.contains(attribute.name()) ||
+                (destination && attribute.name() == AttrIdObject))
+        {
+            continue;
+        }
+
+        bool ok = false;
+        const quint32 id = attribute.value().toUInt(&ok);
+        if (not ok || id == NULL_ID)
+        {
+            continue;
+        }
+
+        if (ReferenceAttributes().contains(attribute.name()))
+        {
+            references.append(id);
+        }
+        else if (not ValueAttributes().contains(attribute.name()))
+        {
+            known = false;
+        }
+    }
+
+    for (QDomElement child = element.firstChildElement(); not child.isNull(); child = child.nextSiblingElement())
+    {
+        known = CollectReferences(child, formulas, false, references) && known;
+    }
+
+    return known;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PieceDependencies return ids the piece declares in its lists of nodes, custom seam allowance paths, internal
+ * paths, pins and place labels.
+ *
+ * Records of internal paths, pins and place labels keep ids as text of an element, not as an attribute.
+ */
+QList<quint32> PieceDependencies(const QDomElement &element)
+{
+    VPiece piece;
+    for (QDomElement child = element.firstChildElement(); not child.isNull(); child = child.nextSiblingElement())
+    {
+        const QString tagName = child.tagName();
+        if (tagName == VAbstractPattern::TagNodes)
+        {
+            piece.SetPath(VAbstractPattern::ParsePieceNodes(child));
+        }
+        else if (tagName == VToolSeamAllowance::TagCSA)
+        {
+            piece.SetCustomSARecords(VAbstractPattern::ParsePieceCSARecords(child));
+        }
+        else if (tagName == VToolSeamAllowance::TagIPaths)
+        {
+            piece.SetInternalPaths(VAbstractPattern::ParsePieceInternalPaths(child));
+        }
+        else if (tagName == VToolSeamAllowance::TagPins)
+        {
+            piece.SetPins(VAbstractPattern::ParsePiecePointRecords(child));
+        }
+        else if (tagName == VToolSeamAllowance::TagPlaceLabels)
+        {
+            piece.SetPlaceLabels(VAbstractPattern::ParsePiecePointRecords(child));
+        }
+    }
+    return piece.Dependencies();
+}
+}  // namespace
+
+//---------------------------------------------------------------------------------------------------------------------
+void VToolDependencyGraph::Clear()
+{
+    m_tools.clear();
+    m_order.clear();
+    m_draws.clear();
+    m_lastTools.clear();
+    m_structure.clear();
+    m_values.clear();
+    m_verified = false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VToolDependencyGraph::IsEmpty() const
+{
+    return m_structure.isEmpty();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Update rebuild the graph from the document and find dirty tools.
+ * @param doc pattern document after a change.
+ * @param data complete data of the pattern. Used to resolve variables in formulas.
+ * @param dirty if not null receives ids of tools to recalculate in document order.
+ * @return false if the change can't be handled incrementally. The graph is rebuilt in any case.
+ */
+bool VToolDependencyGraph::Update(const VAbstractPattern *doc, const VContainer &data, QVector<quint32> *dirty)
+{
+    SCASSERT(doc != nullptr)
+
+    QHash<quint32, VToolNode> tools;
+    QHash<quint32, QDomElement> elements;
+    QVector<quint32> order;
+    QStringList draws;
+    QHash<QString, quint32> lastTools;
+    QString structure;
+    bool supported = true;
+
+    for (QDomElement element = doc->documentElement().firstChildElement(); not element.isNull();
+         element = element.nextSiblingElement())
+    {
+        const QString tagName = element.tagName();
+        if (tagName == VAbstractPattern::TagIncrements || tagName == VAbstractPattern::TagPreviewCalculations)
+        {
+            continue; // Tracked by values
+        }
+
+        if (tagName != VAbstractPattern::TagDraw)
+        {
+            structure += SaveNode(element);
+            continue;
+        }
+
+        const QString draw = element.attribute(AttrName);
+        draws.append(draw);
+        structure += tagName + QChar(':') + draw + QChar('\n');
+
+        for (QDomElement block = element.firstChildElement(); not block.isNull(); block = block.nextSiblingElement())
+        {
+            if (not IsToolsBlock(block.tagName()))
+            {
+                structure += SaveNode(block);
+                continue;
+            }
+
+            structure += block.tagName() + QChar(':');
+            for (QDomElement toolElement = block.firstChildElement(); not toolElement.isNull();
+                 toolElement = toolElement.nextSiblingElement())
+            {
+                const quint32 id = ToolId(toolElement);
+                if (id == NULL_ID || tools.contains(id))
+                {
+                    structure += SaveNode(toolElement);
+                    continue;
+                }
+
+                // Union tool keeps ids of created objects as text. We cannot track them.
+                if (toolElement.tagName() == VAbstractPattern::TagTools &&
+                        toolElement.attribute(AttrType) == VToolUnionDetails::ToolType)
+                {
+                    supported = false;
+                }
+
+                structure += QString::number(id) + QChar(' ');
+
+                VToolNode node;
+                node.draw = draw;
+                node.signature = SaveNode(toolElement);
+                node.names = QStringList({toolElement.attribute(AttrName), toolElement.attribute(AttrName1),
+                                          toolElement.attribute(AttrName2), toolElement.attribute(AttrSuffix)})
+                        .join(QChar('\n'));
+                tools.insert(id, node);
+                elements.insert(id, toolElement);
+                order.append(id);
+                lastTools.insert(draw, id);
+            }
+            structure += QChar('\n');
+        }
+    }
+
+    const QHash<QString, QSharedPointer<VInternalVariable>> *variables = data.DataVariables();
+    const QMap<QString, qmu::QmuTranslation> functions = data.GetTrVars() != nullptr ?
+                data.GetTrVars()->GetFunctions() : QMap<QString, qmu::QmuTranslation>();
+    QHash<QString, qreal> values;
+    for (auto i = variables->constBegin(); i != variables->constEnd(); ++i)
+    {
+        const VarType type = i.value()->GetType();
+        if (type == VarType::Measurement || type == VarType::Increment || type == VarType::IncrementSeparator)
+        {
+            values.insert(i.key(), i.value()->GetValue());
+        }
+    }
+
+    QHash<quint32, QSet<QString>> formulaAttributes;
+    QHash<quint32, QSet<QString>> formulaTokens;
+    const QVector<VFormulaField> expressions = doc->ListExpressions();
+    for (const auto &field : expressions)
+    {
+        const quint32 id = ToolId(ToolElement(field.element));
+        if (not tools.contains(id))
+        {
+            continue;
+        }
+
+        formulaAttributes[id].insert(field.attribute);
+
+        bool ok = true;
+        const QStringList tokens = FormulaTokens(field.expression, ok);
+        if (not ok)
+        {
+            tools[id].alwaysDirty = true;
+        }
+
+        QSet<QString> &toolTokens = formulaTokens[id];
+        for (const auto &token : tokens)
+        {
+            toolTokens.insert(token);
+        }
+    }
+
+    const QHash<quint32, QSharedPointer<VGObject>> *objects = data.CalculationGObjects();
+
+    // A reference is an id of a tool or an id of an object. Each object knows the tool that created it (the same id the
+    // tool passes to VAbstractPattern::IncrementReferens()). Modeling objects, pieces and piece paths have ids of their
+    // tools.
+    auto Owner = [&tools, objects](quint32 object) -> quint32
+    {
+        if (tools.contains(object))
+        {
+            return object;
+        }
+
+        const QSharedPointer<VGObject> gObject = objects->value(object);
+        if (not gObject.isNull() && tools.contains(gObject->getIdTool()))
+        {
+            return gObject->getIdTool();
+        }
+        return NULL_ID;
+    };
+
+    for (auto id : qAsConst(order))
+    {
+        VToolNode &node = tools[id];
+        const QDomElement element = elements.value(id);
+        QSet<quint32> toolReferences;
+
+        // Ids we cannot tie to a tool mean the graph misses an edge
+        auto AddReference = [id, &toolReferences, Owner, &supported](quint32 object)
+        {
+            if (object == NULL_ID)
+            {
+                return;
+            }
+
+            const quint32 owner = Owner(object);
+            if (owner == NULL_ID)
+            {
+                supported = false;
+            }
+            else if (owner != id)
+            {
+                toolReferences.insert(owner);
+            }
+        };
+
+        QVector<quint32> references;
+        if (not CollectReferences(element, formulaAttributes.value(id), true, references))
+        {
+            supported = false;
+        }
+
+        if (element.parentNode().toElement().tagName() == VAbstractPattern::TagDetails)
+        {
+            const QList<quint32> dependencies = PieceDependencies(element);
+            for (auto object : dependencies)
+            {
+                references.append(object);
+            }
+        }
+
+        for (auto object : qAsConst(references))
+        {
+            AddReference(object);
+        }
+
+        for (const auto &token : formulaTokens.value(id))
+        {
+            if (values.contains(token))
+            {
+                node.values.append(token);
+                continue;
+            }
+
+            const QSharedPointer<VInternalVariable> variable = variables->value(token);
+            if (variable.isNull())
+            {
+                // A variable from a new or renamed object. We don't know yet who creates it.
+                node.unresolved = node.unresolved || (IsIdentifier(token) && not functions.contains(token));
+                continue;
+            }
+
+            if (auto *length = dynamic_cast<VLengthLine *>(variable.data()))
+            {
+                AddReference(length->GetP1Id());
+                AddReference(length->GetP2Id());
+            }
+            else if (auto *angle = dynamic_cast<VLineAngle *>(variable.data()))
+            {
+                AddReference(angle->GetP1Id());
+                AddReference(angle->GetP2Id());
+            }
+            else if (auto *curve = dynamic_cast<VCurveVariable *>(variable.data()))
+            {
+                AddReference(curve->GetId());
+                AddReference(curve->GetParentId());
+            }
+        }
+
+        node.references.reserve(toolReferences.size());
+        for (auto owner : qAsConst(toolReferences))
+        {
+            node.references.append(owner);
+        }
+    }
+
+    bool incremental = supported && not m_structure.isEmpty() && structure == m_structure;
+
+    if (incremental)
+    {
+        QStringList names = values.keys();
+        QStringList oldNames = m_values.keys();
+        std::sort(names.begin(), names.end());
+        std::sort(oldNames.begin(), oldNames.end());
+        incremental = names == oldNames;
+    }
+
+    for (int i = 0; incremental && i < order.size(); ++i)
+    {
+        incremental = tools.value(order.at(i)).names == m_tools.value(order.at(i)).names;
+    }
+
+    if (incremental && dirty != nullptr)
+    {
+        QHash<quint32, QVector<quint32>> dependents;
+        for (auto id : qAsConst(order))
+        {
+            for (auto owner : tools.value(id).references)
+            {
+                dependents[owner].append(id);
+            }
+        }
+
+        QSet<quint32> marked;
+        QVector<quint32> queue;
+        for (auto id : qAsConst(order))
+        {
+            const VToolNode &node = tools[id];
+            bool changed = node.alwaysDirty || node.signature != m_tools.value(id).signature;
+            for (int i = 0; not changed && i < node.values.size(); ++i)
+            {
+                const QString &name = node.values.at(i);
+                changed = not VFuzzyComparePossibleNulls(values.value(name), m_values.value(name));
+            }
+
+            if (changed)
+            {
+                marked.insert(id);
+                queue.append(id);
+            }
+        }
+
+        while (not queue.isEmpty())
+        {
+            const quint32 id = queue.takeLast();
+            for (auto dependent : dependents.value(id))
+            {
+                if (not marked.contains(dependent))
+                {
+                    marked.insert(dependent);
+                    queue.append(dependent);
+                }
+            }
+        }
+
+        dirty->clear();
+        for (auto id : qAsConst(order))
+        {
+            if (marked.contains(id))
+            {
+                dirty->append(id);
+            }
+        }
+    }
+
+    m_tools = tools;
+    m_order = order;
+    m_draws = draws;
+    m_lastTools = lastTools;
+    m_structure = structure;
+    m_values = values;
+    m_verified = supported;
+
+    return incremental;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QString VToolDependencyGraph::DrawName(quint32 id) const
+{
+    return m_tools.value(id).draw;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+quint32 VToolDependencyGraph::LastTool(const QString &draw) const
+{
+    return m_lastTools.value(draw, NULL_ID);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief DrawBatches split pattern pieces into batches in document order.
+ *
+ * No pattern piece in a batch uses objects or variables of another pattern piece from the same batch. A pattern piece
+ * with a variable we cannot resolve starts a new batch. If the last Update() couldn't tie all references to tools each
+ * pattern piece gets own batch.
+ * @return list of batches.
+ */
+QVector<QStringList> VToolDependencyGraph::DrawBatches() const
+{
+    if (not m_verified)
+    {
+        QVector<QStringList> batches;
+        batches.reserve(m_draws.size());
+        for (const auto &draw : m_draws)
+        {
+            batches.append(QStringList(draw));
+        }
+        return batches;
+    }
+
+    QHash<QString, QSet<QString>> dependencies;
+    QSet<QString> unresolved;
+    for (auto id : m_order)
+    {
+        const VToolNode &node = m_tools.constFind(id).value();
+        if (node.unresolved)
+        {
+            unresolved.insert(node.draw);
+        }
+
+        for (auto owner : node.references)
+        {
+            const QString draw = m_tools.value(owner).draw;
+            if (draw != node.draw)
+            {
+                dependencies[node.draw].insert(draw);
+            }
+        }
+    }
+
+    QVector<QStringList> batches;
+    for (const auto &draw : m_draws)
+    {
+        bool independent = not batches.isEmpty() && not unresolved.contains(draw);
+        if (independent)
+        {
+            const QSet<QString> drawDependencies = dependencies.value(draw);
+            for (const auto &previous : qAsConst(batches.last()))
+            {
+                if (drawDependencies.contains(previous))
+                {
+                    independent = false;
+                    break;
+                }
+            }
+        }
+
+        if (independent)
+        {
+            batches.last().append(draw);
+        }
+        else
+        {
+            batches.append(QStringList(draw));
+        }
+    }
+
+    return batches;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QStringList VToolDependencyGraph::FormulaTokens(const QString &formula, bool &ok)
+{
+    ok = true;
+
+    auto cached = m_tokens.constFind(formula);
+    if (cached != m_tokens.constEnd())
+    {
+        return cached.value();
+    }
+
+    QStringList tokens;
+    try
+    {
+        QScopedPointer<qmu::QmuTokenParser> cal(new qmu::QmuTokenParser(formula, false, false));
+        tokens = cal->GetTokens().values();
+    }
+    catch (const qmu::QmuParserError &e)
+    {
+        Q_UNUSED(e)
+        // Cannot say what the formula depends on. Recalculate the tool each time.
+        ok = false;
+        return tokens;
+    }
+
+    if (m_tokens.size() >= maxCachedFormulas)
+    {
+        m_tokens.clear();
+    }
+    m_tokens.insert(formula, tokens);
+    return tokens;
+}
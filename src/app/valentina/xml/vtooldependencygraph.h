@@ -0,0 +1,103 @@
+/************************************************************************
+ **
+ **  @file   vtooldependencygraph.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VTOOLDEPENDENCYGRAPH_H
+#define VTOOLDEPENDENCYGRAPH_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+
+class VAbstractPattern;
+class VContainer;
+class QDomElement;
+
+/**
+ * @brief The VToolDependencyGraph class keeps dependencies between tools of a pattern and finds tools that must be
+ * recalculated after a change.
+ *
+ * A tool depends on another tool if it references one of objects the other tool creates, or if one of its formulas
+ * uses a variable (line length, curve length, angle, etc.) built from such objects. Measurements and increments are
+ * tracked by value. Each call of Update() compares a tool's xml with the xml saved by the previous call. Changed tools
+ * and everything downstream of them are dirty.
+ *
+ * The graph answers only when the structure of the pattern stays the same. Adding, removing or moving tools, renaming
+ * objects, changing groups or the list of measurements and increments make Update() return false. The caller must do
+ * a full lite parse in this case.
+ *
+ * References come from attributes the pattern schema defines as ids and from lists of a piece (VPiece::Dependencies()).
+ * Each referenced object is tied to the tool that created it through VGObject::getIdTool(). An integer attribute the
+ * graph doesn't know or an id without a tool make the graph unverified and Update() returns false. Run Valentina with
+ * "--test --checkIncremental" to compare incremental and full lite parse on a pattern.
+ *
+ * The same information split pattern pieces into batches that don't depend on each other and can be parsed at the same
+ * time. An unverified graph gives a batch for each pattern piece.
+ */
+class VToolDependencyGraph
+{
+public:
+    VToolDependencyGraph() = default;
+
+    void Clear();
+    bool IsEmpty() const;
+
+    bool Update(const VAbstractPattern *doc, const VContainer &data, QVector<quint32> *dirty);
+
+    QString DrawName(quint32 id) const;
+    quint32 LastTool(const QString &draw) const;
+
+    QVector<QStringList> DrawBatches() const;
+
+private:
+    Q_DISABLE_COPY(VToolDependencyGraph)
+
+    struct VToolNode
+    {
+        QString           draw{};
+        QString           signature{};
+        QString           names{};
+        QVector<quint32>  references{};
+        QStringList       values{};
+        bool              alwaysDirty{false};
+        bool              unresolved{false};
+    };
+
+    QHash<quint32, VToolNode> m_tools{};
+    QVector<quint32>          m_order{};
+    QStringList               m_draws{};
+    QHash<QString, quint32>   m_lastTools{};
+    QString                   m_structure{};
+    QHash<QString, qreal>     m_values{};
+    bool                      m_verified{false};
+    QHash<QString, QStringList> m_tokens{};
+
+    QStringList FormulaTokens(const QString &formula, bool &ok);
+};
+
+#endif // VTOOLDEPENDENCYGRAPH_H
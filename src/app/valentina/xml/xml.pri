@@ -2,7 +2,9 @@
 # This need for corect working file translations.pro
 
 HEADERS += \
-    $$PWD/vpattern.h
+    $$PWD/vpattern.h \
+    $$PWD/vtooldependencygraph.h
 
 SOURCES += \
-    $$PWD/vpattern.cpp
+    $$PWD/vpattern.cpp \
+    $$PWD/vtooldependencygraph.cpp
@@ -1979,6 +1979,47 @@ void QmuParserBase::Eval(qreal *results, int nBulkSize) const
     #endif
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Evaluate bytecode compiled by another parser.
+ *
+ * Parser replaces own bytecode, the formula string is not used. Bytecode must not depend on parser's string buffer,
+ * see GetByteCode().
+ * @param a_ByteCode compiled formula.
+ * @param a_iFinalResultIdx index of result on the stack.
+ * @return The evaluation result
+ */
+qreal QmuParserBase::Eval(const QmuParserByteCode &a_ByteCode, int a_iFinalResultIdx) const
+{
+    m_vRPN = a_ByteCode;
+    m_nFinalResultIdx = a_iFinalResultIdx;
+    m_vStringBuf.clear();
+    m_vStackBuffer.resize(m_vRPN.GetMaxStackSize() * s_MaxNumOpenMPThreads);
+    m_pParseFormula = &QmuParserBase::ParseCmdCode;
+    return ParseCmdCode();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Copy bytecode of the last parsed formula.
+ *
+ * Bytecode reads variables by pointers returned from variable factory. Caller is responsible for keeping them alive.
+ * @param [out] a_ByteCode compiled formula.
+ * @param [out] a_iFinalResultIdx index of result on the stack.
+ * @return false if formula was not parsed yet or the bytecode needs string buffer of this parser.
+ */
+bool QmuParserBase::GetByteCode(QmuParserByteCode &a_ByteCode, int &a_iFinalResultIdx) const
+{
+    if (m_pParseFormula != &QmuParserBase::ParseCmdCode || not m_vStringBuf.isEmpty())
+    {
+        return false;
+    }
+
+    a_ByteCode = m_vRPN;
+    a_iFinalResultIdx = m_nFinalResultIdx;
+    return true;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief Set a function that can create variable pointer for unknown expression variables.
@@ -76,6 +76,8 @@ public:
     qreal              Eval() const;
     qreal*             Eval(int &nStackSize) const;
     void               Eval(qreal *results, int nBulkSize) const;
+    qreal              Eval(const QmuParserByteCode &a_ByteCode, int a_iFinalResultIdx) const;
+    bool               GetByteCode(QmuParserByteCode &a_ByteCode, int &a_iFinalResultIdx) const;
     int                GetNumResults() const;
     void               SetExpr(const QString &a_sExpr);
     void               SetVarFactory(facfun_type a_pFactory, void *pUserData = nullptr);
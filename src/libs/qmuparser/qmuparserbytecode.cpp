@@ -473,6 +473,38 @@ void QmuParserByteCode::AddStrFun(generic_fun_type a_pFun, int a_iArgc, int a_iI
     m_iMaxStackSize = qMax(m_iMaxStackSize, m_iStackPos);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Redirect variable tokens to other storage of values.
+ *
+ * Bytecode reads variables through pointers. This allows keeping compiled bytecode after the parser that created it
+ * is gone, the caller only provides new addresses for all variables.
+ *
+ * @param a_Relocations maps old address of a variable to a new one. Unknown addresses are left unchanged.
+ * @throw nothrow
+ */
+void QmuParserByteCode::RelocateVars(const QHash<const qreal *, qreal *> &a_Relocations)
+{
+    for (auto &tok : m_vRPN)
+    {
+        switch (tok.Cmd)
+        {
+            case cmVAR:
+            case cmVARPOW2:
+            case cmVARPOW3:
+            case cmVARPOW4:
+            case cmVARMUL:
+                tok.Val.ptr = a_Relocations.value(tok.Val.ptr, tok.Val.ptr);
+                break;
+            case cmASSIGN:
+                tok.Oprt.ptr = a_Relocations.value(tok.Oprt.ptr, tok.Oprt.ptr);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief Add end marker to bytecode.
@@ -22,9 +22,11 @@
 #ifndef QMUPARSERBYTECODE_H
 #define QMUPARSERBYTECODE_H
 
+#include <QHash>
 #include <QVector>
 #include <QtGlobal>
 
+#include "qmuparser_global.h"
 #include "qmudef.h"
 #include "qmuparserdef.h"
 #include "qmuparsertoken.h"
@@ -83,7 +85,7 @@ QT_WARNING_POP
  *
  * @author (C) 2004-2013 Ingo Berg
  */
-class QmuParserByteCode
+class QMUPARSERSHARED_EXPORT QmuParserByteCode
 {
 public:
     QmuParserByteCode();
@@ -98,6 +100,7 @@ public:
     void          AddFun(generic_fun_type a_pFun, int a_iArgc);
     void          AddBulkFun(generic_fun_type a_pFun, int a_iArgc);
     void          AddStrFun(generic_fun_type a_pFun, int a_iArgc, int a_iIdx);
+    void          RelocateVars(const QHash<const qreal *, qreal *> &a_Relocations);
     void          EnableOptimizer(bool bStat);
     void          Finalize();
     void          clear();
@@ -49,7 +49,7 @@
 #include "../ifc/ifcdef.h"
 #include "../qmuparser/qmutokenparser.h"
 #include "../qmuparser/qmuparsererror.h"
-#include "../vpatterndb/calculator.h"
+#include "../vpatterndb/vcalculatorcache.h"
 #include "../vpatterndb/variables/vmeasurement.h"
 #include "../vpatterndb/vcontainer.h"
 #include "../vpatterndb/measurements.h"
@@ -830,8 +830,7 @@ qreal VMeasurements::EvalFormula(VContainer *data, const QString &formula, bool
     {
         try
         {
-            QScopedPointer<Calculator> cal(new Calculator());
-            const qreal result = cal->EvalFormula(data->DataVariables(), formula);
+            const qreal result = VCalculatorCache::Instance()->EvalFormula(data, formula);
 
             (qIsInf(result) || qIsNaN(result)) ? *ok = false : *ok = true;
             return result;
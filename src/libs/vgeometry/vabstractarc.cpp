@@ -108,6 +108,7 @@ void VAbstractArc::SetFormulaF1(const QString &formula, qreal value)
 {
     d->formulaF1 = formula;
     d->f1 = value;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -127,6 +128,7 @@ void VAbstractArc::SetFormulaF2(const QString &formula, qreal value)
 {
     d->formulaF2 = formula;
     d->f2 = value;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -145,6 +147,7 @@ VPointF VAbstractArc::GetCenter() const
 void VAbstractArc::SetCenter(const VPointF &point)
 {
     d->center = point;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -219,6 +222,7 @@ qreal VAbstractArc::AngleArc() const
 void VAbstractArc::SetFlipped(bool value)
 {
     d->isFlipped = value;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -28,12 +28,12 @@
 
 #include "vabstractcubicbezier.h"
 
-#include <QFuture>
 #include <QLineF>
 #include <QMessageLogger>
 #include <QPoint>
 #include <QtDebug>
-#include <QtConcurrent>
+#include <QVarLengthArray>
+#include <algorithm>
 
 #include "../vmisc/def.h"
 #include "../vmisc/vmath.h"
@@ -60,33 +60,21 @@ inline qreal CalcSqDistance(qreal x1, qreal y1, qreal x2, qreal y2)
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
- * @brief PointBezier_r find spline point using four point of spline.
- * @param x1 х coordinate first point.
- * @param y1 у coordinate first point.
- * @param x2 х coordinate first control point.
- * @param y2 у coordinate first control point.
- * @param x3 х coordinate second control point.
- * @param y3 у coordinate second control point.
- * @param x4 х coordinate last point.
- * @param y4 у coordinate last point.
- * @param level level of recursion. In the begin 0.
- * @param points spline points coordinates.
+ * @brief PointBezier find spline points using four point of spline and append them to the list.
+ *
+ * Adaptive subdivision without recursion. Halves that still need subdivision wait in a small stack. The left half is
+ * always taken first, so points come in the same order as with recursive subdivision. All points go directly to the
+ * output list.
+ * @param p1 first point.
+ * @param p2 first control point.
+ * @param p3 second control point.
+ * @param p4 last point.
  * @param approximationScale curve approximation scale.
+ * @param points spline points coordinates.
  */
-QVector<QPointF> PointBezier_r(qreal x1, qreal y1, qreal x2, qreal y2, qreal x3, qreal y3, qreal x4, qreal y4,
-                               qint16 level, QVector<QPointF> points, qreal approximationScale)
+void PointBezier(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4, qreal approximationScale,
+                 QVector<QPointF> &points)
 {
-    if (points.size() >= 2)
-    {
-        for (int i=1; i < points.size(); ++i)
-        {
-            if (points.at(i-1) == points.at(i))
-            {
-                qDebug("All neighbors points in path must be unique.");
-            }
-        }
-    }
-
     const double curve_collinearity_epsilon                 = 1e-30;
     const double curve_angle_tolerance_epsilon              = 0.01;
     const double m_angle_tolerance = 0.0;
@@ -104,271 +92,336 @@ QVector<QPointF> PointBezier_r(qreal x1, qreal y1, qreal x2, qreal y2, qreal x3,
     m_distance_tolerance_square = 0.5 / m_approximation_scale;
     m_distance_tolerance_square *= m_distance_tolerance_square;
 
-    if (level > curve_recursion_limit)
+    struct VBezierSegment
     {
-        return points;
-    }
+        qreal x1;
+        qreal y1;
+        qreal x2;
+        qreal y2;
+        qreal x3;
+        qreal y3;
+        qreal x4;
+        qreal y4;
+        int level;
+    };
+
+    // Each step takes one segment and puts back two, so the stack never grows deeper than the recursion limit.
+    QVarLengthArray<VBezierSegment, curve_recursion_limit + 2> stack;
+    stack.append({p1.x(), p1.y(), p2.x(), p2.y(), p3.x(), p3.y(), p4.x(), p4.y(), 0});
 
-    // Calculate all the mid-points of the line segments
-    //----------------------
-    const double x12   = (x1 + x2) / 2;
-    const double y12   = (y1 + y2) / 2;
-    const double x23   = (x2 + x3) / 2;
-    const double y23   = (y2 + y3) / 2;
-    const double x34   = (x3 + x4) / 2;
-    const double y34   = (y3 + y4) / 2;
-    const double x123  = (x12 + x23) / 2;
-    const double y123  = (y12 + y23) / 2;
-    const double x234  = (x23 + x34) / 2;
-    const double y234  = (y23 + y34) / 2;
-    const double x1234 = (x123 + x234) / 2;
-    const double y1234 = (y123 + y234) / 2;
-
-    // Try to approximate the full cubic curve by a single straight line
-    //------------------
-    const double dx = x4-x1;
-    const double dy = y4-y1;
-
-    double d2 = fabs((x2 - x4) * dy - (y2 - y4) * dx);
-    double d3 = fabs((x3 - x4) * dy - (y3 - y4) * dx);
-
-    switch ((static_cast<int>(d2 > curve_collinearity_epsilon) << 1) +
-             static_cast<int>(d3 > curve_collinearity_epsilon))
+    while (not stack.isEmpty())
     {
-        case 0:
+        const VBezierSegment segment = stack.last();
+        stack.removeLast();
+
+        if (segment.level > curve_recursion_limit)
         {
-            // All collinear OR p1==p4
-            //----------------------
-            double k = dx*dx + dy*dy;
-            if (k < 0.000000001)
-            {
-                d2 = CalcSqDistance(x1, y1, x2, y2);
-                d3 = CalcSqDistance(x4, y4, x3, y3);
-            }
-            else
+            continue;
+        }
+
+        const double x1 = segment.x1;
+        const double y1 = segment.y1;
+        const double x2 = segment.x2;
+        const double y2 = segment.y2;
+        const double x3 = segment.x3;
+        const double y3 = segment.y3;
+        const double x4 = segment.x4;
+        const double y4 = segment.y4;
+
+        // Calculate all the mid-points of the line segments
+        //----------------------
+        const double x12   = (x1 + x2) / 2;
+        const double y12   = (y1 + y2) / 2;
+        const double x23   = (x2 + x3) / 2;
+        const double y23   = (y2 + y3) / 2;
+        const double x34   = (x3 + x4) / 2;
+        const double y34   = (y3 + y4) / 2;
+        const double x123  = (x12 + x23) / 2;
+        const double y123  = (y12 + y23) / 2;
+        const double x234  = (x23 + x34) / 2;
+        const double y234  = (y23 + y34) / 2;
+        const double x1234 = (x123 + x234) / 2;
+        const double y1234 = (y123 + y234) / 2;
+
+        // Try to approximate the full cubic curve by a single straight line
+        //------------------
+        const double dx = x4-x1;
+        const double dy = y4-y1;
+
+        double d2 = fabs((x2 - x4) * dy - (y2 - y4) * dx);
+        double d3 = fabs((x3 - x4) * dy - (y3 - y4) * dx);
+
+        switch ((static_cast<int>(d2 > curve_collinearity_epsilon) << 1) +
+                 static_cast<int>(d3 > curve_collinearity_epsilon))
+        {
+            case 0:
             {
-                k   = 1 / k;
-                {
-                    const double da1 = x2 - x1;
-                    const double da2 = y2 - y1;
-                    d2  = k * (da1*dx + da2*dy);
-                }
-                {
-                    const double da1 = x3 - x1;
-                    const double da2 = y3 - y1;
-                    d3  = k * (da1*dx + da2*dy);
-                }
-                if (d2 > 0 && d2 < 1 && d3 > 0 && d3 < 1)
-                {
-                    // Simple collinear case, 1---2---3---4
-                    // We can leave just two endpoints
-                    return points;
-                }
-                if (d2 <= 0)
-                {
-                    d2 = CalcSqDistance(x2, y2, x1, y1);
-                }
-                else if (d2 >= 1)
+                // All collinear OR p1==p4
+                //----------------------
+                double k = dx*dx + dy*dy;
+                if (k < 0.000000001)
                 {
-                    d2 = CalcSqDistance(x2, y2, x4, y4);
+                    d2 = CalcSqDistance(x1, y1, x2, y2);
+                    d3 = CalcSqDistance(x4, y4, x3, y3);
                 }
                 else
                 {
-                    d2 = CalcSqDistance(x2, y2, x1 + d2*dx, y1 + d2*dy);
-                }
+                    k   = 1 / k;
+                    {
+                        const double da1 = x2 - x1;
+                        const double da2 = y2 - y1;
+                        d2  = k * (da1*dx + da2*dy);
+                    }
+                    {
+                        const double da1 = x3 - x1;
+                        const double da2 = y3 - y1;
+                        d3  = k * (da1*dx + da2*dy);
+                    }
+                    if (d2 > 0 && d2 < 1 && d3 > 0 && d3 < 1)
+                    {
+                        // Simple collinear case, 1---2---3---4
+                        // We can leave just two endpoints
+                        continue;
+                    }
+                    if (d2 <= 0)
+                    {
+                        d2 = CalcSqDistance(x2, y2, x1, y1);
+                    }
+                    else if (d2 >= 1)
+                    {
+                        d2 = CalcSqDistance(x2, y2, x4, y4);
+                    }
+                    else
+                    {
+                        d2 = CalcSqDistance(x2, y2, x1 + d2*dx, y1 + d2*dy);
+                    }
 
-                if (d3 <= 0)
-                {
-                    d3 = CalcSqDistance(x3, y3, x1, y1);
+                    if (d3 <= 0)
+                    {
+                        d3 = CalcSqDistance(x3, y3, x1, y1);
+                    }
+                    else if (d3 >= 1)
+                    {
+                        d3 = CalcSqDistance(x3, y3, x4, y4);
+                    }
+                    else
+                    {
+                        d3 = CalcSqDistance(x3, y3, x1 + d3*dx, y1 + d3*dy);
+                    }
                 }
-                else if (d3 >= 1)
+                if (d2 > d3)
                 {
-                    d3 = CalcSqDistance(x3, y3, x4, y4);
+                    if (d2 < m_distance_tolerance_square)
+                    {
+                        points.append(QPointF(x2, y2));
+                        continue;
+                    }
                 }
                 else
                 {
-                    d3 = CalcSqDistance(x3, y3, x1 + d3*dx, y1 + d3*dy);
-                }
-            }
-            if (d2 > d3)
-            {
-                if (d2 < m_distance_tolerance_square)
-                {
-                    points.append(QPointF(x2, y2));
-                    return points;
-                }
-            }
-            else
-            {
-                if (d3 < m_distance_tolerance_square)
-                {
-                    points.append(QPointF(x3, y3));
-                    return points;
+                    if (d3 < m_distance_tolerance_square)
+                    {
+                        points.append(QPointF(x3, y3));
+                        continue;
+                    }
                 }
+                break;
             }
-            break;
-        }
-        case 1:
-        {
-            // p1,p2,p4 are collinear, p3 is significant
-            //----------------------
-            if (d3 * d3 <= m_distance_tolerance_square * (dx*dx + dy*dy))
+            case 1:
             {
-                if (m_angle_tolerance < curve_angle_tolerance_epsilon)
-                {
-                    points.append(QPointF(x23, y23));
-                    return points;
-                }
-
-                // Angle Condition
+                // p1,p2,p4 are collinear, p3 is significant
                 //----------------------
-                double da1 = fabs(atan2(y4 - y3, x4 - x3) - atan2(y3 - y2, x3 - x2));
-                if (da1 >= M_PI)
+                if (d3 * d3 <= m_distance_tolerance_square * (dx*dx + dy*dy))
                 {
-                    da1 = M_2PI - da1;
-                }
+                    if (m_angle_tolerance < curve_angle_tolerance_epsilon)
+                    {
+                        points.append(QPointF(x23, y23));
+                        continue;
+                    }
 
-                if (da1 < m_angle_tolerance)
-                {
-                    points.append(QPointF(x2, y2));
-                    points.append(QPointF(x3, y3));
-                    return points;
-                }
+                    // Angle Condition
+                    //----------------------
+                    double da1 = fabs(atan2(y4 - y3, x4 - x3) - atan2(y3 - y2, x3 - x2));
+                    if (da1 >= M_PI)
+                    {
+                        da1 = M_2PI - da1;
+                    }
 
-                if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
-                {
-                    if (da1 > m_cusp_limit)
+                    if (da1 < m_angle_tolerance)
                     {
+                        points.append(QPointF(x2, y2));
                         points.append(QPointF(x3, y3));
-                        return points;
+                        continue;
+                    }
+
+                    if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
+                    {
+                        if (da1 > m_cusp_limit)
+                        {
+                            points.append(QPointF(x3, y3));
+                            continue;
+                        }
                     }
                 }
+                break;
             }
-            break;
-        }
-        case 2:
-        {
-            // p1,p3,p4 are collinear, p2 is significant
-            //----------------------
-            if (d2 * d2 <= m_distance_tolerance_square * (dx*dx + dy*dy))
+            case 2:
             {
-                if (m_angle_tolerance < curve_angle_tolerance_epsilon)
-                {
-                    points.append(QPointF(x23, y23));
-                    return points;
-                }
-
-                // Angle Condition
+                // p1,p3,p4 are collinear, p2 is significant
                 //----------------------
-                double da1 = fabs(atan2(y3 - y2, x3 - x2) - atan2(y2 - y1, x2 - x1));
-                if (da1 >= M_PI)
-                {
-                    da1 = M_2PI - da1;
-                }
-
-                if (da1 < m_angle_tolerance)
+                if (d2 * d2 <= m_distance_tolerance_square * (dx*dx + dy*dy))
                 {
-                    points.append(QPointF(x2, y2));
+                    if (m_angle_tolerance < curve_angle_tolerance_epsilon)
+                    {
+                        points.append(QPointF(x23, y23));
+                        continue;
+                    }
 
-                    points.append(QPointF(x3, y3));
-                    return points;
-                }
+                    // Angle Condition
+                    //----------------------
+                    double da1 = fabs(atan2(y3 - y2, x3 - x2) - atan2(y2 - y1, x2 - x1));
+                    if (da1 >= M_PI)
+                    {
+                        da1 = M_2PI - da1;
+                    }
 
-                if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
-                {
-                    if (da1 > m_cusp_limit)
+                    if (da1 < m_angle_tolerance)
                     {
                         points.append(QPointF(x2, y2));
-                        return points;
+
+                        points.append(QPointF(x3, y3));
+                        continue;
+                    }
+
+                    if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
+                    {
+                        if (da1 > m_cusp_limit)
+                        {
+                            points.append(QPointF(x2, y2));
+                            continue;
+                        }
                     }
                 }
+                break;
             }
-            break;
-        }
-        case 3:
-        {
-            // Regular case
-            //-----------------
-            if ((d2 + d3)*(d2 + d3) <= m_distance_tolerance_square * (dx*dx + dy*dy))
+            case 3:
             {
-                // If the curvature doesn't exceed the distance_tolerance value
-                // we tend to finish subdivisions.
-                //----------------------
-                if (m_angle_tolerance < curve_angle_tolerance_epsilon)
+                // Regular case
+                //-----------------
+                if ((d2 + d3)*(d2 + d3) <= m_distance_tolerance_square * (dx*dx + dy*dy))
                 {
-                    points.append(QPointF(x23, y23));
-                    return points;
-                }
-
-                // Angle & Cusp Condition
-                //----------------------
-                const double k   = atan2(y3 - y2, x3 - x2);
-                double da1 = fabs(k - atan2(y2 - y1, x2 - x1));
-                double da2 = fabs(atan2(y4 - y3, x4 - x3) - k);
-                if (da1 >= M_PI)
-                {
-                    da1 = M_2PI - da1;
-                }
-                if (da2 >= M_PI)
-                {
-                    da2 = M_2PI - da2;
-                }
-
-                if (da1 + da2 < m_angle_tolerance)
-                {
-                    // Finally we can stop the recursion
+                    // If the curvature doesn't exceed the distance_tolerance value
+                    // we tend to finish subdivisions.
                     //----------------------
+                    if (m_angle_tolerance < curve_angle_tolerance_epsilon)
+                    {
+                        points.append(QPointF(x23, y23));
+                        continue;
+                    }
 
-                    points.append(QPointF(x23, y23));
-                    return points;
-                }
+                    // Angle & Cusp Condition
+                    //----------------------
+                    const double k   = atan2(y3 - y2, x3 - x2);
+                    double da1 = fabs(k - atan2(y2 - y1, x2 - x1));
+                    double da2 = fabs(atan2(y4 - y3, x4 - x3) - k);
+                    if (da1 >= M_PI)
+                    {
+                        da1 = M_2PI - da1;
+                    }
+                    if (da2 >= M_PI)
+                    {
+                        da2 = M_2PI - da2;
+                    }
 
-                if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
-                {
-                    if (da1 > m_cusp_limit)
+                    if (da1 + da2 < m_angle_tolerance)
                     {
-                        points.append(QPointF(x2, y2));
-                        return points;
+                        // Finally we can stop the recursion
+                        //----------------------
+
+                        points.append(QPointF(x23, y23));
+                        continue;
                     }
 
-                    if (da2 > m_cusp_limit)
+                    if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
                     {
-                        points.append(QPointF(x3, y3));
-                        return points;
+                        if (da1 > m_cusp_limit)
+                        {
+                            points.append(QPointF(x2, y2));
+                            continue;
+                        }
+
+                        if (da2 > m_cusp_limit)
+                        {
+                            points.append(QPointF(x3, y3));
+                            continue;
+                        }
                     }
                 }
+                break;
             }
-            break;
+            default:
+                break;
         }
-        default:
-            break;
+
+        // Continue subdivision
+        //----------------------
+        stack.append({x1234, y1234, x234, y234, x34, y34, x4, y4, segment.level + 1});
+        stack.append({x1, y1, x12, y12, x123, y123, x1234, y1234, segment.level + 1});
     }
+}
 
-    // Continue subdivision
-    //----------------------
-    auto BezierTailPoints = [x1234, y1234, x234, y234, x34, y34, x4, y4, level, approximationScale]()
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> CubicBezierPoints(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4,
+                                   qreal approximationScale)
+{
+    // Enough for most curves of a pattern, longer curves grow the list only a few times
+    QVector<QPointF> points;
+    points.reserve(64);
+    points.append(p1);
+    PointBezier(p1, p2, p3, p4, approximationScale, points);
+    points.append(p4);
+
+    for (int i=1; i < points.size() - 1; ++i)
     {
-        QVector<QPointF> tail;
-        return PointBezier_r(x1234, y1234, x234, y234, x34, y34, x4, y4, static_cast<qint16>(level + 1), tail,
-                             approximationScale);
-    };
+        if (points.at(i-1) == points.at(i))
+        {
+            qDebug("All neighbors points in path must be unique.");
+            break;
+        }
+    }
 
-    auto BezierPoints = [x1, y1, x12, y12, x123, y123, x1234, y1234, level, points, approximationScale]()
-    {
-        return PointBezier_r(x1, y1, x12, y12, x123, y123, x1234, y1234, static_cast<qint16>(level + 1), points,
-                             approximationScale);
-    };
+    return points;
+}
 
-    if (level < 1)
-    {
-        QFuture<QVector<QPointF>> futureBezier = QtConcurrent::run(BezierPoints);
-        const QVector<QPointF> tail = BezierTailPoints();
-        return futureBezier.result() + tail;
-    }
-    else
+//---------------------------------------------------------------------------------------------------------------------
+QPointF CubicBezierPoint(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4, qreal t)
+{
+    const qreal mt = 1 - t;
+    return mt*mt*mt*p1 + 3*mt*mt*t*p2 + 3*mt*t*t*p3 + t*t*t*p4;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VArcLengthTable TabulateArcLength(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4,
+                                  qreal approximationScale)
+{
+    const QVector<QPointF> points = CubicBezierPoints(p1, p2, p3, p4, approximationScale);
+
+    VArcLengthTable table;
+    table.length = VAbstractCurve::PathLength(points);
+
+    // Flattening gives more points where the curve bends, so its size is a good hint how dense the table should be.
+    const int segments = qBound(64, points.size() * 4, 4096);
+    table.lengths.reserve(segments + 1);
+    table.lengths.append(0);
+    QPointF previous = p1;
+    for (int i = 1; i <= segments; ++i)
     {
-        return BezierPoints() + BezierTailPoints();
+        const QPointF point = CubicBezierPoint(p1, p2, p3, p4, static_cast<qreal>(i) / segments);
+        table.lengths.append(table.lengths.last() + QLineF(previous, point).length());
+        previous = point;
     }
+
+    return table;
 }
 }
 
@@ -491,17 +544,77 @@ qreal VAbstractCubicBezier::GetParmT(qreal length) const
     }
 
     const qreal eps = 0.001 * length;
+
+    // The table gives a bracket where the search stops. Outside of the bracket the direction of each step is known
+    // without measuring the curve, inside the curve is measured on each step as before.
+    qreal lower = 0;
+    qreal upper = 1;
+    ParmTBracket(length, eps, lower, upper);
+
     qreal parT = 0.5;
     qreal step = parT;
-    qreal splLength = LengthT(parT);
 
-    while (qAbs(splLength - length) > eps)
+    forever
     {
+        if (parT < lower)
+        {
+            parT += step / 2.0;
+        }
+        else if (parT > upper)
+        {
+            parT -= step / 2.0;
+        }
+        else
+        {
+            const qreal splLength = LengthT(parT);
+            if (qAbs(splLength - length) <= eps)
+            {
+                return parT;
+            }
+            splLength > length ? parT -= step / 2.0 : parT += step / 2.0;
+        }
         step /= 2.0;
-        splLength > length ? parT -= step : parT += step;
-        splLength = LengthT(parT);
     }
-    return parT;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ParmTBracket narrow the range of parameter t where the curve reaches the length.
+ *
+ * The range is taken from the arc-length table and both ends are checked by the exact length, so the result of
+ * GetParmT doesn't depend on the table.
+ * @param length length of the curve part.
+ * @param eps accuracy of the search.
+ * @param lower the curve part to this t is guaranteed shorter than length - eps. Stays 0 if can't be proved.
+ * @param upper the curve part to this t is guaranteed longer than length + eps. Stays 1 if can't be proved.
+ */
+void VAbstractCubicBezier::ParmTBracket(qreal length, qreal eps, qreal &lower, qreal &upper) const
+{
+    const VArcLengthTable table = ArcLengthTable();
+    const QVector<qreal> &lengths = table.lengths;
+
+    if (table.length <= 0 || lengths.size() < 2 || lengths.last() <= 0)
+    {
+        return;
+    }
+
+    const qreal tableLength = length / table.length * lengths.last();
+    const int index = static_cast<int>(std::lower_bound(lengths.constBegin(), lengths.constEnd(), tableLength)
+                                       - lengths.constBegin());
+    const int segments = lengths.size() - 1;
+
+    // One cell of margin on each side covers the difference between the table and the exact length
+    const int lowerIndex = index - 2;
+    if (lowerIndex > 0 && LengthT(static_cast<qreal>(lowerIndex) / segments) < length - eps)
+    {
+        lower = static_cast<qreal>(lowerIndex) / segments;
+    }
+
+    const int upperIndex = index + 1;
+    if (upperIndex < segments && LengthT(static_cast<qreal>(upperIndex) / segments) > length + eps)
+    {
+        upper = static_cast<qreal>(upperIndex) / segments;
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -529,12 +642,7 @@ void VAbstractCubicBezier::CreateName()
 QVector<QPointF> VAbstractCubicBezier::GetCubicBezierPoints(const QPointF &p1, const QPointF &p2, const QPointF &p3,
                                                             const QPointF &p4, qreal approximationScale)
 {
-    QVector<QPointF> pvector;
-    pvector.append(p1);
-    pvector = PointBezier_r(p1.x(), p1.y(), p2.x(), p2.y(), p3.x(), p3.y(), p4.x(), p4.y(), 0, pvector,
-                            approximationScale);
-    pvector.append(p4);
-    return pvector;
+    return CubicBezierPoints(p1, p2, p3, p4, approximationScale);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -587,3 +695,29 @@ qreal VAbstractCubicBezier::LengthT(qreal t) const
 
     return LengthBezier ( static_cast<QPointF>(GetP1()), p12, p123, p1234, GetApproximationScale());
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetCubicBezierLength return length of the curve.
+ *
+ * The length is calculated once for each shape of the curve together with a table of length by parameter t. Next
+ * calls don't flatten the curve again until a control point or the approximation scale changes.
+ * @return length.
+ */
+qreal VAbstractCubicBezier::GetCubicBezierLength() const
+{
+    return ArcLengthTable().length;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ArcLengthTable return table of length by parameter t. The table is kept in the shared data of the curve.
+ */
+VArcLengthTable VAbstractCubicBezier::ArcLengthTable() const
+{
+    return CachedArcLengthTable([this]()
+    {
+        return TabulateArcLength(static_cast<QPointF>(GetP1()), GetControlPoint1(), GetControlPoint2(),
+                                 static_cast<QPointF>(GetP4()), GetApproximationScale());
+    });
+}
@@ -71,6 +71,12 @@ protected:
 
     virtual QPointF GetControlPoint1() const =0;
     virtual QPointF GetControlPoint2() const =0;
+
+    qreal GetCubicBezierLength() const;
+
+private:
+    VArcLengthTable ArcLengthTable() const;
+    void            ParmTBracket(qreal length, qreal eps, qreal &lower, qreal &upper) const;
 };
 
 #endif // VABSTRACTCUBICBEZIER_H
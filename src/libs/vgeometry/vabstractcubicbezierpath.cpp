@@ -30,6 +30,8 @@
 #include "vsplinepoint.h"
 
 #include <QPainterPath>
+#include <QtConcurrentMap>
+#include <functional>
 
 #include "../vmisc/def.h"
 #include "../ifc/ifcdef.h"
@@ -37,6 +39,12 @@
 #include "vpointf.h"
 #include "vspline.h"
 
+namespace
+{
+// Paths with fewer segments are flattened in the calling thread
+const int minParallelSegments = 8;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 VAbstractCubicBezierPath::VAbstractCubicBezierPath(const GOType &type, const quint32 &idObject, const Draw &mode)
     : VAbstractBezier(type, idObject, mode)
@@ -87,17 +95,54 @@ QPainterPath VAbstractCubicBezierPath::GetPath() const
  */
 QVector<QPointF> VAbstractCubicBezierPath::GetPoints() const
 {
-    QVector<QPointF> pathPoints;
-    for (qint32 i = 1; i <= CountSubSpl(); ++i)
+    return CachedPoints([this]()
     {
-        if (not pathPoints.isEmpty())
+        QVector<VSpline> splines;
+        splines.reserve(CountSubSpl());
+        for (qint32 i = 1; i <= CountSubSpl(); ++i)
         {
-            pathPoints.removeLast();
+            splines.append(GetSpline(i));
         }
 
-        pathPoints += GetSpline(i).GetPoints();
-    }
-    return pathPoints;
+        std::function<QVector<QPointF> (const VSpline &spl)> SegmentPoints = [](const VSpline &spl)
+        {
+            return spl.GetPoints();
+        };
+
+        // One segment is too short to pay for a thread. Only long paths get a thread per segment.
+        QVector<QVector<QPointF>> segments;
+        if (splines.size() >= minParallelSegments)
+        {
+            segments = QtConcurrent::blockingMapped(splines, SegmentPoints);
+        }
+        else
+        {
+            segments.reserve(splines.size());
+            for (auto &spl : splines)
+            {
+                segments.append(SegmentPoints(spl));
+            }
+        }
+
+        int size = 0;
+        for (auto &segment : segments)
+        {
+            size += segment.size();
+        }
+
+        QVector<QPointF> pathPoints;
+        pathPoints.reserve(size);
+        for (auto &segment : segments)
+        {
+            if (not pathPoints.isEmpty())
+            {
+                pathPoints.removeLast();
+            }
+
+            pathPoints += segment;
+        }
+        return pathPoints;
+    });
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -31,15 +31,34 @@
 #include <QLine>
 #include <QLineF>
 #include <QMessageLogger>
+#include <QMutexLocker>
 #include <QPainterPath>
 #include <QPoint>
 #include <QtDebug>
+#include <atomic>
 
 #include "vabstractcurve_p.h"
 #include "../vmisc/vabstractapplication.h"
 #include "../vmisc/compatibility.h"
 #include "../ifc/exception/vexceptionobjecterror.h"
 
+namespace
+{
+std::atomic<qint64> pointsRequests{0};
+std::atomic<qint64> pointsFlattenings{0};
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal CachedApproximationScale(qreal approximationScale)
+{
+    if (approximationScale < minCurveApproximationScale || approximationScale > maxCurveApproximationScale)
+    {
+        return qApp->Settings()->GetCurveApproximationScale();
+    }
+    return approximationScale;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
 VAbstractCurve::VAbstractCurve(const GOType &type, const quint32 &idObject, const Draw &mode)
     :VGObject(type, idObject, mode), d (new VAbstractCurveData())
 {}
@@ -428,6 +447,93 @@ void VAbstractCurve::SetApproximationScale(qreal value)
     d->approximationScale = value;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PointsRequests return how many times points of curves were requested since start.
+ */
+qint64 VAbstractCurve::PointsRequests()
+{
+    return pointsRequests.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PointsFlattenings return how many times points of curves were really calculated since start.
+ */
+qint64 VAbstractCurve::PointsFlattenings()
+{
+    return pointsFlattenings.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CachedPoints return points of the curve calculated for current approximation scale.
+ *
+ * Points are calculated once and kept in the shared data, so all copies of an unchanged curve get the same vector.
+ * Subclasses must call ResetCachedPoints() each time they change the shape of the curve.
+ * @param flatten function that calculates points of the curve.
+ * @return list of points.
+ */
+QVector<QPointF> VAbstractCurve::CachedPoints(const std::function<QVector<QPointF>()> &flatten) const
+{
+    ++pointsRequests;
+
+    const qreal scale = CachedApproximationScale(d->approximationScale);
+
+    {
+        QMutexLocker locker(&d->pointsMutex);
+        if (qFuzzyCompare(d->pointsScale, scale))
+        {
+            return d->points;
+        }
+    }
+
+    ++pointsFlattenings;
+    const QVector<QPointF> points = flatten();
+
+    QMutexLocker locker(&d->pointsMutex);
+    d->points = points;
+    d->pointsScale = scale;
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CachedArcLengthTable return table of length by parameter t calculated for current approximation scale.
+ *
+ * Works the same way as CachedPoints(). ResetCachedPoints() drops the table too.
+ * @param tabulate function that calculates the table.
+ * @return table of length.
+ */
+VArcLengthTable VAbstractCurve::CachedArcLengthTable(const std::function<VArcLengthTable()> &tabulate) const
+{
+    const qreal scale = CachedApproximationScale(d->approximationScale);
+
+    {
+        QMutexLocker locker(&d->pointsMutex);
+        if (qFuzzyCompare(d->arcLengthsScale, scale))
+        {
+            return d->arcLengths;
+        }
+    }
+
+    const VArcLengthTable table = tabulate();
+
+    QMutexLocker locker(&d->pointsMutex);
+    d->arcLengths = table;
+    d->arcLengthsScale = scale;
+    return table;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VAbstractCurve::ResetCachedPoints()
+{
+    d->points.clear();
+    d->pointsScale = -1;
+    d->arcLengths = VArcLengthTable();
+    d->arcLengthsScale = -1;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QVector<QPointF> VAbstractCurve::CurveIntersectLine(const QVector<QPointF> &points, const QLineF &line)
 {
@@ -36,6 +36,7 @@
 #include <QTypeInfo>
 #include <QVector>
 #include <QtGlobal>
+#include <functional>
 
 #include "../ifc/ifcdef.h"
 #include "../vmisc/vmath.h"
@@ -104,8 +105,15 @@ public:
     static QPainterPath      ShowDirection(const QVector<DirectionArrow> &arrows, qreal width);
 
     static qreal LengthCurveDirectionArrow();
+
+    static qint64            PointsRequests();
+    static qint64            PointsFlattenings();
 protected:
     virtual void             CreateName() =0;
+
+    QVector<QPointF>         CachedPoints(const std::function<QVector<QPointF>()> &flatten) const;
+    VArcLengthTable          CachedArcLengthTable(const std::function<VArcLengthTable()> &tabulate) const;
+    void                     ResetCachedPoints();
 private:
     QSharedDataPointer<VAbstractCurveData> d;
 
@@ -29,10 +29,15 @@
 #ifndef VABSTRACTCURVE_P_H
 #define VABSTRACTCURVE_P_H
 
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPointF>
 #include <QSharedData>
+#include <QVector>
 
 #include "../ifc/ifcdef.h"
 #include "../vmisc/diagnostic.h"
+#include "vgeometrydef.h"
 
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_GCC("-Weffc++")
@@ -46,7 +51,12 @@ public:
         : duplicate(0),
           color(ColorBlack),
           penStyle(TypeLineLine),
-          approximationScale(defCurveApproximationScale)
+          approximationScale(defCurveApproximationScale),
+          points(),
+          pointsScale(-1),
+          arcLengths(),
+          arcLengthsScale(-1),
+          pointsMutex()
     {}
 
     VAbstractCurveData(const VAbstractCurveData &curve)
@@ -54,8 +64,20 @@ public:
           duplicate(curve.duplicate),
           color(curve.color),
           penStyle(curve.penStyle),
-          approximationScale(curve.approximationScale)
-    {}
+          approximationScale(curve.approximationScale),
+          points(),
+          pointsScale(-1),
+          arcLengths(),
+          arcLengthsScale(-1),
+          pointsMutex()
+    {
+        // Another thread can fill the cache of the source right now
+        QMutexLocker locker(&curve.pointsMutex);
+        points = curve.points;
+        pointsScale = curve.pointsScale;
+        arcLengths = curve.arcLengths;
+        arcLengthsScale = curve.arcLengthsScale;
+    }
 
     virtual ~VAbstractCurveData();
 
@@ -67,6 +89,21 @@ public:
 
     qreal approximationScale;
 
+    /** @brief points cached approximation of the curve. Shared by all copies until the curve changes. */
+    mutable QVector<QPointF> points;
+
+    /** @brief pointsScale approximation scale of cached points. Negative if there are no cached points. */
+    mutable qreal pointsScale;
+
+    /** @brief arcLengths cached table of length by parameter t. Only curves that need it fill the table. */
+    mutable VArcLengthTable arcLengths;
+
+    /** @brief arcLengthsScale approximation scale of the cached table. Negative if there is no cached table. */
+    mutable qreal arcLengthsScale;
+
+    /** @brief pointsMutex guards cached points and the cached table. */
+    mutable QMutex pointsMutex;
+
 private:
     Q_DISABLE_ASSIGN(VAbstractCurveData)
 };
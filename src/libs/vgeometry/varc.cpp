@@ -243,6 +243,12 @@ QPointF VArc::GetP2 () const
  * @return list of points
  */
 QVector<QPointF> VArc::GetPoints() const
+{
+    return CachedPoints([this]() {return FlattenPoints();});
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> VArc::FlattenPoints() const
 {
     QVector<QPointF> points;
     QVector<qreal> sectionAngle;
@@ -440,6 +446,7 @@ void VArc::SetFormulaRadius(const QString &formula, qreal value)
 {
     d->formulaRadius = formula;
     d->radius = value;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
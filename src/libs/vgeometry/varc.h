@@ -90,6 +90,8 @@ private:
     QSharedDataPointer<VArcData> d;
 
     qreal MaxLength() const;
+
+    QVector<QPointF> FlattenPoints() const;
 };
 
 Q_DECLARE_TYPEINFO(VArc, Q_MOVABLE_TYPE);
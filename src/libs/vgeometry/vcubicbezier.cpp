@@ -139,6 +139,7 @@ VPointF VCubicBezier::GetP1() const
 void VCubicBezier::SetP1(const VPointF &p)
 {
     d->p1 = p;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -151,6 +152,7 @@ VPointF VCubicBezier::GetP2() const
 void VCubicBezier::SetP2(const VPointF &p)
 {
     d->p2 = p;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -163,6 +165,7 @@ VPointF VCubicBezier::GetP3() const
 void VCubicBezier::SetP3(const VPointF &p)
 {
     d->p3 = p;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -175,6 +178,7 @@ VPointF VCubicBezier::GetP4() const
 void VCubicBezier::SetP4(const VPointF &p)
 {
     d->p4 = p;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -196,8 +200,7 @@ qreal VCubicBezier::GetEndAngle() const
  */
 qreal VCubicBezier::GetLength() const
 {
-    return LengthBezier (static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
-                         static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4()), GetApproximationScale());
+    return GetCubicBezierLength();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -207,8 +210,12 @@ qreal VCubicBezier::GetLength() const
  */
 QVector<QPointF> VCubicBezier::GetPoints() const
 {
-    return GetCubicBezierPoints(static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
-                                static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4()), GetApproximationScale());
+    return CachedPoints([this]()
+    {
+        return GetCubicBezierPoints(static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
+                                    static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4()),
+                                    GetApproximationScale());
+    });
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -150,6 +150,8 @@ VCubicBezierPath::~VCubicBezierPath()
 //---------------------------------------------------------------------------------------------------------------------
 VPointF &VCubicBezierPath::operator[](int indx)
 {
+    // Caller can change the point through the reference
+    ResetCachedPoints();
     return d->path[indx];
 }
 
@@ -164,6 +166,7 @@ void VCubicBezierPath::append(const VPointF &point)
 {
     d->path.append(point);
     CreateName();
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -183,6 +186,7 @@ void VCubicBezierPath::Clear()
 {
     d->path.clear();
     SetDuplicate(0);
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -245,6 +245,7 @@ QTransform VEllipticalArc::GetTransform() const
 void VEllipticalArc::SetTransform(const QTransform &matrix, bool combine)
 {
     d->m_transform = combine ? d->m_transform * matrix : matrix;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -263,6 +264,12 @@ VPointF VEllipticalArc::GetCenter() const
  * @return list of points
  */
 QVector<QPointF> VEllipticalArc::GetPoints() const
+{
+    return CachedPoints([this]() {return FlattenPoints();});
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> VEllipticalArc::FlattenPoints() const
 {
     const QPointF center = VAbstractArc::GetCenter().toQPointF();
     QRectF box(center.x() - d->radius1, center.y() - d->radius2, d->radius1*2, d->radius2*2);
@@ -511,6 +518,7 @@ void VEllipticalArc::SetFormulaRadius1(const QString &formula, qreal value)
 {
     d->formulaRadius1 = formula;
     d->radius1 = value;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -518,6 +526,7 @@ void VEllipticalArc::SetFormulaRadius2(const QString &formula, qreal value)
 {
     d->formulaRadius2 = formula;
     d->radius2 = value;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -525,6 +534,7 @@ void VEllipticalArc::SetFormulaRotationAngle(const QString &formula, qreal value
 {
     d->formulaRotationAngle = formula;
     d->rotationAngle = value;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
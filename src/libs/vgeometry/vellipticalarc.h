@@ -111,6 +111,8 @@ private:
     qreal MaxLength() const;
 
     QPointF GetP(qreal angle) const;
+
+    QVector<QPointF> FlattenPoints() const;
 };
 
 Q_DECLARE_METATYPE(VEllipticalArc)
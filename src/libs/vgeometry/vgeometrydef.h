@@ -97,6 +97,18 @@ private:
 };
 Q_DECLARE_METATYPE(VLayoutPassmark)
 
+/**
+ * @brief The VArcLengthTable struct keeps cumulative length of a curve for uniform values of parameter t.
+ *
+ * lengths[i] is the length of the polyline through points of the curve for t = 0, 1/n, ..., i/n. The polyline is
+ * a bit shorter than the curve, so lookups use it only as a shape of the length function and scale it to the length.
+ */
+struct VArcLengthTable
+{
+    qreal          length{0};
+    QVector<qreal> lengths{};
+};
+
 constexpr qreal accuracyPointOnLine = (0.117/*mm*/ / 25.4) * PrintDPI;
 
 Q_REQUIRED_RESULT static inline bool VFuzzyComparePoints(const QPointF &p1, const QPointF &p2);
@@ -173,8 +173,7 @@ VSpline::~VSpline()
  */
 qreal VSpline::GetLength () const
 {
-    return LengthBezier ( static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()), static_cast<QPointF>(GetP3()),
-                          static_cast<QPointF>(GetP4()), GetApproximationScale());
+    return GetCubicBezierLength();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -201,8 +200,12 @@ QPointF VSpline::CutSpline(qreal length, VSpline &spl1, VSpline &spl2) const
  */
 QVector<QPointF> VSpline::GetPoints () const
 {
-    return GetCubicBezierPoints(static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
-                                static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4()), GetApproximationScale());
+    return CachedPoints([this]()
+    {
+        return GetCubicBezierPoints(static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
+                                    static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4()),
+                                    GetApproximationScale());
+    });
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -276,6 +279,7 @@ VPointF VSpline::GetP1() const
 void VSpline::SetP1(const VPointF &p)
 {
     d->p1 = p;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -316,6 +320,7 @@ VPointF VSpline::GetP4() const
 void VSpline::SetP4(const VPointF &p)
 {
     d->p4 = p;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -355,6 +360,7 @@ void VSpline::SetStartAngle(qreal angle, const QString &formula)
 {
     d->angle1 = angle;
     d->angle1F = formula;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -362,6 +368,7 @@ void VSpline::SetEndAngle(qreal angle, const QString &formula)
 {
     d->angle2 = angle;
     d->angle2F = formula;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -393,6 +400,7 @@ void VSpline::SetC1Length(qreal length, const QString &formula)
 {
     d->c1Length = length;
     d->c1LengthF = formula;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -400,6 +408,7 @@ void VSpline::SetC2Length(qreal length, const QString &formula)
 {
     d->c2Length = length;
     d->c2LengthF = formula;
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -196,6 +196,7 @@ void VSplinePath::append(const VSplinePoint &point)
 
     d->path.append(point);
     CreateName();
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -262,6 +263,7 @@ void VSplinePath::UpdatePoint(qint32 indexSpline, const SplinePointPosition &pos
     {
         d->path[indexSpline] = point;
     }
+    ResetCachedPoints();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -328,6 +330,8 @@ VSplinePath &VSplinePath::operator=(VSplinePath &&path) Q_DECL_NOTHROW
  */
 VSplinePoint & VSplinePath::operator[](int indx)
 {
+    // Caller can change the point through the reference
+    ResetCachedPoints();
     return d->path[indx];
 }
 
@@ -456,4 +460,5 @@ void VSplinePath::Clear()
 {
     d->path.clear();
     SetDuplicate(0);
+    ResetCachedPoints();
 }
@@ -35,11 +35,14 @@
 #include "../vmisc/compatibility.h"
 #include "../vpatterndb/floatItemData/vgrainlinedata.h"
 #include "../vpatterndb/vcontainer.h"
-#include "../vpatterndb/calculator.h"
+#include "../vpatterndb/vcalculatorcache.h"
+#include "../qmuparser/qmuparsererror.h"
 #include "testpath.h"
 #include "vrawsapoint.h"
+#include "vuniformgrid.h"
 
 #include <QLineF>
+#include <QRectF>
 #include <QSet>
 #include <QVector>
 #include <QPainterPath>
@@ -47,6 +50,9 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QtMath>
+#include <algorithm>
+#include <functional>
 
 const quint32 VAbstractPieceData::streamHeader = 0x05CDD73A; // CRC-32Q string "VAbstractPieceData"
 const quint16 VAbstractPieceData::classVersion = 2;
@@ -59,6 +65,231 @@ const qreal VSAPoint::minSAWidth = ToPixel(0.015, Unit::Cm);
 
 namespace
 {
+// Segments closer than accuracy are treated as touching by the loop check, keep them in the same cells
+const qreal segmentsMargin = accuracyPointOnLine * 2;
+// Protect from huge grids when one segment is much longer than others
+const int maxCellsPerSegment = 4;
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ClosedPathSegments return segments of a closed path. Segment k connects points k and k+1, the last one
+ * connects the last point with the first.
+ */
+template <class T>
+QVector<QLineF> ClosedPathSegments(const QVector<T> &points)
+{
+    QVector<QLineF> segments;
+    segments.reserve(points.size());
+
+    for (qint32 k = 0; k < points.size(); ++k)
+    {
+        segments.append(QLineF(points.at(k), points.at(k == points.size()-1 ? 0 : k+1)));
+    }
+
+    return segments;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QRectF SegmentRect(const QLineF &line)
+{
+    QRectF rect = QRectF(line.p1(), line.p2()).normalized();
+    rect.adjust(-segmentsMargin, -segmentsMargin, segmentsMargin, segmentsMargin);
+    return rect;
+}
+
+/**
+ * @brief The VSegmentsGrid class is a uniform grid over segments of a path.
+ *
+ * Looking for segments that may cross a segment needs only cells under it instead of the whole path.
+ */
+class VSegmentsGrid
+{
+public:
+    explicit VSegmentsGrid(const QVector<QLineF> &segments);
+
+    QVector<qint32> Candidates(qint32 segment, qint32 first);
+    QVector<qint32> Candidates(const QLineF &line);
+
+private:
+    QVector<QRectF> m_bounds{};
+    VUniformGrid m_grid{};
+    QVector<qint32> m_stamps{};
+    qint32 m_query{0};
+
+    QVector<qint32> Candidates(const QRectF &rect, qint32 first);
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+VSegmentsGrid::VSegmentsGrid(const QVector<QLineF> &segments)
+{
+    const qint32 count = segments.size();
+    m_bounds.reserve(count);
+    m_stamps.fill(-1, count);
+
+    QRectF area;
+    qreal length = 0;
+    for (auto &line : segments)
+    {
+        const QRectF rect = SegmentRect(line);
+        m_bounds.append(rect);
+        area = area.united(rect);
+        length += line.length();
+    }
+
+    // Twice the average segment keeps a few segments per cell
+    m_grid = VUniformGrid::WithCellSize(area, qMax(length / qMax(count, 1) * 2, segmentsMargin),
+                                        maxCellsPerSegment * qMax(count, 1));
+    for (qint32 k = 0; k < count; ++k)
+    {
+        m_grid.Insert(k, m_bounds.at(k));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Candidates return segments starting from the first that may cross the segment.
+ * @param segment index of segment.
+ * @param first smallest index of a candidate.
+ * @return indexes of candidates in descending order.
+ */
+QVector<qint32> VSegmentsGrid::Candidates(qint32 segment, qint32 first)
+{
+    return Candidates(m_bounds.at(segment), first);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Candidates return segments that may cross a line from outside of the grid.
+ * @param line line to check.
+ * @return indexes of candidates in descending order.
+ */
+QVector<qint32> VSegmentsGrid::Candidates(const QLineF &line)
+{
+    return Candidates(SegmentRect(line), 0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<qint32> VSegmentsGrid::Candidates(const QRectF &rect, qint32 first)
+{
+    QVector<qint32> candidates;
+
+    // Each query gets own stamp, so a segment from several cells is added only once
+    ++m_query;
+
+    m_grid.Visit(rect, [this, &candidates, &rect, first](qint32 k)
+    {
+        if (k >= first && m_stamps.at(k) != m_query && rect.intersects(m_bounds.at(k)))
+        {
+            m_stamps[k] = m_query;
+            candidates.append(k);
+        }
+        return false;
+    });
+
+    std::sort(candidates.begin(), candidates.end(), std::greater<qint32>());
+    return candidates;
+}
+
+/**
+ * @brief The VWindingBands class classifies points against a polygon the same way as
+ * QPolygonF::containsPoint(point, Qt::WindingFill) does.
+ *
+ * The polygon is cut into horizontal bands. Each band keeps edges whose vertical range touches the band, so a point
+ * is checked only against edges that can cross its scan line instead of the whole polygon.
+ */
+class VWindingBands
+{
+public:
+    explicit VWindingBands(const QVector<QPointF> &polygon);
+
+    bool Contains(const QPointF &point) const;
+
+private:
+    QVector<QLineF> m_edges{};
+    VUniformGrid m_bands{};
+    qreal m_top{0};
+    qreal m_bottom{0};
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+VWindingBands::VWindingBands(const QVector<QPointF> &polygon)
+{
+    if (polygon.isEmpty())
+    {
+        return;
+    }
+
+    m_edges.reserve(polygon.size());
+    for (qint32 k = 1; k < polygon.size(); ++k)
+    {
+        m_edges.append(QLineF(polygon.at(k-1), polygon.at(k)));
+    }
+
+    // Implicitly close the polygon like QPolygonF does
+    if (polygon.last() != polygon.first())
+    {
+        m_edges.append(QLineF(polygon.last(), polygon.first()));
+    }
+
+    m_top = m_bottom = polygon.first().y();
+    for (auto &point : polygon)
+    {
+        m_top = qMin(m_top, point.y());
+        m_bottom = qMax(m_bottom, point.y());
+    }
+
+    const int count = qMax(1, m_edges.size());
+    const qreal bandHeight = qMax((m_bottom - m_top) / count, accuracyPointOnLine);
+    m_bands = VUniformGrid(QRectF(0, m_top, 0, m_bottom - m_top), 1,
+                           qBound(1, qCeil((m_bottom - m_top) / bandHeight), count));
+
+    for (qint32 k = 0; k < m_edges.size(); ++k)
+    {
+        const QLineF &edge = m_edges.at(k);
+        if (qFuzzyCompare(edge.y1(), edge.y2()))
+        {
+            continue; // Horizontal edges are ignored by the scan conversion rule
+        }
+
+        m_bands.Insert(k, QRectF(0, qMin(edge.y1(), edge.y2()), 0, qAbs(edge.y2() - edge.y1())));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VWindingBands::Contains(const QPointF &point) const
+{
+    if (m_bands.IsEmpty() || point.y() < m_top || point.y() >= m_bottom)
+    {
+        return false;
+    }
+
+    int winding = 0;
+    m_bands.Visit(QRectF(0, point.y(), 0, 0), [this, point, &winding](qint32 k)
+    {
+        QPointF p1 = m_edges.at(k).p1();
+        QPointF p2 = m_edges.at(k).p2();
+        int direction = 1;
+
+        if (p2.y() < p1.y())
+        {
+            qSwap(p1, p2);
+            direction = -1;
+        }
+
+        if (point.y() >= p1.y() && point.y() < p2.y())
+        {
+            const qreal x = p1.x() + ((p2.x() - p1.x()) / (p2.y() - p1.y())) * (point.y() - p1.y());
+            if (x <= point.x())
+            {
+                winding += direction;
+            }
+        }
+        return false;
+    });
+
+    return winding != 0;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 inline bool IsSameDirection(QPointF p1, QPointF p2, QPointF px)
 {
@@ -1216,6 +1447,8 @@ QVector<QPointF> VAbstractPiece::CheckLoops(const QVector<VRawSAPoint> &points)
     QVector<qint32> uniqueVertices;
     uniqueVertices.reserve(4);
 
+    VSegmentsGrid grid(ClosedPathSegments(points));
+
     qint32 i, j, jNext = 0;
     for (i = 0; i < count; ++i)
     {
@@ -1233,9 +1466,11 @@ QVector<QPointF> VAbstractPiece::CheckLoops(const QVector<VRawSAPoint> &points)
         LoopIntersectType status = NoIntersection;
         const QLineF line1(points.at(i), points.at(i+1));
         // Because a path can contains several loops we will seek the last and only then remove the loop(s)
-        // That's why we parse from the end
-        for (j = count-1; j >= i+2; --j)
+        // That's why we parse from the end. Only segments close to the line can cross it.
+        const QVector<qint32> candidates = grid.Candidates(i, i+2);
+        for (auto candidate : candidates)
         {
+            j = candidate;
             j == count-1 ? jNext = 0 : jNext = j+1;
             QLineF line2(points.at(j), points.at(jNext));
 
@@ -1536,38 +1771,22 @@ bool VAbstractPiece::IsAllowanceValid(const QVector<QPointF> &base, const QVecto
         return false; // Wrong direction
     }
 
-    // Edges must not intersect
-    for (auto i = 0; i < base.count(); ++i)
-    {
-        int nextI = -1;
-        if (i < base.count()-1)
-        {
-            nextI = i + 1;
-        }
-        else
-        {
-            nextI = 0;
-        }
+    // Edges must not intersect. Only allowance edges close to a base edge can cross it.
+    const QVector<QLineF> baseSegments = ClosedPathSegments(base);
+    const QVector<QLineF> allowanceSegments = ClosedPathSegments(allowance);
+    VSegmentsGrid grid(allowanceSegments);
 
-        QLineF baseSegment(base.at(i), base.at(nextI));
+    for (auto &baseSegment : baseSegments)
+    {
         if (baseSegment.isNull())
         {
             continue;
         }
 
-        for (auto j = 0; j < allowance.count(); ++j)
+        const QVector<qint32> candidates = grid.Candidates(baseSegment);
+        for (auto j : candidates)
         {
-            int nextJ = -1;
-            if (j < allowance.count()-1)
-            {
-                nextJ = j + 1;
-            }
-            else
-            {
-                nextJ = 0;
-            }
-
-            QLineF allowanceSegment(allowance.at(j), allowance.at(nextJ));
+            const QLineF &allowanceSegment = allowanceSegments.at(j);
             if (allowanceSegment.isNull())
             {
                 continue;
@@ -1588,11 +1807,11 @@ bool VAbstractPiece::IsAllowanceValid(const QVector<QPointF> &base, const QVecto
     }
 
     // Just instersection edges is not enough. The base must be inside of the allowance.
-    QPolygonF allowancePolygon(allowance);
+    const VWindingBands allowancePolygon(allowance);
 
     for (auto &point : base)
     {
-        if (not allowancePolygon.containsPoint(point, Qt::WindingFill))
+        if (not allowancePolygon.Contains(point))
         {
             return false;
         }
@@ -1880,12 +2099,10 @@ bool VAbstractPiece::FindGrainlineGeometry(const VGrainlineData& geom, const VCo
 
     try
     {
-        Calculator cal1;
-        rotationAngle = cal1.EvalFormula(pattern->DataVariables(), geom.GetRotation());
+        rotationAngle = VCalculatorCache::Instance()->EvalFormula(pattern, geom.GetRotation());
         rotationAngle = qDegreesToRadians(rotationAngle);
 
-        Calculator cal2;
-        length = cal2.EvalFormula(pattern->DataVariables(), geom.GetLength());
+        length = VCalculatorCache::Instance()->EvalFormula(pattern, geom.GetLength());
         length = ToPixel(length, *pattern->GetPatternUnit());
     }
     catch(qmu::QmuParserError &e)
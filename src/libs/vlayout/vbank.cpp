@@ -213,6 +213,12 @@ void VBank::SetDetails(const QVector<VLayoutPiece> &details)
     Reset();
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VLayoutPiece> VBank::GetDetails() const
+{
+    return details;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 int VBank::GetNext()
 {
@@ -419,6 +425,12 @@ void VBank::Reset()
     diagonal = 0;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+Cases VBank::GetCaseType() const
+{
+    return caseType;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VBank::SetCaseType(Cases caseType)
 {
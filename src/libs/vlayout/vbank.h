@@ -69,6 +69,7 @@ public:
     void SetDetails(const QVector<VLayoutPiece> &details);
     int  GetNext();
     VLayoutPiece GetDetail(int i) const;
+    QVector<VLayoutPiece> GetDetails() const;
 
     void Arranged(int i);
     void NotArranged(int i);
@@ -76,6 +77,7 @@ public:
     bool PrepareUnsorted();
     bool PrepareDetails();
     void Reset();
+    Cases GetCaseType() const;
     void SetCaseType(Cases caseType);
 
     int AllDetailsCount() const;
@@ -0,0 +1,420 @@
+/************************************************************************
+ **
+ **  @file   vcollisionpolygon.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vcollisionpolygon.h"
+
+namespace
+{
+// Average number of edges in one band
+const int edgesPerBand = 8;
+const int maxBands = 256;
+
+//---------------------------------------------------------------------------------------------------------------------
+// The same precision QPathClipper uses for comparing points.
+inline bool FuzzyIsNull(qreal d)
+{
+    return qAbs(d) <= 1e-12;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool ComparePoints(const QPointF &a, const QPointF &b)
+{
+    return FuzzyIsNull(a.x() - b.x()) && FuzzyIsNull(a.y() - b.y());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline qreal Dot(const QPointF &a, const QPointF &b)
+{
+    return a.x() * b.x() + a.y() * b.y();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool RectsOverlap(qreal left1, qreal top1, qreal right1, qreal bottom1,
+                         qreal left2, qreal top2, qreal right2, qreal bottom2)
+{
+    return not (left1 > right2 || right1 < left2 || top1 > bottom2 || bottom1 < top2);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool RectsOverlap(const QRectF &r1, const QRectF &r2)
+{
+    return RectsOverlap(r1.left(), r1.top(), r1.right(), r1.bottom(), r2.left(), r2.top(), r2.right(), r2.bottom());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool RectContains(const QRectF &rect, const QPointF &point)
+{
+    return point.x() >= rect.left() && point.x() <= rect.right() && point.y() >= rect.top()
+            && point.y() <= rect.bottom();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsectLine update winding number for horizontal ray from the point to the left. Copy of scan conversion rule
+ * Qt uses in QPainterPath::contains().
+ */
+inline void IsectLine(const QPointF &p1, const QPointF &p2, const QPointF &pos, int &winding)
+{
+    qreal x1 = p1.x();
+    qreal y1 = p1.y();
+    qreal x2 = p2.x();
+    qreal y2 = p2.y();
+    const qreal y = pos.y();
+
+    int dir = 1;
+
+    if (qFuzzyCompare(y1, y2))
+    {
+        // ignore horizontal lines according to scan conversion rule
+        return;
+    }
+    else if (y2 < y1)
+    {
+        qSwap(x1, x2);
+        qSwap(y1, y2);
+        dir = -1;
+    }
+
+    if (y >= y1 && y < y2)
+    {
+        const qreal x = x1 + ((x2 - x1) / (y2 - y1)) * (y - y1);
+
+        if (x <= pos.x())
+        {
+            winding += dir;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IntersectSegments segments intersection test with precomputed edge vectors (p2 - p1 and q2 - q1).
+ */
+inline bool IntersectSegments(const QPointF &p1, const QPointF &p2, const QPointF &pDelta, const QPointF &q1,
+                              const QPointF &q2, const QPointF &qDelta)
+{
+    if (ComparePoints(p1, p2) || ComparePoints(q1, q2))
+    {
+        return false;
+    }
+
+    if ((ComparePoints(p1, q1) && ComparePoints(p2, q2)) || (ComparePoints(p1, q2) && ComparePoints(p2, q1)))
+    {
+        return true;
+    }
+
+    const qreal par = pDelta.x() * qDelta.y() - pDelta.y() * qDelta.x();
+
+    if (qFuzzyIsNull(par))
+    {
+        const QPointF normal(-pDelta.y(), pDelta.x());
+
+        // coinciding?
+        if (qFuzzyIsNull(Dot(normal, q1 - p1)))
+        {
+            const qreal dp = Dot(pDelta, pDelta);
+
+            const qreal tq1 = Dot(pDelta, q1 - p1);
+            const qreal tq2 = Dot(pDelta, q2 - p1);
+
+            if ((tq1 > 0 && tq1 < dp) || (tq2 > 0 && tq2 < dp))
+            {
+                return true;
+            }
+
+            const qreal dq = Dot(qDelta, qDelta);
+
+            const qreal tp1 = Dot(qDelta, p1 - q1);
+            const qreal tp2 = Dot(qDelta, p2 - q1);
+
+            if ((tp1 > 0 && tp1 < dq) || (tp2 > 0 && tp2 < dq))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    const qreal invPar = 1 / par;
+
+    const qreal tp = (qDelta.y() * (q1.x() - p1.x()) - qDelta.x() * (q1.y() - p1.y())) * invPar;
+
+    if (tp < 0 || tp > 1)
+    {
+        return false;
+    }
+
+    const qreal tq = (pDelta.y() * (q1.x() - p1.x()) - pDelta.x() * (q1.y() - p1.y())) * invPar;
+
+    return tq >= 0 && tq <= 1;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VCollisionPolygon::VCollisionPolygon(const QVector<QPointF> &points)
+    : m_points(points)
+{
+    const int count = m_points.size();
+    if (count < 3)
+    {
+        return;
+    }
+
+    const QPointF *p = m_points.constData();
+
+    qreal left = p[0].x();
+    qreal right = p[0].x();
+    qreal top = p[0].y();
+    qreal bottom = p[0].y();
+    for (int i = 1; i < count; ++i)
+    {
+        left = qMin(left, p[i].x());
+        right = qMax(right, p[i].x());
+        top = qMin(top, p[i].y());
+        bottom = qMax(bottom, p[i].y());
+    }
+    m_boundingRect = QRectF(QPointF(left, top), QPointF(right, bottom));
+
+    m_edges.resize(count);
+    for (int i = 0; i < count; ++i)
+    {
+        m_edges[i] = p[(i + 1) % count] - p[i];
+    }
+
+    const int bands = qFuzzyIsNull(m_boundingRect.height()) ? 1 : qBound(1, count / edgesPerBand, maxBands);
+    m_bands = VUniformGrid(m_boundingRect, 1, bands);
+    for (int i = 0; i < count; ++i)
+    {
+        m_bands.Insert(i, QRectF(p[i], p[(i + 1) % count]).normalized());
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Intersects check if the polygon and this polygon have at least one common point. The same as
+ * QPainterPath::intersects(const QPainterPath &).
+ * @param polygon closed polygon.
+ * @param rect bounding rectangle of the polygon.
+ * @return true if polygons intersect or one contains another.
+ */
+bool VCollisionPolygon::Intersects(const QVector<QPointF> &polygon, const QRectF &rect) const
+{
+    if (IsEmpty() || polygon.size() < 3 || not RectsOverlap(m_boundingRect, rect))
+    {
+        return false;
+    }
+
+    return Intersects(VFlatPolygon(polygon));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VCollisionPolygon::Intersects(const VFlatPolygon &polygon) const
+{
+    if (IsEmpty() || polygon.Count() < 3)
+    {
+        return false;
+    }
+
+    const QRectF rect = polygon.BoundingRect();
+    if (not RectsOverlap(m_boundingRect, rect))
+    {
+        return false;
+    }
+
+    if (HasEdgeIntersection(polygon))
+    {
+        return true;
+    }
+
+    const QPointF first = polygon.Point(0);
+    if (RectContains(m_boundingRect, first) && ContainsPoint(first))
+    {
+        return true;
+    }
+
+    const QPointF &ownFirst = m_points.at(0);
+    return RectContains(rect, ownFirst) && PolygonContainsPoint(polygon, ownFirst);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Contains check if the polygon lies inside this polygon. The same as QPainterPath::contains(const QPainterPath &).
+ * @param polygon closed polygon.
+ * @param rect bounding rectangle of the polygon.
+ * @return true if the polygon is inside and edges do not intersect.
+ */
+bool VCollisionPolygon::Contains(const QVector<QPointF> &polygon, const QRectF &rect) const
+{
+    if (IsEmpty() || polygon.size() < 3 || not RectsOverlap(m_boundingRect, rect))
+    {
+        return false;
+    }
+
+    return Contains(VFlatPolygon(polygon));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VCollisionPolygon::Contains(const VFlatPolygon &polygon) const
+{
+    if (IsEmpty() || polygon.Count() < 3 || not RectsOverlap(m_boundingRect, polygon.BoundingRect()))
+    {
+        return false;
+    }
+
+    if (HasEdgeIntersection(polygon))
+    {
+        return false;
+    }
+
+    const QPointF first = polygon.Point(0);
+    return RectContains(m_boundingRect, first) && ContainsPoint(first);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VCollisionPolygon::ContainsPoint(const QPointF &point) const
+{
+    if (IsEmpty() || not RectContains(m_boundingRect, point))
+    {
+        return false;
+    }
+
+    const int count = m_points.size();
+    const QPointF *p = m_points.constData();
+
+    // Band of the point keeps every edge which y range covers the point, so the rest of edges cannot change winding.
+    int winding = 0;
+    m_bands.Visit(QRectF(point, point), [p, count, point, &winding](int i)
+    {
+        IsectLine(p[i], p[(i + 1) % count], point, winding);
+        return false;
+    });
+
+    return winding != 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PolygonContainsPoint winding fill point in polygon test for not prepared polygon.
+ */
+bool VCollisionPolygon::PolygonContainsPoint(const QVector<QPointF> &polygon, const QPointF &point)
+{
+    const int count = polygon.size();
+    if (count < 3)
+    {
+        return false;
+    }
+
+    const QPointF *p = polygon.constData();
+    int winding = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        IsectLine(p[i], p[(i + 1) % count], point, winding);
+    }
+
+    return winding != 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VCollisionPolygon::PolygonContainsPoint(const VFlatPolygon &polygon, const QPointF &point)
+{
+    const int count = polygon.Count();
+    if (count < 3)
+    {
+        return false;
+    }
+
+    int winding = 0;
+    for (int i = 0; i < count - 1; ++i)
+    {
+        IsectLine(polygon.Point(i), polygon.Point(i + 1), point, winding);
+    }
+    IsectLine(polygon.Point(count - 1), polygon.Point(0), point, winding);
+
+    return winding != 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SegmentsIntersect check segments for intersection. Follows QIntersectionFinder::linesIntersect(). Touching
+ * segments intersect, collinear segments intersect only if they overlap.
+ */
+bool VCollisionPolygon::SegmentsIntersect(const QPointF &p1, const QPointF &p2, const QPointF &q1, const QPointF &q2)
+{
+    return IntersectSegments(p1, p2, p2 - p1, q1, q2, q2 - q1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VCollisionPolygon::HasEdgeIntersection(const VFlatPolygon &polygon) const
+{
+    const int count = m_points.size();
+    const int polygonCount = polygon.Count();
+    const QPointF *p = m_points.constData();
+    const QPointF *pEdges = m_edges.constData();
+    const qreal *qx = polygon.X();
+    const qreal *qy = polygon.Y();
+    const qreal *qEdgeX = polygon.EdgeX();
+    const qreal *qEdgeY = polygon.EdgeY();
+
+    for (int j = 0; j < polygonCount; ++j)
+    {
+        const int next = j + 1 < polygonCount ? j + 1 : 0;
+        const QPointF q1(qx[j], qy[j]);
+        const QPointF q2(qx[next], qy[next]);
+
+        const qreal qLeft = qMin(q1.x(), q2.x());
+        const qreal qRight = qMax(q1.x(), q2.x());
+        const qreal qTop = qMin(q1.y(), q2.y());
+        const qreal qBottom = qMax(q1.y(), q2.y());
+
+        if (not RectsOverlap(qLeft, qTop, qRight, qBottom, m_boundingRect.left(), m_boundingRect.top(),
+                             m_boundingRect.right(), m_boundingRect.bottom()))
+        {
+            continue;
+        }
+
+        const QPointF qDelta(qEdgeX[j], qEdgeY[j]);
+
+        const bool intersects = m_bands.Visit(QRectF(QPointF(qLeft, qTop), QPointF(qRight, qBottom)),
+                                              [=](int i)
+        {
+            const QPointF &p1 = p[i];
+            const QPointF &p2 = p[(i + 1) % count];
+
+            return RectsOverlap(qMin(p1.x(), p2.x()), qMin(p1.y(), p2.y()), qMax(p1.x(), p2.x()),
+                                qMax(p1.y(), p2.y()), qLeft, qTop, qRight, qBottom)
+                    && IntersectSegments(p1, p2, pEdges[i], q1, q2, qDelta);
+        });
+
+        if (intersects)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,102 @@
+/************************************************************************
+ **
+ **  @file   vcollisionpolygon.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VCOLLISIONPOLYGON_H
+#define VCOLLISIONPOLYGON_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QTypeInfo>
+#include <QVector>
+#include <QtGlobal>
+
+#include "vflatpolygon.h"
+#include "vuniformgrid.h"
+
+/**
+ * @brief The VCollisionPolygon class is a closed polygon prepared for fast collision tests.
+ *
+ * Edges of the polygon are distributed into horizontal bands. A segment test asks only edges from bands the segment
+ * crosses, point in polygon test asks only the band of the point. Preparation happens once when a piece is placed on a
+ * sheet, tests itself work on flat point arrays and do not allocate. Tests with VFlatPolygon are the fast path, tests
+ * with a vector of points convert it first.
+ *
+ * The tests follow QPainterPath::intersects() and QPainterPath::contains() for paths built with
+ * VLayoutPiece::PainterPath() (closed polyline, Qt::WindingFill), including treatment of touching edges.
+ */
+class VCollisionPolygon
+{
+public:
+    VCollisionPolygon() = default;
+    explicit VCollisionPolygon(const QVector<QPointF> &points);
+
+    bool IsEmpty() const;
+    QRectF BoundingRect() const;
+    QVector<QPointF> Points() const;
+
+    bool Intersects(const QVector<QPointF> &polygon, const QRectF &rect) const;
+    bool Intersects(const VFlatPolygon &polygon) const;
+    bool Contains(const QVector<QPointF> &polygon, const QRectF &rect) const;
+    bool Contains(const VFlatPolygon &polygon) const;
+    bool ContainsPoint(const QPointF &point) const;
+
+    static bool PolygonContainsPoint(const QVector<QPointF> &polygon, const QPointF &point);
+    static bool PolygonContainsPoint(const VFlatPolygon &polygon, const QPointF &point);
+    static bool SegmentsIntersect(const QPointF &p1, const QPointF &p2, const QPointF &q1, const QPointF &q2);
+
+private:
+    QVector<QPointF> m_points{};
+    /** @brief m_edges edge vectors. Edge i goes from point i to point i+1. */
+    QVector<QPointF> m_edges{};
+    QRectF m_boundingRect{};
+    /** @brief m_bands edges grouped by horizontal bands. */
+    VUniformGrid m_bands{};
+
+    bool HasEdgeIntersection(const VFlatPolygon &polygon) const;
+};
+
+Q_DECLARE_TYPEINFO(VCollisionPolygon, Q_MOVABLE_TYPE);
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool VCollisionPolygon::IsEmpty() const
+{
+    return m_points.size() < 3;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QRectF VCollisionPolygon::BoundingRect() const
+{
+    return m_boundingRect;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QVector<QPointF> VCollisionPolygon::Points() const
+{
+    return m_points;
+}
+
+#endif // VCOLLISIONPOLYGON_H
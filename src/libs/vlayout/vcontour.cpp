@@ -60,6 +60,44 @@ void AppendToContour(QVector<QPointF> &contour, QPointF point)
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+QRectF UniteBounds(const QRectF &rect1, const QRectF &rect2)
+{
+    // Unlike QRectF::united() doesn't ignore rectangles of zero size
+    return QRectF(QPointF(qMin(rect1.left(), rect2.left()), qMin(rect1.top(), rect2.top())),
+                  QPointF(qMax(rect1.right(), rect2.right()), qMax(rect1.bottom(), rect2.bottom())));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void PointsBounds(const QVector<QPointF> &points, QVector<QRectF> &prefix, QVector<QRectF> &suffix)
+{
+    prefix.clear();
+    suffix.clear();
+
+    if (points.isEmpty())
+    {
+        return;
+    }
+
+    const int count = points.size();
+    prefix.resize(count);
+    suffix.resize(count);
+
+    QRectF rect(points.first(), points.first());
+    for (int i = 0; i < count; ++i)
+    {
+        rect = UniteBounds(rect, QRectF(points.at(i), points.at(i)));
+        prefix[i] = rect;
+    }
+
+    rect = QRectF(points.last(), points.last());
+    for (int i = count - 1; i >= 0; --i)
+    {
+        rect = UniteBounds(rect, QRectF(points.at(i), points.at(i)));
+        suffix[i] = rect;
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QVector<QPointF> OptimizeCombining(const QVector<QPointF> &contour, const QPointF &withdrawEnd)
 {
@@ -106,7 +144,9 @@ VContour::VContour()
 //---------------------------------------------------------------------------------------------------------------------
 VContour::VContour(int height, int width, qreal layoutWidth)
     :d(new VContourData(height, width, layoutWidth))
-{}
+{
+    UpdateCache();
+}
 
 //---------------------------------------------------------------------------------------------------------------------
 VContour::VContour(const VContour &contour)
@@ -147,8 +187,7 @@ void VContour::CeateEmptySheetContour()
 {
     if (d->globalContour.isEmpty())
     {
-        d->globalContour = CutEmptySheetEdge();
-        d->globalContour.append(d->globalContour.first()); // Close path
+        d->globalContour = d->emptySheetContour; // Already closed
 
         ResetAttributes();
     }
@@ -192,6 +231,8 @@ int VContour::GetHeight() const
 void VContour::SetHeight(int height)
 {
     d->paperHeight = height;
+
+    UpdateCache();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -204,6 +245,8 @@ int VContour::GetWidth() const
 void VContour::SetWidth(int width)
 {
     d->paperWidth = width;
+
+    UpdateCache();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -259,47 +302,86 @@ QVector<QPointF> VContour::UniteWithContour(const VLayoutPiece &detail, int glob
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-int VContour::GlobalEdgesCount() const
+/**
+ * @brief UnitedBoundingRect return bounding rectangle of contour UniteWithContour would create.
+ *
+ * Used to score a candidate position without building the united contour. The united contour keeps all global contour
+ * points except points OptimizeCombining cuts before the piece, and adds points which lie on piece edges. So the rect
+ * is a union of cached bounds of kept global contour points and the piece's bounding rect.
+ * @param detail piece on candidate position.
+ * @param globalI edge of global contour.
+ * @param detJ edge of piece.
+ * @param type how the piece was placed.
+ * @return bounding rectangle. Null rect if edges are not valid.
+ */
+QRectF VContour::UnitedBoundingRect(const VLayoutPiece &detail, int globalI, int detJ, BestFrom type) const
 {
-    return d->m_emptySheetEdgesCount;
-}
+    const QVector<QPointF> &points = d->globalContour;
+    const QVector<QRectF> &prefix = d->prefixBounds;
+    const QVector<QRectF> &suffix = d->suffixBounds;
 
-//---------------------------------------------------------------------------------------------------------------------
-QLineF VContour::GlobalEdge(int i) const
-{
-    QLineF edge;
-    if (d->globalContour.isEmpty()) //-V807
+    const QRectF detailRect = detail.LayoutBoundingRect();
+
+    if (points.isEmpty())
     {
-        // Because sheet is blank we have one global edge for all cases.
-        if (i < 1 || i > GlobalEdgesCount())
-        { // Doesn't exist such edge
-            return EmptySheetEdge();
-        }
+        return detailRect;
+    }
 
-        const QLineF emptyEdge = EmptySheetEdge();
-        const qreal nShift = emptyEdge.length()/GlobalEdgesCount();
-        edge = IsPortrait() ? QLineF(nShift*(i-1) + emptyEdge.x1(), emptyEdge.y1(),
-                                     nShift*i + emptyEdge.x1(), emptyEdge.y2()) :
-                              QLineF(emptyEdge.x1(), nShift*(i-1) + emptyEdge.y1(),
-                                     emptyEdge.x2(), nShift*i + emptyEdge.y1());
+    if (globalI <= 0 || globalI > points.size())
+    {
+        return QRectF();
     }
-    else
+
+    if (detJ <= 0 || detJ > detail.LayoutEdgesCount())
     {
-        if (i < 1 || i > GlobalEdgesCount())
-        { // Doesn't exist such edge
-            return QLineF();
-        }
+        return QRectF();
+    }
 
-        if (i < GlobalEdgesCount())
+    const int insert = type == BestFrom::Rotation ? globalI : globalI-1;
+    if (insert >= points.size())
+    {
+        return prefix.last(); // The piece is never inserted
+    }
+
+    // Repeat OptimizeCombining. Points on the segment between the insert point and the piece will be cut.
+    int keep = insert;
+    if (insert > 0)
+    {
+        const QPointF withdrawFirst = points.at(insert);
+        const QPointF withdrawEnd = detail.LayoutEdge(detJ).p2();
+        for (int i = insert - 1; i >= 0; --i)
         {
-            edge = QLineF(d->globalContour.at(i-1), d->globalContour.at(i));
-        }
-        else
-        { // Closed countour
-            edge = QLineF(d->globalContour.at(GlobalEdgesCount()-1), d->globalContour.at(0));
+            if (not VGObject::IsPointOnLineSegment(points.at(i), withdrawFirst, withdrawEnd, accuracyPointOnLine*2))
+            {
+                keep = i + 1;
+                break;
+            }
         }
     }
-    return edge;
+
+    QRectF rect = UniteBounds(prefix.at(keep), detailRect);
+    if (insert + 1 < points.size())
+    {
+        rect = UniteBounds(rect, suffix.at(insert + 1));
+    }
+    return rect;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VContour::GlobalEdgesCount() const
+{
+    return d->m_emptySheetEdgesCount;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QLineF VContour::GlobalEdge(int i) const
+{
+    if (i < 1 || i > d->globalEdges.size())
+    { // Doesn't exist such edge
+        return d->globalContour.isEmpty() ? EmptySheetEdge() : QLineF();
+    }
+
+    return d->globalEdges.at(i-1);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -421,6 +503,60 @@ void VContour::ResetAttributes()
     {
         d->m_emptySheetEdgesCount = EmptySheetEdgesCount(); // Edges count
     }
+
+    UpdateCache();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief UpdateCache rebuild cached edges and bounds of global contour.
+ *
+ * Called each time the contour or sheet changes, so placement checks from many threads only read the cache.
+ */
+void VContour::UpdateCache()
+{
+    const int count = GlobalEdgesCount();
+    d->globalEdges.clear();
+    d->globalEdges.reserve(count);
+
+    if (d->globalContour.isEmpty())
+    {
+        // Because sheet is blank we have one global edge for all cases.
+        const QLineF emptyEdge = EmptySheetEdge();
+        const qreal nShift = emptyEdge.length()/count;
+        for (int i = 1; i <= count; ++i)
+        {
+            d->globalEdges.append(IsPortrait() ? QLineF(nShift*(i-1) + emptyEdge.x1(), emptyEdge.y1(),
+                                                        nShift*i + emptyEdge.x1(), emptyEdge.y2()) :
+                                                 QLineF(emptyEdge.x1(), nShift*(i-1) + emptyEdge.y1(),
+                                                        emptyEdge.x2(), nShift*i + emptyEdge.y1()));
+        }
+
+        d->emptySheetContour.clear();
+        if (count > 0)
+        {
+            d->emptySheetContour = CutEmptySheetEdge();
+            d->emptySheetContour.append(d->emptySheetContour.first()); // Close path
+        }
+    }
+    else
+    {
+        for (int i = 1; i <= count; ++i)
+        {
+            if (i < count)
+            {
+                d->globalEdges.append(QLineF(d->globalContour.at(i-1), d->globalContour.at(i)));
+            }
+            else
+            { // Closed countour
+                d->globalEdges.append(QLineF(d->globalContour.at(count-1), d->globalContour.at(0)));
+            }
+        }
+
+        d->emptySheetContour.clear();
+    }
+
+    PointsBounds(d->globalContour, d->prefixBounds, d->suffixBounds);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -78,6 +78,7 @@ public:
     QSizeF GetSize() const;
 
     QVector<QPointF> UniteWithContour(const VLayoutPiece &detail, int globalI, int detJ, BestFrom type) const;
+    QRectF UnitedBoundingRect(const VLayoutPiece &detail, int globalI, int detJ, BestFrom type) const;
 
     QLineF EmptySheetEdge() const;
     int    GlobalEdgesCount() const;
@@ -94,6 +95,7 @@ private:
     void InsertDetail(QVector<QPointF> &contour, const VLayoutPiece &detail, int detJ) const;
 
     void ResetAttributes();
+    void UpdateCache();
 
     int EmptySheetEdgesCount() const;
 };
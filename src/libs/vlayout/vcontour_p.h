@@ -32,6 +32,7 @@
 #include <QSharedData>
 #include <QPointF>
 #include <QVector>
+#include <QLineF>
 #include <QRectF>
 #include <QPainterPath>
 
@@ -61,7 +62,11 @@ public:
           paperWidth(contour.paperWidth),
           shift(contour.shift),
           layoutWidth(contour.layoutWidth),
-          m_emptySheetEdgesCount(contour.m_emptySheetEdgesCount)
+          m_emptySheetEdgesCount(contour.m_emptySheetEdgesCount),
+          globalEdges(contour.globalEdges),
+          prefixBounds(contour.prefixBounds),
+          suffixBounds(contour.suffixBounds),
+          emptySheetContour(contour.emptySheetContour)
     {}
 
     ~VContourData() {}
@@ -81,6 +86,18 @@ public:
 
     int  m_emptySheetEdgesCount{0};
 
+    /** @brief globalEdges cached edges of global contour. Edge i is stored at index i-1. */
+    QVector<QLineF> globalEdges{};
+
+    /** @brief prefixBounds bounding rect of global contour points from 0 to i. */
+    QVector<QRectF> prefixBounds{};
+
+    /** @brief suffixBounds bounding rect of global contour points from i to the end. */
+    QVector<QRectF> suffixBounds{};
+
+    /** @brief emptySheetContour contour of blank sheet cut from empty sheet edge. Empty if the sheet is not blank. */
+    QVector<QPointF> emptySheetContour{};
+
 private:
     Q_DISABLE_ASSIGN(VContourData)
 };
@@ -0,0 +1,174 @@
+/************************************************************************
+ **
+ **  @file   vflatpolygon.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vflatpolygon.h"
+
+#include <QTransform>
+
+//---------------------------------------------------------------------------------------------------------------------
+VFlatPolygon::VFlatPolygon(const QVector<QPointF> &points)
+{
+    const int count = points.size();
+    Resize(count);
+
+    const QPointF *p = points.constData();
+    qreal *x = m_x.data();
+    qreal *y = m_y.data();
+    for (int i = 0; i < count; ++i)
+    {
+        x[i] = p[i].x();
+        y[i] = p[i].y();
+    }
+
+    Update();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BoundingRect return bounding rectangle of points. Equal to QPolygonF::boundingRect().
+ */
+QRectF VFlatPolygon::BoundingRect() const
+{
+    if (IsEmpty())
+    {
+        return QRectF(0, 0, 0, 0);
+    }
+
+    return QRectF(m_left, m_top, m_right - m_left, m_bottom - m_top);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> VFlatPolygon::Points() const
+{
+    QVector<QPointF> points;
+    points.reserve(Count());
+    for (int i = 0; i < Count(); ++i)
+    {
+        points.append(Point(i));
+    }
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Map replace points by points of the source polygon mapped by the matrix.
+ *
+ * Uses the same formula as QTransform::map() for affine matrices. Projective matrices are not supported.
+ * @param source source polygon. Must not be this polygon.
+ * @param matrix affine matrix.
+ * @param reverse reverse order of points. Mirrored piece does so.
+ */
+void VFlatPolygon::Map(const VFlatPolygon &source, const QTransform &matrix, bool reverse)
+{
+    Q_ASSERT(&source != this);
+
+    const int count = source.Count();
+    Resize(count);
+
+    const qreal m11 = matrix.m11();
+    const qreal m12 = matrix.m12();
+    const qreal m21 = matrix.m21();
+    const qreal m22 = matrix.m22();
+    const qreal dx = matrix.dx();
+    const qreal dy = matrix.dy();
+
+    const qreal *sx = source.X();
+    const qreal *sy = source.Y();
+    qreal *x = m_x.data();
+    qreal *y = m_y.data();
+
+    if (not reverse)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            x[i] = m11 * sx[i] + m21 * sy[i] + dx;
+            y[i] = m12 * sx[i] + m22 * sy[i] + dy;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            const int j = count - 1 - i;
+            x[j] = m11 * sx[i] + m21 * sy[i] + dx;
+            y[j] = m12 * sx[i] + m22 * sy[i] + dy;
+        }
+    }
+
+    Update();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VFlatPolygon::Resize(int count)
+{
+    // Does not reallocate if the size is the same, the buffers are not shared by the owner of a working polygon.
+    m_x.resize(count);
+    m_y.resize(count);
+    m_edgeX.resize(count);
+    m_edgeY.resize(count);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VFlatPolygon::Update()
+{
+    const int count = Count();
+    if (count == 0)
+    {
+        m_left = m_top = m_right = m_bottom = 0;
+        return;
+    }
+
+    const qreal *x = m_x.constData();
+    const qreal *y = m_y.constData();
+    qreal *edgeX = m_edgeX.data();
+    qreal *edgeY = m_edgeY.data();
+
+    for (int i = 0; i < count - 1; ++i)
+    {
+        edgeX[i] = x[i + 1] - x[i];
+        edgeY[i] = y[i + 1] - y[i];
+    }
+    edgeX[count - 1] = x[0] - x[count - 1];
+    edgeY[count - 1] = y[0] - y[count - 1];
+
+    qreal left = x[0];
+    qreal right = x[0];
+    qreal top = y[0];
+    qreal bottom = y[0];
+    for (int i = 1; i < count; ++i)
+    {
+        left = qMin(left, x[i]);
+        right = qMax(right, x[i]);
+        top = qMin(top, y[i]);
+        bottom = qMax(bottom, y[i]);
+    }
+
+    m_left = left;
+    m_top = top;
+    m_right = right;
+    m_bottom = bottom;
+}
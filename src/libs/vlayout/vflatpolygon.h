@@ -0,0 +1,133 @@
+/************************************************************************
+ **
+ **  @file   vflatpolygon.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VFLATPOLYGON_H
+#define VFLATPOLYGON_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QTypeInfo>
+#include <QVector>
+#include <QtGlobal>
+
+class QTransform;
+
+/**
+ * @brief The VFlatPolygon class keeps a closed polygon as structure of arrays: separate arrays of x and y coordinates
+ * and of edge vectors. Edge i goes from point i to point i+1, the last edge closes the polygon.
+ *
+ * Placement loop maps the same polygon for each candidate position. Map() writes into existing arrays, so a buffer
+ * which already has the right size is reused without allocation. Loops over plain arrays are easy to vectorize for
+ * a compiler.
+ */
+class VFlatPolygon
+{
+public:
+    VFlatPolygon() = default;
+    explicit VFlatPolygon(const QVector<QPointF> &points);
+
+    int    Count() const;
+    bool   IsEmpty() const;
+    QRectF BoundingRect() const;
+
+    QPointF Point(int i) const;
+    QPointF Edge(int i) const;
+
+    const qreal *X() const;
+    const qreal *Y() const;
+    const qreal *EdgeX() const;
+    const qreal *EdgeY() const;
+
+    QVector<QPointF> Points() const;
+
+    void Map(const VFlatPolygon &source, const QTransform &matrix, bool reverse);
+
+private:
+    QVector<qreal> m_x{};
+    QVector<qreal> m_y{};
+    QVector<qreal> m_edgeX{};
+    QVector<qreal> m_edgeY{};
+    qreal m_left{0};
+    qreal m_top{0};
+    qreal m_right{0};
+    qreal m_bottom{0};
+
+    void Resize(int count);
+    void Update();
+};
+
+Q_DECLARE_TYPEINFO(VFlatPolygon, Q_MOVABLE_TYPE);
+
+//---------------------------------------------------------------------------------------------------------------------
+inline int VFlatPolygon::Count() const
+{
+    return m_x.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool VFlatPolygon::IsEmpty() const
+{
+    return m_x.isEmpty();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QPointF VFlatPolygon::Point(int i) const
+{
+    return QPointF(m_x.at(i), m_y.at(i));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QPointF VFlatPolygon::Edge(int i) const
+{
+    return QPointF(m_edgeX.at(i), m_edgeY.at(i));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline const qreal *VFlatPolygon::X() const
+{
+    return m_x.constData();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline const qreal *VFlatPolygon::Y() const
+{
+    return m_y.constData();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline const qreal *VFlatPolygon::EdgeX() const
+{
+    return m_edgeX.constData();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline const qreal *VFlatPolygon::EdgeY() const
+{
+    return m_edgeY.constData();
+}
+
+#endif // VFLATPOLYGON_H
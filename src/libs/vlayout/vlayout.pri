@@ -24,7 +24,18 @@ HEADERS += \
     $$PWD/vlayoutpiecepath.h \
     $$PWD/vlayoutpiecepath_p.h \
     $$PWD/vbestsquare_p.h \
-    $$PWD/vrawsapoint.h
+    $$PWD/vrawsapoint.h \
+    $$PWD/vpositionsindex.h \
+    $$PWD/vcollisionpolygon.h \
+    $$PWD/vuniformgrid.h \
+    $$PWD/vpositionscheduler.h \
+    $$PWD/vnfpcache.h \
+    $$PWD/vnfpposition.h \
+    $$PWD/vlayoutpiececache.h \
+    $$PWD/vflatpolygon.h \
+    $$PWD/vlayoutpiecesnapshot.h \
+    $$PWD/vlayoutexporter.h \
+    $$PWD/vpngwriter.h
 
 SOURCES += \
     $$PWD/testpath.cpp \
@@ -40,6 +51,17 @@ SOURCES += \
     $$PWD/vabstractpiece.cpp \
     $$PWD/vlayoutpiece.cpp \
     $$PWD/vlayoutpiecepath.cpp \
-    $$PWD/vrawsapoint.cpp
+    $$PWD/vrawsapoint.cpp \
+    $$PWD/vpositionsindex.cpp \
+    $$PWD/vcollisionpolygon.cpp \
+    $$PWD/vuniformgrid.cpp \
+    $$PWD/vpositionscheduler.cpp \
+    $$PWD/vnfpcache.cpp \
+    $$PWD/vnfpposition.cpp \
+    $$PWD/vlayoutpiececache.cpp \
+    $$PWD/vflatpolygon.cpp \
+    $$PWD/vlayoutpiecesnapshot.cpp \
+    $$PWD/vlayoutexporter.cpp \
+    $$PWD/vpngwriter.cpp
 
 *msvc*:SOURCES += $$PWD/stable.cpp
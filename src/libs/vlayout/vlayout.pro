@@ -7,7 +7,7 @@
 # File with common stuff for whole project
 include(../../../common.pri)
 
-QT += core gui widgets printsupport xml concurrent
+QT += core gui widgets printsupport xml concurrent svg
 
 # Name of library
 TARGET = vlayout
@@ -44,6 +44,11 @@ DEFINES += QT_MESSAGELOGCONTEXT
 
 include(vlayout.pri)
 
+validateCollisions{ # For enable run qmake with CONFIG+=validateCollisions
+    # Compare each polygon collision test with QPainterPath result and report mismatches
+    DEFINES += LAYOUT_VALIDATE_COLLISIONS
+}
+
 # This is static library so no need in "make install"
 
 # directory for executable file
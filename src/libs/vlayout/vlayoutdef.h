@@ -32,9 +32,11 @@
 #include <QSize>
 #include <QTransform>
 #include <QPainterPath>
+#include <atomic>
 #include <ciso646>
 
 #include "../vmisc/typedef.h"
+#include "vcollisionpolygon.h"
 
 enum class LayoutExportFormats : qint8
 {
@@ -86,6 +88,12 @@ enum class LayoutErrors : qint8
     TerminatedByException
 };
 
+enum class PlacementEngine : qint8
+{
+    EdgeMatching = 0, // Combine edges of a piece with edges of the global contour
+    NoFitPolygon = 1  // Bottom-left placement with help of no-fit polygons
+};
+
 enum class BestFrom : qint8
 {
     Rotation = 0,
@@ -112,7 +120,19 @@ struct VBestSquareResData
 struct VCachedPositions
 {
     QRectF boundingRect{};
-    QPainterPath layoutAllowancePath{};
+    VCollisionPolygon layoutAllowance{};
+};
+
+/**
+ * @brief The VLayoutCounters struct collects statistic of nesting. Placement jobs run in parallel, so the counters are
+ * atomic. Each job adds own totals only once at the end.
+ */
+struct VLayoutCounters
+{
+    // Number of checked placement variants (edge engine) or candidate points (no-fit polygon engine)
+    std::atomic<qint64> placements{0};
+    // Number of piece against piece collision checks (edge engine) or point in polygon tests (no-fit polygon engine)
+    std::atomic<qint64> collisionChecks{0};
 };
 
 #endif // VLAYOUTDEF_H
@@ -0,0 +1,384 @@
+/************************************************************************
+ **
+ **  @file   vlayoutexporter.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vlayoutexporter.h"
+
+#include <QFile>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPageLayout>
+#include <QPageSize>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QSvgGenerator>
+#include <QtDebug>
+#include <QtMath>
+
+#include "../vmisc/def.h"
+#include "../vobj/vobjpaintdevice.h"
+#include "../vdxf/vdxfpaintdevice.h"
+#include "../vdxf/dxfdef.h"
+#include "vlayoutpiece.h"
+#include "vpngwriter.h"
+
+namespace
+{
+// Memory for one band of a raster image
+const int maxBandBytes = 32 * 1024 * 1024;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Export writes the sheet in the format.
+ * @param format export format.
+ * @param details pieces of the sheet in layout coordinates.
+ * @return false if the format is not supported or the file could not be written.
+ */
+bool VLayoutExporter::Export(LayoutExportFormats format, const QVector<VLayoutPiece> &details) const
+{
+    switch (format)
+    {
+        case LayoutExportFormats::SVG:
+            return ExportToSVG(details);
+        case LayoutExportFormats::PDF:
+            return ExportToPDF(details);
+        case LayoutExportFormats::PNG:
+            return ExportToPNG(details);
+        case LayoutExportFormats::OBJ:
+            return ExportToOBJ(details);
+        case LayoutExportFormats::DXF_AC1006_Flat:
+            return ExportToFlatDXF(details, DRW::AC1006);
+        case LayoutExportFormats::DXF_AC1009_Flat:
+            return ExportToFlatDXF(details, DRW::AC1009);
+        case LayoutExportFormats::DXF_AC1012_Flat:
+            return ExportToFlatDXF(details, DRW::AC1012);
+        case LayoutExportFormats::DXF_AC1014_Flat:
+            return ExportToFlatDXF(details, DRW::AC1014);
+        case LayoutExportFormats::DXF_AC1015_Flat:
+            return ExportToFlatDXF(details, DRW::AC1015);
+        case LayoutExportFormats::DXF_AC1018_Flat:
+            return ExportToFlatDXF(details, DRW::AC1018);
+        case LayoutExportFormats::DXF_AC1021_Flat:
+            return ExportToFlatDXF(details, DRW::AC1021);
+        case LayoutExportFormats::DXF_AC1024_Flat:
+            return ExportToFlatDXF(details, DRW::AC1024);
+        case LayoutExportFormats::DXF_AC1027_Flat:
+            return ExportToFlatDXF(details, DRW::AC1027);
+        case LayoutExportFormats::DXF_AC1006_AAMA:
+            return ExportToAAMADXF(details, DRW::AC1006);
+        case LayoutExportFormats::DXF_AC1009_AAMA:
+            return ExportToAAMADXF(details, DRW::AC1009);
+        case LayoutExportFormats::DXF_AC1012_AAMA:
+            return ExportToAAMADXF(details, DRW::AC1012);
+        case LayoutExportFormats::DXF_AC1014_AAMA:
+            return ExportToAAMADXF(details, DRW::AC1014);
+        case LayoutExportFormats::DXF_AC1015_AAMA:
+            return ExportToAAMADXF(details, DRW::AC1015);
+        case LayoutExportFormats::DXF_AC1018_AAMA:
+            return ExportToAAMADXF(details, DRW::AC1018);
+        case LayoutExportFormats::DXF_AC1021_AAMA:
+            return ExportToAAMADXF(details, DRW::AC1021);
+        case LayoutExportFormats::DXF_AC1024_AAMA:
+            return ExportToAAMADXF(details, DRW::AC1024);
+        case LayoutExportFormats::DXF_AC1027_AAMA:
+            return ExportToAAMADXF(details, DRW::AC1027);
+        case LayoutExportFormats::DXF_AC1006_ASTM:
+            return ExportToASTMDXF(details, DRW::AC1006);
+        case LayoutExportFormats::DXF_AC1009_ASTM:
+            return ExportToASTMDXF(details, DRW::AC1009);
+        case LayoutExportFormats::DXF_AC1012_ASTM:
+            return ExportToASTMDXF(details, DRW::AC1012);
+        case LayoutExportFormats::DXF_AC1014_ASTM:
+            return ExportToASTMDXF(details, DRW::AC1014);
+        case LayoutExportFormats::DXF_AC1015_ASTM:
+            return ExportToASTMDXF(details, DRW::AC1015);
+        case LayoutExportFormats::DXF_AC1018_ASTM:
+            return ExportToASTMDXF(details, DRW::AC1018);
+        case LayoutExportFormats::DXF_AC1021_ASTM:
+            return ExportToASTMDXF(details, DRW::AC1021);
+        case LayoutExportFormats::DXF_AC1024_ASTM:
+            return ExportToASTMDXF(details, DRW::AC1024);
+        case LayoutExportFormats::DXF_AC1027_ASTM:
+            return ExportToASTMDXF(details, DRW::AC1027);
+        default:
+            qDebug() << "Can't recognize file type." << Q_FUNC_INFO;
+            return false;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutExporter::ExportToSVG(const QVector<VLayoutPiece> &details) const
+{
+    QSvgGenerator generator;
+    generator.setFileName(m_fileName);
+    generator.setSize(QSize(qFloor(m_imageRect.width() * m_xScale + m_margins.left() + m_margins.right()),
+                            qFloor(m_imageRect.height() * m_yScale + m_margins.top() + m_margins.bottom())));
+    generator.setViewBox(QRectF(0, 0, m_imageRect.width() * m_xScale + m_margins.left() + m_margins.right(),
+                                m_imageRect.height() * m_yScale + m_margins.top() + m_margins.bottom()));
+    generator.setTitle(m_title);
+    generator.setDescription(m_description);
+    generator.setResolution(static_cast<int>(PrintDPI));
+
+    QPainter painter;
+    if (not painter.begin(&generator))
+    {
+        return false;
+    }
+    painter.translate(m_margins.left(), m_margins.top());
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setPen(m_pen);
+    painter.setBrush(QBrush(Qt::NoBrush));
+    painter.scale(m_xScale, m_yScale);
+    PaintDetails(&painter, details);
+    return painter.end();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutExporter::ExportToPNG(const QVector<VLayoutPiece> &details) const
+{
+    const qreal dpiScale = m_dpi / PrintDPI;
+    const int width = qFloor((m_imageRect.width() * m_xScale + m_margins.left() + m_margins.right()) * dpiScale);
+    const int height = qFloor((m_imageRect.height() * m_yScale + m_margins.top() + m_margins.bottom()) * dpiScale);
+
+    if (width <= 0 || height <= 0)
+    {
+        qCritical("%s", qUtf8Printable(tr("Can't create image %1. Size is empty.").arg(m_fileName)));
+        return false;
+    }
+
+    QFile file(m_fileName);
+    if (not file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qCritical("%s", qUtf8Printable(tr("Can't open file %1").arg(m_fileName)));
+        return false;
+    }
+
+    // Sheet coordinates to image pixels
+    QTransform matrix;
+    matrix.scale(dpiScale, dpiScale);
+    matrix.translate(m_margins.left(), m_margins.top());
+    matrix.scale(m_xScale, m_yScale);
+    matrix.translate(-m_imageRect.left(), -m_imageRect.top());
+
+    const int bandHeight = qBound(1, maxBandBytes / (width * 4), height);
+    QImage band(width, bandHeight, QImage::Format_RGB32);
+    if (band.isNull())
+    {
+        qCritical("%s", qUtf8Printable(tr("Can't allocate image for %1").arg(m_fileName)));
+        return false;
+    }
+
+    VPngWriter writer(&file, width, height, m_dpi);
+    if (not writer.Begin())
+    {
+        return false;
+    }
+
+    // Lines and labels can go a bit out of the outline of a piece
+    const qreal bandMargin = m_pen.widthF() + ToPixel(1, Unit::Cm);
+
+    for (int top = 0; top < height; top += bandHeight)
+    {
+        const int rows = qMin(bandHeight, height - top);
+        const QRectF bandRect(0, top, width, rows);
+        const QRectF visibleRect = matrix.inverted().mapRect(bandRect).adjusted(-bandMargin, -bandMargin,
+                                                                                  bandMargin, bandMargin);
+        band.fill(Qt::white);
+
+        QPainter painter(&band);
+        painter.translate(0, -top);
+        painter.setClipRect(bandRect);
+        painter.setTransform(matrix, true);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.setPen(m_pen);
+        painter.setBrush(QBrush(Qt::NoBrush));
+
+        for (auto &detail : details)
+        {
+            if (detail.DetailBoundingRect().intersects(visibleRect))
+            {
+                detail.Paint(&painter, m_textAsPaths);
+            }
+        }
+
+        painter.end();
+
+        if (not writer.WriteRows(band, rows))
+        {
+            qCritical("%s", qUtf8Printable(tr("Can't write file %1").arg(m_fileName)));
+            return false;
+        }
+    }
+
+    return writer.End();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutExporter::ExportToPDF(const QVector<VLayoutPiece> &details) const
+{
+    QPdfWriter generator(m_fileName);
+    generator.setCreator(QGuiApplication::applicationDisplayName()+QChar(QChar::Space)+
+                         QCoreApplication::applicationVersion());
+    generator.setTitle(m_title);
+    generator.setResolution(static_cast<int>(PrintDPI));
+
+    const qreal width = FromPixel(m_imageRect.width() * m_xScale + m_margins.left() + m_margins.right(), Unit::Mm);
+    const qreal height = FromPixel(m_imageRect.height() * m_yScale + m_margins.top() + m_margins.bottom(), Unit::Mm);
+
+    if (not generator.setPageSize(QPageSize(QSizeF(width, height), QPageSize::Millimeter)))
+    {
+        qWarning() << tr("Cannot set printer page size");
+    }
+
+    // Margins are a part of the page. Without them the sheet is painted from the corner of the page.
+    QMarginsF margins;
+    if (not m_ignorePrinterMargins)
+    {
+        margins = QMarginsF(FromPixel(m_margins.left(), Unit::Mm), FromPixel(m_margins.top(), Unit::Mm),
+                            FromPixel(m_margins.right(), Unit::Mm), FromPixel(m_margins.bottom(), Unit::Mm));
+    }
+
+    if (not generator.setPageMargins(margins, QPageLayout::Millimeter))
+    {
+        qWarning() << tr("Cannot set printer margins");
+    }
+
+    QPainter painter;
+    if (not painter.begin(&generator))
+    { // failed to open file
+        qCritical("%s", qUtf8Printable(tr("Can't open file %1").arg(m_fileName)));
+        return false;
+    }
+    painter.setFont(QFont(QStringLiteral("Arial"), 8, QFont::Normal));
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setPen(m_pen);
+    painter.setBrush(QBrush(Qt::NoBrush));
+    painter.scale(m_xScale, m_yScale);
+    PaintDetails(&painter, details);
+    return painter.end();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutExporter::ExportToOBJ(const QVector<VLayoutPiece> &details) const
+{
+    VObjPaintDevice generator;
+    generator.setFileName(m_fileName);
+    generator.setSize(m_imageRect.size().toSize());
+    generator.setResolution(static_cast<int>(PrintDPI));
+
+    QPainter painter;
+    if (not painter.begin(&generator))
+    {
+        return false;
+    }
+    painter.setPen(m_pen);
+    PaintDetails(&painter, details);
+    return painter.end();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutExporter::ExportToFlatDXF(const QVector<VLayoutPiece> &details, int dxfVersion) const
+{
+    VDxfPaintDevice generator;
+    generator.setFileName(m_fileName);
+    generator.setSize(QSize(qFloor(m_imageRect.width() * m_xScale), qFloor(m_imageRect.height() * m_yScale)));
+    generator.setResolution(PrintDPI);
+    generator.SetVersion(static_cast<DRW::Version>(dxfVersion));
+    generator.SetBinaryFormat(m_binaryDxfFormat);
+    generator.setInsunits(VarInsunits::Millimeters);// Decided to always use mm. See issue #745
+
+    QPainter painter;
+    if (not painter.begin(&generator))
+    {
+        return false;
+    }
+    painter.setPen(m_pen);
+    painter.scale(m_xScale, m_yScale);
+    // Because QPaintEngine::drawTextItem doesn't pass whole string per time we mark end of each string.
+    PaintDetails(&painter, details, endStringPlaceholder);
+    return painter.end();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutExporter::ExportToAAMADXF(const QVector<VLayoutPiece> &details, int dxfVersion) const
+{
+    VDxfPaintDevice generator;
+    generator.setFileName(m_fileName);
+    generator.setSize(QSize(qCeil(m_imageRect.width() * m_xScale), qCeil(m_imageRect.height() * m_yScale)));
+    generator.setResolution(PrintDPI);
+    generator.SetVersion(static_cast<DRW::Version>(dxfVersion));
+    generator.SetBinaryFormat(m_binaryDxfFormat);
+    generator.setInsunits(VarInsunits::Millimeters);// Decided to always use mm. See issue #745
+    generator.SetXScale(m_xScale);
+    generator.SetYScale(m_yScale);
+    return generator.ExportToAAMA(details);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutExporter::ExportToASTMDXF(const QVector<VLayoutPiece> &details, int dxfVersion) const
+{
+    VDxfPaintDevice generator;
+    generator.setFileName(m_fileName);
+    generator.setSize(m_imageRect.size().toSize());
+    generator.setResolution(PrintDPI);
+    generator.SetVersion(static_cast<DRW::Version>(dxfVersion));
+    generator.SetBinaryFormat(m_binaryDxfFormat);
+    generator.setInsunits(VarInsunits::Millimeters);// Decided to always use mm. See issue #745
+    generator.SetXScale(m_xScale);
+    generator.SetYScale(m_yScale);
+    return generator.ExportToASTM(details);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutExporter::IsSupported(LayoutExportFormats format)
+{
+    switch (format)
+    {
+        case LayoutExportFormats::PS:
+        case LayoutExportFormats::EPS:
+        case LayoutExportFormats::PDFTiled:
+        case LayoutExportFormats::NC:
+        case LayoutExportFormats::COUNT:
+            return false;
+        default:
+            return true;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutExporter::PaintDetails(QPainter *painter, const QVector<VLayoutPiece> &details,
+                                   const QString &endStringPlaceholder) const
+{
+    SCASSERT(painter != nullptr)
+
+    painter->translate(-m_imageRect.topLeft());
+
+    for (auto &detail : details)
+    {
+        detail.Paint(painter, m_textAsPaths, endStringPlaceholder);
+    }
+}
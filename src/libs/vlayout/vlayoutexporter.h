@@ -0,0 +1,271 @@
+/************************************************************************
+ **
+ **  @file   vlayoutexporter.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VLAYOUTEXPORTER_H
+#define VLAYOUTEXPORTER_H
+
+#include <QCoreApplication>
+#include <QMarginsF>
+#include <QPen>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include "../vmisc/defglobal.h"
+#include "vlayoutdef.h"
+
+class QPainter;
+class VLayoutPiece;
+
+/**
+ * @brief The VLayoutExporter class writes one sheet of a layout to a file.
+ *
+ * Pieces are painted directly with QPainter (VLayoutPiece::Paint) on a paint device of the format, so export doesn't
+ * need graphics items, a scene or any widget. A sheet is described by a rectangle in layout coordinates, scale and
+ * margins. PS, EPS and tiled PDF are not supported because they need an external tool or a printer.
+ *
+ * PNG is rendered in horizontal bands and streamed to the file, so a long marker with high resolution needs memory
+ * only for one band. Resolution of PNG is set by DPI, the default matches the layout units one pixel to one pixel.
+ */
+class VLayoutExporter
+{
+    Q_DECLARE_TR_FUNCTIONS(VLayoutExporter)
+public:
+    VLayoutExporter() = default;
+
+    QString FileName() const;
+    void    SetFileName(const QString &fileName);
+
+    QMarginsF Margins() const;
+    void      SetMargins(const QMarginsF &margins);
+
+    QRectF ImageRect() const;
+    void   SetImageRect(const QRectF &imageRect);
+
+    qreal XScale() const;
+    void  SetXScale(qreal xScale);
+
+    qreal YScale() const;
+    void  SetYScale(qreal yScale);
+
+    QString Title() const;
+    void    SetTitle(const QString &title);
+
+    QString Description() const;
+    void    SetDescription(const QString &description);
+
+    QPen Pen() const;
+    void SetPen(const QPen &pen);
+
+    bool IsTextAsPaths() const;
+    void SetTextAsPaths(bool textAsPaths);
+
+    bool IgnorePrinterMargins() const;
+    void SetIgnorePrinterMargins(bool ignorePrinterMargins);
+
+    bool IsBinaryDxfFormat() const;
+    void SetBinaryDxfFormat(bool binaryFormat);
+
+    qreal Dpi() const;
+    void  SetDpi(qreal dpi);
+
+    bool Export(LayoutExportFormats format, const QVector<VLayoutPiece> &details) const;
+
+    bool ExportToSVG(const QVector<VLayoutPiece> &details) const;
+    bool ExportToPNG(const QVector<VLayoutPiece> &details) const;
+    bool ExportToPDF(const QVector<VLayoutPiece> &details) const;
+    bool ExportToOBJ(const QVector<VLayoutPiece> &details) const;
+    bool ExportToFlatDXF(const QVector<VLayoutPiece> &details, int dxfVersion) const;
+    bool ExportToAAMADXF(const QVector<VLayoutPiece> &details, int dxfVersion) const;
+    bool ExportToASTMDXF(const QVector<VLayoutPiece> &details, int dxfVersion) const;
+
+    static bool IsSupported(LayoutExportFormats format);
+
+private:
+    QString   m_fileName{};
+    QMarginsF m_margins{};
+    QRectF    m_imageRect{};
+    qreal     m_xScale{1.0};
+    qreal     m_yScale{1.0};
+    QString   m_title{};
+    QString   m_description{};
+    QPen      m_pen{Qt::black, 1, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin};
+    bool      m_textAsPaths{false};
+    bool      m_ignorePrinterMargins{false};
+    bool      m_binaryDxfFormat{false};
+    qreal     m_dpi{PrintDPI};
+
+    void PaintDetails(QPainter *painter, const QVector<VLayoutPiece> &details,
+                      const QString &endStringPlaceholder = QString()) const;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QString VLayoutExporter::FileName() const
+{
+    return m_fileName;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetFileName(const QString &fileName)
+{
+    m_fileName = fileName;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QMarginsF VLayoutExporter::Margins() const
+{
+    return m_margins;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetMargins(const QMarginsF &margins)
+{
+    m_margins = margins;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QRectF VLayoutExporter::ImageRect() const
+{
+    return m_imageRect;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetImageRect(const QRectF &imageRect)
+{
+    m_imageRect = imageRect;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline qreal VLayoutExporter::XScale() const
+{
+    return m_xScale;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetXScale(qreal xScale)
+{
+    m_xScale = xScale;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline qreal VLayoutExporter::YScale() const
+{
+    return m_yScale;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetYScale(qreal yScale)
+{
+    m_yScale = yScale;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QString VLayoutExporter::Title() const
+{
+    return m_title;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetTitle(const QString &title)
+{
+    m_title = title;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QString VLayoutExporter::Description() const
+{
+    return m_description;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetDescription(const QString &description)
+{
+    m_description = description;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QPen VLayoutExporter::Pen() const
+{
+    return m_pen;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetPen(const QPen &pen)
+{
+    m_pen = pen;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool VLayoutExporter::IsTextAsPaths() const
+{
+    return m_textAsPaths;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetTextAsPaths(bool textAsPaths)
+{
+    m_textAsPaths = textAsPaths;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool VLayoutExporter::IgnorePrinterMargins() const
+{
+    return m_ignorePrinterMargins;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetIgnorePrinterMargins(bool ignorePrinterMargins)
+{
+    m_ignorePrinterMargins = ignorePrinterMargins;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool VLayoutExporter::IsBinaryDxfFormat() const
+{
+    return m_binaryDxfFormat;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetBinaryDxfFormat(bool binaryFormat)
+{
+    m_binaryDxfFormat = binaryFormat;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline qreal VLayoutExporter::Dpi() const
+{
+    return m_dpi;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline void VLayoutExporter::SetDpi(qreal dpi)
+{
+    m_dpi = dpi;
+}
+
+#endif // VLAYOUTEXPORTER_H
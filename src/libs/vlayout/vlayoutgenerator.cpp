@@ -29,17 +29,35 @@
 #include "vlayoutgenerator.h"
 
 #include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFuture>
 #include <QGraphicsRectItem>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QRectF>
+#include <QThread>
 #include <QThreadPool>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <climits>
 
 #include "../vmisc/def.h"
 #include "../vmisc/vmath.h"
 #include "../vmisc/compatibility.h"
 #include "vlayoutpiece.h"
 #include "vlayoutpaper.h"
+#include "vnfpcache.h"
 #include "../ifc/exception/vexceptionterminatedposition.h"
 
+namespace
+{
+// How often multi-start nesting checks workers, msecs.
+const int workersCheckInterval = 50;
+// Rotation by 90 degrees for multi-start workers which start with rotation.
+const int workerRotationNumber = 4;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 VLayoutGenerator::VLayoutGenerator(QObject *parent)
     : QObject(parent),
@@ -80,6 +98,7 @@ VLayoutGenerator::~VLayoutGenerator()
 void VLayoutGenerator::SetDetails(const QVector<VLayoutPiece> &details)
 {
     bank->SetDetails(details);
+    nfpCache.clear();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -119,7 +138,8 @@ void VLayoutGenerator::Generate(const QElapsedTimer &timer, qint64 timeout, Layo
         return;
     }
 
-    if (state != LayoutErrors::Timeout)
+    // A worker can be stopped by the master at any time. Never lose such request.
+    if (state != LayoutErrors::Timeout && not multiStartWorker)
     {
         stopGeneration.store(false);
     }
@@ -135,7 +155,7 @@ void VLayoutGenerator::Generate(const QElapsedTimer &timer, qint64 timeout, Layo
     {
         if (bank->PrepareDetails())
         {
-            SetShift(ToPixel(1, Unit::Cm));
+            SetShift(ToPixel(1, Unit::Cm) / (1 << startShiftLevel));
         }
         else
         {
@@ -165,6 +185,11 @@ void VLayoutGenerator::Generate(const QElapsedTimer &timer, qint64 timeout, Layo
         return;
     }
 
+    if (placementEngine == PlacementEngine::NoFitPolygon && nfpCache.isNull())
+    {
+        nfpCache = QSharedPointer<VNfpCache>(new VNfpCache());
+    }
+
     if (bank->PrepareUnsorted())
     {
         if (HasExpired())
@@ -192,6 +217,9 @@ void VLayoutGenerator::Generate(const QElapsedTimer &timer, qint64 timeout, Layo
             paper.SetRotationNumber(rotationNumber);
             paper.SetSaveLength(saveLength);
             paper.SetOriginPaperPortrait(IsPortrait());
+            paper.SetPlacementEngine(placementEngine);
+            paper.SetNfpCache(nfpCache);
+            paper.SetCounters(counters.data());
             do
             {
                 const int index = bank->GetNext();
@@ -269,6 +297,187 @@ void VLayoutGenerator::Generate(const QElapsedTimer &timer, qint64 timeout, Layo
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GenerateMultiStart run several independent searches of a layout at the same time and keep the best result.
+ *
+ * Each worker is a copy of this generator with own bank. Worker 0 uses exactly the same settings, others start with
+ * another bank ordering, rotation and shift. Each worker repeats generation the same way GUI does it in sequential mode
+ * until time runs out. The best result is the one with the smallest number of sheets and then the highest efficiency.
+ * @param timer nesting timer.
+ * @param timeout nesting time in msecs.
+ * @param progress called in the caller thread each time one of workers finds a layout with better efficiency than all
+ * found before.
+ */
+void VLayoutGenerator::GenerateMultiStart(const QElapsedTimer &timer, qint64 timeout,
+                                          const std::function<void(qreal)> &progress)
+{
+    stopGeneration.store(false);
+    state = LayoutErrors::NoError;
+    papers.clear();
+
+    const int count = qMax(1, QThread::idealThreadCount());
+
+    if (placementEngine == PlacementEngine::NoFitPolygon && nfpCache.isNull())
+    {
+        nfpCache = QSharedPointer<VNfpCache>(new VNfpCache());
+    }
+
+    QVector<QSharedPointer<VLayoutGenerator>> workers;
+    workers.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        workers.append(PrepareWorker(i));
+    }
+
+    // Placement jobs of each worker go to the global pool. Workers themselves must not occupy it or they will wait for
+    // jobs which can never start.
+    QThreadPool pool;
+    pool.setMaxThreadCount(count);
+
+    // Best efficiency of each worker. Workers write it, progress is reported from the check timer.
+    QVector<qreal> efficiencies(count, 0);
+    QMutex efficienciesMutex;
+    qreal reportedEfficiency = 0;
+
+    QVector<QFuture<bool>> futures;
+    futures.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        VLayoutGenerator *w = workers.at(i).data();
+        futures.append(QtConcurrent::run(&pool, [w, i, &timer, timeout, &efficiencies, &efficienciesMutex]()
+        {
+            return w->Search(timer, timeout, [w, i, &efficiencies, &efficienciesMutex]()
+            {
+                const qreal efficiency = w->LayoutEfficiency();
+                QMutexLocker locker(&efficienciesMutex);
+                efficiencies[i] = efficiency;
+            });
+        }));
+    }
+
+    auto ReportProgress = [&efficiencies, &efficienciesMutex, &reportedEfficiency, progress]()
+    {
+        qreal efficiency = 0;
+        {
+            QMutexLocker locker(&efficienciesMutex);
+            efficiency = *std::max_element(efficiencies.cbegin(), efficiencies.cend());
+        }
+
+        if (efficiency > reportedEfficiency)
+        {
+            reportedEfficiency = efficiency;
+            if (progress)
+            {
+                progress(efficiency);
+            }
+        }
+    };
+
+    auto StopWorkers = [this, &workers]()
+    {
+        for (auto &worker : workers)
+        {
+            state == LayoutErrors::ProcessStoped ? worker->Abort() : worker->Timeout();
+        }
+    };
+
+    QEventLoop wait;
+    QTimer check;
+    check.setInterval(workersCheckInterval);
+    connect(&check, &QTimer::timeout, &wait, [this, &futures, &workers, &wait, StopWorkers, ReportProgress]()
+    {
+        ReportProgress();
+
+        bool finished = true;
+        bool enough = false;
+        for (int i = 0; i < futures.size(); ++i)
+        {
+            if (futures.at(i).isFinished())
+            {
+                // One good enough solution is all we need
+                enough = enough || (futures.at(i).result() && not qFuzzyIsNull(efficiencyCoefficient)
+                                    && (not preferOneSheetSolution || workers.at(i)->PapersCount() == 1)
+                                    && workers.at(i)->LayoutEfficiency() >= efficiencyCoefficient);
+            }
+            else
+            {
+                finished = false;
+            }
+        }
+
+        if (finished)
+        {
+            wait.quit();
+        }
+        else if (stopGeneration.load() || enough)
+        {
+            StopWorkers();
+        }
+    });
+    check.start();
+    wait.exec();
+    check.stop();
+    pool.waitForDone();
+
+    int best = -1;
+    int papersCount = INT_MAX;
+    qreal efficiency = 0;
+    for (int i = 0; i < futures.size(); ++i)
+    {
+        if (futures.at(i).result())
+        {
+            const int workerPapers = workers.at(i)->PapersCount();
+            const qreal workerEfficiency = workers.at(i)->LayoutEfficiency();
+            if (workerPapers < papersCount || (workerPapers == papersCount && efficiency < workerEfficiency))
+            {
+                best = i;
+                papersCount = workerPapers;
+                efficiency = workerEfficiency;
+            }
+        }
+    }
+
+    if (best >= 0)
+    {
+        const QSharedPointer<VLayoutGenerator> &worker = workers.at(best);
+        papers = worker->papers;
+        shift = worker->shift;
+        rotate = worker->rotate;
+        rotationNumber = worker->rotationNumber;
+        stripOptimizationEnabled = worker->stripOptimizationEnabled;
+
+        if (state != LayoutErrors::ProcessStoped)
+        {
+            state = LayoutErrors::NoError;
+        }
+    }
+    else if (state == LayoutErrors::NoError)
+    {
+        state = workers.first()->State();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PlacementsCount return number of placements checked by the generator since creation. Includes work of
+ * multi-start workers.
+ */
+qint64 VLayoutGenerator::PlacementsCount() const
+{
+    return counters->placements.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CollisionChecksCount return number of collision checks made by the generator since creation. Includes work
+ * of multi-start workers.
+ */
+qint64 VLayoutGenerator::CollisionChecksCount() const
+{
+    return counters->collisionChecks.load();
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 qreal VLayoutGenerator::LayoutEfficiency() const
 {
@@ -341,10 +550,8 @@ void VLayoutGenerator::Abort()
 void VLayoutGenerator::Timeout()
 {
     stopGeneration.store(true);
-    if (state == LayoutErrors::NoError)
-    {
-        state = LayoutErrors::Timeout;
-    }
+    LayoutErrors expected = LayoutErrors::NoError;
+    state.compare_exchange_strong(expected, LayoutErrors::Timeout);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -732,6 +939,166 @@ VLayoutPaper VLayoutGenerator::MasterPage() const
     return paper;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PrepareWorker create a copy of the generator for multi-start nesting.
+ *
+ * Strategy depends on index. Index 0 keeps the user settings. Next indexes first change bank ordering, then start with
+ * rotation, then start with smaller shift.
+ * @param index worker index.
+ * @return new generator.
+ */
+QSharedPointer<VLayoutGenerator> VLayoutGenerator::PrepareWorker(int index) const
+{
+    QSharedPointer<VLayoutGenerator> worker(new VLayoutGenerator());
+    worker->multiStartWorker = true;
+
+    worker->bank->SetDetails(bank->GetDetails());
+    worker->bank->SetLayoutWidth(bank->GetLayoutWidth());
+    worker->bank->SetManualPriority(bank->GetManualPriority());
+    worker->bank->SetNestQuantity(bank->IsNestQuantity());
+
+    const int casesCount = static_cast<int>(Cases::UnknownCase);
+    worker->bank->SetCaseType(static_cast<Cases>((static_cast<int>(bank->GetCaseType()) + index) % casesCount));
+
+    worker->paperHeight = paperHeight;
+    worker->paperWidth = paperWidth;
+    worker->margins = margins;
+    worker->usePrinterFields = usePrinterFields;
+    worker->shift = shift;
+    worker->rotate = rotate;
+    worker->followGrainline = followGrainline;
+    worker->rotationNumber = rotationNumber;
+    worker->autoCropLength = autoCropLength;
+    worker->autoCropWidth = autoCropWidth;
+    worker->saveLength = saveLength;
+    worker->preferOneSheetSolution = preferOneSheetSolution;
+    worker->unitePages = unitePages;
+    worker->multiplier = multiplier;
+    worker->stripOptimization = stripOptimization;
+    worker->textAsPaths = textAsPaths;
+    worker->nestingTime = nestingTime;
+    worker->efficiencyCoefficient = efficiencyCoefficient;
+    worker->placementEngine = placementEngine;
+    worker->nfpCache = nfpCache; // Workers place the same pieces, the cache is thread safe
+    worker->counters = counters; // Statistic includes work of all workers
+
+    if ((index / casesCount) % 2 == 1 && not worker->rotate && worker->IsRotationNeeded())
+    {
+        worker->rotate = true;
+        worker->rotationNumber = workerRotationNumber;
+    }
+
+    worker->startShiftLevel = index / (casesCount * 2);
+
+    return worker;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Search repeat generation changing shift and rotation until time runs out or the process was stopped.
+ *
+ * Used by the sequential nesting and by each multi-start worker. At the end the generator keeps the best found papers.
+ * @param timer nesting timer.
+ * @param timeout nesting time in msecs.
+ * @param bestFound called each time a better layout was found, while the generator still keeps it.
+ * @return true if at least one layout was found.
+ */
+bool VLayoutGenerator::Search(const QElapsedTimer &timer, qint64 timeout, const std::function<void()> &bestFound)
+{
+    QVector<VLayoutPaper> bestPapers;
+    int papersCount = INT_MAX;
+    qreal efficiency = 0;
+    bool rotationUsed = false;
+    int rotation = rotate ? rotationNumber : 1;
+    LayoutErrors nestingState = LayoutErrors::NoError;
+
+    auto NextRotation = [this, &rotation, &rotationUsed]()
+    {
+        if (IsRotationNeeded())
+        {
+            SetRotate(true);
+            SetRotationNumber(++rotation);
+            rotationUsed = true;
+        }
+    };
+
+    while (not timer.hasExpired(timeout) && not stopGeneration.load())
+    {
+        Generate(timer, timeout, nestingState);
+
+        switch (state.load())
+        {
+            case LayoutErrors::NoError:
+                if (papers.size() <= papersCount)
+                {
+                    const qreal layoutEfficiency = LayoutEfficiency();
+                    if (efficiency < layoutEfficiency || papers.size() < papersCount)
+                    {
+                        efficiency = layoutEfficiency;
+                        papersCount = papers.size();
+                        bestPapers = papers;
+
+                        if (bestFound)
+                        {
+                            bestFound();
+                        }
+                    }
+                    else
+                    {
+                        NextRotation();
+                    }
+                }
+                else
+                {
+                    NextRotation();
+                }
+                SetShift(shift/2.0);
+                break;
+            case LayoutErrors::EmptyPaperError:
+                if (IsRotationNeeded())
+                {
+                    if (not rotationUsed)
+                    {
+                        NextRotation();
+                    }
+                    else
+                    {
+                        SetShift(shift/2.0);
+                        rotationUsed = false;
+                    }
+                }
+                else
+                {
+                    SetShift(shift/2.0);
+                }
+                break;
+            case LayoutErrors::Timeout:
+            case LayoutErrors::PrepareLayoutError:
+            case LayoutErrors::ProcessStoped:
+            case LayoutErrors::TerminatedByException:
+            default:
+                break;
+        }
+
+        nestingState = state;
+
+        if (nestingState == LayoutErrors::PrepareLayoutError || nestingState == LayoutErrors::ProcessStoped
+                || nestingState == LayoutErrors::TerminatedByException
+                || (nestingState == LayoutErrors::NoError && not qFuzzyIsNull(efficiencyCoefficient)
+                    && efficiency >= efficiencyCoefficient))
+        {
+            if (not preferOneSheetSolution || papers.size() == 1)
+            {
+                break;
+            }
+        }
+    }
+
+    papers = bestPapers;
+    return not bestPapers.isEmpty();
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 bool VLayoutGenerator::IsUnitePages() const
 {
@@ -768,6 +1135,30 @@ void VLayoutGenerator::SetPreferOneSheetSolution(bool value)
     preferOneSheetSolution = value;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutGenerator::IsMultiStart() const
+{
+    return multiStart;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutGenerator::SetMultiStart(bool value)
+{
+    multiStart = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+PlacementEngine VLayoutGenerator::GetPlacementEngine() const
+{
+    return placementEngine;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutGenerator::SetPlacementEngine(PlacementEngine engine)
+{
+    placementEngine = engine;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 bool VLayoutGenerator::GetAutoCropLength() const
 {
@@ -36,15 +36,18 @@
 #include <QString>
 #include <QVector>
 #include <QtGlobal>
+#include <functional>
 #include <memory>
 #include <atomic>
 #include <QMargins>
+#include <QSharedPointer>
 
 #include "vbank.h"
 #include "vlayoutdef.h"
 
 class QGraphicsItem;
 class VLayoutPaper;
+class VNfpCache;
 class QElapsedTimer;
 
 class VLayoutGenerator :public QObject
@@ -80,9 +83,16 @@ public:
     void  SetShift(qreal shift);
 
     void Generate(const QElapsedTimer &timer, qint64 timeout, LayoutErrors previousState = LayoutErrors::NoError);
+    void GenerateMultiStart(const QElapsedTimer &timer, qint64 timeout,
+                            const std::function<void(qreal)> &progress = std::function<void(qreal)>());
+    bool Search(const QElapsedTimer &timer, qint64 timeout,
+                const std::function<void()> &bestFound = std::function<void()>());
 
     qreal LayoutEfficiency() const;
 
+    qint64 PlacementsCount() const;
+    qint64 CollisionChecksCount() const;
+
     LayoutErrors State() const;
 
     int PapersCount() const {return papers.size();}
@@ -120,6 +130,12 @@ public:
     bool IsPreferOneSheetSolution() const;
     void SetPreferOneSheetSolution(bool value);
 
+    bool IsMultiStart() const;
+    void SetMultiStart(bool value);
+
+    PlacementEngine GetPlacementEngine() const;
+    void            SetPlacementEngine(PlacementEngine engine);
+
     bool IsUnitePages() const;
     void SetUnitePages(bool value);
 
@@ -149,7 +165,7 @@ private:
     QMarginsF margins;
     bool usePrinterFields;
     std::atomic_bool stopGeneration;
-    LayoutErrors state;
+    std::atomic<LayoutErrors> state;
     qreal shift;
     bool rotate;
     bool followGrainline;
@@ -165,6 +181,12 @@ private:
     bool textAsPaths;
     int nestingTime{1};
     qreal efficiencyCoefficient{0.0};
+    bool multiStart{false};
+    bool multiStartWorker{false};
+    int startShiftLevel{0};
+    PlacementEngine placementEngine{PlacementEngine::EdgeMatching};
+    QSharedPointer<VNfpCache> nfpCache{};
+    QSharedPointer<VLayoutCounters> counters{new VLayoutCounters()};
 
     int PageHeight() const;
     int PageWidth() const;
@@ -175,6 +197,8 @@ private:
     void UnitePapers(int j, QList<qreal> &papersLength, qreal length);
     QList<VLayoutPiece> MoveDetails(qreal length, const QVector<VLayoutPiece> &details) const;
     VLayoutPaper MasterPage() const;
+
+    QSharedPointer<VLayoutGenerator> PrepareWorker(int index) const;
 };
 
 #endif // VLAYOUTGENERATOR_H
@@ -48,6 +48,7 @@
 #include "vlayoutpiece.h"
 #include "vlayoutpaper_p.h"
 #include "vposition.h"
+#include "vnfpposition.h"
 #include "../ifc/exception/vexceptionterminatedposition.h"
 #include "../vmisc/compatibility.h"
 
@@ -220,6 +221,38 @@ void VLayoutPaper::SetOriginPaperPortrait(bool portrait)
     d->originPaperOrientation = portrait;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+PlacementEngine VLayoutPaper::GetPlacementEngine() const
+{
+    return d->placementEngine;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutPaper::SetPlacementEngine(PlacementEngine engine)
+{
+    d->placementEngine = engine;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetNfpCache set cache of no-fit polygons. Sheets of one layout should share the same cache.
+ * @param cache cache.
+ */
+void VLayoutPaper::SetNfpCache(const QSharedPointer<VNfpCache> &cache)
+{
+    d->nfpCache = cache;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetCounters set counters which collect statistic of placement. Counters must live longer than the sheet.
+ * @param counters counters or nullptr if statistic is not needed.
+ */
+void VLayoutPaper::SetCounters(VLayoutCounters *counters)
+{
+    d->counters = counters;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 bool VLayoutPaper::ArrangeDetail(const VLayoutPiece &detail, std::atomic_bool &stop)
 {
@@ -239,6 +272,28 @@ bool VLayoutPaper::ArrangeDetail(const VLayoutPiece &detail, std::atomic_bool &s
         d->localRotationNumber = d->globalRotationNumber;
     }
 
+    if (d->placementEngine == PlacementEngine::NoFitPolygon)
+    {
+        if (d->nfpCache.isNull())
+        {
+            d->nfpCache = QSharedPointer<VNfpCache>(new VNfpCache());
+        }
+
+        VNfpPositionData data;
+        data.detail = detail;
+        data.placements = d->nfpPlacements;
+        data.cache = d->nfpCache;
+        data.width = d->globalContour.GetWidth();
+        data.height = d->globalContour.GetHeight();
+        data.rotate = d->localRotate;
+        data.rotationNumber = d->localRotationNumber;
+        data.followGrainline = d->followGrainline;
+        data.isOriginPaperOrientationPortrait = d->originPaperOrientation;
+        data.counters = d->counters;
+
+        return SaveResult(VNfpPosition::ArrangeDetail(data, &stop), detail);
+    }
+
     VPositionData data;
     data.gContour = d->globalContour;
     data.detail = detail;
@@ -247,6 +302,7 @@ bool VLayoutPaper::ArrangeDetail(const VLayoutPiece &detail, std::atomic_bool &s
     data.followGrainline = d->followGrainline;
     data.positionsCache = d->positionsCache;
     data.isOriginPaperOrientationPortrait = d->originPaperOrientation;
+    data.counters = d->counters;
 
     const VBestSquare result = VPosition::ArrangeDetail(data, &stop, d->saveLength);
     return SaveResult(result, detail);
@@ -285,8 +341,15 @@ bool VLayoutPaper::SaveResult(const VBestSquare &bestResult, const VLayoutPiece
         VCachedPositions positionChache;
         QVector<QPointF> layoutPoints = workDetail.GetLayoutAllowancePoints();
         positionChache.boundingRect = VLayoutPiece::BoundingRect(layoutPoints);
-        positionChache.layoutAllowancePath = VLayoutPiece::PainterPath(layoutPoints);
-        d->positionsCache.append(positionChache);
+        positionChache.layoutAllowance = VCollisionPolygon(layoutPoints);
+
+        if (d->positionsCache.IsEmpty())
+        {
+            const qreal offset = d->layoutWidth * 2;
+            d->positionsCache = VPositionsIndex(QRectF(-offset, -offset, d->globalContour.GetWidth() + offset * 2,
+                                                       d->globalContour.GetHeight() + offset * 2));
+        }
+        d->positionsCache.Append(positionChache);
     }
     else if (bestResult.IsTerminatedByException())
     {
@@ -296,6 +359,30 @@ bool VLayoutPaper::SaveResult(const VBestSquare &bestResult, const VLayoutPiece
     return bestResult.HasValidResult(); // Do we have the best result?
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SaveResult save position found by no-fit polygon engine.
+ *
+ * The engine uses neither the global contour nor the positions cache, so only lists of details and positions are
+ * updated.
+ */
+bool VLayoutPaper::SaveResult(const VNfpResult &result, const VLayoutPiece &detail)
+{
+    if (not result.valid)
+    {
+        return false;
+    }
+
+    VLayoutPiece workDetail = detail;
+    workDetail.SetMatrix(result.matrix);// Don't forget set matrix
+    workDetail.SetMirror(result.mirror);
+
+    d->details.append(workDetail);
+    d->nfpPlacements.append(result.placement);
+
+    return true;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QGraphicsRectItem *VLayoutPaper::GetPaperItem(bool autoCropLength, bool autoCropWidth, bool textAsPaths) const
 {
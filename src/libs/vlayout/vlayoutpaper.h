@@ -35,10 +35,13 @@
 #include <QtGlobal>
 #include <atomic>
 #include <QGraphicsPathItem>
+#include <QSharedPointer>
 
 #include "vlayoutdef.h"
 
 class VBestSquare;
+class VNfpCache;
+struct VNfpResult;
 class VLayoutPaperData;
 class VLayoutPiece;
 class QGraphicsRectItem;
@@ -91,6 +94,13 @@ public:
     bool IsOriginPaperPortrait() const;
     void SetOriginPaperPortrait(bool portrait);
 
+    PlacementEngine GetPlacementEngine() const;
+    void            SetPlacementEngine(PlacementEngine engine);
+
+    void SetNfpCache(const QSharedPointer<VNfpCache> &cache);
+
+    void SetCounters(VLayoutCounters *counters);
+
     bool ArrangeDetail(const VLayoutPiece &detail, std::atomic_bool &stop);
     int  Count() const;
     Q_REQUIRED_RESULT QGraphicsRectItem *GetPaperItem(bool autoCropLength, bool autoCropWidth, bool textAsPaths) const;
@@ -108,6 +118,7 @@ private:
     QSharedDataPointer<VLayoutPaperData> d;
 
     bool SaveResult(const VBestSquare &bestResult, const VLayoutPiece &detail);
+    bool SaveResult(const VNfpResult &result, const VLayoutPiece &detail);
 
 };
 
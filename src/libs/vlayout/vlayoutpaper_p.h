@@ -30,11 +30,14 @@
 #define VLAYOUTPAPER_P_H
 
 #include <QSharedData>
+#include <QSharedPointer>
 #include <QVector>
 #include <QPointF>
 
 #include "vlayoutpiece.h"
 #include "vcontour.h"
+#include "vpositionsindex.h"
+#include "vnfpcache.h"
 
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_GCC("-Weffc++")
@@ -64,7 +67,11 @@ public:
           localRotationNumber(paper.localRotationNumber),
           saveLength(paper.saveLength),
           followGrainline(paper.followGrainline),
-          originPaperOrientation(paper.originPaperOrientation)
+          originPaperOrientation(paper.originPaperOrientation),
+          placementEngine(paper.placementEngine),
+          nfpCache(paper.nfpCache),
+          nfpPlacements(paper.nfpPlacements),
+          counters(paper.counters)
     {}
 
     ~VLayoutPaperData() {}
@@ -72,7 +79,8 @@ public:
     /** @brief details list of arranged details. */
     QVector<VLayoutPiece> details{};
 
-    QVector<VCachedPositions> positionsCache{};
+    /** @brief positionsCache spatial index of arranged details for collision check. */
+    VPositionsIndex positionsCache{};
 
     /** @brief globalContour list of global points contour. */
     VContour globalContour{};
@@ -86,6 +94,16 @@ public:
     bool saveLength{false};
     bool followGrainline{false};
     bool originPaperOrientation{true};
+    PlacementEngine placementEngine{PlacementEngine::EdgeMatching};
+
+    /** @brief nfpCache no-fit polygons shared by all sheets of a generator. */
+    QSharedPointer<VNfpCache> nfpCache{};
+
+    /** @brief nfpPlacements positions of details arranged by no-fit polygon engine. */
+    QVector<VNfpPlacement> nfpPlacements{};
+
+    /** @brief counters statistic of the generator. Not owned. */
+    VLayoutCounters *counters{nullptr};
 
 private:
     Q_DISABLE_ASSIGN(VLayoutPaperData)
@@ -35,9 +35,11 @@
 #include <QFuture>
 #include <QtConcurrent/QtConcurrentRun>
 #include <QGraphicsPathItem>
+#include <QGraphicsSimpleTextItem>
 #include <QList>
 #include <QMatrix>
 #include <QMessageLogger>
+#include <QPainter>
 #include <QPainterPath>
 #include <QPoint>
 #include <QPolygonF>
@@ -51,8 +53,10 @@
 #include "../vmisc/vabstractapplication.h"
 #include "../vmisc/compatibility.h"
 #include "../vpatterndb/vcontainer.h"
-#include "../vpatterndb/calculator.h"
+#include "../vpatterndb/vcalculatorcache.h"
+#include "../qmuparser/qmuparsererror.h"
 #include "../vpatterndb/vpassmark.h"
+#include "../vpatterndb/vpiecegeometry.h"
 #include "../vpatterndb/vpiecenode.h"
 #include "../vgeometry/vpointf.h"
 #include "../vgeometry/vplacelabelitem.h"
@@ -97,8 +101,7 @@ bool FindLabelGeometry(const VPatternLabelData &labelData, const VContainer *pat
 
     try
     {
-        Calculator cal1;
-        rotationAngle = cal1.EvalFormula(pattern->DataVariables(), labelData.GetRotation());
+        rotationAngle = VCalculatorCache::Instance()->EvalFormula(pattern, labelData.GetRotation());
     }
     catch(qmu::QmuParserError &e)
     {
@@ -133,11 +136,9 @@ bool FindLabelGeometry(const VPatternLabelData &labelData, const VContainer *pat
 
     try
     {
-        Calculator cal1;
-        labelWidth = cal1.EvalFormula(pattern->DataVariables(), labelData.GetLabelWidth());
+        labelWidth = VCalculatorCache::Instance()->EvalFormula(pattern, labelData.GetLabelWidth());
 
-        Calculator cal2;
-        labelHeight = cal2.EvalFormula(pattern->DataVariables(), labelData.GetLabelHeight());
+        labelHeight = VCalculatorCache::Instance()->EvalFormula(pattern, labelData.GetLabelHeight());
     }
     catch(qmu::QmuParserError &e)
     {
@@ -245,9 +246,11 @@ QVector<VLayoutPlaceLabel> ConvertPlaceLabels(const VPiece &piece, const VContai
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QVector<VLayoutPassmark> ConvertPassmarks(const VPiece &piece, const VContainer *pattern)
+QVector<VLayoutPassmark> ConvertPassmarks(const VPiece &piece, const VPieceGeometry &geometry,
+                                          const VContainer *pattern)
 {
-    const QVector<VPassmark> passmarks = piece.Passmarks(pattern);
+    const QVector<VPassmark> passmarks = geometry.Passmarks();
+    const QVector<VPieceNode> path = piece.GetUnitedPath(pattern);
     QVector<VLayoutPassmark> layoutPassmarks;
     for(auto &passmark : passmarks)
     {
@@ -255,15 +258,14 @@ QVector<VLayoutPassmark> ConvertPassmarks(const VPiece &piece, const VContainer
         {
             VPiecePassmarkData pData = passmark.Data();
 
-            auto PreapreBuiltInSAPassmark = [pData, passmark, piece, &layoutPassmarks, pattern]()
+            auto PreapreBuiltInSAPassmark = [pData, passmark, piece, &layoutPassmarks, &path, &geometry]()
             {
                 VLayoutPassmark layoutPassmark;
 
-                const QVector<VPieceNode> path = piece.GetUnitedPath(pattern);
                 const int nodeIndex = VPiecePath::indexOfNode(path, pData.id);
                 if (nodeIndex != -1)
                 {
-                    layoutPassmark.lines = passmark.BuiltInSAPassmark(piece, pattern);
+                    layoutPassmark.lines = passmark.BuiltInSAPassmark(piece, geometry.MainPath());
                     layoutPassmark.baseLine = ConstFirst (passmark.BuiltInSAPassmarkBaseLine(piece));
                     layoutPassmark.type = pData.passmarkLineType;
                     layoutPassmark.isBuiltIn = true;
@@ -280,7 +282,7 @@ QVector<VLayoutPassmark> ConvertPassmarks(const VPiece &piece, const VContainer
                 }
             };
 
-            auto PrepareSAPassmark = [pData, passmark, piece, &layoutPassmarks, pattern](PassmarkSide side)
+            auto PrepareSAPassmark = [pData, passmark, piece, &layoutPassmarks, &path, &geometry](PassmarkSide side)
             {
                 QT_WARNING_PUSH
                 QT_WARNING_DISABLE_GCC("-Wnoexcept")
@@ -290,12 +292,12 @@ QVector<VLayoutPassmark> ConvertPassmarks(const VPiece &piece, const VContainer
 
                 QT_WARNING_POP
 
-                const QVector<VPieceNode> path = piece.GetUnitedPath(pattern);
                 const int nodeIndex = VPiecePath::indexOfNode(path, pData.id);
                 if (nodeIndex != -1)
                 {
-                    QVector<QLineF> lines =
-                            passmark.SAPassmarkBaseLine(piece, pattern, static_cast<PassmarkSide>(side));
+                    // Seam allowance of the passmark is already calculated and rotated
+                    const QVector<QPointF> seamAllowance = geometry.SeamAllowanceWithRotation(pData.passmarkIndex);
+                    QVector<QLineF> lines = passmark.SAPassmarkBaseLine(seamAllowance, static_cast<PassmarkSide>(side));
 
                     if (side == PassmarkSide::All || side == PassmarkSide::Right)
                     {
@@ -305,7 +307,7 @@ QVector<VLayoutPassmark> ConvertPassmarks(const VPiece &piece, const VContainer
                     {
                         layoutPassmark.baseLine = lines.last();
                     }
-                    layoutPassmark.lines = passmark.SAPassmark(piece, pattern, side);
+                    layoutPassmark.lines = passmark.SAPassmark(seamAllowance, side);
                     layoutPassmark.type = pData.passmarkLineType;
                     layoutPassmark.isBuiltIn = false;
 
@@ -439,13 +441,23 @@ VLayoutPiece::~VLayoutPiece()
 //---------------------------------------------------------------------------------------------------------------------
 VLayoutPiece VLayoutPiece::Create(const VPiece &piece, vidtype id, const VContainer *pattern)
 {
-    QFuture<QVector<QPointF> > futureSeamAllowance = QtConcurrent::run(piece, &VPiece::SeamAllowancePoints, pattern);
-    QFuture<bool> futureSeamAllowanceValid = QtConcurrent::run(piece, &VPiece::IsSeamAllowanceValid, pattern);
-    QFuture<QVector<QPointF> > futureMainPath = QtConcurrent::run(piece, &VPiece::MainPathPoints, pattern);
+    return Create(piece, id, pattern, VPieceGeometry());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Create create a layout piece using geometry calculated by the piece tool.
+ *
+ * Null geometry is calculated here.
+ */
+VLayoutPiece VLayoutPiece::Create(const VPiece &piece, vidtype id, const VContainer *pattern,
+                                  const VPieceGeometry &pieceGeometry)
+{
     QFuture<QVector<VLayoutPiecePath> > futureInternalPaths = QtConcurrent::run(ConvertInternalPaths, piece, pattern);
-    QFuture<QVector<VLayoutPassmark> > futurePassmarks = QtConcurrent::run(ConvertPassmarks, piece, pattern);
     QFuture<QVector<VLayoutPlaceLabel> > futurePlaceLabels = QtConcurrent::run(ConvertPlaceLabels, piece, pattern);
 
+    const VPieceGeometry geometry = pieceGeometry.IsNull() ? VPieceGeometry::Create(piece, pattern) : pieceGeometry;
+
     VLayoutPiece det;
 
     det.SetMx(piece.GetMx());
@@ -458,7 +470,7 @@ VLayoutPiece VLayoutPiece::Create(const VPiece &piece, vidtype id, const VContai
     det.SetForceFlipping(piece.IsForceFlipping());
     det.SetId(id);
 
-    if (not futureSeamAllowanceValid.result())
+    if (not geometry.IsSeamAllowanceValid())
     {
         const QString errorMsg = QObject::tr("Piece '%1'. Seam allowance is not valid.")
                 .arg(piece.GetName());
@@ -466,11 +478,11 @@ VLayoutPiece VLayoutPiece::Create(const VPiece &piece, vidtype id, const VContai
                              qWarning() << VAbstractApplication::patternMessageSignature + errorMsg;
     }
 
-    det.SetCountourPoints(futureMainPath.result(),
+    det.SetCountourPoints(geometry.MainPath(),
                           qApp->Settings()->IsPieceShowMainPath() ? false : piece.IsHideMainPath());
-    det.SetSeamAllowancePoints(futureSeamAllowance.result(), piece.IsSeamAllowance(), piece.IsSeamAllowanceBuiltIn());
+    det.SetSeamAllowancePoints(geometry.SeamAllowance(), piece.IsSeamAllowance(), piece.IsSeamAllowanceBuiltIn());
     det.SetInternalPaths(futureInternalPaths.result());
-    det.SetPassmarks(futurePassmarks.result());
+    det.SetPassmarks(ConvertPassmarks(piece, geometry, pattern));
     det.SetPlaceLabels(futurePlaceLabels.result());
     det.SetPriority(piece.GetPriority());
 
@@ -554,7 +566,8 @@ QVector<VLayoutPassmark> VLayoutPiece::Map<VLayoutPassmark>(QVector<VLayoutPassm
 // cppcheck-suppress unusedFunction
 QVector<QPointF> VLayoutPiece::GetMappedContourPoints() const
 {
-    return Map(d->contour);
+    const VMappedGeometry geometry = MappedGeometry();
+    return geometry.contour.Translated(geometry.offset);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -568,13 +581,15 @@ void VLayoutPiece::SetCountourPoints(const QVector<QPointF> &points, bool hideMa
 {
     d->contour = RemoveDublicates(points, false);
     SetHideMainPath(hideMainPath);
+    ResetCache();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 // cppcheck-suppress unusedFunction
 QVector<QPointF> VLayoutPiece::GetMappedSeamAllowancePoints() const
 {
-    return Map(d->seamAllowance);
+    const VMappedGeometry geometry = MappedGeometry();
+    return geometry.seamAllowance.Translated(geometry.offset);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -600,13 +615,15 @@ void VLayoutPiece::SetSeamAllowancePoints(const QVector<QPointF> &points, bool s
             qWarning()<<"Seam allowance is empty.";
             SetSeamAllowance(false);
         }
+        ResetCache();
     }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 QVector<QPointF> VLayoutPiece::GetLayoutAllowancePoints() const
 {
-    return Map(d->layoutAllowance);
+    const VMappedGeometry geometry = MappedGeometry();
+    return geometry.layoutAllowance.Translated(geometry.offset);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -906,26 +923,30 @@ int VLayoutPiece::LayoutEdgesCount() const
 //---------------------------------------------------------------------------------------------------------------------
 QLineF VLayoutPiece::LayoutEdge(int i) const
 {
-    return Edge(d->layoutAllowance, i);
+    const VMappedGeometry geometry = MappedGeometry();
+    return Edge(geometry.layoutAllowance, geometry.offset, i);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 int VLayoutPiece::LayoutEdgeByPoint(const QPointF &p1) const
 {
-    return EdgeByPoint(d->layoutAllowance, p1);
+    const VMappedGeometry geometry = MappedGeometry();
+    return EdgeByPoint(geometry.layoutAllowance, geometry.offset, p1);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 QRectF VLayoutPiece::DetailBoundingRect() const
 {
-    return IsSeamAllowance() && not IsSeamAllowanceBuiltIn() ? BoundingRect(GetMappedSeamAllowancePoints()) :
-                                                               BoundingRect(GetMappedContourPoints());
+    const VMappedGeometry geometry = MappedGeometry();
+    return IsSeamAllowance() && not IsSeamAllowanceBuiltIn() ? geometry.seamAllowance.BoundingRect(geometry.offset) :
+                                                               geometry.contour.BoundingRect(geometry.offset);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 QRectF VLayoutPiece::LayoutBoundingRect() const
 {
-    return BoundingRect(GetLayoutAllowancePoints());
+    const VMappedGeometry geometry = MappedGeometry();
+    return geometry.layoutAllowance.BoundingRect(geometry.offset);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -994,6 +1015,8 @@ void VLayoutPiece::SetLayoutAllowancePoints()
     {
         d->layoutAllowance.clear();
     }
+
+    ResetCache();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -1129,29 +1152,152 @@ QPainterPath VLayoutPiece::PainterPath(const QVector<QPointF> &points)
 //---------------------------------------------------------------------------------------------------------------------
 QGraphicsItem *VLayoutPiece::GetItem(bool textAsPaths) const
 {
-    QGraphicsPathItem *item = GetMainItem();
+    QGraphicsPathItem *item = nullptr;
 
-    for (auto &path : d->m_internalPaths)
+    auto CreateShape = [&item](const QPainterPath &path, ShapeType type, Qt::PenStyle style)
     {
-        QGraphicsPathItem* pathItem = new QGraphicsPathItem(item);
-        pathItem->setPath(d->matrix.map(path.GetPainterPath()));
+        if (type == ShapeType::Contour)
+        {
+            item = new QGraphicsPathItem();
+            item->setPath(path);
+            return;
+        }
 
-        QPen pen = pathItem->pen();
-        pen.setStyle(path.PenStyle());
-        pathItem->setPen(pen);
+        SCASSERT(item != nullptr)
+
+        QGraphicsPathItem *pathItem = type == ShapeType::Fill ? new VGraphicsFillItem(item)
+                                                              : new QGraphicsPathItem(item);
+        pathItem->setPath(path);
+
+        if (type == ShapeType::Text)
+        {
+            pathItem->setBrush(QBrush(Qt::black));
+        }
+        else if (style != Qt::SolidLine)
+        {
+            QPen pen = pathItem->pen();
+            pen.setStyle(style);
+            pathItem->setPen(pen);
+        }
+    };
+
+    auto CreateText = [&item](const QFont &fnt, const QString &qsText, const QTransform &labelMatrix)
+    {
+        SCASSERT(item != nullptr)
+
+        QGraphicsSimpleTextItem* textItem = new QGraphicsSimpleTextItem(item);
+        textItem->setFont(fnt);
+        textItem->setText(qsText);
+        textItem->setTransform(labelMatrix);
+    };
+
+    Draw(textAsPaths, CreateShape, CreateText);
+
+    return item;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Paint draws the piece with the painter the same way as the item from GetItem() is drawn on a scene.
+ *
+ * Allows to render a layout on any paint device without creating graphics items and a scene.
+ * @param painter painter with pen for lines.
+ * @param textAsPaths draw label strings as paths.
+ * @param endStringPlaceholder string appended to each label string. DXF engine uses it to find the end of a string.
+ */
+void VLayoutPiece::Paint(QPainter *painter, bool textAsPaths, const QString &endStringPlaceholder) const
+{
+    SCASSERT(painter != nullptr)
+
+    painter->save();
+    const QPen pen = painter->pen();
+
+    auto DrawShape = [painter, pen](const QPainterPath &path, ShapeType type, Qt::PenStyle style)
+    {
+        QPen shapePen = pen;
+        shapePen.setStyle(style);
+        painter->setPen(shapePen);
+
+        if (type == ShapeType::Text)
+        {
+            painter->setBrush(QBrush(Qt::black));
+        }
+        else if (type == ShapeType::Fill)
+        {
+            painter->setBrush(pen.color());
+        }
+        else
+        {
+            painter->setBrush(QBrush(Qt::NoBrush));
+        }
+
+        painter->drawPath(path);
+    };
+
+    auto DrawText = [painter, pen, endStringPlaceholder](const QFont &fnt, const QString &qsText,
+                                                         const QTransform &labelMatrix)
+    {
+        painter->save();
+        painter->setPen(pen);
+        painter->setTransform(labelMatrix, true);
+        // Simple text item puts top left corner of the text in the origin
+        painter->setFont(fnt);
+        painter->drawText(QPointF(0, QFontMetrics(fnt).ascent()), qsText + endStringPlaceholder);
+        painter->restore();
+    };
+
+    Draw(textAsPaths, DrawShape, DrawText);
+
+    painter->restore();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Draw passes each part of the piece to the callbacks in the drawing order.
+ *
+ * GetItem() and Paint() both draw the piece through this method, so a scene and a paint device get the same picture.
+ * @param textAsPaths label strings are converted to paths and passed as shapes.
+ * @param shape callback for a path in layout coordinates, its type and pen style. The contour always comes first.
+ * @param text callback for a label string with its font and matrix in layout coordinates.
+ */
+void VLayoutPiece::Draw(bool textAsPaths,
+                        const std::function<void (const QPainterPath &, ShapeType, Qt::PenStyle)> &shape,
+                        const std::function<void (const QFont &, const QString &, const QTransform &)> &text) const
+{
+    shape(ContourPath(), ShapeType::Contour, Qt::SolidLine);
+
+    for (auto &path : d->m_internalPaths)
+    {
+        shape(d->matrix.map(path.GetPainterPath()), ShapeType::Line, path.PenStyle());
     }
 
     for (auto &label : d->m_placeLabels)
     {
-        QGraphicsPathItem* pathItem = new QGraphicsPathItem(item);
-        pathItem->setPath(d->matrix.map(VPlaceLabelItem::LabelShapePath(label.shape)));
+        shape(d->matrix.map(VPlaceLabelItem::LabelShapePath(label.shape)), ShapeType::Line, Qt::SolidLine);
     }
 
-    CreateLabelStrings(item, d->detailLabel, d->m_tmDetail, textAsPaths);
-    CreateLabelStrings(item, d->patternInfo, d->m_tmPattern, textAsPaths);
-    CreateGrainlineItem(item);
+    auto LabelString = [textAsPaths, &shape, &text](const QFont &fnt, const QString &qsText,
+                                                    const QTransform &labelMatrix)
+    {
+        if (textAsPaths)
+        {
+            QPainterPath path;
+            path.addText(0, - static_cast<qreal>(QFontMetrics(fnt).ascent())/6., fnt, qsText);
+            shape(labelMatrix.map(path), ShapeType::Text, Qt::SolidLine);
+        }
+        else
+        {
+            text(fnt, qsText, labelMatrix);
+        }
+    };
+
+    LabelStrings(d->detailLabel, d->m_tmDetail, textAsPaths, LabelString);
+    LabelStrings(d->patternInfo, d->m_tmPattern, textAsPaths, LabelString);
 
-    return item;
+    if (d->grainlineEnabled && d->grainlinePoints.count() >= 2)
+    {
+        shape(GrainlinePath(), ShapeType::Fill, Qt::SolidLine);
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -1184,18 +1330,24 @@ qreal VLayoutPiece::BiggestEdge() const
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QRectF VLayoutPiece::BoundingRect(QVector<QPointF> points)
+QRectF VLayoutPiece::BoundingRect(const QVector<QPointF> &points)
 {
-    points.append(points.first());
+    // Closing point doesn't change the rect, so no need to copy the vector for it
     return QPolygonF(points).boundingRect();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void VLayoutPiece::CreateLabelStrings(QGraphicsItem *parent, const QVector<QPointF> &labelShape,
-                                      const VTextManager &tm, bool textAsPaths) const
+/**
+ * @brief LabelStrings lays out lines of a label and passes each visible line to the callback.
+ * @param labelShape label rectangle.
+ * @param tm text manager with the lines.
+ * @param textAsPaths text will be drawn as paths. Changes vertical position of lines.
+ * @param label callback that receives font, text and matrix of a line in layout coordinates.
+ */
+void VLayoutPiece::LabelStrings(const QVector<QPointF> &labelShape, const VTextManager &tm, bool textAsPaths,
+                                const std::function<void (const QFont &, const QString &,
+                                                          const QTransform &)> &label) const
 {
-    SCASSERT(parent != nullptr)
-
     if (labelShape.count() > 2)
     {
         const qreal dW = QLineF(labelShape.at(0), labelShape.at(1)).length();
@@ -1274,42 +1426,16 @@ void VLayoutPiece::CreateLabelStrings(QGraphicsItem *parent, const QVector<QPoin
 
             labelMatrix *= d->matrix;
 
-            if (textAsPaths)
-            {
-                QPainterPath path;
-                path.addText(0, - static_cast<qreal>(fm.ascent())/6., fnt, qsText);
-
-                QGraphicsPathItem* item = new QGraphicsPathItem(parent);
-                item->setPath(path);
-                item->setBrush(QBrush(Qt::black));
-                item->setTransform(labelMatrix);
-
-                dY += tm.GetSpacing();
-            }
-            else
-            {
-                QGraphicsSimpleTextItem* item = new QGraphicsSimpleTextItem(parent);
-                item->setFont(fnt);
-                item->setText(qsText);
-                item->setTransform(labelMatrix);
+            label(fnt, qsText, labelMatrix);
 
-                dY += (fm.height() + tm.GetSpacing());
-            }
+            dY += textAsPaths ? tm.GetSpacing() : fm.height() + tm.GetSpacing();
         }
     }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void VLayoutPiece::CreateGrainlineItem(QGraphicsItem *parent) const
+QPainterPath VLayoutPiece::GrainlinePath() const
 {
-    SCASSERT(parent != nullptr)
-
-    if (not d->grainlineEnabled || d->grainlinePoints.count() < 2)
-    {
-        return;
-    }
-    VGraphicsFillItem* item = new VGraphicsFillItem(parent);
-
     QPainterPath path;
 
     QVector<QPointF> gPoints = GetGrainline();
@@ -1318,7 +1444,7 @@ void VLayoutPiece::CreateGrainlineItem(QGraphicsItem *parent) const
     {
         path.lineTo(p);
     }
-    item->setPath(path);
+    return path;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -1334,14 +1460,6 @@ QVector<QPointF> VLayoutPiece::DetailPath() const
     }
 }
 
-//---------------------------------------------------------------------------------------------------------------------
-QGraphicsPathItem *VLayoutPiece::GetMainItem() const
-{
-    QGraphicsPathItem *item = new QGraphicsPathItem();
-    item->setPath(ContourPath());
-    return item;
-}
-
 //---------------------------------------------------------------------------------------------------------------------
 QGraphicsPathItem *VLayoutPiece::GetMainPathItem() const
 {
@@ -1376,7 +1494,26 @@ void VLayoutPiece::SetMirror(bool value)
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QLineF VLayoutPiece::Edge(const QVector<QPointF> &path, int i) const
+/**
+ * @brief MappedGeometry return paths mapped by the piece matrix. Paths for each orientation are calculated only once
+ * and shared by all copies of the piece.
+ */
+VMappedGeometry VLayoutPiece::MappedGeometry() const
+{
+    return d->m_cache->Geometry(d->matrix, d->mirror, d->contour, d->seamAllowance, d->layoutAllowance);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ResetCache detach the piece from the cache of mapped paths. Call after changing points.
+ */
+void VLayoutPiece::ResetCache()
+{
+    d->m_cache.reset(new VLayoutPieceCache());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QLineF VLayoutPiece::Edge(const VMappedPath &path, const QPointF &offset, int i)
 {
     if (i < 1)
     { // Doesn't exist such edge
@@ -1384,48 +1521,39 @@ QLineF VLayoutPiece::Edge(const QVector<QPointF> &path, int i) const
     }
 
     int i1, i2;
-    if (i < path.count())
+    if (i < path.points.count())
     {
         i1 = i-1;
         i2 = i;
     }
     else
     {
-        i1 = path.count()-1;
+        i1 = path.points.count()-1;
         i2 = 0;
     }
 
-    if (d->mirror)
-    {
-        QVector<QPointF> newPath = Map(path);
-        return QLineF(newPath.at(i1), newPath.at(i2));
-    }
-    else
-    {
-        return QLineF(d->matrix.map(path.at(i1)), d->matrix.map(path.at(i2)));
-    }
+    return QLineF(path.points.at(i1) + offset, path.points.at(i2) + offset);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-int VLayoutPiece::EdgeByPoint(const QVector<QPointF> &path, const QPointF &p1) const
+int VLayoutPiece::EdgeByPoint(const VMappedPath &path, const QPointF &offset, const QPointF &p1)
 {
     if (p1.isNull())
     {
         return 0;
     }
 
-    if (path.count() < 3)
+    if (path.points.count() < 3)
     {
         return 0;
     }
 
-    const QVector<QPointF> points = Map(path);
-    for (int i=0; i < points.size(); i++)
+    for (int i=0; i < path.points.size(); i++)
     {
-        if (VFuzzyComparePoints(points.at(i), p1))
+        if (VFuzzyComparePoints(path.points.at(i) + offset, p1))
         {
             int pos = i+1;
-            if (pos > points.size())
+            if (pos > path.points.size())
             {
                 pos = 1;
             }
@@ -41,17 +41,22 @@
 #include <QVector>
 #include <QtGlobal>
 #include <QCoreApplication>
+#include <functional>
 
 #include "vabstractpiece.h"
 #include "../vmisc/typedef.h"
 #include "../vpatterndb/floatItemData/floatitemdef.h"
 
 class VLayoutPieceData;
+struct VMappedGeometry;
+struct VMappedPath;
 class VLayoutPiecePath;
 class QGraphicsItem;
 class QGraphicsPathItem;
+class QPainter;
 class VTextManager;
 class VPiece;
+class VPieceGeometry;
 class VPieceLabelData;
 class VAbstractPattern;
 class VPatternLabelData;
@@ -72,6 +77,8 @@ public:
 #endif
 
     static VLayoutPiece Create(const VPiece &piece, vidtype id, const VContainer *pattern);
+    static VLayoutPiece Create(const VPiece &piece, vidtype id, const VContainer *pattern,
+                               const VPieceGeometry &pieceGeometry);
 
     QVector<QPointF> GetMappedContourPoints() const;
     QVector<QPointF> GetContourPoints() const;
@@ -141,7 +148,7 @@ public:
     QRectF LayoutBoundingRect() const;
     qreal  Diagonal() const;
 
-    static QRectF BoundingRect(QVector<QPointF> points);
+    static QRectF BoundingRect(const QVector<QPointF> &points);
 
     bool isNull() const;
     qint64 Square() const;
@@ -152,6 +159,7 @@ public:
     static QPainterPath PainterPath(const QVector<QPointF> &points);
 
     Q_REQUIRED_RESULT QGraphicsItem *GetItem(bool textAsPaths) const;
+    void Paint(QPainter *painter, bool textAsPaths, const QString &endStringPlaceholder = QString()) const;
 
     bool IsLayoutAllowanceValid() const;
 
@@ -159,24 +167,37 @@ public:
 
     friend QDataStream& operator<< (QDataStream& dataStream, const VLayoutPiece& piece);
     friend QDataStream& operator>> (QDataStream& dataStream, VLayoutPiece& piece);
+    friend class VLayoutPieceSnapshot;
 
 private:
     QSharedDataPointer<VLayoutPieceData> d;
 
+    enum class ShapeType : qint8
+    {
+        Contour = 0, // Outline of the piece, always comes first
+        Line = 1,    // Internal paths and place labels, drawn with own pen style
+        Text = 2,    // Label string converted to a path, filled with black color
+        Fill = 3     // Grainline, filled with color of the pen
+    };
+
     QVector<QPointF> DetailPath() const;
 
-    Q_REQUIRED_RESULT QGraphicsPathItem *GetMainItem() const;
     Q_REQUIRED_RESULT QGraphicsPathItem *GetMainPathItem() const;
 
-    void CreateLabelStrings(QGraphicsItem *parent, const QVector<QPointF> &labelShape, const VTextManager &tm,
-                            bool textAsPaths) const;
-    void CreateGrainlineItem(QGraphicsItem *parent) const;
+    void Draw(bool textAsPaths, const std::function<void (const QPainterPath &, ShapeType, Qt::PenStyle)> &shape,
+              const std::function<void (const QFont &, const QString &, const QTransform &)> &text) const;
+    void LabelStrings(const QVector<QPointF> &labelShape, const VTextManager &tm, bool textAsPaths,
+                      const std::function<void (const QFont &, const QString &, const QTransform &)> &label) const;
+    QPainterPath GrainlinePath() const;
 
     template <class T>
     QVector<T> Map(QVector<T> points) const;
 
-    QLineF Edge(const QVector<QPointF> &path, int i) const;
-    int    EdgeByPoint(const QVector<QPointF> &path, const QPointF &p1) const;
+    VMappedGeometry MappedGeometry() const;
+    void            ResetCache();
+
+    static QLineF Edge(const VMappedPath &path, const QPointF &offset, int i);
+    static int    EdgeByPoint(const VMappedPath &path, const QPointF &offset, const QPointF &p1);
 };
 
 Q_DECLARE_TYPEINFO(VLayoutPiece, Q_MOVABLE_TYPE);
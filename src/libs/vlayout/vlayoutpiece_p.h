@@ -33,6 +33,7 @@
 #include <QPointF>
 #include <QVector>
 #include <QTransform>
+#include <QSharedPointer>
 
 #include "../vpatterndb/floatItemData/vpiecelabeldata.h"
 #include "../vpatterndb/floatItemData/vpatternlabeldata.h"
@@ -44,6 +45,7 @@
 #include "vlayoutpiecepath.h"
 #include "../vgeometry/vgeometrydef.h"
 #include "vtextmanager.h"
+#include "vlayoutpiececache.h"
 #include "../ifc/exception/vexception.h"
 
 QT_WARNING_PUSH
@@ -77,7 +79,8 @@ public:
           m_placeLabels(detail.m_placeLabels),
           m_square(detail.m_square),
           m_quantity(detail.m_quantity),
-          m_id(detail.m_id)
+          m_id(detail.m_id),
+          m_cache(detail.m_cache)
     {}
 
     ~VLayoutPieceData() Q_DECL_EQ_DEFAULT;
@@ -137,6 +140,9 @@ public:
     /** @brief m_id keep id of original piece. */
     vidtype                   m_id;
 
+    /** @brief m_cache mapped paths shared by all copies of the piece. Replace it after changing points. */
+    QSharedPointer<VLayoutPieceCache> m_cache{new VLayoutPieceCache()};
+
 private:
     Q_DISABLE_ASSIGN(VLayoutPieceData)
 
@@ -224,6 +230,8 @@ inline QDataStream &operator>>(QDataStream &dataStream, VLayoutPieceData &piece)
         dataStream >> piece.m_id;
     }
 
+    piece.m_cache.reset(new VLayoutPieceCache());
+
     return dataStream;
 }
 
@@ -0,0 +1,269 @@
+/************************************************************************
+ **
+ **  @file   vlayoutpiececache.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vlayoutpiececache.h"
+
+#include <QPair>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+// Limit for points kept by one piece. Combining edges gives a new angle almost for each pair of edges, the cache must
+// not grow without end.
+const int maxPointsCount = 1 << 16;
+// When the cache is full, drop old orientations until this part of the limit is free.
+const int freePointsCount = maxPointsCount / 4;
+
+//---------------------------------------------------------------------------------------------------------------------
+inline quint64 Bits(qreal value)
+{
+    quint64 bits = 0;
+    std::memcpy(&bits, &value, sizeof bits);
+    return bits;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Translated return points moved on offset.
+ */
+QVector<QPointF> VMappedPath::Translated(const QPointF &offset) const
+{
+    if (offset.isNull())
+    {
+        return points;
+    }
+
+    QVector<QPointF> translated = points;
+    for (auto &point : translated)
+    {
+        point += offset;
+    }
+    return translated;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BoundingRect return bounding rectangle of points moved on offset.
+ *
+ * Result is equal to QPolygonF::boundingRect() for translated points.
+ */
+QRectF VMappedPath::BoundingRect(const QPointF &offset) const
+{
+    if (points.isEmpty())
+    {
+        return QRectF(0, 0, 0, 0);
+    }
+
+    const QPointF min = minimum + offset;
+    const QPointF max = maximum + offset;
+    return QRectF(min.x(), min.y(), max.x() - min.x(), max.y() - min.y());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutPieceCache::Key::operator==(const Key &other) const
+{
+    return m11 == other.m11 && m12 == other.m12 && m21 == other.m21 && m22 == other.m22 && mirror == other.mirror;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+uint qHash(const VLayoutPieceCache::Key &key, uint seed)
+{
+    return qHash(key.m11, seed) ^ qHash(key.m12, seed) ^ qHash(key.m21, seed) ^ qHash(key.m22, seed)
+            ^ qHash(key.mirror, seed);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Geometry return paths of a piece for the matrix.
+ * @param matrix piece matrix.
+ * @param mirror piece mirror flag.
+ * @param contour contour points.
+ * @param seamAllowance seam allowance points.
+ * @param layoutAllowance layout allowance points.
+ * @return mapped paths and translation which should be added.
+ */
+VMappedGeometry VLayoutPieceCache::Geometry(const QTransform &matrix, bool mirror, const QVector<QPointF> &contour,
+                                            const QVector<QPointF> &seamAllowance,
+                                            const QVector<QPointF> &layoutAllowance)
+{
+    if (matrix.type() == QTransform::TxProject)
+    {// Translation part cannot be separated
+        VMappedGeometry geometry;
+        geometry.contour = MapPath(contour, matrix, mirror);
+        geometry.seamAllowance = MapPath(seamAllowance, matrix, mirror);
+        geometry.layoutAllowance = MapPath(layoutAllowance, matrix, mirror);
+        return geometry;
+    }
+
+    Key key;
+    key.m11 = Bits(matrix.m11());
+    key.m12 = Bits(matrix.m12());
+    key.m21 = Bits(matrix.m21());
+    key.m22 = Bits(matrix.m22());
+    key.mirror = mirror;
+
+    const QPointF offset(matrix.dx(), matrix.dy());
+
+    {
+        QReadLocker locker(&m_lock);
+        auto i = m_geometry.constFind(key);
+        if (i != m_geometry.constEnd())
+        {
+            ++m_hits;
+            i.value()->lastUse.store(++m_clock);
+            VMappedGeometry geometry = i.value()->geometry;
+            geometry.offset = offset;
+            return geometry;
+        }
+    }
+
+    ++m_misses;
+
+    const QTransform linear(matrix.m11(), matrix.m12(), matrix.m21(), matrix.m22(), 0, 0);
+
+    VMappedGeometry geometry;
+    geometry.contour = MapPath(contour, linear, mirror);
+    geometry.seamAllowance = MapPath(seamAllowance, linear, mirror);
+    geometry.layoutAllowance = MapPath(layoutAllowance, linear, mirror);
+
+    {
+        QWriteLocker locker(&m_lock);
+        if (not m_geometry.contains(key))
+        {
+            QSharedPointer<Entry> entry(new Entry());
+            entry->geometry = geometry;
+            entry->pointsCount = contour.size() + seamAllowance.size() + layoutAllowance.size();
+            entry->lastUse.store(++m_clock);
+
+            if (m_pointsCount + entry->pointsCount > maxPointsCount)
+            {
+                Evict(maxPointsCount - freePointsCount - entry->pointsCount);
+            }
+
+            m_geometry.insert(key, entry);
+            m_pointsCount += entry->pointsCount;
+        }
+    }
+
+    geometry.offset = offset;
+    return geometry;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VLayoutPieceCache::Count() const
+{
+    QReadLocker locker(&m_lock);
+    return m_geometry.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qint64 VLayoutPieceCache::Hits() const
+{
+    return m_hits.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qint64 VLayoutPieceCache::Misses() const
+{
+    return m_misses.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Evict drop least recently used orientations until the cache keeps no more than limit points. Must be called
+ * under the write lock.
+ */
+void VLayoutPieceCache::Evict(int limit)
+{
+    QVector<QPair<quint64, Key>> uses;
+    uses.reserve(m_geometry.size());
+    for (auto i = m_geometry.constBegin(); i != m_geometry.constEnd(); ++i)
+    {
+        uses.append(qMakePair(i.value()->lastUse.load(), i.key()));
+    }
+
+    std::sort(uses.begin(), uses.end(), [](const QPair<quint64, Key> &a, const QPair<quint64, Key> &b)
+    {
+        return a.first < b.first;
+    });
+
+    for (auto &use : uses)
+    {
+        if (m_pointsCount <= limit)
+        {
+            break;
+        }
+
+        m_pointsCount -= m_geometry.take(use.second)->pointsCount;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief MapPath map points by matrix the same way VLayoutPiece does. Mirrored piece has reverse order of points.
+ */
+VMappedPath VLayoutPieceCache::MapPath(const QVector<QPointF> &points, const QTransform &matrix, bool mirror)
+{
+    VMappedPath path;
+
+    if (points.isEmpty())
+    {
+        return path;
+    }
+
+    path.points.reserve(points.size());
+    for (auto &point : points)
+    {
+        path.points.append(matrix.map(point));
+    }
+
+    if (mirror)
+    {
+        std::reverse(path.points.begin(), path.points.end());
+    }
+
+    qreal minX = path.points.first().x();
+    qreal maxX = minX;
+    qreal minY = path.points.first().y();
+    qreal maxY = minY;
+
+    for (auto &point : path.points)
+    {
+        minX = qMin(minX, point.x());
+        maxX = qMax(maxX, point.x());
+        minY = qMin(minY, point.y());
+        maxY = qMax(maxY, point.y());
+    }
+
+    path.minimum = QPointF(minX, minY);
+    path.maximum = QPointF(maxX, maxY);
+    return path;
+}
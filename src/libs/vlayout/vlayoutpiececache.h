@@ -0,0 +1,122 @@
+/************************************************************************
+ **
+ **  @file   vlayoutpiececache.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VLAYOUTPIECECACHE_H
+#define VLAYOUTPIECECACHE_H
+
+#include <QHash>
+#include <QPointF>
+#include <QReadWriteLock>
+#include <QRectF>
+#include <QSharedPointer>
+#include <QTransform>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+
+/**
+ * @brief The VMappedPath struct keeps points of a path mapped by the linear part of a piece matrix.
+ */
+struct VMappedPath
+{
+    QVector<QPointF> points{};
+    QPointF          minimum{}; // Smallest coordinates of points.
+    QPointF          maximum{}; // Biggest coordinates of points.
+
+    QVector<QPointF> Translated(const QPointF &offset) const;
+    QRectF           BoundingRect(const QPointF &offset) const;
+};
+
+struct VMappedGeometry
+{
+    VMappedPath contour{};
+    VMappedPath seamAllowance{};
+    VMappedPath layoutAllowance{};
+    QPointF     offset{}; // Translation part of the matrix. Must be added to all points.
+};
+
+/**
+ * @brief The VLayoutPieceCache class keeps contour, seam allowance and layout allowance of a piece mapped for each
+ * orientation (rotation and mirroring) the piece was used in.
+ *
+ * Layout generator copies a piece for every placement attempt and moves copies around. Translation is cheap, but
+ * mapping all points for rotation is repeated by each attempt and by each repeated run of the generator. All copies of
+ * a piece share one cache. Orientation is the linear part of the matrix plus the mirror flag (mirror flag reverses
+ * order of points), the translation part is applied on request. Points stay bit to bit equal to mapping with the full
+ * matrix.
+ *
+ * A piece must replace the cache by a new one when its points are changed. The cache is thread safe. Lookups take
+ * only a read lock. When the cache is full, the least recently used orientations are dropped.
+ */
+class VLayoutPieceCache
+{
+public:
+    VLayoutPieceCache() = default;
+
+    VMappedGeometry Geometry(const QTransform &matrix, bool mirror, const QVector<QPointF> &contour,
+                             const QVector<QPointF> &seamAllowance, const QVector<QPointF> &layoutAllowance);
+
+    int    Count() const;
+    qint64 Hits() const;
+    qint64 Misses() const;
+
+    static VMappedPath MapPath(const QVector<QPointF> &points, const QTransform &matrix, bool mirror);
+
+private:
+    Q_DISABLE_COPY(VLayoutPieceCache)
+
+    struct Key
+    {
+        quint64 m11{0};
+        quint64 m12{0};
+        quint64 m21{0};
+        quint64 m22{0};
+        bool mirror{false};
+
+        bool operator==(const Key &other) const;
+    };
+
+    struct Entry
+    {
+        VMappedGeometry geometry{};
+        int pointsCount{0};
+        std::atomic<quint64> lastUse{0};
+    };
+
+    friend uint qHash(const Key &key, uint seed);
+
+    mutable QReadWriteLock m_lock{};
+    QHash<Key, QSharedPointer<Entry>> m_geometry{};
+    int m_pointsCount{0};
+    std::atomic<quint64> m_clock{0};
+    std::atomic<qint64> m_hits{0};
+    std::atomic<qint64> m_misses{0};
+
+    void Evict(int limit);
+};
+
+#endif // VLAYOUTPIECECACHE_H
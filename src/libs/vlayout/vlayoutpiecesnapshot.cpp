@@ -0,0 +1,57 @@
+/************************************************************************
+ **
+ **  @file   vlayoutpiecesnapshot.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vlayoutpiecesnapshot.h"
+
+#include <QTransform>
+
+#include "vlayoutpiece.h"
+#include "vlayoutpiece_p.h"
+
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutPieceSnapshot::VLayoutPieceSnapshot(const VLayoutPiece &piece)
+    : m_layoutAllowance(piece.d->layoutAllowance),
+      m_outline(piece.IsSeamAllowance() && not piece.IsSeamAllowanceBuiltIn() ? piece.d->seamAllowance
+                                                                                : piece.d->contour)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Map write geometry of the piece placed with the matrix into working polygons. Points are the same as
+ * VLayoutPiece::GetLayoutAllowancePoints() and VLayoutPiece::GetMappedSeamAllowancePoints() (or
+ * VLayoutPiece::GetMappedContourPoints()) return for the same matrix and mirror flag.
+ * @param matrix piece matrix.
+ * @param mirror piece mirror flag.
+ * @param layoutAllowance working polygon for layout allowance.
+ * @param outline working polygon for seam allowance or contour.
+ */
+void VLayoutPieceSnapshot::Map(const QTransform &matrix, bool mirror, VFlatPolygon &layoutAllowance,
+                               VFlatPolygon &outline) const
+{
+    layoutAllowance.Map(m_layoutAllowance, matrix, mirror);
+    outline.Map(m_outline, matrix, mirror);
+}
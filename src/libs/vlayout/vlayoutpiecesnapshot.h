@@ -0,0 +1,59 @@
+/************************************************************************
+ **
+ **  @file   vlayoutpiecesnapshot.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VLAYOUTPIECESNAPSHOT_H
+#define VLAYOUTPIECESNAPSHOT_H
+
+#include <QtGlobal>
+
+#include "vflatpolygon.h"
+
+class QTransform;
+class VLayoutPiece;
+
+/**
+ * @brief The VLayoutPieceSnapshot class keeps geometry of a piece needed for collision checks in flat form: layout
+ * allowance and the outline (seam allowance or contour) before any transformation.
+ *
+ * Placement loop makes a snapshot once per piece and maps it into own working polygons for each candidate matrix.
+ * Unlike VLayoutPiece this does not copy and detach piece data and does not allocate new point vectors for each
+ * candidate.
+ */
+class VLayoutPieceSnapshot
+{
+public:
+    VLayoutPieceSnapshot() = default;
+    explicit VLayoutPieceSnapshot(const VLayoutPiece &piece);
+
+    void Map(const QTransform &matrix, bool mirror, VFlatPolygon &layoutAllowance, VFlatPolygon &outline) const;
+
+private:
+    VFlatPolygon m_layoutAllowance{};
+    VFlatPolygon m_outline{};
+};
+
+#endif // VLAYOUTPIECESNAPSHOT_H
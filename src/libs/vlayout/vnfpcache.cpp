@@ -0,0 +1,613 @@
+/************************************************************************
+ **
+ **  @file   vnfpcache.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vnfpcache.h"
+
+#include <QPainterPath>
+#include <QPolygonF>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QtMath>
+#include <algorithm>
+
+#include "../vobj/vearclipping.h"
+#include "vlayoutpiece.h"
+
+namespace
+{
+// Protect memory on big orders with many unique pieces. Shapes are few, only polygons are dropped. Concave pieces
+// give many parts, so the limit is for points, not for polygons.
+const int maxPointsCount = 1 << 22;
+// When the cache is full, drop old polygons until this part of the limit is free.
+const int freePointsCount = maxPointsCount / 4;
+// No-fit polygon of two pieces has a part for each pair of their parts. A piece with more parts (long concave curves)
+// is approximated by its convex hull.
+const int maxPartsCount = 24;
+
+//---------------------------------------------------------------------------------------------------------------------
+inline qreal Cross(const QPointF &o, const QPointF &a, const QPointF &b)
+{
+    return (a.x() - o.x()) * (b.y() - o.y()) - (a.y() - o.y()) * (b.x() - o.x());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline qreal Cross(const QPointF &a, const QPointF &b)
+{
+    return a.x() * b.y() - a.y() * b.x();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ReorderPolygon rotate list of vertices to start from the lowest one. Closes polygon by two first vertices.
+ */
+QVector<QPointF> ReorderPolygon(const QVector<QPointF> &polygon)
+{
+    int first = 0;
+    for (int i = 1; i < polygon.size(); ++i)
+    {
+        const QPointF &p = polygon.at(i);
+        const QPointF &lowest = polygon.at(first);
+        if (p.y() < lowest.y() || (not (lowest.y() < p.y()) && p.x() < lowest.x()))
+        {
+            first = i;
+        }
+    }
+
+    QVector<QPointF> reordered;
+    reordered.reserve(polygon.size() + 2);
+    for (int i = 0; i < polygon.size() + 2; ++i)
+    {
+        reordered.append(polygon.at((first + i) % polygon.size()));
+    }
+    return reordered;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal Area(const QVector<QPointF> &polygon)
+{
+    qreal area = 0;
+    for (int i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+    {
+        area += Cross(polygon.at(j), polygon.at(i));
+    }
+    return area / 2;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Merge join two counterclockwise polygons with a common edge. First polygon has edge from a to b, second one
+ * from b to a.
+ */
+QVector<int> Merge(const QVector<int> &first, const QVector<int> &second, int a, int b)
+{
+    QVector<int> merged;
+    merged.reserve(first.size() + second.size() - 2);
+
+    const int begin1 = first.indexOf(b);
+    for (int i = 0; i < first.size(); ++i)
+    {
+        merged.append(first.at((begin1 + i) % first.size())); // From b to a
+    }
+
+    const int begin2 = second.indexOf(a);
+    for (int i = 1; i < second.size() - 1; ++i)
+    {
+        merged.append(second.at((begin2 + i) % second.size())); // Between a and b
+    }
+
+    return merged;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool IsConvexCorner(const QVector<QPointF> &points, const QVector<int> &polygon, int vertex)
+{
+    const int i = polygon.indexOf(vertex);
+    const QPointF &previous = points.at(polygon.at((i + polygon.size() - 1) % polygon.size()));
+    const QPointF &next = points.at(polygon.at((i + 1) % polygon.size()));
+    return Cross(previous, points.at(vertex), next) >= 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Outline return border of the union of polygons.
+ */
+QVector<QVector<QPointF>> Outline(const QVector<QVector<QPointF>> &polygons)
+{
+    if (polygons.size() <= 1)
+    {
+        return polygons;
+    }
+
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill);
+    for (auto &polygon : polygons)
+    {
+        path.addPolygon(QPolygonF(polygon));
+        path.closeSubpath();
+    }
+
+    const QList<QPolygonF> rings = path.simplified().toSubpathPolygons();
+
+    QVector<QVector<QPointF>> outline;
+    outline.reserve(rings.size());
+    for (auto ring : rings)
+    {
+        if (ring.size() > 1 && ring.first() == ring.last())
+        {
+            ring.removeLast();
+        }
+
+        if (ring.size() >= 3)
+        {
+            outline.append(ring);
+        }
+    }
+
+    return outline;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool operator==(const VNfpShapeKey &lhs, const VNfpShapeKey &rhs)
+{
+    return lhs.id == rhs.id && lhs.square == rhs.square && lhs.angle == rhs.angle && lhs.mirror == rhs.mirror;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+uint qHash(const VNfpShapeKey &key, uint seed)
+{
+    return qHash(key.id, seed) ^ qHash(key.square, seed) ^ qHash(key.angle << 1 | static_cast<int>(key.mirror), seed);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Shape return orientation of a piece. Calculates and caches it on first use.
+ * @param detail piece from the bank.
+ * @param key orientation key created by ShapeKey() for the same piece.
+ * @return orientation of the piece.
+ */
+VNfpShape VNfpCache::Shape(const VLayoutPiece &detail, const VNfpShapeKey &key)
+{
+    {
+        QReadLocker locker(&m_lock);
+        auto i = m_shapes.constFind(key);
+        if (i != m_shapes.constEnd())
+        {
+            return i.value();
+        }
+    }
+
+    VLayoutPiece workDetail = detail;
+    if (key.mirror)
+    {
+        workDetail.Mirror();
+    }
+    workDetail.Rotate(QPointF(), key.angle / 100.);
+
+    VNfpShape shape;
+    shape.matrix = workDetail.GetMatrix();
+    const QVector<QPointF> layoutPoints = workDetail.GetLayoutAllowancePoints();
+    shape.parts = ConvexParts(layoutPoints);
+    shape.layoutRect = VLayoutPiece::BoundingRect(layoutPoints);
+    shape.detailRect = workDetail.DetailBoundingRect();
+    shape.mirror = workDetail.IsMirror();
+
+    // Another thread could calculate the same shape meanwhile. The result is the same, so overwriting is safe.
+    QWriteLocker locker(&m_lock);
+    m_shapes.insert(key, shape);
+    return shape;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief NoFitPolygon return no-fit polygon for a placed piece in the origin and a moving piece.
+ *
+ * Both shapes must be already known by the cache.
+ * @param placed key of the placed piece.
+ * @param moving key of the moving piece.
+ * @return union of convex polygons. Empty if one of shapes is degenerate.
+ */
+VNfpPolygon VNfpCache::NoFitPolygon(const VNfpShapeKey &placed, const VNfpShapeKey &moving)
+{
+    const QPair<VNfpShapeKey, VNfpShapeKey> pair(placed, moving);
+    QVector<QVector<QPointF>> placedParts;
+    QVector<QVector<QPointF>> reflected;
+
+    {
+        QReadLocker locker(&m_lock);
+        auto i = m_polygons.constFind(pair);
+        if (i != m_polygons.constEnd())
+        {
+            ++m_hits;
+            i.value()->lastUse.store(++m_clock);
+            return i.value()->polygon;
+        }
+
+        placedParts = m_shapes.value(placed).parts;
+        reflected = m_shapes.value(moving).parts;
+    }
+
+    ++m_misses;
+
+    for (auto &part : reflected)
+    {
+        for (auto &point : part)
+        {
+            point = -point;
+        }
+    }
+
+    VNfpPolygon polygon;
+    polygon.parts.reserve(placedParts.size() * reflected.size());
+
+    int pointsCount = 0;
+    for (auto &placedPart : placedParts)
+    {
+        for (auto &movingPart : reflected)
+        {
+            const QVector<QPointF> sum = MinkowskiSum(placedPart, movingPart);
+            if (not sum.isEmpty())
+            {
+                polygon.parts.append(sum);
+                polygon.boundingRect = polygon.boundingRect.united(VLayoutPiece::BoundingRect(sum));
+                pointsCount += sum.size();
+            }
+        }
+    }
+
+    polygon.outline = Outline(polygon.parts);
+    for (auto &ring : polygon.outline)
+    {
+        pointsCount += ring.size();
+    }
+
+    QWriteLocker locker(&m_lock);
+    if (not m_polygons.contains(pair))
+    {
+        QSharedPointer<Entry> entry(new Entry());
+        entry->polygon = polygon;
+        entry->pointsCount = pointsCount;
+        entry->lastUse.store(++m_clock);
+
+        if (m_pointsCount + entry->pointsCount > maxPointsCount)
+        {
+            Evict(maxPointsCount - freePointsCount - entry->pointsCount);
+        }
+
+        m_polygons.insert(pair, entry);
+        m_pointsCount += entry->pointsCount;
+    }
+    return polygon;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VNfpCache::Clear()
+{
+    QWriteLocker locker(&m_lock);
+    m_shapes.clear();
+    m_polygons.clear();
+    m_pointsCount = 0;
+    m_hits = 0;
+    m_misses = 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VNfpCache::ShapesCount() const
+{
+    QReadLocker locker(&m_lock);
+    return m_shapes.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VNfpCache::PolygonsCount() const
+{
+    QReadLocker locker(&m_lock);
+    return m_polygons.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qint64 VNfpCache::Hits() const
+{
+    return m_hits.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qint64 VNfpCache::Misses() const
+{
+    return m_misses.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VNfpShapeKey VNfpCache::ShapeKey(const VLayoutPiece &detail, qreal angle, bool mirror)
+{
+    int hundredths = qRound(angle * 100) % 36000;
+    if (hundredths < 0)
+    {
+        hundredths += 36000;
+    }
+
+    VNfpShapeKey key;
+    key.id = detail.GetId();
+    key.square = detail.Square();
+    key.angle = hundredths;
+    key.mirror = mirror;
+    return key;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ConvexHull build convex hull of points (Andrew's monotone chain).
+ * @param points list of points.
+ * @return vertices of the hull in counterclockwise order (for y axis directed up). Collinear points are dropped.
+ */
+QVector<QPointF> VNfpCache::ConvexHull(QVector<QPointF> points)
+{
+    if (points.size() < 3)
+    {
+        return points;
+    }
+
+    std::sort(points.begin(), points.end(), [](const QPointF &a, const QPointF &b)
+    {
+        return a.x() < b.x() || (not (b.x() < a.x()) && a.y() < b.y());
+    });
+
+    QVector<QPointF> hull(points.size() * 2);
+    int k = 0;
+
+    for (int i = 0; i < points.size(); ++i)
+    {// Lower hull
+        while (k >= 2 && Cross(hull.at(k-2), hull.at(k-1), points.at(i)) <= 0)
+        {
+            --k;
+        }
+        hull[k++] = points.at(i);
+    }
+
+    for (int i = points.size() - 2, t = k + 1; i >= 0; --i)
+    {// Upper hull
+        while (k >= t && Cross(hull.at(k-2), hull.at(k-1), points.at(i)) <= 0)
+        {
+            --k;
+        }
+        hull[k++] = points.at(i);
+    }
+
+    hull.resize(k - 1); // Last point is equal to the first one
+    return hull;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ConvexParts split a polygon into convex parts.
+ *
+ * Convex polygon is one part. Other polygons are split into triangles by ear clipping, after that neighbor parts are
+ * merged while the result stays convex (Hertel-Mehlhorn). Number of parts is not minimal, but not bigger than four
+ * minimal numbers. The convex hull is the only part if triangles do not cover the polygon (self-intersecting contour)
+ * or if there are too many parts.
+ * @param points vertices of the polygon in any order.
+ * @return convex parts in counterclockwise order (for y axis directed up). Empty for a degenerate polygon.
+ */
+QVector<QVector<QPointF>> VNfpCache::ConvexParts(const QVector<QPointF> &points)
+{
+    const QVector<QPointF> hull = ConvexHull(points);
+    if (hull.size() < 3)
+    {
+        return QVector<QVector<QPointF>>();
+    }
+
+    // Only a convex polygon has the same area as its hull
+    const qreal polygonArea = qAbs(Area(points));
+    const qreal hullArea = Area(hull);
+    if (hullArea - polygonArea <= hullArea * 1e-6)
+    {
+        return QVector<QVector<QPointF>>{hull};
+    }
+
+    const QVector<int> triangles = EarClipping(points);
+
+    QVector<QVector<int>> polygons;
+    polygons.reserve(triangles.size() / 3);
+    QHash<QPair<int, int>, int> edges; // Owner of each edge
+    qreal area = 0;
+
+    for (int i = 0; i < triangles.size(); i += 3)
+    {
+        const QVector<int> triangle{triangles.at(i), triangles.at(i + 1), triangles.at(i + 2)};
+        area += Cross(points.at(triangle.at(0)), points.at(triangle.at(1)), points.at(triangle.at(2))) / 2;
+
+        for (int k = 0; k < 3; ++k)
+        {
+            edges.insert(qMakePair(triangle.at(k), triangle.at((k + 1) % 3)), polygons.size());
+        }
+        polygons.append(triangle);
+    }
+
+    if (qAbs(area - polygonArea) > polygonArea * 1e-6)
+    {
+        return QVector<QVector<QPointF>>{hull};
+    }
+
+    for (int p = 0; p < polygons.size(); ++p)
+    {
+        for (int k = 0; k < polygons.at(p).size(); ++k)
+        {
+            const int a = polygons.at(p).at(k);
+            const int b = polygons.at(p).at((k + 1) % polygons.at(p).size());
+            const int q = edges.value(qMakePair(b, a), -1);
+
+            if (q == -1 || q == p)
+            {
+                continue; // Border of the polygon
+            }
+
+            const QVector<int> merged = Merge(polygons.at(p), polygons.at(q), a, b);
+            if (not IsConvexCorner(points, merged, a) || not IsConvexCorner(points, merged, b))
+            {
+                continue;
+            }
+
+            edges.remove(qMakePair(a, b));
+            edges.remove(qMakePair(b, a));
+            for (int i = 0; i < polygons.at(q).size(); ++i)
+            {
+                const QPair<int, int> edge(polygons.at(q).at(i), polygons.at(q).at((i + 1) % polygons.at(q).size()));
+                if (edges.contains(edge))
+                {
+                    edges.insert(edge, p);
+                }
+            }
+
+            polygons[p] = merged;
+            polygons[q].clear();
+            k = -1; // The polygon has new edges, check all again
+        }
+    }
+
+    QVector<QVector<QPointF>> parts;
+    for (auto &polygon : polygons)
+    {
+        QVector<QPointF> part;
+        part.reserve(polygon.size());
+        for (auto index : polygon)
+        {
+            part.append(points.at(index));
+        }
+
+        part = ConvexHull(part); // Drops collinear points
+        if (part.size() >= 3)
+        {
+            parts.append(part);
+        }
+    }
+
+    if (parts.isEmpty() || parts.size() > maxPartsCount)
+    {
+        return QVector<QVector<QPointF>>{hull};
+    }
+
+    return parts;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Evict drop least recently used polygons until the cache keeps no more than limit points. Must be called
+ * under the write lock.
+ */
+void VNfpCache::Evict(int limit)
+{
+    QVector<QPair<quint64, QPair<VNfpShapeKey, VNfpShapeKey>>> uses;
+    uses.reserve(m_polygons.size());
+    for (auto i = m_polygons.constBegin(); i != m_polygons.constEnd(); ++i)
+    {
+        uses.append(qMakePair(i.value()->lastUse.load(), i.key()));
+    }
+
+    std::sort(uses.begin(), uses.end(), [](const QPair<quint64, QPair<VNfpShapeKey, VNfpShapeKey>> &a,
+                                           const QPair<quint64, QPair<VNfpShapeKey, VNfpShapeKey>> &b)
+    {
+        return a.first < b.first;
+    });
+
+    for (auto &use : uses)
+    {
+        if (m_pointsCount <= limit)
+        {
+            break;
+        }
+
+        m_pointsCount -= m_polygons.take(use.second)->pointsCount;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief MinkowskiSum calculate Minkowski sum of two convex polygons.
+ * @param p first polygon, counterclockwise order.
+ * @param q second polygon, counterclockwise order.
+ * @return convex polygon in counterclockwise order. Empty if one of polygons has less than three vertices.
+ */
+QVector<QPointF> VNfpCache::MinkowskiSum(const QVector<QPointF> &p, const QVector<QPointF> &q)
+{
+    if (p.size() < 3 || q.size() < 3)
+    {
+        return QVector<QPointF>();
+    }
+
+    const QVector<QPointF> a = ReorderPolygon(p);
+    const QVector<QPointF> b = ReorderPolygon(q);
+
+    QVector<QPointF> sum;
+    sum.reserve(p.size() + q.size());
+
+    int i = 0;
+    int j = 0;
+    while (i < a.size() - 2 || j < b.size() - 2)
+    {
+        sum.append(a.at(i) + b.at(j));
+        const qreal cross = Cross(a.at(i+1) - a.at(i), b.at(j+1) - b.at(j));
+        if (cross >= 0 && i < a.size() - 2)
+        {
+            ++i;
+        }
+        if (cross <= 0 && j < b.size() - 2)
+        {
+            ++j;
+        }
+    }
+
+    return sum;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief StrictlyInside check if a point is inside a convex polygon and far from its border.
+ * @param polygon convex polygon in counterclockwise order.
+ * @param point point to check.
+ * @param tolerance points closer to the border than this distance are outside.
+ * @return true if inside.
+ */
+bool VNfpCache::StrictlyInside(const QVector<QPointF> &polygon, const QPointF &point, qreal tolerance)
+{
+    if (polygon.size() < 3)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < polygon.size(); ++i)
+    {
+        const QPointF &a = polygon.at(i);
+        const QPointF &b = polygon.at((i + 1) % polygon.size());
+        const QPointF edge = b - a;
+        const qreal length = qSqrt(QPointF::dotProduct(edge, edge));
+        if (Cross(a, b, point) <= tolerance * length)
+        {
+            return false;
+        }
+    }
+    return true;
+}
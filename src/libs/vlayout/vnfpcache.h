@@ -0,0 +1,165 @@
+/************************************************************************
+ **
+ **  @file   vnfpcache.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VNFPCACHE_H
+#define VNFPCACHE_H
+
+#include <QHash>
+#include <QPair>
+#include <QPointF>
+#include <QReadWriteLock>
+#include <QRectF>
+#include <QSharedPointer>
+#include <QTransform>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+
+#include "../vmisc/typedef.h"
+
+class VLayoutPiece;
+
+/**
+ * @brief The VNfpShapeKey struct identifies one orientation of a piece.
+ *
+ * Id alone is not enough, because pieces prepared outside of a pattern (tests, manual layout) can share id. Square
+ * of a piece separates such pieces.
+ */
+struct VNfpShapeKey
+{
+    vidtype id{NULL_ID};
+    qint64  square{0};
+    // cppcheck-suppress unusedStructMember
+    int     angle{0}; // Rotation angle in hundredths of degree.
+    // cppcheck-suppress unusedStructMember
+    bool    mirror{false};
+};
+
+bool operator==(const VNfpShapeKey &lhs, const VNfpShapeKey &rhs);
+uint qHash(const VNfpShapeKey &key, uint seed = 0);
+
+Q_DECLARE_TYPEINFO(VNfpShapeKey, Q_PRIMITIVE_TYPE);
+
+/**
+ * @brief The VNfpShape struct keeps one orientation of a piece placed with top left corner of transformation in the
+ * origin.
+ */
+struct VNfpShape
+{
+    QTransform                matrix{};      // Rotation (and mirroring) of the piece.
+    QVector<QVector<QPointF>> parts{};       // Convex parts of layout allowance.
+    QRectF                    detailRect{};  // Bounding rectangle of the piece contour.
+    QRectF                    layoutRect{};  // Bounding rectangle of the layout allowance.
+    // cppcheck-suppress unusedStructMember
+    bool                      mirror{false}; // Mirror flag of the piece after transformation.
+};
+
+/**
+ * @brief The VNfpPolygon struct keeps no-fit polygon of two orientations as a union of convex polygons.
+ *
+ * A translation is free if it is not strictly inside any of the polygons. Outline of the union is used only to find
+ * candidates for a position, the check itself does not depend on it.
+ */
+struct VNfpPolygon
+{
+    QVector<QVector<QPointF>> parts{};        // Convex polygons, one for each pair of parts of two pieces.
+    QVector<QVector<QPointF>> outline{};      // Rings of the union border, holes included.
+    QRectF                    boundingRect{};
+};
+
+/**
+ * @brief The VNfpPlacement struct keeps position of a piece placed by no-fit polygon engine.
+ */
+struct VNfpPlacement
+{
+    VNfpShapeKey key{};
+    QPointF      offset{};
+    QRectF       detailRect{}; // Bounding rectangle of the placed piece contour.
+};
+
+Q_DECLARE_TYPEINFO(VNfpPlacement, Q_MOVABLE_TYPE);
+
+/**
+ * @brief The VNfpCache class keeps orientations of pieces and no-fit polygons between them.
+ *
+ * No-fit polygon of a placed piece A and a moving piece B is a set of translations of B where B touches or overlaps A.
+ * A translation outside of the polygon is free. Layout allowance of each piece is split into convex parts, the polygon
+ * is the union of Minkowski sums for all pairs of parts. So a piece can be nested inside a concave part of another one.
+ * Pieces with too many parts are approximated by the convex hull. This is conservative, pieces never overlap.
+ *
+ * A layout has only a few unique pieces, while each of them is placed many times. Polygons are calculated for a pair
+ * of orientations with the placed piece in the origin and are reused for all copies of the pair. One cache is shared
+ * by all sheets of a generator and by all multi-start workers.
+ *
+ * Lookups take only a read lock. A missing entry is calculated without a lock and inserted under a write lock, so
+ * workers do not wait for each other while calculating. When the cache is full, the least recently used polygons are
+ * dropped.
+ */
+class VNfpCache
+{
+public:
+    VNfpCache() = default;
+
+    VNfpShape Shape(const VLayoutPiece &detail, const VNfpShapeKey &key);
+    VNfpPolygon NoFitPolygon(const VNfpShapeKey &placed, const VNfpShapeKey &moving);
+
+    void Clear();
+
+    int    ShapesCount() const;
+    int    PolygonsCount() const;
+    qint64 Hits() const;
+    qint64 Misses() const;
+
+    static VNfpShapeKey ShapeKey(const VLayoutPiece &detail, qreal angle, bool mirror);
+
+    static QVector<QPointF>          ConvexHull(QVector<QPointF> points);
+    static QVector<QVector<QPointF>> ConvexParts(const QVector<QPointF> &points);
+    static QVector<QPointF>          MinkowskiSum(const QVector<QPointF> &p, const QVector<QPointF> &q);
+    static bool StrictlyInside(const QVector<QPointF> &polygon, const QPointF &point, qreal tolerance);
+
+private:
+    Q_DISABLE_COPY(VNfpCache)
+
+    struct Entry
+    {
+        VNfpPolygon polygon{};
+        int pointsCount{0};
+        std::atomic<quint64> lastUse{0};
+    };
+
+    mutable QReadWriteLock m_lock{};
+    QHash<VNfpShapeKey, VNfpShape> m_shapes{};
+    QHash<QPair<VNfpShapeKey, VNfpShapeKey>, QSharedPointer<Entry>> m_polygons{};
+    int m_pointsCount{0};
+    std::atomic<quint64> m_clock{0};
+    std::atomic<qint64> m_hits{0};
+    std::atomic<qint64> m_misses{0};
+
+    void Evict(int limit);
+};
+
+#endif // VNFPCACHE_H
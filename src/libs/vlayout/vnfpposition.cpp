@@ -0,0 +1,400 @@
+/************************************************************************
+ **
+ **  @file   vnfpposition.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vnfpposition.h"
+
+#include <QRectF>
+#include <algorithm>
+
+#include "../vgeometry/vgeometrydef.h"
+#include "../vmisc/def.h"
+#include "vlayoutdef.h"
+#include "vpositionsindex.h"
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Overlaps check if two rectangles overlap. Unlike QRectF::intersects() also works for degenerated rectangles.
+ */
+inline bool Overlaps(const QRectF &r1, const QRectF &r2)
+{
+    return r1.left() <= r2.right() && r2.left() <= r1.right() && r1.top() <= r2.bottom() && r2.top() <= r1.bottom();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool Contains(const QRectF &rect, const QPointF &point)
+{
+    return rect.left() <= point.x() && point.x() <= rect.right() &&
+           rect.top() <= point.y() && point.y() <= rect.bottom();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void AppendIntersection(const QPointF &p1, const QPointF &p2, const QPointF &q1, const QPointF &q2,
+                        QVector<QPointF> &points)
+{
+    const QPointF r = p2 - p1;
+    const QPointF s = q2 - q1;
+    const qreal denominator = r.x() * s.y() - r.y() * s.x();
+
+    if (qFuzzyIsNull(denominator))
+    {
+        return; // Parallel segments. Their ends are already candidates.
+    }
+
+    const QPointF qp = q1 - p1;
+    const qreal t = (qp.x() * s.y() - qp.y() * s.x()) / denominator;
+    const qreal u = (qp.x() * r.y() - qp.y() * r.x()) / denominator;
+
+    if (t >= 0 && t <= 1 && u >= 0 && u <= 1)
+    {
+        points.append(p1 + r * t);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void AppendIntersections(const QVector<QPointF> &polygon1, const QVector<QPointF> &polygon2, QVector<QPointF> &points)
+{
+    for (int i = 0; i < polygon1.size(); ++i)
+    {
+        const QPointF &p1 = polygon1.at(i);
+        const QPointF &p2 = polygon1.at((i + 1) % polygon1.size());
+
+        for (int j = 0; j < polygon2.size(); ++j)
+        {
+            AppendIntersection(p1, p2, polygon2.at(j), polygon2.at((j + 1) % polygon2.size()), points);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief AppendPolygon move a polygon on offset and append it if it can touch the inner-fit rectangle.
+ */
+void AppendPolygon(QVector<QPointF> polygon, const QPointF &offset, const QRectF &innerFit,
+                   QVector<QVector<QPointF>> &polygons, QVector<QRectF> &bounds, VPositionsIndex &index)
+{
+    for (auto &point : polygon)
+    {
+        point += offset;
+    }
+
+    const QRectF rect = VLayoutPiece::BoundingRect(polygon);
+    if (polygon.isEmpty() || not Overlaps(rect, innerFit))
+    {
+        return; // Cannot block any position
+    }
+
+    polygons.append(polygon);
+    bounds.append(rect);
+
+    VCachedPositions position;
+    position.boundingRect = rect;
+    index.Append(position);
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VNfpPosition::VNfpPosition(const VNfpPositionData &data, std::atomic_bool *stop)
+    : m_data(data),
+      m_stop(stop),
+      m_portrait(data.height >= data.width)
+{
+    for (auto &placement : m_data.placements)
+    {
+        m_usedRect = m_usedRect.united(placement.detailRect);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ArrangeDetail find bottom-left position of a piece among all allowed orientations.
+ * @param data sheet state and the piece.
+ * @param stop stop flag.
+ * @return result. Check flag valid before use.
+ */
+VNfpResult VNfpPosition::ArrangeDetail(const VNfpPositionData &data, std::atomic_bool *stop)
+{
+    VNfpResult best;
+
+    if (data.cache.isNull())
+    {
+        return best;
+    }
+
+    const VNfpPosition position(data, stop);
+    const QVector<qreal> angles = position.Angles();
+
+    for (auto angle : angles)
+    {
+        if (stop->load())
+        {
+            return VNfpResult();
+        }
+
+        const VNfpResult result = position.Place(angle, data.detail.IsForceFlipping());
+        if (result.valid && position.IsBetter(result, best))
+        {
+            best = result;
+        }
+    }
+
+    if (data.counters != nullptr)
+    {
+        data.counters->placements += position.m_placements;
+        data.counters->collisionChecks += position.m_collisionChecks;
+    }
+
+    return best;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Angles return list of rotation angles allowed for the piece.
+ */
+QVector<qreal> VNfpPosition::Angles() const
+{
+    QVector<qreal> angles;
+
+    if (m_data.followGrainline && m_data.detail.IsGrainlineEnabled())
+    {
+        QLineF detailGrainline(10, 10, 100, 10);
+        detailGrainline.setAngle(m_data.detail.GrainlineAngle());
+
+        if (m_data.detail.IsForceFlipping())
+        {
+            VLayoutPiece workDetail = m_data.detail; // We need copy for temp change
+            workDetail.Mirror();
+            detailGrainline = workDetail.GetMatrix().map(detailGrainline);
+        }
+
+        const qreal angle = detailGrainline.angleTo(FabricGrainline());
+        const GrainlineArrowDirection arrow = m_data.detail.GrainlineArrowType();
+
+        if (arrow == GrainlineArrowDirection::atBoth || arrow == GrainlineArrowDirection::atFront)
+        {
+            angles.append(angle);
+        }
+
+        if (arrow == GrainlineArrowDirection::atBoth || arrow == GrainlineArrowDirection::atRear)
+        {
+            angles.append(angle + 180);
+        }
+    }
+    else if (m_data.rotate)
+    {
+        const int step = 360 / qMax(1, m_data.rotationNumber);
+        for (int angle = 0; angle < 360; angle += step)
+        {
+            angles.append(angle);
+        }
+    }
+    else
+    {
+        angles.append(0);
+    }
+
+    return angles;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Place find bottom-left position of the piece in one orientation.
+ * @param angle rotation angle.
+ * @param mirror true if the piece must be mirrored.
+ * @return result. Check flag valid before use.
+ */
+VNfpResult VNfpPosition::Place(qreal angle, bool mirror) const
+{
+    VNfpResult result;
+
+    const VNfpShapeKey key = VNfpCache::ShapeKey(m_data.detail, angle, mirror);
+    const VNfpShape shape = m_data.cache->Shape(m_data.detail, key);
+
+    if (shape.parts.isEmpty())
+    {
+        return result;
+    }
+
+    // Inner-fit rectangle. Translations which keep the piece inside the sheet.
+    const qreal left = -shape.detailRect.left();
+    const qreal top = -shape.detailRect.top();
+    qreal right = m_data.width - shape.detailRect.right();
+    qreal bottom = m_data.height - shape.detailRect.bottom();
+
+    if (right < left - accuracyPointOnLine || bottom < top - accuracyPointOnLine)
+    {
+        return result; // The piece is bigger than the sheet
+    }
+    right = qMax(left, right);
+    bottom = qMax(top, bottom);
+
+    const QRectF innerFit(QPointF(left, top), QPointF(right, bottom));
+
+    // Rings of no-fit polygons give candidates, convex parts decide if a candidate is free
+    QVector<QVector<QPointF>> polygons;
+    QVector<QRectF> bounds;
+    VPositionsIndex index(innerFit);
+
+    QVector<QVector<QPointF>> parts;
+    QVector<QRectF> partBounds;
+    VPositionsIndex partIndex(innerFit);
+
+    for (auto &placement : m_data.placements)
+    {
+        const VNfpPolygon nfp = m_data.cache->NoFitPolygon(placement.key, key);
+        if (nfp.parts.isEmpty() || not Overlaps(nfp.boundingRect.translated(placement.offset), innerFit))
+        {
+            continue; // Cannot block any position
+        }
+
+        for (auto &ring : nfp.outline)
+        {
+            AppendPolygon(ring, placement.offset, innerFit, polygons, bounds, index);
+        }
+
+        for (auto &part : nfp.parts)
+        {
+            AppendPolygon(part, placement.offset, innerFit, parts, partBounds, partIndex);
+        }
+    }
+
+    // Candidates for the bottom-left position
+    QVector<QPointF> points{innerFit.topLeft(), innerFit.topRight(), innerFit.bottomLeft(), innerFit.bottomRight()};
+
+    for (int i = 0; i < polygons.size(); ++i)
+    {
+        if (m_stop->load())
+        {
+            return result;
+        }
+
+        const QVector<QPointF> &polygon = polygons.at(i);
+        points += polygon;
+
+        for (int k = 0; k < polygon.size(); ++k)
+        {
+            const QPointF &p1 = polygon.at(k);
+            const QPointF &p2 = polygon.at((k + 1) % polygon.size());
+            AppendIntersection(p1, p2, innerFit.topLeft(), innerFit.topRight(), points);
+            AppendIntersection(p1, p2, innerFit.topRight(), innerFit.bottomRight(), points);
+            AppendIntersection(p1, p2, innerFit.bottomRight(), innerFit.bottomLeft(), points);
+            AppendIntersection(p1, p2, innerFit.bottomLeft(), innerFit.topLeft(), points);
+        }
+
+        for (auto j : index.Candidates(bounds.at(i)))
+        {
+            if (j > i && Overlaps(bounds.at(i), bounds.at(j)))
+            {
+                AppendIntersections(polygon, polygons.at(j), points);
+            }
+        }
+    }
+
+    const QRectF allowed = innerFit.adjusted(-accuracyPointOnLine, -accuracyPointOnLine, accuracyPointOnLine,
+                                             accuracyPointOnLine);
+    auto outside = std::remove_if(points.begin(), points.end(), [allowed](const QPointF &point)
+    {
+        return not Contains(allowed, point);
+    });
+    points.erase(outside, points.end());
+
+    const bool portrait = m_portrait;
+    std::sort(points.begin(), points.end(), [portrait](const QPointF &p1, const QPointF &p2)
+    {
+        const qreal depth1 = portrait ? p1.y() : p1.x();
+        const qreal depth2 = portrait ? p2.y() : p2.x();
+        const qreal side1 = portrait ? p1.x() : p1.y();
+        const qreal side2 = portrait ? p2.x() : p2.y();
+        return depth1 < depth2 || (not (depth2 < depth1) && side1 < side2);
+    });
+
+    for (auto point : points)
+    {
+        point.setX(qBound(left, point.x(), right));
+        point.setY(qBound(top, point.y(), bottom));
+
+        ++m_placements;
+
+        bool free = true;
+        for (auto i : partIndex.Candidates(QRectF(point, point)))
+        {
+            if (Contains(partBounds.at(i), point))
+            {
+                ++m_collisionChecks;
+                if (VNfpCache::StrictlyInside(parts.at(i), point, accuracyPointOnLine))
+                {
+                    free = false;
+                    break;
+                }
+            }
+        }
+
+        if (free)
+        {
+            result.valid = true;
+            result.matrix = shape.matrix * QTransform::fromTranslate(point.x(), point.y());
+            result.mirror = shape.mirror;
+            result.placement.key = key;
+            result.placement.offset = point;
+            result.placement.detailRect = shape.detailRect.translated(point);
+
+            const QRectF &rect = result.placement.detailRect;
+            const QRectF used = m_usedRect.isNull() ? rect : m_usedRect.united(rect);
+            result.length = m_portrait ? used.bottom() : used.right();
+            result.depthPosition = m_portrait ? rect.top() : rect.left();
+            result.sidePosition = m_portrait ? rect.left() : rect.top();
+            break;
+        }
+    }
+
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsBetter compare two results. Shortest layout is better, then position closer to the start of the sheet.
+ */
+bool VNfpPosition::IsBetter(const VNfpResult &candidate, const VNfpResult &best) const
+{
+    if (not best.valid)
+    {
+        return true;
+    }
+
+    if (not VFuzzyComparePossibleNulls(candidate.length, best.length))
+    {
+        return candidate.length < best.length;
+    }
+
+    if (not VFuzzyComparePossibleNulls(candidate.depthPosition, best.depthPosition))
+    {
+        return candidate.depthPosition < best.depthPosition;
+    }
+
+    return candidate.sidePosition < best.sidePosition;
+}
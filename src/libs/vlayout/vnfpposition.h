@@ -0,0 +1,123 @@
+/************************************************************************
+ **
+ **  @file   vnfpposition.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VNFPPOSITION_H
+#define VNFPPOSITION_H
+
+#include <QLineF>
+#include <QSharedPointer>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+#include <climits>
+
+#include "vlayoutdef.h"
+#include "vlayoutpiece.h"
+#include "vnfpcache.h"
+
+struct VNfpPositionData
+{
+    VLayoutPiece detail{};
+    QVector<VNfpPlacement> placements{};
+    QSharedPointer<VNfpCache> cache{};
+    // cppcheck-suppress unusedStructMember
+    int width{0};
+    // cppcheck-suppress unusedStructMember
+    int height{0};
+    // cppcheck-suppress unusedStructMember
+    bool rotate{false};
+    // cppcheck-suppress unusedStructMember
+    int rotationNumber{2};
+    // cppcheck-suppress unusedStructMember
+    bool followGrainline{false};
+    // cppcheck-suppress unusedStructMember
+    bool isOriginPaperOrientationPortrait{true};
+    VLayoutCounters *counters{nullptr};
+};
+
+struct VNfpResult
+{
+    // cppcheck-suppress unusedStructMember
+    bool          valid{false};
+    QTransform    matrix{};
+    // cppcheck-suppress unusedStructMember
+    bool          mirror{false};
+    VNfpPlacement placement{};
+    // cppcheck-suppress unusedStructMember
+    qreal         length{INT_MAX};
+    // cppcheck-suppress unusedStructMember
+    qreal         depthPosition{INT_MAX};
+    // cppcheck-suppress unusedStructMember
+    qreal         sidePosition{INT_MAX};
+};
+
+/**
+ * @brief The VNfpPosition class places a piece on a sheet with help of no-fit polygons.
+ *
+ * For each allowed orientation of the piece the inner-fit rectangle (translations which keep the piece inside the
+ * sheet) is intersected with no-fit polygons of all placed pieces. Free position can only be a corner of the
+ * rectangle, a vertex of a polygon or an intersection of two borders. These points are sorted from the start of the
+ * sheet and the first point outside of all polygons is the bottom-left position for the orientation. Orientation which
+ * gives the shortest layout wins.
+ *
+ * Unlike VPosition there is no collision check of pieces at all, only point in polygon tests.
+ */
+class VNfpPosition
+{
+public:
+    static VNfpResult ArrangeDetail(const VNfpPositionData &data, std::atomic_bool *stop);
+
+private:
+    Q_DISABLE_COPY(VNfpPosition)
+
+    VNfpPosition(const VNfpPositionData &data, std::atomic_bool *stop);
+
+    const VNfpPositionData &m_data;
+    std::atomic_bool *m_stop;
+    bool m_portrait;
+    QRectF m_usedRect{};
+    mutable qint64 m_placements{0};
+    mutable qint64 m_collisionChecks{0};
+
+    QVector<qreal> Angles() const;
+    VNfpResult     Place(qreal angle, bool mirror) const;
+    bool           IsBetter(const VNfpResult &candidate, const VNfpResult &best) const;
+
+    QLineF FabricGrainline() const;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VNfpPosition::FabricGrainline return fabric gainline accoding to paper orientation
+ * @return fabric gainline line
+ */
+inline QLineF VNfpPosition::FabricGrainline() const
+{
+    return m_data.isOriginPaperOrientationPortrait ? QLineF(10, 10, 10, 100) : QLineF(10, 10, 100, 10);
+}
+
+#endif // VNFPPOSITION_H
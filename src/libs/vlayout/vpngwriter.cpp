@@ -0,0 +1,388 @@
+/************************************************************************
+ **
+ **  @file   vpngwriter.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vpngwriter.h"
+
+#include <QIODevice>
+#include <QImage>
+#include <QtMath>
+#include <algorithm>
+#include <array>
+
+namespace
+{
+// Length codes 257..285 of deflate (RFC 1951, 3.2.5).
+const std::array<int, 29> lengthBase{{3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83,
+                                      99, 115, 131, 163, 195, 227, 258}};
+const std::array<int, 29> lengthExtraBits{{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5,
+                                           5, 5, 5, 0}};
+
+const int minMatch = 3;
+const int maxMatch = 258;
+const int endOfBlock = 256;
+const quint32 adlerBase = 65521;
+const int adlerMax = 5552; // Biggest count of bytes that cannot overflow the sums before modulo
+const int bytesPerPixel = 3;
+const char filterUp = 2;
+
+//---------------------------------------------------------------------------------------------------------------------
+const std::array<quint32, 256> &CrcTable()
+{
+    static const std::array<quint32, 256> table = []()
+    {
+        std::array<quint32, 256> crcTable{};
+        for (quint32 n = 0; n < 256; ++n)
+        {
+            quint32 c = n;
+            for (int k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+            }
+            crcTable[n] = c;
+        }
+        return crcTable;
+    }();
+
+    return table;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+quint32 Crc(quint32 crc, const char *data, int size)
+{
+    const std::array<quint32, 256> &table = CrcTable();
+    for (int i = 0; i < size; ++i)
+    {
+        crc = table[(crc ^ static_cast<uchar>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void AppendUInt32(QByteArray &data, quint32 value)
+{
+    data.append(static_cast<char>((value >> 24) & 0xFF));
+    data.append(static_cast<char>((value >> 16) & 0xFF));
+    data.append(static_cast<char>((value >> 8) & 0xFF));
+    data.append(static_cast<char>(value & 0xFF));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Huffman codes are packed starting from the most significant bit.
+quint32 ReverseBits(quint32 code, int count)
+{
+    quint32 reversed = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        reversed = (reversed << 1) | (code & 1);
+        code >>= 1;
+    }
+    return reversed;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VPngWriter::VPngWriter(QIODevice *device, int width, int height, qreal dpi)
+    : m_device(device),
+      m_width(width),
+      m_height(height),
+      m_dpi(dpi)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Begin writes the signature and the header of the image.
+ * @return false if the size is not valid or the device cannot be written.
+ */
+bool VPngWriter::Begin()
+{
+    if (m_device == nullptr || m_width <= 0 || m_height <= 0)
+    {
+        return false;
+    }
+
+    if (m_device->write("\x89PNG\r\n\x1a\n", 8) != 8)
+    {
+        return false;
+    }
+
+    QByteArray header;
+    AppendUInt32(header, static_cast<quint32>(m_width));
+    AppendUInt32(header, static_cast<quint32>(m_height));
+    header.append(static_cast<char>(8)); // bit depth
+    header.append(static_cast<char>(2)); // color type RGB
+    header.append(static_cast<char>(0)); // compression method
+    header.append(static_cast<char>(0)); // filter method
+    header.append(static_cast<char>(0)); // no interlace
+
+    if (not WriteChunk("IHDR", header))
+    {
+        return false;
+    }
+
+    if (m_dpi > 0)
+    {
+        const quint32 pixelsPerMeter = static_cast<quint32>(qRound(m_dpi / 0.0254));
+
+        QByteArray physical;
+        AppendUInt32(physical, pixelsPerMeter);
+        AppendUInt32(physical, pixelsPerMeter);
+        physical.append(static_cast<char>(1)); // unit is meter
+
+        if (not WriteChunk("pHYs", physical))
+        {
+            return false;
+        }
+    }
+
+    // Prior row of the first row is zero
+    m_previousRow = QByteArray(m_width * bytesPerPixel, '\0');
+
+    // zlib header: deflate with 32K window, no dictionary, fastest compression level
+    m_compressed.append(static_cast<char>(0x78));
+    m_compressed.append(static_cast<char>(0x01));
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief WriteRows compresses first rows of the image and writes them as one data chunk.
+ * @param image band of the picture. Width must be the same as width of the PNG. Alpha channel is ignored.
+ * @param count number of rows to take from the band.
+ * @return false if the band doesn't fit the image or the device cannot be written.
+ */
+bool VPngWriter::WriteRows(const QImage &image, int count)
+{
+    if (image.width() != m_width || count < 0 || count > image.height() || m_rows + count > m_height)
+    {
+        return false;
+    }
+
+    if (count == 0)
+    {
+        return true;
+    }
+
+    const QImage band = image.format() == QImage::Format_RGB32 || image.format() == QImage::Format_ARGB32
+            ? image : image.convertToFormat(QImage::Format_RGB32);
+
+    const int rowSize = m_width * bytesPerPixel;
+    m_filtered.resize(count * (rowSize + 1));
+    char *filtered = m_filtered.data();
+    char *previous = m_previousRow.data();
+
+    for (int y = 0; y < count; ++y)
+    {
+        const QRgb *line = reinterpret_cast<const QRgb *>(band.constScanLine(y));
+        *filtered++ = filterUp;
+
+        for (int x = 0; x < m_width; ++x)
+        {
+            const std::array<int, bytesPerPixel> pixel{{qRed(line[x]), qGreen(line[x]), qBlue(line[x])}};
+            for (int channel = 0; channel < bytesPerPixel; ++channel)
+            {
+                const int i = x * bytesPerPixel + channel;
+                *filtered++ = static_cast<char>(pixel[channel] - static_cast<uchar>(previous[i]));
+                previous[i] = static_cast<char>(pixel[channel]);
+            }
+        }
+    }
+
+    UpdateAdler(m_filtered);
+
+    WriteBits(0, 1); // not final block
+    WriteBits(1, 2); // fixed Huffman codes
+    Deflate(m_filtered);
+    WriteSymbol(endOfBlock);
+
+    m_rows += count;
+
+    const bool ok = WriteChunk("IDAT", m_compressed);
+    m_compressed.clear();
+    return ok;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief End closes the zlib stream and writes the end of the image.
+ * @return false if not all rows were written or the device cannot be written.
+ */
+bool VPngWriter::End()
+{
+    if (m_rows != m_height)
+    {
+        return false;
+    }
+
+    WriteBits(1, 1); // final block
+    WriteBits(1, 2); // fixed Huffman codes
+    WriteSymbol(endOfBlock);
+    FlushBits();
+
+    AppendUInt32(m_compressed, (m_adlerB << 16) | m_adlerA);
+
+    const bool ok = WriteChunk("IDAT", m_compressed) && WriteChunk("IEND", QByteArray());
+    m_compressed.clear();
+    return ok;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VPngWriter::WriteChunk(const char *type, const QByteArray &data)
+{
+    QByteArray chunk;
+    chunk.reserve(data.size() + 12);
+    AppendUInt32(chunk, static_cast<quint32>(data.size()));
+    chunk.append(type, 4);
+    chunk.append(data);
+
+    // CRC covers type and data
+    const quint32 crc = Crc(0xFFFFFFFFU, chunk.constData() + 4, chunk.size() - 4) ^ 0xFFFFFFFFU;
+    AppendUInt32(chunk, crc);
+
+    return m_device->write(chunk) == chunk.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPngWriter::Deflate(const QByteArray &data)
+{
+    const uchar *bytes = reinterpret_cast<const uchar *>(data.constData());
+    const int size = data.size();
+
+    int i = 0;
+    while (i < size)
+    {
+        const int byte = bytes[i];
+
+        if (byte == m_previousByte)
+        {
+            int run = 1;
+            while (i + run < size && run < maxMatch && bytes[i + run] == byte)
+            {
+                ++run;
+            }
+
+            if (run >= minMatch)
+            {
+                WriteLength(run);
+                WriteBits(0, 5); // distance 1, code 0 has no extra bits
+                i += run;
+                continue;
+            }
+        }
+
+        WriteSymbol(byte);
+        m_previousByte = byte;
+        ++i;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPngWriter::WriteBits(quint32 bits, int count)
+{
+    m_bitBuffer |= bits << m_bitCount;
+    m_bitCount += count;
+
+    while (m_bitCount >= 8)
+    {
+        m_compressed.append(static_cast<char>(m_bitBuffer & 0xFF));
+        m_bitBuffer >>= 8;
+        m_bitCount -= 8;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPngWriter::WriteSymbol(int symbol)
+{
+    // Fixed Huffman codes (RFC 1951, 3.2.6)
+    if (symbol <= 143)
+    {
+        WriteBits(ReverseBits(0x30 + static_cast<quint32>(symbol), 8), 8);
+    }
+    else if (symbol <= 255)
+    {
+        WriteBits(ReverseBits(0x190 + static_cast<quint32>(symbol - 144), 9), 9);
+    }
+    else if (symbol <= 279)
+    {
+        WriteBits(ReverseBits(static_cast<quint32>(symbol - 256), 7), 7);
+    }
+    else
+    {
+        WriteBits(ReverseBits(0xC0 + static_cast<quint32>(symbol - 280), 8), 8);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPngWriter::WriteLength(int length)
+{
+    int code = static_cast<int>(lengthBase.size()) - 1;
+    if (length < maxMatch)
+    {
+        code = static_cast<int>(std::upper_bound(lengthBase.cbegin(), lengthBase.cend() - 1, length) -
+                                lengthBase.cbegin()) - 1;
+    }
+
+    WriteSymbol(257 + code);
+
+    if (lengthExtraBits.at(static_cast<std::size_t>(code)) > 0)
+    {
+        WriteBits(static_cast<quint32>(length - lengthBase.at(static_cast<std::size_t>(code))),
+                  lengthExtraBits.at(static_cast<std::size_t>(code)));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPngWriter::FlushBits()
+{
+    if (m_bitCount > 0)
+    {
+        m_compressed.append(static_cast<char>(m_bitBuffer & 0xFF));
+    }
+    m_bitBuffer = 0;
+    m_bitCount = 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPngWriter::UpdateAdler(const QByteArray &data)
+{
+    const uchar *bytes = reinterpret_cast<const uchar *>(data.constData());
+    int size = data.size();
+
+    while (size > 0)
+    {
+        const int chunk = qMin(size, adlerMax);
+        for (int i = 0; i < chunk; ++i)
+        {
+            m_adlerA += bytes[i];
+            m_adlerB += m_adlerA;
+        }
+        m_adlerA %= adlerBase;
+        m_adlerB %= adlerBase;
+
+        bytes += chunk;
+        size -= chunk;
+    }
+}
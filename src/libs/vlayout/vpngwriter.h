@@ -0,0 +1,96 @@
+/************************************************************************
+ **
+ **  @file   vpngwriter.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VPNGWRITER_H
+#define VPNGWRITER_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+class QIODevice;
+class QImage;
+
+/**
+ * @brief The VPngWriter class writes a RGB PNG image row by row.
+ *
+ * QImageWriter needs the whole image in memory. A sheet of a long marker with high resolution can take gigabytes. This
+ * writer gets the image in bands of rows and writes each band to the device right away, so memory depends only on a
+ * band.
+ *
+ * Rows use the "Up" filter, white space becomes long runs of zeros. The zlib stream is built from fixed Huffman
+ * blocks, one block per band, with matches only on the previous byte. This is a simple run length encoding, but a
+ * layout is mostly empty paper and compresses well with it.
+ */
+class VPngWriter
+{
+public:
+    VPngWriter(QIODevice *device, int width, int height, qreal dpi);
+
+    bool Begin();
+    bool WriteRows(const QImage &image, int count);
+    bool End();
+
+    int RowsWritten() const;
+
+private:
+    Q_DISABLE_COPY(VPngWriter)
+
+    QIODevice *m_device;
+    int m_width;
+    int m_height;
+    qreal m_dpi;
+    int m_rows{0};
+
+    QByteArray m_previousRow{};
+    QByteArray m_filtered{};
+    QByteArray m_compressed{};
+
+    quint32 m_bitBuffer{0};
+    int m_bitCount{0};
+    int m_previousByte{-1};
+
+    quint32 m_adlerA{1};
+    quint32 m_adlerB{0};
+
+    bool WriteChunk(const char *type, const QByteArray &data);
+
+    void Deflate(const QByteArray &data);
+    void WriteBits(quint32 bits, int count);
+    void WriteSymbol(int symbol);
+    void WriteLength(int length);
+    void FlushBits();
+
+    void UpdateAdler(const QByteArray &data);
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+inline int VPngWriter::RowsWritten() const
+{
+    return m_rows;
+}
+
+#endif // VPNGWRITER_H
@@ -28,8 +28,9 @@
 
 #include "vposition.h"
 
+#include <QDebug>
 #include <QDir>
-#include <QtConcurrent>
+#include <QEventLoop>
 #include <QFutureWatcher>
 #include <QImage>
 #include <QLineF>
@@ -47,13 +48,17 @@
 #include <QStringData>
 #include <QStringDataPtr>
 #include <QThreadPool>
+#include <QTimer>
 #include <Qt>
-#include <functional>
+#include <QtMath>
+#include <QSharedPointer>
+#include <algorithm>
 
 #include "../vmisc/def.h"
 #include "../vmisc/vmath.h"
 #include "../ifc/exception/vexception.h"
 #include "../vpatterndb/floatItemData/floatitemdef.h"
+#include "vpositionscheduler.h"
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
 #include "../vmisc/backport/qscopeguard.h"
@@ -61,73 +66,78 @@
 #include <QScopeGuard>
 #endif
 
-//---------------------------------------------------------------------------------------------------------------------
-VPosition::VPosition()
-{}
+Q_LOGGING_CATEGORY(lPosition, "layout.position")
+
+namespace
+{
+// How often to check the stop flag while waiting for results, msecs
+const int stopCheckInterval = 50;
+}
 
 //---------------------------------------------------------------------------------------------------------------------
-VPosition::VPosition(const VPositionData &data, std::atomic_bool *stop, bool saveLength)
-    : m_isValid(true),
-      m_bestResult(VBestSquare(data.gContour.GetSize(), saveLength, data.isOriginPaperOrientationPortrait)),
-      m_data(data),
+VPosition::VPosition(const VPositionData &data, const VLayoutPieceSnapshot &snapshot, std::atomic_bool *stop,
+                     bool saveLength)
+    : m_data(data),
+      m_snapshot(snapshot),
       stop(stop),
+      m_scoreContour(data.gContour),
+      m_rotationNumber(RotationNumber(data)),
+      m_variantsCount(VariantsCount(data, m_rotationNumber)),
+      m_detailEdgesCount(data.detail.LayoutEdgesCount()),
       angle_between(0)
 {
-    if (m_data.rotationNumber > 360 || m_data.rotationNumber < 1)
+    if (saveLength)
     {
-        m_data.rotationNumber = 2;
+        m_scoreContour.CeateEmptySheetContour();
     }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void VPosition::run()
+/**
+ * @brief TasksCount return number of tasks needed to check all placements of a piece.
+ *
+ * Tasks are ordered by global contour edge, then by piece edge, then by variant. This is the same order in which
+ * the old per edge jobs checked placements.
+ */
+int VPosition::TasksCount(const VPositionData &data)
 {
-    if (not m_isValid)
-    {
-        return;
-    }
+    return data.gContour.GlobalEdgesCount() * data.detail.LayoutEdgesCount()
+            * VariantsCount(data, RotationNumber(data));
+}
 
+//---------------------------------------------------------------------------------------------------------------------
+void VPosition::RunTask(int task)
+{
     if (stop->load())
     {
         return;
     }
 
+    const int edgeTasks = m_detailEdgesCount * m_variantsCount;
+    m_task = task;
+    m_j = task / edgeTasks + 1;
+    m_i = (task % edgeTasks) / m_variantsCount + 1;
+
     try
     {
-        for (int i=1; i<= m_data.detail.LayoutEdgesCount(); ++i)
-        {
-            if (stop->load())
-            {
-                return;
-            }
-
-            m_data.i = i;
-            FindBestPosition();
-
-            if (stop->load())
-            {
-                return;
-            }
-        }
+        FindBestPosition(task % m_variantsCount);
     }
     catch (const VException &e)
     {
-        m_bestResult.TerminatedByException(QStringLiteral("%1\n\n%2").arg(e.ErrorMessage(), e.DetailedInformation()));
-        return;
+        if (m_exceptionReason.isEmpty())
+        {
+            m_exceptionReason = QStringLiteral("%1\n\n%2").arg(e.ErrorMessage(), e.DetailedInformation());
+        }
     }
     catch (std::exception& e)
     {
-        m_bestResult.TerminatedByException(QString::fromLatin1(e.what()));
-        return;
+        if (m_exceptionReason.isEmpty())
+        {
+            m_exceptionReason = QString::fromLatin1(e.what());
+        }
     }
 }
 
-//---------------------------------------------------------------------------------------------------------------------
-VBestSquare VPosition::getBestResult() const
-{
-    return m_bestResult;
-}
-
 //---------------------------------------------------------------------------------------------------------------------
 VBestSquare VPosition::ArrangeDetail(const VPositionData &data, std::atomic_bool *stop, bool saveLength)
 {
@@ -144,82 +154,135 @@ VBestSquare VPosition::ArrangeDetail(const VPositionData &data, std::atomic_bool
         return bestResult;
     }
 
-    const VLayoutPiece detail = data.detail;
-    const int detailEdgesCount = detail.LayoutEdgesCount();
-    if (detailEdgesCount < 3 || detail.DetailEdgesCount() < 3)
+    const int detailEdgesCount = data.detail.LayoutEdgesCount();
+    if (detailEdgesCount < 3 || data.detail.DetailEdgesCount() < 3)
     {
         return bestResult;//Not enough edges
     }
 
-    QFutureWatcher<VBestSquare> watcher;
-    QVector<VPosition> jobs;
-    jobs.reserve(data.gContour.GlobalEdgesCount());
+    VPositionScheduler scheduler(TasksCount(data), QThreadPool::globalInstance()->maxThreadCount());
 
-    for (int j=1; j <= data.gContour.GlobalEdgesCount(); ++j)
-    {
-        VPositionData linkedData = data;
-        linkedData.j = j;
+    const VLayoutPieceSnapshot snapshot(data.detail);
 
-        jobs.append(VPosition(linkedData, stop, saveLength));
+    // Each worker gets own context, all of them use the same data
+    QVector<QSharedPointer<VPosition>> contexts;
+    contexts.reserve(scheduler.WorkersCount());
+    for (int i = 0; i < scheduler.WorkersCount(); ++i)
+    {
+        contexts.append(QSharedPointer<VPosition>(new VPosition(data, snapshot, stop, saveLength)));
     }
 
-    Q_ASSERT(not jobs.isEmpty());
+    // Wait for results in a local event loop. The loop quits as soon as all jobs are done, meanwhile the application
+    // stays responsive and continues to deliver events (abort button, timeout timer).
+    QFutureWatcher<void> watcher;
+    QEventLoop wait;
+    QObject::connect(&watcher, &QFutureWatcher<void>::finished, &wait, &QEventLoop::quit);
 
-    std::function<VBestSquare (VPosition position)> Nest = [](VPosition position)
+    // The stop flag is an atomic, not an object with signals, so we check it periodically. This affects only how fast
+    // we react on stop, not how fast we get results.
+    QTimer stopCheck;
+    stopCheck.setInterval(stopCheckInterval);
+    QObject::connect(&stopCheck, &QTimer::timeout, &wait, [&wait, stop]()
     {
-        position.run();
-        return position.getBestResult();
-    };
+        if (stop->load())
+        {
+            wait.quit();
+        }
+    });
 
-    watcher.setFuture(QtConcurrent::mapped(jobs, Nest));
+    watcher.setFuture(scheduler.Start([&contexts](int worker, int task)
+    {
+        contexts.at(worker)->RunTask(task);
+    }, stop));
+
+    if (not watcher.isFinished())
+    {
+        stopCheck.start();
+        wait.exec();
+        stopCheck.stop();
+    }
 
-    while(not watcher.isStarted())
+    if (stop->load())
     {
-        QCoreApplication::processEvents();
-        QThread::msleep(250);
+        // Workers check the flag too and will finish soon
+        watcher.waitForFinished();
+        return bestResult;
     }
 
-    // Wait for done
-    do
+    qCDebug(lPosition, "Tasks: %d, workers: %d, initial share: %d, steals: %lld", scheduler.TasksCount(),
+            scheduler.WorkersCount(), scheduler.InitialShare(), scheduler.StealsCount());
+
+    if (data.counters != nullptr)
     {
-        QCoreApplication::processEvents();
-        QThread::msleep(250);
+        for (auto &context : contexts)
+        {
+            data.counters->placements += context->m_placements;
+            data.counters->collisionChecks += context->m_collisionChecks;
+        }
     }
-    while(watcher.isRunning() && not stop->load());
 
-    if (stop->load())
+    // Workers take tasks in any order. Restore the original order to get the same result in each run.
+    QVector<QPair<int, VBestSquareResData>> candidates;
+    QString exceptionReason;
+    for (auto &context : contexts)
     {
-        do
+        candidates += context->m_candidates;
+        if (exceptionReason.isEmpty())
         {
-            QCoreApplication::processEvents();
-            QThread::msleep(250);
+            exceptionReason = context->m_exceptionReason;
         }
-        while(watcher.isRunning());
+    }
 
-        return bestResult;
+    std::sort(candidates.begin(), candidates.end(),
+              [](const QPair<int, VBestSquareResData> &a, const QPair<int, VBestSquareResData> &b)
+    {
+        return a.first < b.first;
+    });
+
+    for (auto &candidate : candidates)
+    {
+        bestResult.NewResult(candidate.second);
     }
 
-    QList<VBestSquare> results = watcher.future().results();
-    for (auto &result : results)
+    if (not bestResult.HasValidResult() && not exceptionReason.isEmpty())
     {
-        bestResult.NewResult(result);
+        bestResult.TerminatedByException(exceptionReason);
     }
 
     return bestResult;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void VPosition::SaveCandidate(VBestSquare &bestResult, const VLayoutPiece &detail, int globalI, int detJ,
-                              BestFrom type)
+int VPosition::VariantsCount(const VPositionData &data, int rotationNumber)
 {
-    if (bestResult.IsSaveLength())
+    if (data.followGrainline && data.detail.IsGrainlineEnabled())
     {
-        m_data.gContour.CeateEmptySheetContour();
+        return 2; // Front and rear direction of grainline
     }
 
-    QVector<QPointF> newGContour = m_data.gContour.UniteWithContour(detail, globalI, detJ, type);
-    newGContour.append(newGContour.first());
-    const QSizeF size = QPolygonF(newGContour).boundingRect().size();
+    int count = 1; // Combine edges
+    if (data.rotate)
+    {
+        count += qCeil(360. / (360/rotationNumber));
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VPosition::RotationNumber(const VPositionData &data)
+{
+    if (data.rotationNumber > 360 || data.rotationNumber < 1)
+    {
+        return 2;
+    }
+    return data.rotationNumber;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPosition::SaveCandidate(const VLayoutPiece &detail, int globalI, int detJ, BestFrom type)
+{
+    // Score by bounding rect of the united contour. No need to build the contour itself.
+    const QSizeF size = m_scoreContour.UnitedBoundingRect(detail, globalI, detJ, type).size();
     const QRectF boundingRect = detail.DetailBoundingRect();
     const qreal depthPosition = m_data.isOriginPaperOrientationPortrait ? boundingRect.y() : boundingRect.x();
     const qreal sidePosition = m_data.isOriginPaperOrientationPortrait ? boundingRect.x() : boundingRect.y();
@@ -234,7 +297,7 @@ void VPosition::SaveCandidate(VBestSquare &bestResult, const VLayoutPiece &detai
     data.depthPosition = depthPosition;
     data.sidePosition = sidePosition;
 
-    bestResult.NewResult(data);
+    m_candidates.append(qMakePair(m_task, data));
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -347,35 +410,38 @@ void VPosition::RotateOnAngle(qreal angle)
     // We should use copy of the detail.
     VLayoutPiece workDetail = m_data.detail;
 
-    if (CheckRotationEdges(workDetail, m_data.j, m_data.i, angle))
+    if (CheckRotationEdges(workDetail, m_j, m_i, angle))
     {
-        SaveCandidate(m_bestResult, workDetail, m_data.j, m_data.i, BestFrom::Rotation);
+        SaveCandidate(workDetail, m_j, m_i, BestFrom::Rotation);
     }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 VPosition::CrossingType VPosition::Crossing(const VLayoutPiece &detail) const
 {
-    if (m_data.positionsCache.isEmpty())
+    if (m_data.positionsCache.IsEmpty())
     {
         return CrossingType::NoIntersection;
     }
 
-    const QVector<QPointF> layoutPoints = detail.GetLayoutAllowancePoints();
-    const QRectF layoutBoundingRect = VLayoutPiece::BoundingRect(layoutPoints);
-    const QPainterPath layoutAllowancePath = VLayoutPiece::PainterPath(layoutPoints);
-
-    const QVector<QPointF> contourPoints = detail.IsSeamAllowance() && not detail.IsSeamAllowanceBuiltIn() ?
-                detail.GetMappedSeamAllowancePoints() : detail.GetMappedContourPoints();
-    const QRectF detailBoundingRect = VLayoutPiece::BoundingRect(contourPoints);
-    const QPainterPath contourPath = VLayoutPiece::PainterPath(contourPoints);
+    m_snapshot.Map(detail.GetMatrix(), detail.IsMirror(), m_layoutAllowance, m_outline);
+    const QRectF layoutBoundingRect = m_layoutAllowance.BoundingRect();
+    const QRectF detailBoundingRect = m_outline.BoundingRect();
 
-    for(auto &position : m_data.positionsCache)
+    for(auto index : m_data.positionsCache.Candidates(layoutBoundingRect))
     {
+        const VCachedPositions &position = m_data.positionsCache.at(index);
         if (position.boundingRect.intersects(layoutBoundingRect) || position.boundingRect.contains(detailBoundingRect))
         {
-            if (position.layoutAllowancePath.contains(contourPath) ||
-                    position.layoutAllowancePath.intersects(layoutAllowancePath))
+            ++m_collisionChecks;
+            const bool crossing = position.layoutAllowance.Contains(m_outline) ||
+                    position.layoutAllowance.Intersects(m_layoutAllowance);
+
+#ifdef LAYOUT_VALIDATE_COLLISIONS
+            ValidateCrossing(position, m_layoutAllowance.Points(), m_outline.Points(), crossing);
+#endif
+
+            if (crossing)
             {
                 return CrossingType::Intersection;
             }
@@ -385,6 +451,29 @@ VPosition::CrossingType VPosition::Crossing(const VLayoutPiece &detail) const
     return CrossingType::NoIntersection;
 }
 
+#ifdef LAYOUT_VALIDATE_COLLISIONS
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ValidateCrossing compare result of the polygon collision kernel with QPainterPath based check.
+ *
+ * Enabled with CONFIG+=validateCollisions. Very slow, use only for testing.
+ */
+void VPosition::ValidateCrossing(const VCachedPositions &position, const QVector<QPointF> &layoutPoints,
+                                 const QVector<QPointF> &contourPoints, bool crossing)
+{
+    const QPainterPath positionPath = VLayoutPiece::PainterPath(position.layoutAllowance.Points());
+    const bool pathCrossing = positionPath.contains(VLayoutPiece::PainterPath(contourPoints)) ||
+            positionPath.intersects(VLayoutPiece::PainterPath(layoutPoints));
+
+    if (crossing != pathCrossing)
+    {
+        qWarning() << "Collision kernel mismatch. Kernel:" << crossing << "QPainterPath:" << pathCrossing
+                   << "Position:" << position.layoutAllowance.Points() << "Layout allowance:" << layoutPoints
+                   << "Contour:" << contourPoints;
+    }
+}
+#endif
+
 //---------------------------------------------------------------------------------------------------------------------
 bool VPosition::SheetContains(const QRectF &rect) const
 {
@@ -424,40 +513,35 @@ void VPosition::RotateEdges(VLayoutPiece &detail, const QLineF &globalEdge, int
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void VPosition::Rotate(int number)
+void VPosition::Rotate(int number, int index)
 {
+    // The same angle combining edges gives
+    angle_between = m_data.gContour.GlobalEdge(m_j).angleTo(m_data.detail.LayoutEdge(m_i));
+
     const qreal step = 360/number;
     qreal startAngle = 0;
     if (VFuzzyComparePossibleNulls(angle_between, 360))
     {
         startAngle = step;
     }
-    for (qreal angle = startAngle; angle < 360; angle = angle+step)
-    {
-        if (stop->load())
-        {
-            return;
-        }
 
+    const qreal angle = startAngle + step * index;
+    if (angle < 360)
+    {
         RotateOnAngle(angle);
     }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void VPosition::FollowGrainline()
+void VPosition::FollowGrainline(bool rear)
 {
-    if (stop->load())
-    {
-        return;
-    }
-
     QLineF detailGrainline(10, 10, 100, 10);
     detailGrainline.setAngle(m_data.detail.GrainlineAngle());
 
     if (m_data.detail.IsForceFlipping())
     {
         VLayoutPiece workDetail = m_data.detail; // We need copy for temp change
-        workDetail.Mirror(not m_data.followGrainline ? m_data.gContour.GlobalEdge(m_data.j) : QLineF(10, 10, 10, 100));
+        workDetail.Mirror(not m_data.followGrainline ? m_data.gContour.GlobalEdge(m_j) : QLineF(10, 10, 10, 100));
         detailGrainline = workDetail.GetMatrix().map(detailGrainline);
     }
 
@@ -467,51 +551,48 @@ void VPosition::FollowGrainline()
     }
 
     const qreal angle = detailGrainline.angleTo(FabricGrainline());
+    const GrainlineArrowDirection arrow = m_data.detail.GrainlineArrowType();
 
-    if (m_data.detail.GrainlineArrowType() == GrainlineArrowDirection::atBoth ||
-            m_data.detail.GrainlineArrowType() == GrainlineArrowDirection::atFront)
+    if (not rear && (arrow == GrainlineArrowDirection::atBoth || arrow == GrainlineArrowDirection::atFront))
     {
         RotateOnAngle(angle);
     }
-
-    if (stop->load())
-    {
-        return;
-    }
-
-    if (m_data.detail.GrainlineArrowType() == GrainlineArrowDirection::atBoth ||
-            m_data.detail.GrainlineArrowType() == GrainlineArrowDirection::atRear)
+    else if (rear && (arrow == GrainlineArrowDirection::atBoth || arrow == GrainlineArrowDirection::atRear))
     {
         RotateOnAngle(angle+180);
     }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void VPosition::FindBestPosition()
+/**
+ * @brief FindBestPosition check one placement variant for current pair of edges.
+ * @param variant index of variant. If the piece follows grainline 0 is front direction and 1 is rear direction.
+ * Otherwise 0 is combining edges and next values are rotation steps.
+ */
+void VPosition::FindBestPosition(int variant)
 {
+    ++m_placements;
+
     if (not m_data.followGrainline || not m_data.detail.IsGrainlineEnabled())
     {
-        // We should use copy of the detail.
-        VLayoutPiece workDetail = m_data.detail;
-
-        int dEdge = m_data.i;// For mirror detail edge will be different
-        if (CheckCombineEdges(workDetail, m_data.j, dEdge))
+        if (variant == 0)
         {
-            SaveCandidate(m_bestResult, workDetail, m_data.j, dEdge, BestFrom::Combine);
-        }
+            // We should use copy of the detail.
+            VLayoutPiece workDetail = m_data.detail;
 
-        if (stop->load())
-        {
-            return;
+            int dEdge = m_i;// For mirror detail edge will be different
+            if (CheckCombineEdges(workDetail, m_j, dEdge))
+            {
+                SaveCandidate(workDetail, m_j, dEdge, BestFrom::Combine);
+            }
         }
-
-        if (m_data.rotate)
+        else if (m_data.rotate)
         {
-            Rotate(m_data.rotationNumber);
+            Rotate(m_rotationNumber, variant - 1);
         }
     }
     else
     {
-        FollowGrainline();
+        FollowGrainline(variant == 1);
     }
 }
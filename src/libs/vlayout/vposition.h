@@ -30,7 +30,9 @@
 #define VPOSITION_H
 
 #include <qcompilerdetection.h>
-#include <QRunnable>
+#include <QLoggingCategory>
+#include <QPair>
+#include <QString>
 #include <QVector>
 #include <QtGlobal>
 #include <atomic>
@@ -38,45 +40,71 @@
 #include "vbestsquare.h"
 #include "vcontour.h"
 #include "vlayoutdef.h"
+#include "vflatpolygon.h"
 #include "vlayoutpiece.h"
+#include "vlayoutpiecesnapshot.h"
+#include "vpositionsindex.h"
+
+Q_DECLARE_LOGGING_CATEGORY(lPosition)
 
 struct VPositionData
 {
     VContour gContour{};
     VLayoutPiece detail{};
-    int i{-1};
-    int j{-1};
     bool rotate{false};
     int rotationNumber{0};
     bool followGrainline{false};
-    QVector<VCachedPositions> positionsCache{};
+    VPositionsIndex positionsCache{};
     bool isOriginPaperOrientationPortrait{true};
+    VLayoutCounters *counters{nullptr};
 };
 
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_GCC("-Weffc++")
 
+/**
+ * @brief The VPosition class checks placement of a piece on a sheet.
+ *
+ * Work is split in tasks. One task checks one placement variant for a pair of edges: combining a piece edge with a
+ * global contour edge, one rotation angle or one grainline direction. Each worker of VPositionScheduler gets own
+ * VPosition object. All objects share the same placement data by reference, the data must not change until the end.
+ *
+ * Collision check does not map points of a piece copy. Each object maps flat snapshot of the piece into own working
+ * buffers, so checking a candidate does not allocate.
+ */
 class VPosition
 {
 public:
-    VPosition();
-    VPosition(const VPositionData &data, std::atomic_bool *stop, bool saveLength);
-    VPosition(const VPosition&) = default;
-    VPosition& operator=(const VPosition&) = default;
-    VPosition& operator=(VPosition&&) = default;
-    virtual ~VPosition()= default;
+    VPosition(const VPositionData &data, const VLayoutPieceSnapshot &snapshot, std::atomic_bool *stop,
+              bool saveLength);
 
-    virtual void run();
+    static int TasksCount(const VPositionData &data);
 
-    VBestSquare getBestResult() const;
+    void RunTask(int task);
 
     static VBestSquare ArrangeDetail(const VPositionData &data, std::atomic_bool *stop, bool saveLength);
 
 private:
-    bool m_isValid{false};
-    VBestSquare m_bestResult{};
-    VPositionData m_data{};
+    Q_DISABLE_COPY(VPosition)
+    const VPositionData &m_data;
+    const VLayoutPieceSnapshot &m_snapshot;
     std::atomic_bool *stop{nullptr};
+    /** @brief m_scoreContour copy of global contour candidates are scored against. */
+    VContour m_scoreContour;
+    int m_rotationNumber;
+    int m_variantsCount;
+    int m_detailEdgesCount;
+    int m_task{-1};
+    int m_i{-1};
+    int m_j{-1};
+    QVector<QPair<int, VBestSquareResData>> m_candidates{};
+    QString m_exceptionReason{};
+    qint64 m_placements{0};
+    mutable qint64 m_collisionChecks{0};
+    /** @brief m_layoutAllowance working buffer for layout allowance of a candidate. Reused by all candidates. */
+    mutable VFlatPolygon m_layoutAllowance{};
+    /** @brief m_outline working buffer for seam allowance or contour of a candidate. Reused by all candidates. */
+    mutable VFlatPolygon m_outline{};
     /**
      * @brief angle_between keep angle between global edge and detail edge. Need for optimization rotation.
      */
@@ -96,7 +124,10 @@ private:
         EdgeError = 2
     };
 
-    void SaveCandidate(VBestSquare &bestResult, const VLayoutPiece &detail, int globalI, int detJ, BestFrom type);
+    static int VariantsCount(const VPositionData &data, int rotationNumber);
+    static int RotationNumber(const VPositionData &data);
+
+    void SaveCandidate(const VLayoutPiece &detail, int globalI, int detJ, BestFrom type);
 
     bool CheckCombineEdges(VLayoutPiece &detail, int j, int &dEdge);
     bool CheckRotationEdges(VLayoutPiece &detail, int j, int dEdge, qreal angle) const;
@@ -104,17 +135,21 @@ private:
     void RotateOnAngle(qreal angle);
 
     CrossingType Crossing(const VLayoutPiece &detail) const;
+#ifdef LAYOUT_VALIDATE_COLLISIONS
+    static void  ValidateCrossing(const VCachedPositions &position, const QVector<QPointF> &layoutPoints,
+                                  const QVector<QPointF> &contourPoints, bool crossing);
+#endif
     bool         SheetContains(const QRectF &rect) const;
 
     void CombineEdges(VLayoutPiece &detail, const QLineF &globalEdge, int dEdge);
     static void RotateEdges(VLayoutPiece &detail, const QLineF &globalEdge, int dEdge, qreal angle);
 
-    void Rotate(int number);
-    void FollowGrainline();
+    void Rotate(int number, int index);
+    void FollowGrainline(bool rear);
 
     QLineF FabricGrainline() const;
 
-    void FindBestPosition();
+    void FindBestPosition(int variant);
 };
 
 QT_WARNING_POP
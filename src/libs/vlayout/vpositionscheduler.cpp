@@ -0,0 +1,200 @@
+/************************************************************************
+ **
+ **  @file   vpositionscheduler.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vpositionscheduler.h"
+
+#include <QMutexLocker>
+#include <QtConcurrent/QtConcurrentMap>
+
+//---------------------------------------------------------------------------------------------------------------------
+VPositionScheduler::VPositionScheduler(int tasksCount, int workersCount)
+    : m_tasksCount(qMax(0, tasksCount)),
+      m_queues()
+{
+    const int count = qMax(1, qMin(workersCount, m_tasksCount));
+    m_queues.reset(new Queue[count]);
+    m_workers.reserve(count);
+
+    for (int i = 0; i < count; ++i)
+    {
+        m_workers.append(i);
+        m_queues[i].begin = static_cast<int>(static_cast<qint64>(m_tasksCount) * i / count);
+        m_queues[i].end = static_cast<int>(static_cast<qint64>(m_tasksCount) * (i + 1) / count);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Start run all tasks.
+ *
+ * Each worker checks the stop flag before taking next task. The scheduler must live until the returned future is
+ * finished.
+ * @param task function to call for each task. Calls with the same worker index never overlap.
+ * @param stop stop flag.
+ * @return future that will be finished when all tasks are done or the process was stopped.
+ */
+QFuture<void> VPositionScheduler::Start(const Task &task, std::atomic_bool *stop)
+{
+    m_task = task;
+    m_stop = stop;
+
+    return QtConcurrent::map(m_workers, [this](int worker) {Work(worker);});
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VPositionScheduler::TasksCount() const
+{
+    return m_tasksCount;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VPositionScheduler::WorkersCount() const
+{
+    return m_workers.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief QueueDepth return number of tasks still waiting in all queues.
+ */
+int VPositionScheduler::QueueDepth() const
+{
+    int depth = 0;
+    for (int i = 0; i < m_workers.size(); ++i)
+    {
+        QMutexLocker locker(&m_queues[i].mutex);
+        depth += m_queues[i].end - m_queues[i].begin;
+    }
+    return depth;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief InitialShare return the biggest number of tasks one worker gets at start.
+ *
+ * Stealing takes half of a queue, so no queue grows longer than this later.
+ */
+int VPositionScheduler::InitialShare() const
+{
+    const int count = m_workers.size();
+    return (m_tasksCount + count - 1) / count;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qint64 VPositionScheduler::ExecutedCount() const
+{
+    return m_executed.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qint64 VPositionScheduler::StealsCount() const
+{
+    return m_steals.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPositionScheduler::Work(int worker)
+{
+    int task = -1;
+    while (not m_stop->load())
+    {
+        if (Pop(worker, task))
+        {
+            m_task(worker, task);
+            ++m_executed;
+        }
+        else if (not Steal(worker))
+        {
+            // No new tasks can appear. What is left is already being processed by other workers.
+            return;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VPositionScheduler::Pop(int worker, int &task)
+{
+    Queue &queue = m_queues[worker];
+    QMutexLocker locker(&queue.mutex);
+
+    if (queue.begin >= queue.end)
+    {
+        return false;
+    }
+
+    task = queue.begin++;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VPositionScheduler::Steal(int worker)
+{
+    const int count = m_workers.size();
+
+    // Pick the biggest queue. Sizes can change meanwhile, it is only a hint.
+    int victim = -1;
+    int victimDepth = 0;
+    for (int i = 1; i < count; ++i)
+    {
+        const int candidate = (worker + i) % count;
+        QMutexLocker locker(&m_queues[candidate].mutex);
+        const int depth = m_queues[candidate].end - m_queues[candidate].begin;
+        if (depth > victimDepth)
+        {
+            victim = candidate;
+            victimDepth = depth;
+        }
+    }
+
+    if (victim < 0)
+    {
+        return false;
+    }
+
+    int begin = 0;
+    int end = 0;
+    {
+        // Never hold two locks at the same time, two workers can try to steal from each other
+        QMutexLocker locker(&m_queues[victim].mutex);
+        Queue &queue = m_queues[victim];
+        if (queue.begin >= queue.end)
+        {
+            return true; // Someone was faster, try again
+        }
+
+        end = queue.end;
+        begin = queue.begin + (queue.end - queue.begin) / 2;
+        queue.end = begin;
+    }
+
+    QMutexLocker locker(&m_queues[worker].mutex);
+    m_queues[worker].begin = begin;
+    m_queues[worker].end = end;
+    ++m_steals;
+
+    return true;
+}
@@ -0,0 +1,89 @@
+/************************************************************************
+ **
+ **  @file   vpositionscheduler.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VPOSITIONSCHEDULER_H
+#define VPOSITIONSCHEDULER_H
+
+#include <QFuture>
+#include <QMutex>
+#include <QScopedArrayPointer>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+#include <functional>
+
+/**
+ * @brief The VPositionScheduler class runs a fixed number of independent placement tasks on the global thread pool
+ * with work stealing.
+ *
+ * Tasks are identified by index in range [0, tasksCount). At start each worker gets an equal continuous range of
+ * tasks as own queue. A worker takes tasks from the front of its queue. When own queue is empty the worker steals the
+ * back half of the biggest queue of another worker. Cost of placement tasks is very different (some positions fail on
+ * the first check, others go through all rotations), stealing keeps all workers busy until the end.
+ *
+ * A queue is just a range of indexes, so the scheduler never allocates memory per task.
+ */
+class VPositionScheduler
+{
+public:
+    using Task = std::function<void (int worker, int task)>;
+
+    VPositionScheduler(int tasksCount, int workersCount);
+
+    QFuture<void> Start(const Task &task, std::atomic_bool *stop);
+
+    int    TasksCount() const;
+    int    WorkersCount() const;
+    int    QueueDepth() const;
+    int    InitialShare() const;
+    qint64 ExecutedCount() const;
+    qint64 StealsCount() const;
+
+private:
+    Q_DISABLE_COPY(VPositionScheduler)
+
+    struct Queue
+    {
+        mutable QMutex mutex{};
+        int begin{0};
+        int end{0};
+    };
+
+    int m_tasksCount;
+    QVector<int> m_workers{};
+    QScopedArrayPointer<Queue> m_queues;
+    Task m_task{};
+    std::atomic_bool *m_stop{nullptr};
+    std::atomic<qint64> m_executed{0};
+    std::atomic<qint64> m_steals{0};
+
+    void Work(int worker);
+    bool Pop(int worker, int &task);
+    bool Steal(int worker);
+};
+
+#endif // VPOSITIONSCHEDULER_H
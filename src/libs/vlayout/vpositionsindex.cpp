@@ -0,0 +1,80 @@
+/************************************************************************
+ **
+ **  @file   vpositionsindex.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vpositionsindex.h"
+
+#include <QtGlobal>
+
+namespace
+{
+// Protect from huge grids when the first piece is very small compared to the sheet.
+const int maxCells = 1 << 16;
+// Smallest cell we allow. One centimeter in pixels.
+const qreal minCellSize = 37.8;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VPositionsIndex::VPositionsIndex(const QRectF &area)
+    : m_area(area)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPositionsIndex::Append(const VCachedPositions &position)
+{
+    if (m_grid.IsEmpty())
+    {
+        InitGrid(position.boundingRect);
+    }
+
+    m_grid.Insert(m_positions.size(), position.boundingRect);
+    m_positions.append(position);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Candidates return indexes of positions which bounding rectangle can intersect the rect.
+ *
+ * The result is a superset of positions which really intersect the rect. Indexes are sorted and unique, so the caller
+ * gets the same order as a linear walk over positions.
+ * @param rect bounding rectangle of a candidate placement.
+ * @return list of position indexes.
+ */
+QVector<int> VPositionsIndex::Candidates(const QRectF &rect) const
+{
+    return m_grid.Candidates(rect);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPositionsIndex::InitGrid(const QRectF &rect)
+{
+    if (m_area.isEmpty())
+    {
+        m_area = rect;
+    }
+
+    m_grid = VUniformGrid::WithCellSize(m_area, qMax(qMax(rect.width(), rect.height()), minCellSize), maxCells);
+}
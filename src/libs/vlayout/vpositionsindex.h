@@ -0,0 +1,99 @@
+/************************************************************************
+ **
+ **  @file   vpositionsindex.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VPOSITIONSINDEX_H
+#define VPOSITIONSINDEX_H
+
+#include <QRectF>
+#include <QTypeInfo>
+#include <QVector>
+#include <QtGlobal>
+
+#include "vlayoutdef.h"
+#include "vuniformgrid.h"
+
+/**
+ * @brief The VPositionsIndex class keeps positions of pieces already placed on a sheet and a uniform grid over their
+ * bounding rectangles.
+ *
+ * Collision check for a candidate placement asks only for positions from cells under the candidate's bounding
+ * rectangle instead of walking the whole list. Size of a cell is taken from the first added position. Because the bank
+ * gives big pieces first this gives cells close to size of the biggest piece.
+ *
+ * All data is kept in implicitly shared containers, so copying an index into each placement job is cheap.
+ */
+class VPositionsIndex
+{
+public:
+    VPositionsIndex() = default;
+    explicit VPositionsIndex(const QRectF &area);
+
+    void Append(const VCachedPositions &position);
+
+    bool IsEmpty() const;
+    int  Count() const;
+
+    const VCachedPositions &at(int i) const;
+    QVector<VCachedPositions> Positions() const;
+
+    QVector<int> Candidates(const QRectF &rect) const;
+
+private:
+    QRectF m_area{};
+    QVector<VCachedPositions> m_positions{};
+    VUniformGrid m_grid{};
+
+    void InitGrid(const QRectF &rect);
+};
+
+Q_DECLARE_TYPEINFO(VPositionsIndex, Q_MOVABLE_TYPE);
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool VPositionsIndex::IsEmpty() const
+{
+    return m_positions.isEmpty();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline int VPositionsIndex::Count() const
+{
+    return m_positions.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline const VCachedPositions &VPositionsIndex::at(int i) const
+{
+    return m_positions.at(i);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QVector<VCachedPositions> VPositionsIndex::Positions() const
+{
+    return m_positions;
+}
+
+#endif // VPOSITIONSINDEX_H
@@ -0,0 +1,173 @@
+/************************************************************************
+ **
+ **  @file   vuniformgrid.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vuniformgrid.h"
+
+#include <QtMath>
+#include <algorithm>
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VUniformGrid create grid with fixed number of cells.
+ *
+ * A dimension with zero size gets one cell.
+ * @param area area the grid covers.
+ * @param columns number of columns.
+ * @param rows number of rows.
+ */
+VUniformGrid::VUniformGrid(const QRectF &area, int columns, int rows)
+    : m_area(area),
+      m_columns(qMax(1, columns)),
+      m_rows(qMax(1, rows))
+{
+    m_cellWidth = m_area.width() / m_columns;
+    if (m_cellWidth <= 0)
+    {
+        m_columns = 1;
+    }
+
+    m_cellHeight = m_area.height() / m_rows;
+    if (m_cellHeight <= 0)
+    {
+        m_rows = 1;
+    }
+
+    m_cells = QVector<QVector<int>>(m_columns * m_rows);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief WithCellSize create grid of square cells.
+ * @param area area the grid covers.
+ * @param cellSize wanted size of a cell. The size is doubled until the grid has not more than maxCells cells.
+ * @param maxCells protects from huge grids when cells are very small compared to the area.
+ * @return grid.
+ */
+VUniformGrid VUniformGrid::WithCellSize(const QRectF &area, qreal cellSize, int maxCells)
+{
+    int columns = 1;
+    int rows = 1;
+    auto Size = [area, &cellSize, &columns, &rows]()
+    {
+        columns = qMax(1, qCeil(area.width() / cellSize));
+        rows = qMax(1, qCeil(area.height() / cellSize));
+    };
+
+    if (cellSize > 0)
+    {
+        Size();
+        while (static_cast<qint64>(columns) * rows > qMax(maxCells, 1))
+        {
+            cellSize *= 2;
+            Size();
+        }
+    }
+
+    return VUniformGrid(area, columns, rows);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VUniformGrid::Insert(int item, const QRectF &rect)
+{
+    if (m_cells.isEmpty())
+    {
+        return;
+    }
+
+    int column1 = 0;
+    int row1 = 0;
+    int column2 = 0;
+    int row2 = 0;
+    CellRange(rect, column1, row1, column2, row2);
+
+    for (int row = row1; row <= row2; ++row)
+    {
+        for (int column = column1; column <= column2; ++column)
+        {
+            m_cells[row * m_columns + column].append(item);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Candidates return items which rectangle can intersect the rect.
+ *
+ * Indexes are sorted and unique, so the caller gets the same order as a linear walk over items.
+ * @param rect rectangle to look under.
+ * @return list of item indexes.
+ */
+QVector<int> VUniformGrid::Candidates(const QRectF &rect) const
+{
+    QVector<int> candidates;
+
+    if (m_cells.isEmpty())
+    {
+        return candidates;
+    }
+
+    int column1 = 0;
+    int row1 = 0;
+    int column2 = 0;
+    int row2 = 0;
+    CellRange(rect, column1, row1, column2, row2);
+
+    for (int row = row1; row <= row2; ++row)
+    {
+        for (int column = column1; column <= column2; ++column)
+        {
+            candidates += m_cells.at(row * m_columns + column);
+        }
+    }
+
+    if (row1 != row2 || column1 != column2)
+    {
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    }
+
+    return candidates;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VUniformGrid::CellRange(const QRectF &rect, int &column1, int &row1, int &column2, int &row2) const
+{
+    auto Column = [this](qreal x)
+    {
+        return m_columns == 1 ? 0 : qBound(0, qFloor((x - m_area.left()) / m_cellWidth), m_columns - 1);
+    };
+
+    auto Row = [this](qreal y)
+    {
+        return m_rows == 1 ? 0 : qBound(0, qFloor((y - m_area.top()) / m_cellHeight), m_rows - 1);
+    };
+
+    column1 = Column(rect.left());
+    column2 = Column(rect.right());
+    row1 = Row(rect.top());
+    row2 = Row(rect.bottom());
+}
@@ -0,0 +1,122 @@
+/************************************************************************
+ **
+ **  @file   vuniformgrid.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VUNIFORMGRID_H
+#define VUNIFORMGRID_H
+
+#include <QRectF>
+#include <QTypeInfo>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @brief The VUniformGrid class is a uniform grid over bounding rectangles of items.
+ *
+ * Each cell keeps indexes of items whose rectangle touches the cell. A query visits only cells under a rectangle
+ * instead of all items, so the result is a superset of items which rectangles really intersect it. Rectangles that go
+ * out of the grid area are kept in the border cells. Clamping is monotone, so two overlapping rectangles always share
+ * at least one cell. A grid with one column is a list of horizontal bands.
+ *
+ * Cells are kept in implicitly shared containers, so copying a grid is cheap.
+ */
+class VUniformGrid
+{
+public:
+    VUniformGrid() = default;
+    VUniformGrid(const QRectF &area, int columns, int rows);
+
+    static VUniformGrid WithCellSize(const QRectF &area, qreal cellSize, int maxCells);
+
+    bool IsEmpty() const;
+
+    void Insert(int item, const QRectF &rect);
+
+    template <typename Func>
+    bool Visit(const QRectF &rect, Func func) const;
+
+    QVector<int> Candidates(const QRectF &rect) const;
+
+private:
+    QRectF m_area{};
+    QVector<QVector<int>> m_cells{};
+    qreal m_cellWidth{0};
+    qreal m_cellHeight{0};
+    int m_columns{0};
+    int m_rows{0};
+
+    void CellRange(const QRectF &rect, int &column1, int &row1, int &column2, int &row2) const;
+};
+
+Q_DECLARE_TYPEINFO(VUniformGrid, Q_MOVABLE_TYPE);
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool VUniformGrid::IsEmpty() const
+{
+    return m_cells.isEmpty();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Visit call the function for each item from cells under the rect.
+ *
+ * An item that touches several cells is visited once for each of them.
+ * @param rect rectangle to look under.
+ * @param func function that takes index of an item. Returning true stops the walk.
+ * @return true if the function stopped the walk.
+ */
+template <typename Func>
+inline bool VUniformGrid::Visit(const QRectF &rect, Func func) const
+{
+    if (m_cells.isEmpty())
+    {
+        return false;
+    }
+
+    int column1 = 0;
+    int row1 = 0;
+    int column2 = 0;
+    int row2 = 0;
+    CellRange(rect, column1, row1, column2, row2);
+
+    for (int row = row1; row <= row2; ++row)
+    {
+        for (int column = column1; column <= column2; ++column)
+        {
+            for (auto item : m_cells.at(row * m_columns + column))
+            {
+                if (func(item))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+#endif // VUNIFORMGRID_H
@@ -55,6 +55,7 @@ const QString LONG_OPTION_EXPORTONLYDETAILS = QStringLiteral("exportOnlyDetails"
 const QString LONG_OPTION_EXPORTSUCHDETAILS = QStringLiteral("exportSuchDetails");
 const QString LONG_OPTION_EXPXSCALE         = QStringLiteral("xscale");
 const QString LONG_OPTION_EXPYSCALE         = QStringLiteral("yscale");
+const QString LONG_OPTION_EXPDPI            = QStringLiteral("dpi");
 
 const QString LONG_OPTION_CROP_LENGTH       = QStringLiteral("crop");
 const QString SINGLE_OPTION_CROP_LENGTH     = QStringLiteral("c");
@@ -87,6 +88,8 @@ const QString SINGLE_OPTION_GROUPPING       = QStringLiteral("g");
 
 const QString LONG_OPTION_TEST              = QStringLiteral("test");
 const QString SINGLE_OPTION_TEST            = QStringLiteral("t");
+const QString LONG_OPTION_CHECK_INCREMENTAL = QStringLiteral("checkIncremental");
+const QString LONG_OPTION_CHECK_PARALLEL = QStringLiteral("checkParallel");
 
 const QString LONG_OPTION_PENDANTIC         = QStringLiteral("pedantic");
 
@@ -96,6 +99,9 @@ const QString SINGLE_OPTION_GRADATIONSIZE   = QStringLiteral("x");
 const QString LONG_OPTION_GRADATIONHEIGHT   = QStringLiteral("gheight");
 const QString SINGLE_OPTION_GRADATIONHEIGHT = QStringLiteral("e");
 
+const QString LONG_OPTION_GRADATIONSIZES    = QStringLiteral("gsizes");
+const QString LONG_OPTION_GRADATIONHEIGHTS  = QStringLiteral("gheights");
+
 const QString LONG_OPTION_USER_MATERIAL     = QStringLiteral("userMaterial");
 
 const QString LONG_OPTION_IGNORE_MARGINS    = QStringLiteral("ignoremargins");
@@ -137,6 +143,8 @@ const QString LONG_OPTION_LANDSCAPE_ORIENTATION = QStringLiteral("landscapeOrien
 
 const QString LONG_OPTION_NEST_QUANTITY = QStringLiteral("nestQuantity");
 const QString LONG_OPTION_PREFER_ONE_SHEET_SOLUTION = QStringLiteral("preferOneSheetSolution");
+const QString LONG_OPTION_MULTI_START = QStringLiteral("multiStart");
+const QString LONG_OPTION_NO_FIT_POLYGON = QStringLiteral("noFitPolygon");
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
@@ -158,6 +166,7 @@ QStringList AllKeys()
         LONG_OPTION_EXPORTSUCHDETAILS,
         LONG_OPTION_EXPXSCALE,
         LONG_OPTION_EXPYSCALE,
+        LONG_OPTION_EXPDPI,
         LONG_OPTION_CROP_LENGTH, SINGLE_OPTION_CROP_LENGTH,
         LONG_OPTION_CROP_WIDTH,
         LONG_OPTION_UNITE, SINGLE_OPTION_UNITE,
@@ -169,9 +178,13 @@ QStringList AllKeys()
         LONG_OPTION_GAPWIDTH, SINGLE_OPTION_GAPWIDTH,
         LONG_OPTION_GROUPPING, SINGLE_OPTION_GROUPPING,
         LONG_OPTION_TEST, SINGLE_OPTION_TEST,
+        LONG_OPTION_CHECK_INCREMENTAL,
+        LONG_OPTION_CHECK_PARALLEL,
         LONG_OPTION_PENDANTIC,
         LONG_OPTION_GRADATIONSIZE, SINGLE_OPTION_GRADATIONSIZE,
         LONG_OPTION_GRADATIONHEIGHT, SINGLE_OPTION_GRADATIONHEIGHT,
+        LONG_OPTION_GRADATIONSIZES,
+        LONG_OPTION_GRADATIONHEIGHTS,
         LONG_OPTION_USER_MATERIAL,
         LONG_OPTION_IGNORE_MARGINS, SINGLE_OPTION_IGNORE_MARGINS,
         LONG_OPTION_LEFT_MARGIN, SINGLE_OPTION_LEFT_MARGIN,
@@ -195,6 +208,8 @@ QStringList AllKeys()
         LONG_OPTION_MANUAL_PRIORITY,
         LONG_OPTION_LANDSCAPE_ORIENTATION,
         LONG_OPTION_NEST_QUANTITY,
-        LONG_OPTION_PREFER_ONE_SHEET_SOLUTION
+        LONG_OPTION_PREFER_ONE_SHEET_SOLUTION,
+        LONG_OPTION_MULTI_START,
+        LONG_OPTION_NO_FIT_POLYGON
     };
 }
@@ -52,6 +52,7 @@ extern const QString LONG_OPTION_EXPORTONLYDETAILS;
 extern const QString LONG_OPTION_EXPORTSUCHDETAILS;
 extern const QString LONG_OPTION_EXPXSCALE;
 extern const QString LONG_OPTION_EXPYSCALE;
+extern const QString LONG_OPTION_EXPDPI;
 
 extern const QString LONG_OPTION_CROP_LENGTH;
 extern const QString SINGLE_OPTION_CROP_LENGTH;
@@ -84,6 +85,8 @@ extern const QString SINGLE_OPTION_GROUPPING;
 
 extern const QString LONG_OPTION_TEST;
 extern const QString SINGLE_OPTION_TEST;
+extern const QString LONG_OPTION_CHECK_INCREMENTAL;
+extern const QString LONG_OPTION_CHECK_PARALLEL;
 
 extern const QString LONG_OPTION_PENDANTIC;
 
@@ -93,6 +96,9 @@ extern const QString SINGLE_OPTION_GRADATIONSIZE;
 extern const QString LONG_OPTION_GRADATIONHEIGHT;
 extern const QString SINGLE_OPTION_GRADATIONHEIGHT;
 
+extern const QString LONG_OPTION_GRADATIONSIZES;
+extern const QString LONG_OPTION_GRADATIONHEIGHTS;
+
 extern const QString LONG_OPTION_USER_MATERIAL;
 
 extern const QString LONG_OPTION_IGNORE_MARGINS;
@@ -131,6 +137,8 @@ extern const QString LONG_OPTION_MANUAL_PRIORITY;
 extern const QString LONG_OPTION_LANDSCAPE_ORIENTATION;
 extern const QString LONG_OPTION_NEST_QUANTITY;
 extern const QString LONG_OPTION_PREFER_ONE_SHEET_SOLUTION;
+extern const QString LONG_OPTION_MULTI_START;
+extern const QString LONG_OPTION_NO_FIT_POLYGON;
 
 QStringList AllKeys();
 
@@ -95,6 +95,8 @@ Q_GLOBAL_STATIC_WITH_ARGS(const QString, settingLayoutAutoCropWidth, (QLatin1Str
 Q_GLOBAL_STATIC_WITH_ARGS(const QString, settingLayoutSaveLength, (QLatin1String("layout/saveLength")))
 Q_GLOBAL_STATIC_WITH_ARGS(const QString, settingLayoutPreferOneSheetSolution,
                           (QLatin1String("layout/preferOneSheetSolution")))
+Q_GLOBAL_STATIC_WITH_ARGS(const QString, settingLayoutMultiStart, (QLatin1String("layout/multiStart")))
+Q_GLOBAL_STATIC_WITH_ARGS(const QString, settingLayoutNoFitPolygon, (QLatin1String("layout/noFitPolygon")))
 Q_GLOBAL_STATIC_WITH_ARGS(const QString, settingLayoutUnitePages, (QLatin1String("layout/unitePages")))
 Q_GLOBAL_STATIC_WITH_ARGS(const QString, settingFields, (QLatin1String("layout/fields")))
 Q_GLOBAL_STATIC_WITH_ARGS(const QString, settingIgnoreFields, (QLatin1String("layout/ignoreFields")))
@@ -448,6 +450,42 @@ void VSettings::SetLayoutPreferOneSheetSolution(bool value)
     setValue(*settingLayoutPreferOneSheetSolution, value);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool VSettings::GetLayoutMultiStart() const
+{
+    return value(*settingLayoutMultiStart, GetDefLayoutMultiStart()).toBool();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VSettings::GetDefLayoutMultiStart()
+{
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VSettings::SetLayoutMultiStart(bool value)
+{
+    setValue(*settingLayoutMultiStart, value);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VSettings::GetLayoutNoFitPolygon() const
+{
+    return value(*settingLayoutNoFitPolygon, GetDefLayoutNoFitPolygon()).toBool();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VSettings::GetDefLayoutNoFitPolygon()
+{
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VSettings::SetLayoutNoFitPolygon(bool value)
+{
+    setValue(*settingLayoutNoFitPolygon, value);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 bool VSettings::GetLayoutUnitePages() const
 {
@@ -114,6 +114,14 @@ public:
     static bool GetDefLayoutPreferOneSheetSolution();
     void SetLayoutPreferOneSheetSolution(bool value);
 
+    bool GetLayoutMultiStart() const;
+    static bool GetDefLayoutMultiStart();
+    void SetLayoutMultiStart(bool value);
+
+    bool GetLayoutNoFitPolygon() const;
+    static bool GetDefLayoutNoFitPolygon();
+    void SetLayoutNoFitPolygon(bool value);
+
     bool GetLayoutUnitePages() const;
     static bool GetDefLayoutUnitePages();
     void SetLayoutUnitePages(bool value);
@@ -0,0 +1,595 @@
+/************************************************************************
+ **
+ **  @file   vearclipping.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vearclipping.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <limits>
+
+#include "../vmisc/def.h"
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+// Positive if c lies to the left of a line from a to b.
+inline qreal Cross(const QPointF &a, const QPointF &b, const QPointF &c)
+{
+    return (b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Triangle must be counterclockwise. Points on edges are inside.
+inline bool InTriangle(const QPointF &a, const QPointF &b, const QPointF &c, const QPointF &p)
+{
+    return Cross(a, b, p) >= 0 && Cross(b, c, p) >= 0 && Cross(c, a, p) >= 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Triangle may have any orientation. Points on edges are inside.
+inline bool InAnyTriangle(const QPointF &a, const QPointF &b, const QPointF &c, const QPointF &p)
+{
+    const qreal d1 = Cross(a, b, p);
+    const qreal d2 = Cross(b, c, p);
+    const qreal d3 = Cross(c, a, p);
+    return (d1 >= 0 && d2 >= 0 && d3 >= 0) || (d1 <= 0 && d2 <= 0 && d3 <= 0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool Less(const QPointF &a, const QPointF &b)
+{
+    return a.x() < b.x() || (VFuzzyComparePossibleNulls(a.x(), b.x()) && a.y() < b.y());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief The VEarClipper class keeps contours as rings of nodes in a doubly linked list over vectors.
+ *
+ * A node refers to a point by index. Bridges to holes repeat points, so two nodes may refer to the same point.
+ *
+ * Check of an ear looks through all reflex vertices, so cutting all ears takes quadratic time. For big polygons nodes
+ * are also linked in z-order (Morton code of a point). Points inside a bounding box of a triangle have z-order between
+ * z-order of corners of the box, so the check looks only through nodes near the triangle.
+ */
+class VEarClipper
+{
+public:
+    explicit VEarClipper(const QVector<QPointF> &points);
+
+    int  Ring(int begin, int end, bool counterclockwise);
+    void EliminateHoles(int outer, QVector<int> holes);
+
+    QVector<int> Triangulate(int ear);
+
+private:
+    const QVector<QPointF> &m_points;
+    QVector<int> m_index{};
+    QVector<int> m_previous{};
+    QVector<int> m_next{};
+    QVector<int> m_triangles{};
+    int m_count{0};
+
+    QVector<quint32> m_zOrder{};
+    QVector<int> m_previousZ{};
+    QVector<int> m_nextZ{};
+    QPointF m_min{};
+    qreal m_scale{0};
+
+    const QPointF &Point(int node) const;
+    int   Node(int index);
+    void  IndexCurve(int ear);
+    quint32 ZOrder(const QPointF &point) const;
+    qreal Corner(int node) const;
+    bool  IsEar(int ear) const;
+    bool  LocallyInside(int a, int b) const;
+    int   FindBridge(int hole, int outer) const;
+    void  Split(int a, int b);
+    void  Cut(int ear);
+    void  Remove(int node);
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+VEarClipper::VEarClipper(const QVector<QPointF> &points)
+    : m_points(points)
+{
+    m_index.reserve(points.size());
+    m_previous.reserve(points.size());
+    m_next.reserve(points.size());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Ring links points from begin to end into a ring.
+ * @param begin index of the first point.
+ * @param end index after the last point.
+ * @param counterclockwise orientation of the ring. The order of points is reversed if needed.
+ * @return the first node of the ring or -1 if the contour has no area.
+ */
+int VEarClipper::Ring(int begin, int end, bool counterclockwise)
+{
+    if (end - begin > 1 && m_points.at(begin) == m_points.at(end - 1))
+    {
+        --end;
+    }
+
+    if (end - begin < 3)
+    {
+        return -1;
+    }
+
+    qreal area = 0;
+    for (int i = begin, j = end - 1; i < end; j = i++)
+    {
+        area += (m_points.at(j).x() - m_points.at(i).x()) * (m_points.at(j).y() + m_points.at(i).y());
+    }
+
+    if (qFuzzyIsNull(area))
+    {
+        return -1;
+    }
+
+    const bool reverse = (area > 0) != counterclockwise;
+
+    const int first = m_index.size();
+    const int count = end - begin;
+    for (int i = 0; i < count; ++i)
+    {
+        const int node = Node(reverse ? end - 1 - i : begin + i);
+        m_previous[node] = first + (i + count - 1) % count;
+        m_next[node] = first + (i + 1) % count;
+    }
+
+    m_count += count;
+    return first;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EliminateHoles joins holes to the outer ring with bridges.
+ *
+ * Holes are joined from left to right. A bridge goes from the leftmost point of a hole to a visible point of the outer
+ * ring to the left of it, so the next holes see bridges of the previous ones as a part of the outer ring.
+ */
+void VEarClipper::EliminateHoles(int outer, QVector<int> holes)
+{
+    for (auto &hole : holes)
+    {
+        int leftmost = hole;
+        for (int node = m_next.at(hole); node != hole; node = m_next.at(node))
+        {
+            if (Less(Point(node), Point(leftmost)))
+            {
+                leftmost = node;
+            }
+        }
+        hole = leftmost;
+    }
+
+    std::sort(holes.begin(), holes.end(), [this](int a, int b) {return Less(Point(a), Point(b));});
+
+    for (auto hole : holes)
+    {
+        const int bridge = FindBridge(hole, outer);
+        if (bridge != -1)
+        {
+            Split(bridge, hole);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<int> VEarClipper::Triangulate(int ear)
+{
+    m_triangles.reserve((m_count - 2) * 3);
+
+    // Small polygons are faster without the index
+    if (m_count > 80)
+    {
+        IndexCurve(ear);
+    }
+
+    int stalled = 0;
+
+    while (m_count > 3)
+    {
+        const int next = m_next.at(ear);
+
+        if (qFuzzyIsNull(Corner(ear)))
+        {
+            // Collinear points, spikes and collapsed bridges have no area
+            Remove(ear);
+            stalled = 0;
+        }
+        else if (IsEar(ear) || stalled >= m_count)
+        {
+            // After a whole lap without an ear the polygon is not simple. Cut anyway to finish.
+            Cut(ear);
+            stalled = 0;
+        }
+        else
+        {
+            ++stalled;
+        }
+
+        ear = next;
+    }
+
+    Cut(ear);
+
+    return m_triangles;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline const QPointF &VEarClipper::Point(int node) const
+{
+    return m_points.at(m_index.at(node));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VEarClipper::Node(int index)
+{
+    m_index.append(index);
+    m_previous.append(-1);
+    m_next.append(-1);
+    return m_index.size() - 1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IndexCurve links nodes of the ring in z-order.
+ * @param ear any node of the ring.
+ */
+void VEarClipper::IndexCurve(int ear)
+{
+    QVector<int> nodes;
+    nodes.reserve(m_count);
+
+    qreal maxX = Point(ear).x();
+    qreal maxY = Point(ear).y();
+    m_min = Point(ear);
+
+    int node = ear;
+    do
+    {
+        const QPointF &p = Point(node);
+        m_min.setX(qMin(m_min.x(), p.x()));
+        m_min.setY(qMin(m_min.y(), p.y()));
+        maxX = qMax(maxX, p.x());
+        maxY = qMax(maxY, p.y());
+
+        nodes.append(node);
+        node = m_next.at(node);
+    }
+    while (node != ear);
+
+    // Coordinates are scaled to 15 bits
+    const qreal size = qMax(maxX - m_min.x(), maxY - m_min.y());
+    m_scale = qFuzzyIsNull(size) ? 0 : 32767 / size;
+
+    m_zOrder.fill(0, m_index.size());
+    m_previousZ.fill(-1, m_index.size());
+    m_nextZ.fill(-1, m_index.size());
+
+    for (auto n : nodes)
+    {
+        m_zOrder[n] = ZOrder(Point(n));
+    }
+
+    std::sort(nodes.begin(), nodes.end(), [this](int a, int b) {return m_zOrder.at(a) < m_zOrder.at(b);});
+
+    for (int i = 1; i < nodes.size(); ++i)
+    {
+        m_nextZ[nodes.at(i - 1)] = nodes.at(i);
+        m_previousZ[nodes.at(i)] = nodes.at(i - 1);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Interleave bits of scaled coordinates
+quint32 VEarClipper::ZOrder(const QPointF &point) const
+{
+    auto Spread = [](quint32 value)
+    {
+        value = (value | (value << 8)) & 0x00FF00FF;
+        value = (value | (value << 4)) & 0x0F0F0F0F;
+        value = (value | (value << 2)) & 0x33333333;
+        value = (value | (value << 1)) & 0x55555555;
+        return value;
+    };
+
+    const auto x = static_cast<quint32>(qBound(0., (point.x() - m_min.x()) * m_scale, 32767.));
+    const auto y = static_cast<quint32>(qBound(0., (point.y() - m_min.y()) * m_scale, 32767.));
+
+    return Spread(x) | (Spread(y) << 1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Positive for a convex corner
+inline qreal VEarClipper::Corner(int node) const
+{
+    return Cross(Point(m_previous.at(node)), Point(node), Point(m_next.at(node)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VEarClipper::IsEar(int ear) const
+{
+    const int previous = m_previous.at(ear);
+    const int next = m_next.at(ear);
+
+    const QPointF &a = Point(previous);
+    const QPointF &b = Point(ear);
+    const QPointF &c = Point(next);
+
+    if (Cross(a, b, c) <= 0)
+    {
+        return false;
+    }
+
+    const qreal minX = qMin(a.x(), qMin(b.x(), c.x()));
+    const qreal minY = qMin(a.y(), qMin(b.y(), c.y()));
+    const qreal maxX = qMax(a.x(), qMax(b.x(), c.x()));
+    const qreal maxY = qMax(a.y(), qMax(b.y(), c.y()));
+
+    // Only a reflex vertex can be inside an ear
+    auto Inside = [this, &a, &b, &c, minX, minY, maxX, maxY](int node)
+    {
+        const QPointF &p = Point(node);
+
+        if (p.x() < minX || p.x() > maxX || p.y() < minY || p.y() > maxY)
+        {
+            return false;
+        }
+
+        // Bridges repeat vertices of the triangle
+        if (p == a || p == b || p == c)
+        {
+            return false;
+        }
+
+        return Corner(node) <= 0 && InTriangle(a, b, c, p);
+    };
+
+    if (m_zOrder.isEmpty())
+    {
+        for (int node = m_next.at(next); node != previous; node = m_next.at(node))
+        {
+            if (Inside(node))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    const quint32 minZ = ZOrder(QPointF(minX, minY));
+    const quint32 maxZ = ZOrder(QPointF(maxX, maxY));
+
+    for (int node = m_nextZ.at(ear); node != -1 && m_zOrder.at(node) <= maxZ; node = m_nextZ.at(node))
+    {
+        if (node != previous && node != next && Inside(node))
+        {
+            return false;
+        }
+    }
+
+    for (int node = m_previousZ.at(ear); node != -1 && m_zOrder.at(node) >= minZ; node = m_previousZ.at(node))
+    {
+        if (node != previous && node != next && Inside(node))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Check if a diagonal from node a to node b goes inside the polygon near a
+bool VEarClipper::LocallyInside(int a, int b) const
+{
+    const QPointF &pa = Point(a);
+    const QPointF &pb = Point(b);
+    const QPointF &previous = Point(m_previous.at(a));
+    const QPointF &next = Point(m_next.at(a));
+
+    if (Cross(previous, pa, next) > 0)
+    {
+        return Cross(pa, pb, next) <= 0 && Cross(pa, previous, pb) <= 0;
+    }
+
+    return Cross(pa, pb, previous) > 0 || Cross(pa, next, pb) > 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief FindBridge looks for a node of the outer ring which the hole node can be connected with.
+ *
+ * A ray from the hole point to the left hits the nearest edge of the outer ring. The end of this edge with bigger x is
+ * a candidate. If reflex vertices hide it, the vertex with the smallest angle to the ray is taken instead.
+ * @return node of the outer ring or -1 if the hole is not inside the ring.
+ */
+int VEarClipper::FindBridge(int hole, int outer) const
+{
+    const QPointF &h = Point(hole);
+    qreal qx = -std::numeric_limits<qreal>::max();
+    int candidate = -1;
+
+    int node = outer;
+    do
+    {
+        const QPointF &a = Point(node);
+        const QPointF &b = Point(m_next.at(node));
+
+        // Only edges which look at the hole by their inner side
+        if (h.y() <= a.y() && h.y() >= b.y() && not VFuzzyComparePossibleNulls(a.y(), b.y()))
+        {
+            const qreal x = a.x() + (h.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y());
+            if (x <= h.x() && x > qx)
+            {
+                qx = x;
+                candidate = a.x() < b.x() ? m_next.at(node) : node;
+
+                if (VFuzzyComparePossibleNulls(x, h.x()))
+                {
+                    return candidate; // Hole touches the outer ring
+                }
+            }
+        }
+
+        node = m_next.at(node);
+    }
+    while (node != outer);
+
+    if (candidate == -1)
+    {
+        return -1;
+    }
+
+    const QPointF hit(qx, h.y());
+    const QPointF m = Point(candidate);
+    qreal minTan = std::numeric_limits<qreal>::max();
+
+    const int stop = candidate;
+    node = candidate;
+    do
+    {
+        const QPointF &p = Point(node);
+
+        if (h.x() >= p.x() && p.x() >= m.x() && not VFuzzyComparePossibleNulls(h.x(), p.x())
+            && InAnyTriangle(h, hit, m, p))
+        {
+            const qreal tan = qAbs(h.y() - p.y()) / (h.x() - p.x());
+
+            if (LocallyInside(node, hole)
+                && (tan < minTan || (VFuzzyComparePossibleNulls(tan, minTan) && p.x() > Point(candidate).x())))
+            {
+                candidate = node;
+                minTan = tan;
+            }
+        }
+
+        node = m_next.at(node);
+    }
+    while (node != stop);
+
+    return candidate;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Connect node a of the outer ring with node b of a hole by a bridge which goes there and back
+void VEarClipper::Split(int a, int b)
+{
+    const int a2 = Node(m_index.at(a));
+    const int b2 = Node(m_index.at(b));
+    const int an = m_next.at(a);
+    const int bp = m_previous.at(b);
+
+    m_next[a] = b;
+    m_previous[b] = a;
+
+    m_next[a2] = an;
+    m_previous[an] = a2;
+
+    m_next[b2] = a2;
+    m_previous[a2] = b2;
+
+    m_next[bp] = b2;
+    m_previous[b2] = bp;
+
+    m_count += 2;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VEarClipper::Cut(int ear)
+{
+    if (Corner(ear) > 0)
+    {
+        m_triangles.append(m_index.at(m_previous.at(ear)));
+        m_triangles.append(m_index.at(ear));
+        m_triangles.append(m_index.at(m_next.at(ear)));
+    }
+
+    Remove(ear);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VEarClipper::Remove(int node)
+{
+    const int previous = m_previous.at(node);
+    const int next = m_next.at(node);
+
+    m_next[previous] = next;
+    m_previous[next] = previous;
+    --m_count;
+
+    if (not m_zOrder.isEmpty())
+    {
+        const int previousZ = m_previousZ.at(node);
+        const int nextZ = m_nextZ.at(node);
+
+        if (previousZ != -1)
+        {
+            m_nextZ[previousZ] = nextZ;
+        }
+
+        if (nextZ != -1)
+        {
+            m_previousZ[nextZ] = previousZ;
+        }
+    }
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<int> EarClipping(const QVector<QPointF> &points, const QVector<int> &holes)
+{
+    VEarClipper clipper(points);
+
+    const int outerEnd = holes.isEmpty() ? points.size() : holes.first();
+    const int outer = clipper.Ring(0, outerEnd, true);
+    if (outer == -1)
+    {
+        return QVector<int>();
+    }
+
+    QVector<int> holeRings;
+    holeRings.reserve(holes.size());
+    for (int i = 0; i < holes.size(); ++i)
+    {
+        const int end = i + 1 < holes.size() ? holes.at(i + 1) : points.size();
+        const int ring = clipper.Ring(holes.at(i), end, false);
+        if (ring != -1)
+        {
+            holeRings.append(ring);
+        }
+    }
+
+    clipper.EliminateHoles(outer, holeRings);
+
+    return clipper.Triangulate(outer);
+}
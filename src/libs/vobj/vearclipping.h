@@ -0,0 +1,50 @@
+/************************************************************************
+ **
+ **  @file   vearclipping.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VEARCLIPPING_H
+#define VEARCLIPPING_H
+
+#include <QPointF>
+#include <QVector>
+
+/**
+ * @brief EarClipping splits a polygon with holes into triangles which lie inside it.
+ *
+ * Contours may have any orientation and any number of points. A closing point equal to the first one is ignored. Each
+ * hole is joined to the outer contour by a bridge to a visible vertex, after that triangles are cut from the polygon
+ * one by one. A vertex can be cut if its corner is convex and no reflex vertex lies inside the triangle it forms with
+ * its neighbors. Self-intersecting input has no such vertex at some point; in this case a vertex is cut anyway, so the
+ * function always finishes.
+ *
+ * @param points points of the outer contour followed by points of holes.
+ * @param holes index of the first point of each hole.
+ * @return indexes of points, three for each triangle. All triangles are counterclockwise in a coordinate system with
+ * the y axis up.
+ */
+QVector<int> EarClipping(const QVector<QPointF> &points, const QVector<int> &holes = QVector<int>());
+
+#endif // VEARCLIPPING_H
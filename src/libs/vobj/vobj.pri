@@ -4,13 +4,12 @@
 SOURCES += \
     $$PWD/vobjengine.cpp \
     $$PWD/vobjpaintdevice.cpp \
-    $$PWD/delaunay.cpp \
-    $$PWD/predicates.cpp
+    $$PWD/vearclipping.cpp
 
 *msvc*:SOURCES += $$PWD/stable.cpp
 
 HEADERS += \
     $$PWD/vobjengine.h \
-    $$PWD/delaunay.h \
+    $$PWD/vearclipping.h \
     $$PWD/vobjpaintdevice.h \
     $$PWD/stable.h
@@ -33,6 +33,7 @@
 #include <QFlags>
 #include <QIODevice>
 #include <QLatin1Char>
+#include <QList>
 #include <QMessageLogger>
 #include <QPaintEngineState>
 #include <QPainterPath>
@@ -45,6 +46,7 @@
 
 #include "../vmisc/diagnostic.h"
 #include "../vmisc/vmath.h"
+#include "vearclipping.h"
 
 class QPaintDevice;
 class QPixmap;
@@ -73,17 +75,87 @@ QT_WARNING_DISABLE_INTEL(2022)
 QT_WARNING_POP
 }
 
+namespace
+{
 //---------------------------------------------------------------------------------------------------------------------
-VObjEngine::VObjEngine()
-    :QPaintEngine(svgEngineFeatures()), stream(), globalPointsCount(0), outputDevice(), planeCount(0),
-      size(), resolution(96), matrix()
+QVector<QPointF> RemoveRepeatedPoints(const QPolygonF &polygon)
+{
+    QVector<QPointF> points;
+    points.reserve(polygon.size());
+
+    for (auto &p : polygon)
+    {
+        if (points.isEmpty() || points.last() != p)
+        {
+            points.append(p);
+        }
+    }
+
+    if (points.size() > 1 && points.first() == points.last())
+    {
+        points.removeLast();
+    }
+
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Nesting finds for each contour the contour it lies in directly.
+ *
+ * A contour inside an even number of other contours is an outer contour, inside an odd number it is a hole of the
+ * contour around it. This gives the same result as odd-even filling for contours which do not cross each other.
+ * @param contours list of contours.
+ * @return for each contour index of its parent or -1 for outer contours.
+ */
+QVector<int> Nesting(const QVector<QVector<QPointF>> &contours)
 {
-    for (int i=0; i < MAX_POINTS; i++)
+    QVector<QRectF> rects;
+    rects.reserve(contours.size());
+    for (auto &contour : contours)
+    {
+        rects.append(QPolygonF(contour).boundingRect());
+    }
+
+    QVector<QVector<int>> around(contours.size());
+    for (int i = 0; i < contours.size(); ++i)
+    {
+        const QPointF &p = contours.at(i).first();
+        for (int j = 0; j < contours.size(); ++j)
+        {
+            if (i != j && rects.at(j).contains(p) && QPolygonF(contours.at(j)).containsPoint(p, Qt::OddEvenFill))
+            {
+                around[i].append(j);
+            }
+        }
+    }
+
+    QVector<int> parents(contours.size(), -1);
+    for (int i = 0; i < contours.size(); ++i)
     {
-        points[i].x = 0;
-        points[i].y = 0;
+        const int depth = around.at(i).size();
+        if (depth % 2 == 1)
+        {
+            for (auto j : around.at(i))
+            {
+                if (around.at(j).size() == depth - 1)
+                {
+                    parents[i] = j;
+                    break;
+                }
+            }
+        }
     }
+
+    return parents;
 }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VObjEngine::VObjEngine()
+    :QPaintEngine(svgEngineFeatures()), stream(), globalPointsCount(0), outputDevice(), planeCount(0),
+      size(), resolution(96), matrix()
+{}
 
 #if defined(Q_CC_INTEL)
 #pragma warning( pop )
@@ -162,14 +234,23 @@ void VObjEngine::updateState(const QPaintEngineState &state)
 //---------------------------------------------------------------------------------------------------------------------
 void VObjEngine::drawPath(const QPainterPath &path)
 {
-    QPolygonF polygon = path.toFillPolygon(matrix);
-    polygon = MakePointsUnique(polygon);// Points must be unique
-    if (polygon.size() < 3)
+    const QList<QPolygonF> subpaths = path.toSubpathPolygons(matrix);
+
+    QVector<QVector<QPointF>> contours;
+    contours.reserve(subpaths.size());
+    for (auto &subpath : subpaths)
     {
-        return;
+        const QVector<QPointF> contour = RemoveRepeatedPoints(subpath);
+        if (contour.size() >= 3)
+        {
+            contours.append(contour);
+        }
     }
 
-    qint64 sq = Square(polygon);
+    if (contours.isEmpty())
+    {
+        return;
+    }
 
     ++planeCount;
 #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
@@ -178,59 +259,30 @@ void VObjEngine::drawPath(const QPainterPath &path)
     *stream << "o Plane." << QString("%1").arg(planeCount, 3, 10, QLatin1Char('0')) << Qt::endl;
 #endif
 
-    quint32 num_points = 0;
+    const QVector<int> parents = Nesting(contours);
 
-    for (auto &p : polygon)
+    for (int i = 0; i < contours.size(); ++i)
     {
-        if ( num_points < MAX_POINTS )
+        if (parents.at(i) != -1)
         {
-            points[num_points].x = p.x();
-            points[num_points].y = p.y();
-            num_points++;
+            continue; // Hole
         }
-    }
 
-    int offset = 0;
-    delaunay2d_t *res = delaunay2d_from(points, num_points);//Calculate faces
+        QVector<QPointF> points = contours.at(i);
+        QVector<int> holes;
 
-    QPointF pf[MAX_POINTS];
-    bool skipFace=false;//Need skip first face
-
-    for (quint32 i = 0; i < res->num_faces; i++ )
-    {
-        if (offset == 0)
+        for (int j = 0; j < contours.size(); ++j)
         {
-            skipFace=true;
-        }
-        else
-        {
-            skipFace=false;
-        }
-        int num_verts = static_cast<int>(res->faces[offset]);
-        offset++;
-        for ( int j = 0; j < num_verts; j++ )
-        {
-            int p0 = static_cast<int>(res->faces[offset + j]);
-            pf[j] = QPointF(points[p0].x, points[p0].y);
-        }
-        if (skipFace == false )
-        {
-            QPolygonF face;
-            for ( int i = 0; i < num_verts; i++ )
+            if (parents.at(j) == i)
             {
-                face << QPointF(pf[i]);
-            }
-            QPolygonF united = polygon.united(face);
-            qint64 sqUnited = Square(united);
-            if (sqUnited <= sq)
-            {// This face incide our base polygon.
-                drawPolygon(pf, num_verts, QPaintEngine::OddEvenMode);
+                holes.append(points.size());
+                points += contours.at(j);
             }
         }
-        offset += num_verts;
+
+        WriteFaces(points, EarClipping(points, holes));
     }
 
-    delaunay2d_release(res);//Don't forget release data
 #if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
     *stream << "s off" << endl;
 #else
@@ -343,59 +395,25 @@ void VObjEngine::setResolution(int value)
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QPolygonF VObjEngine::MakePointsUnique(const QPolygonF &polygon) const
+void VObjEngine::WriteFaces(const QVector<QPointF> &points, const QVector<int> &triangles)
 {
-    QVector<QPointF> set;
-    QPolygonF uniquePolygon;
-    for (auto p : polygon)
+    if (triangles.isEmpty())
     {
-        if (set.contains(p) == false)
-        {
-            set.append(p);
-            uniquePolygon.append(p);
-        }
+        return;
     }
-    return uniquePolygon;
-}
-
-//---------------------------------------------------------------------------------------------------------------------
-qint64 VObjEngine::Square(const QPolygonF &poly) const
-{
-    QVector<qreal> x;
-    QVector<qreal> y;
 
-    int n = poly.count();
-    qreal s, res = 0;
-    qint64 sq = 0;
+    // Faces share vertices of the polygon
+    drawPoints(points.constData(), points.size());
+    const int offset = static_cast<int>(globalPointsCount) - points.size() + 1;
 
-    for (int i=0; i < n; i++)
+    for (int i = 0; i + 2 < triangles.size(); i += 3)
     {
-        x.append(poly.at(i).x());
-        y.append(poly.at(i).y());
-    }
-
-    // Calculation a polygon area through the sum of the areas of trapezoids
-    for (int i = 0; i < n; i++)
-    {
-        if (i == 0)
-        {
-            s = x.at(i)*(y.at(n-1) - y.at(i+1)); //if i == 0, then y[i-1] replace on y[n-1]
-            res += s;
-        }
-        else
-        {
-            if (i == n-1)
-            {
-                s = x.at(i)*(y.at(i-1) - y.at(0)); // if i == n-1, then y[i+1] replace on y[0]
-                res += s;
-            }
-            else
-            {
-                s = x.at(i)*(y.at(i-1) - y.at(i+1));
-                res += s;
-            }
-        }
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+        *stream << "f " << offset + triangles.at(i) << " " << offset + triangles.at(i + 1) << " "
+                << offset + triangles.at(i + 2) << endl;
+#else
+        *stream << "f " << offset + triangles.at(i) << " " << offset + triangles.at(i + 1) << " "
+                << offset + triangles.at(i + 2) << Qt::endl;
+#endif
     }
-    sq = qFloor(qAbs(res/2.0));
-    return sq;
 }
@@ -32,18 +32,16 @@
 #include <qcompilerdetection.h>
 #include <QMatrix>
 #include <QPaintEngine>
+#include <QPointF>
 #include <QPolygonF>
 #include <QRectF>
 #include <QSharedPointer>
 #include <QSize>
+#include <QVector>
 #include <QtGlobal>
 
-#include "delaunay.h"
-
 class QTextStream;
 
-#define MAX_POINTS      512
-
 class VObjEngine : public QPaintEngine
 {
 public:
@@ -75,14 +73,12 @@ private:
     QSharedPointer<QTextStream> stream;
     quint32     globalPointsCount;
     QSharedPointer<QIODevice> outputDevice;
-    del_point2d_t    points[MAX_POINTS];
     quint32     planeCount;
     QSize            size;
     int              resolution;
     QTransform       matrix;
 
-    QPolygonF  MakePointsUnique(const QPolygonF &polygon)const;
-    qint64     Square(const QPolygonF &poly)const;
+    void       WriteFaces(const QVector<QPointF> &points, const QVector<int> &triangles);
 };
 
 #endif // VOBJENGINE_H
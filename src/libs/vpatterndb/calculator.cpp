@@ -55,6 +55,7 @@
 Calculator::Calculator()
     : QmuFormulaBase(),
       m_varsValues(),
+      m_varsNames(),
       m_vars(nullptr)
 {
     InitCharSets();
@@ -88,31 +89,81 @@ qreal Calculator::EvalFormula(const QHash<QString, QSharedPointer<VInternalVaria
 
     SetSepForEval();//Reset separators options
     m_vars = vars;
+
+    ClearVar();
+    m_varsValues.clear();
+    m_varsNames.clear();
+
     SetExpr(formula);
 
     m_pTokenReader->IgnoreUndefVar(true);
     return Eval();
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VariablesNames return names of variables used by the last parsed formula. Index of name is index of its slot.
+ */
+const QVector<QString> &Calculator::VariablesNames() const
+{
+    return m_varsNames;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ExportByteCode copy bytecode of the last parsed formula for evaluation without this calculator.
+ *
+ * Copied bytecode reads variables from the array of values provided by caller instead of own slots. See
+ * qmu::QmuParserBase::Eval(const QmuParserByteCode &, int).
+ *
+ * @param byteCode [out] compiled formula.
+ * @param resultIndex [out] index of result on the stack.
+ * @param values array with one value per name from VariablesNames(). Receives current values of variables.
+ * @return false if the formula cannot be evaluated without its parser.
+ */
+bool Calculator::ExportByteCode(qmu::QmuParserByteCode &byteCode, int &resultIndex, qreal *values)
+{
+    if (not GetByteCode(byteCode, resultIndex))
+    {
+        return false;
+    }
+
+    QHash<const qreal *, qreal *> relocations;
+    relocations.reserve(m_varsNames.size());
+    for (int i = 0; i < m_varsNames.size(); ++i)
+    {
+        const qreal &slot = m_varsValues.at(static_cast<size_t>(i));
+        values[i] = slot;
+        relocations.insert(&slot, values + i);
+    }
+
+    byteCode.RelocateVars(relocations);
+    return true;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 qreal *Calculator::VarFactory(const QString &a_szName, void *a_pUserData)
 {
-    Q_UNUSED(a_szName)
     Calculator *calc = static_cast<Calculator *>(a_pUserData);
 
-    if (calc->m_vars != nullptr && calc->m_vars->contains(a_szName))
+    qreal value = 0;
+    bool found = false;
+    if (calc->m_vars != nullptr)
     {
-        QSharedPointer<qreal> val(new qreal(*calc->m_vars->value(a_szName)->GetValue()));
-        calc->m_varsValues.append(val);
-        return val.data();
+        auto variable = calc->m_vars->constFind(a_szName);
+        if (variable != calc->m_vars->constEnd())
+        {
+            value = *variable.value()->GetValue();
+            found = true;
+        }
     }
 
-    if (a_szName.startsWith('#'))
+    if (not found && not a_szName.startsWith('#'))
     {
-        QSharedPointer<qreal> val(new qreal(0));
-        calc->m_varsValues.append(val);
-        return val.data();
+        throw qmu::QmuParserError (qmu::ecUNASSIGNABLE_TOKEN);
     }
 
-    throw qmu::QmuParserError (qmu::ecUNASSIGNABLE_TOKEN);
+    calc->m_varsValues.push_back(value);
+    calc->m_varsNames.append(a_szName);
+    return &calc->m_varsValues.back();
 }
@@ -33,10 +33,13 @@
 #include <QHash>
 #include <QMap>
 #include <QString>
+#include <QVector>
 #include <QtGlobal>
+#include <deque>
 
 #include "../qmuparser/qmuformulabase.h"
 
+class VContainer;
 class VInternalVariable;
 
 /**
@@ -64,11 +67,21 @@ public:
     virtual ~Calculator() Q_DECL_EQ_DEFAULT;
 
     qreal EvalFormula(const QHash<QString, QSharedPointer<VInternalVariable> > *vars, const QString &formula);
+
+    const QVector<QString> &VariablesNames() const;
+    bool ExportByteCode(qmu::QmuParserByteCode &byteCode, int &resultIndex, qreal *values);
 protected:
     static qreal* VarFactory(const QString &a_szName, void *a_pUserData);
 private:
     Q_DISABLE_COPY(Calculator)
-    QVector<QSharedPointer<qreal>> m_varsValues;
+    /**
+     * @brief m_varsValues values of variables bound to bytecode. Each variable has its slot index.
+     *
+     * Bytecode keeps pointers to slots. Unlike a vector, deque never moves already added slots when it grows.
+     */
+    std::deque<qreal> m_varsValues;
+    /** @brief m_varsNames name of variable for each slot. */
+    QVector<QString> m_varsNames;
     const QHash<QString, QSharedPointer<VInternalVariable> > *m_vars;
 };
 
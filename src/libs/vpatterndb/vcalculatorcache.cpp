@@ -0,0 +1,282 @@
+/************************************************************************
+ **
+ **  @file   vcalculatorcache.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vcalculatorcache.h"
+
+#include <QLocale>
+#include <QMutexLocker>
+
+#include "calculator.h"
+#include "vcontainer.h"
+#include "variables/vinternalvariable.h"
+#include "../vmisc/def.h"
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 12, 0)
+#include "../vmisc/backport/qscopeguard.h"
+#else
+#include <QScopeGuard>
+#endif
+
+Q_LOGGING_CATEGORY(vCalculatorCache, "v.calculatorcache")
+
+namespace
+{
+// Compiled formulas are small, but a pattern can have thousands of them. Protect memory from unbounded growth.
+const int maxFormulas = 1 << 14;
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Evaluator return parser of the current thread that runs compiled formulas.
+ */
+Calculator *Evaluator()
+{
+    static thread_local Calculator evaluator;
+    return &evaluator;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VCalculatorCache *VCalculatorCache::Instance()
+{
+    static VCalculatorCache cache;
+    return &cache;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EvalFormula calculate formula. Result is the same as with Calculator::EvalFormula.
+ *
+ * Formula is parsed on the first use only. Parser errors are not cached, a broken formula throws each time.
+ * @param vars set of variables.
+ * @param formula string of formula in internal format.
+ * @return value of formula.
+ */
+qreal VCalculatorCache::EvalFormula(const QHash<QString, QSharedPointer<VInternalVariable>> *vars,
+                                    const QString &formula)
+{
+    return Eval(vars, nullptr, formula);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EvalFormula calculate formula with variables of the container.
+ *
+ * Unlike the version with a set of variables this one remembers which variables the formula uses and doesn't look for
+ * them by name until the container's set of variables changes.
+ * @param data container with variables.
+ * @param formula string of formula in internal format.
+ * @return value of formula.
+ */
+qreal VCalculatorCache::EvalFormula(const VContainer *data, const QString &formula)
+{
+    SCASSERT(data != nullptr)
+    return Eval(data->DataVariables(), data, formula);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal VCalculatorCache::Eval(const QHash<QString, QSharedPointer<VInternalVariable>> *vars, const VContainer *data,
+                             const QString &formula)
+{
+    // Single numerical value doesn't need parser at all.
+    QLocale c(QLocale::C);
+    bool ok = false;
+    const qreal value = c.toDouble(formula, &ok);
+    if (ok)
+    {
+        return value;
+    }
+
+    QSharedPointer<VCompiledFormula> compiled;
+    {
+        QMutexLocker locker(&m_mutex);
+        compiled = m_formulas.value(formula);
+    }
+
+    if (not compiled.isNull() && compiled->mutex.tryLock())
+    {
+        auto unlock = qScopeGuard([compiled]() {compiled->mutex.unlock();});
+
+        if (Bind(*compiled, vars, data))
+        {
+            ++m_hits;
+            return Evaluator()->Eval(compiled->byteCode, compiled->resultIndex);
+        }
+    }
+
+    ++m_misses;
+
+    // Formula is new, busy or uses variable unknown in this set. Temporary parser also reports the right error.
+    QScopedPointer<Calculator> cal(new Calculator());
+    const qreal result = cal->EvalFormula(vars, formula);
+
+    if (compiled.isNull())
+    {
+        compiled = Compile(*cal);
+        if (not compiled.isNull())
+        {
+            QMutexLocker locker(&m_mutex);
+            // Keep already compiled formulas, they are the ones the pattern uses most.
+            if (m_formulas.size() < maxFormulas)
+            {
+                m_formulas.insert(formula, compiled);
+            }
+        }
+    }
+
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Compile take bytecode of the formula the calculator just parsed.
+ * @return null if the formula cannot be evaluated without its parser.
+ */
+QSharedPointer<VCalculatorCache::VCompiledFormula> VCalculatorCache::Compile(Calculator &cal)
+{
+    auto compiled = QSharedPointer<VCompiledFormula>::create();
+    compiled->names = cal.VariablesNames();
+    compiled->values.reset(new qreal[static_cast<size_t>(compiled->names.size())]);
+
+    if (not cal.ExportByteCode(compiled->byteCode, compiled->resultIndex, compiled->values.data()))
+    {
+        return QSharedPointer<VCompiledFormula>();
+    }
+
+    return compiled;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Bind update values of variables used by compiled formula.
+ *
+ * With a container variables are resolved by name only if the container's set of variables was changed since the last
+ * call. Otherwise values are copied directly from already resolved variables.
+ *
+ * @return false if one of variables used by the formula is unknown.
+ */
+bool VCalculatorCache::Bind(VCompiledFormula &compiled, const QHash<QString, QSharedPointer<VInternalVariable>> *vars,
+                            const VContainer *data)
+{
+    if (data == nullptr)
+    {
+        // No way to know if the set was changed since the last call.
+        compiled.boundVars = nullptr;
+        compiled.boundRevision = 0;
+
+        if (not Resolve(compiled, vars))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        const quint64 revision = data->VariablesRevision();
+        if (vars != compiled.boundVars || revision != compiled.boundRevision)
+        {
+            compiled.boundVars = nullptr;
+            compiled.boundRevision = 0;
+
+            if (not Resolve(compiled, vars))
+            {
+                return false;
+            }
+
+            compiled.boundVars = vars;
+            compiled.boundRevision = revision;
+        }
+    }
+
+    for (int i = 0; i < compiled.variables.size(); ++i)
+    {
+        const VInternalVariable *variable = compiled.variables.at(i);
+        compiled.values[i] = variable != nullptr ? variable->GetValue() : 0;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VCalculatorCache::Resolve(VCompiledFormula &compiled,
+                               const QHash<QString, QSharedPointer<VInternalVariable>> *vars)
+{
+    compiled.variables.resize(compiled.names.size());
+
+    for (int i = 0; i < compiled.names.size(); ++i)
+    {
+        const QString &name = compiled.names.at(i);
+
+        if (vars != nullptr)
+        {
+            auto variable = vars->constFind(name);
+            if (variable != vars->constEnd())
+            {
+                compiled.variables[i] = variable.value().data();
+                continue;
+            }
+        }
+
+        if (not name.startsWith('#'))
+        {
+            return false;
+        }
+
+        compiled.variables[i] = nullptr;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Clear forget all compiled formulas. Call it when the pattern they belong to is closed.
+ */
+void VCalculatorCache::Clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_formulas.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VCalculatorCache::Count() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_formulas.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qint64 VCalculatorCache::Hits() const
+{
+    return m_hits;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qint64 VCalculatorCache::Misses() const
+{
+    return m_misses;
+}
@@ -0,0 +1,107 @@
+/************************************************************************
+ **
+ **  @file   vcalculatorcache.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VCALCULATORCACHE_H
+#define VCALCULATORCACHE_H
+
+#include <QHash>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QScopedArrayPointer>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+
+#include "../qmuparser/qmuparserbytecode.h"
+
+class Calculator;
+class VContainer;
+class VInternalVariable;
+
+Q_DECLARE_LOGGING_CATEGORY(vCalculatorCache)
+
+/**
+ * @brief The VCalculatorCache class keeps parsed formulas of a pattern.
+ *
+ * Creating a new Calculator for each evaluation means tokenizing the formula and building bytecode again, even if the
+ * same formula was evaluated a moment ago with other variables. The cache keeps only the bytecode of each formula text
+ * and values of variables it reads. Next evaluation of the same text updates the values and runs the bytecode with a
+ * parser that belongs to the current thread.
+ *
+ * Compiled formulas are valid only for the pattern they came from, the application clears the cache when a pattern
+ * is closed. Each compiled formula is locked while in use, if another thread evaluates the same formula at the same
+ * time it falls back to a temporary Calculator.
+ */
+class VCalculatorCache
+{
+public:
+    static VCalculatorCache *Instance();
+
+    qreal EvalFormula(const QHash<QString, QSharedPointer<VInternalVariable> > *vars, const QString &formula);
+    qreal EvalFormula(const VContainer *data, const QString &formula);
+
+    void Clear();
+
+    int    Count() const;
+    qint64 Hits() const;
+    qint64 Misses() const;
+
+private:
+    Q_DISABLE_COPY(VCalculatorCache)
+    VCalculatorCache() = default;
+
+    struct VCompiledFormula
+    {
+        QMutex mutex{};
+        qmu::QmuParserByteCode byteCode{};
+        int resultIndex{0};
+        QVector<QString> names{};
+        /** @brief values slot for each variable. Bytecode keeps pointers to them, allocated once. */
+        QScopedArrayPointer<qreal> values{};
+        /** @brief variables resolved for slots. Null for a missed variable that gets 0. */
+        QVector<const VInternalVariable *> variables{};
+        const QHash<QString, QSharedPointer<VInternalVariable>> *boundVars{nullptr};
+        quint64 boundRevision{0};
+    };
+
+    mutable QMutex m_mutex{};
+    QHash<QString, QSharedPointer<VCompiledFormula>> m_formulas{};
+    std::atomic<qint64> m_hits{0};
+    std::atomic<qint64> m_misses{0};
+
+    qreal Eval(const QHash<QString, QSharedPointer<VInternalVariable> > *vars, const VContainer *data,
+               const QString &formula);
+
+    static QSharedPointer<VCompiledFormula> Compile(Calculator &cal);
+    static bool Bind(VCompiledFormula &compiled, const QHash<QString, QSharedPointer<VInternalVariable> > *vars,
+                     const VContainer *data);
+    static bool Resolve(VCompiledFormula &compiled, const QHash<QString, QSharedPointer<VInternalVariable> > *vars);
+};
+
+#endif // VCALCULATORCACHE_H
@@ -33,6 +33,9 @@
 #include <QtDebug>
 #include <QUuid>
 #include <QLoggingCategory>
+#include <QMutex>
+#include <QMutexLocker>
+#include <atomic>
 
 #include "../ifc/exception/vexception.h"
 #include "../vgeometry/vabstractcubicbezierpath.h"
@@ -64,11 +67,24 @@ Q_LOGGING_CATEGORY(vCon, "v.container")
 
 QT_WARNING_POP
 
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief NamespaceMutex guards static data of namespaces. Containers of one pattern can be filled from several threads
+ * while parsing independent pattern pieces.
+ */
+QMutex *NamespaceMutex()
+{
+    static QMutex mutex;
+    return &mutex;
+}
+} // anonymous namespace
+
 QMap<QString, quint32> VContainer::_id = QMap<QString, quint32>();
 QMap<QString, qreal> VContainer::_size = QMap<QString, qreal>();
 QMap<QString, qreal> VContainer::_height = QMap<QString, qreal>();
 QMap<QString, QSet<QString>> VContainer::uniqueNames = QMap<QString, QSet<QString>>();
-QMap<QString, quint32> VContainer::copyCounter = QMap<QString, quint32>();
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
@@ -82,6 +98,8 @@ VContainer::VContainer(const VTranslateVars *trVars, const Unit *patternUnit, co
         qFatal("Namesapce is empty.");
     }
 
+    QMutexLocker locker(NamespaceMutex());
+
     if (VContainer::_id.contains(nspace))
     {
         qFatal("Namespace is not unique.");
@@ -106,11 +124,6 @@ VContainer::VContainer(const VTranslateVars *trVars, const Unit *patternUnit, co
     {
         uniqueNames[d->nspace] = QSet<QString>();
     }
-
-    if (not copyCounter.contains(d->nspace))
-    {
-        copyCounter[d->nspace] = 1;
-    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -126,7 +139,7 @@ VContainer &VContainer::operator =(const VContainer &data)
         return *this;
     }
     d = data.d;
-    ++copyCounter[d->nspace];
+    ++*d->copyCounter;
     return *this;
 }
 
@@ -152,7 +165,7 @@ VContainer &VContainer::operator=(VContainer &&data) Q_DECL_NOTHROW
 VContainer::VContainer(const VContainer &data)
     :d(data.d)
 {
-    ++copyCounter[d->nspace];
+    ++*d->copyCounter;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -163,6 +176,7 @@ VContainer::~VContainer()
 QString VContainer::UniqueNamespace()
 {
     QString candidate;
+    QMutexLocker locker(NamespaceMutex());
     do
     {
         candidate = QUuid::createUuid().toString();
@@ -173,6 +187,10 @@ QString VContainer::UniqueNamespace()
 }
 
 //---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ClearNamespace remove static data of a namespace. Caller must lock the namespace mutex.
+ * @param nspace namespace.
+ */
 void VContainer::ClearNamespace(const QString &nspace)
 {
     _id.remove(nspace);
@@ -279,7 +297,7 @@ quint32 VContainer::AddGObject(const QSharedPointer<VGObject> &obj)
         return NULL_ID;
     }
 
-    uniqueNames[d->nspace].insert(obj->name());
+    AddUniqueName(d->nspace, obj->name());
     const quint32 id = getNextId();
     obj->setId(id);
 
@@ -314,6 +332,7 @@ quint32 VContainer::AddPiecePath(const VPiecePath &path)
 //---------------------------------------------------------------------------------------------------------------------
 quint32 VContainer::getId() const
 {
+    QMutexLocker locker(NamespaceMutex());
     return _id.value(d->nspace);
 }
 
@@ -327,6 +346,7 @@ quint32 VContainer::getNextId() const
     //TODO. Current count of ids are very big and allow us save time before someone will reach its max value.
     //Better way, of cource, is to seek free ids inside the set of values and reuse them.
     //But for now better to keep it as it is now.
+    QMutexLocker locker(NamespaceMutex());
     if (_id.value(d->nspace) == UINT_MAX)
     {
         qCritical()<<(tr("Number of free id exhausted."));
@@ -338,6 +358,7 @@ quint32 VContainer::getNextId() const
 //---------------------------------------------------------------------------------------------------------------------
 void VContainer::UpdateId(quint32 newId, const QString &nspace)
 {
+    QMutexLocker locker(NamespaceMutex());
     if (_id.contains(nspace))
     {
         if (newId > _id.value(nspace))
@@ -368,7 +389,7 @@ void VContainer::UpdateId(quint32 newId) const
 void VContainer::Clear()
 {
     qCDebug(vCon, "Clearing container data.");
-    _id[d->nspace] = NULL_ID;
+    ResetId();
 
     d->pieces->clear();
     d->piecePaths->clear();
@@ -381,7 +402,7 @@ void VContainer::Clear()
 void VContainer::ClearForFullParse()
 {
     qCDebug(vCon, "Clearing container data for full parse.");
-    _id[d->nspace] = NULL_ID;
+    ResetId();
 
     d->pieces->clear();
     d->piecePaths->clear();
@@ -428,6 +449,7 @@ void VContainer::ClearVariables(const QVector<VarType> &types)
         if (types.isEmpty() || types.contains(VarType::Unknown))
         {
             d->variables.clear();
+            VariablesChanged();
         }
         else
         {
@@ -443,6 +465,7 @@ void VContainer::ClearVariables(const QVector<VarType> &types)
                     ++i;
                 }
             }
+            VariablesChanged();
         }
     }
 }
@@ -529,6 +552,7 @@ void VContainer::AddCurveWithSegments(const QSharedPointer<VAbstractCubicBezierP
 void VContainer::RemoveVariable(const QString &name)
 {
     d->variables.remove(name);
+    VariablesChanged();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -537,6 +561,16 @@ void VContainer::RemovePiece(quint32 id)
     d->pieces->remove(id);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RemoveGObject remove calculation object from the container. The object stays in other copies of the container.
+ * @param id id of the object.
+ */
+void VContainer::RemoveGObject(quint32 id)
+{
+    d->calculationObjects.remove(id);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VContainer::UpdatePiece(quint32 id, const VPiece &detail)
 {
@@ -553,6 +587,54 @@ void VContainer::UpdatePiecePath(quint32 id, const VPiecePath &path)
     UpdateId(id);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief DetachModeling give the container own tables of modeling objects and piece paths.
+ *
+ * The tables are shared between all copies of a container. A copy filled in a worker thread must not insert into
+ * them. Objects in the tables stay shared.
+ */
+void VContainer::DetachModeling()
+{
+    d->modelingObjects = QSharedPointer<QHash<quint32, QSharedPointer<VGObject>>>::create(*d->modelingObjects);
+    d->piecePaths = QSharedPointer<QHash<quint32, VPiecePath>>::create(*d->piecePaths);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ShareModeling make the container use tables of modeling objects and piece paths of another container.
+ * @param data container which tables to use.
+ */
+void VContainer::ShareModeling(const VContainer &data)
+{
+    d->modelingObjects = data.d->modelingObjects;
+    d->piecePaths = data.d->piecePaths;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief MergeModeling copy modeling objects and piece paths from a container with detached tables.
+ * @param shard container that was filled with own tables.
+ * @param ids ids of objects and paths to copy.
+ */
+void VContainer::MergeModeling(const VContainer &shard, const QVector<quint32> &ids)
+{
+    for (auto id : ids)
+    {
+        auto object = shard.d->modelingObjects->constFind(id);
+        if (object != shard.d->modelingObjects->constEnd())
+        {
+            d->modelingObjects->insert(id, object.value());
+        }
+
+        auto path = shard.d->piecePaths->constFind(id);
+        if (path != shard.d->piecePaths->constEnd())
+        {
+            d->piecePaths->insert(id, path.value());
+        }
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief RemoveIncrement remove increment by name from increment table
@@ -562,6 +644,7 @@ void VContainer::RemoveIncrement(const QString &name)
 {
     d->variables[name].clear();
     d->variables.remove(name);
+    VariablesChanged();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -637,6 +720,7 @@ bool VContainer::IsUnique(const QString &name) const
 //---------------------------------------------------------------------------------------------------------------------
 bool VContainer::IsUnique(const QString &name, const QString &nspace)
 {
+    QMutexLocker locker(NamespaceMutex());
     if (uniqueNames.contains(nspace))
     {
         return (!uniqueNames.value(nspace).contains(name) && !builInFunctions.contains(name));
@@ -656,6 +740,7 @@ QStringList VContainer::AllUniqueNames() const
 //---------------------------------------------------------------------------------------------------------------------
 QStringList VContainer::AllUniqueNames(const QString &nspace)
 {
+    QMutexLocker locker(NamespaceMutex());
     if (uniqueNames.contains(nspace))
     {
         QStringList names = builInFunctions;
@@ -701,14 +786,16 @@ const QMap<QString, QSharedPointer<T> > VContainer::DataVar(const VarType &type)
 //---------------------------------------------------------------------------------------------------------------------
 void VContainer::ClearUniqueNames() const
 {
+    QMutexLocker locker(NamespaceMutex());
     uniqueNames[d->nspace].clear();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 void VContainer::ClearUniqueIncrementNames() const
 {
+    QMutexLocker locker(NamespaceMutex());
     const QList<QString> list = uniqueNames.value(d->nspace).values();
-    ClearUniqueNames();
+    uniqueNames[d->nspace].clear();
 
     for(auto &name : list)
     {
@@ -722,8 +809,9 @@ void VContainer::ClearUniqueIncrementNames() const
 //---------------------------------------------------------------------------------------------------------------------
 void VContainer::ClearExceptUniqueIncrementNames() const
 {
+    QMutexLocker locker(NamespaceMutex());
     const QList<QString> list = uniqueNames.value(d->nspace).values();
-    ClearUniqueNames();
+    uniqueNames[d->nspace].clear();
 
     for(auto &name : list)
     {
@@ -741,6 +829,7 @@ void VContainer::ClearExceptUniqueIncrementNames() const
  */
 void VContainer::SetSize(qreal size) const
 {
+    QMutexLocker locker(NamespaceMutex());
     _size[d->nspace] = size;
 }
 
@@ -751,6 +840,7 @@ void VContainer::SetSize(qreal size) const
  */
 void VContainer::SetHeight(qreal height) const
 {
+    QMutexLocker locker(NamespaceMutex());
     _height[d->nspace] = height;
 }
 
@@ -767,6 +857,7 @@ qreal VContainer::size() const
 //---------------------------------------------------------------------------------------------------------------------
 qreal VContainer::size(const QString &nspace)
 {
+    QMutexLocker locker(NamespaceMutex());
     if (_size.contains(nspace))
     {
         return _size.value(nspace);
@@ -790,6 +881,7 @@ qreal VContainer::height() const
 //---------------------------------------------------------------------------------------------------------------------
 qreal VContainer::height(const QString &nspace)
 {
+    QMutexLocker locker(NamespaceMutex());
     if (_height.contains(nspace))
     {
         return _height.value(nspace);
@@ -822,20 +914,56 @@ const QHash<QString, QSharedPointer<VInternalVariable> > *VContainer::DataVariab
     return &d->variables;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VariablesRevision return unique number of the current set of variables.
+ *
+ * Equal revision of the same container guarantees that each name still points to the same variable object. Values of
+ * variables can be different.
+ */
+quint64 VContainer::VariablesRevision() const
+{
+    return d->variablesRevision;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VContainer::VariablesChanged()
+{
+    d->variablesRevision = VContainerData::NewVariablesRevision();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VContainer::AddUniqueName(const QString &nspace, const QString &name)
+{
+    QMutexLocker locker(NamespaceMutex());
+    uniqueNames[nspace].insert(name);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VContainer::ResetId() const
+{
+    QMutexLocker locker(NamespaceMutex());
+    _id[d->nspace] = NULL_ID;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+quint64 VContainerData::NewVariablesRevision()
+{
+    static std::atomic<quint64> revision{0};
+    return ++revision;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 VContainerData::~VContainerData()
 {
 #if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
-    if (ref.loadRelaxed() == 0)
+    if (ref.loadRelaxed() == 0 && --*copyCounter == 0)
 #else
-    if (ref.load() == 0)
+    if (ref.load() == 0 && --*copyCounter == 0)
 #endif
     {
-        --VContainer::copyCounter[nspace];
-    }
-
-    if (VContainer::copyCounter.value(nspace) == 0)
-    {
+        // Only creating and removing a namespace touch the static maps
+        QMutexLocker locker(NamespaceMutex());
         VContainer::ClearNamespace(nspace);
     }
 }
@@ -42,6 +42,7 @@
 #include <QStringList>
 #include <QTypeInfo>
 #include <QtGlobal>
+#include <atomic>
 #include <new>
 
 #include "../vmisc/def.h"
@@ -76,7 +77,9 @@ public:
           piecePaths(QSharedPointer<QHash<quint32, VPiecePath>>::create()),
           trVars(trVars),
           patternUnit(patternUnit),
-          nspace(nspace)
+          nspace(nspace),
+          copyCounter(QSharedPointer<std::atomic<quint32>>::create(1)),
+          variablesRevision(NewVariablesRevision())
     {}
 
     VContainerData(const VContainerData &data)
@@ -88,7 +91,9 @@ public:
           piecePaths(data.piecePaths),
           trVars(data.trVars),
           patternUnit(data.patternUnit),
-          nspace(data.nspace)
+          nspace(data.nspace),
+          copyCounter(data.copyCounter),
+          variablesRevision(NewVariablesRevision())
     {}
 
     virtual ~VContainerData();
@@ -110,6 +115,16 @@ public:
     /** @brief nspace namespace for static variables */
     QString nspace;
 
+    /** @brief copyCounter number of copies of the namespace. Static data of the namespace is removed when it reaches
+     * zero. Shared by all containers of the namespace, so copying a container doesn't lock anything. */
+    QSharedPointer<std::atomic<quint32>> copyCounter;
+
+    /** @brief variablesRevision unique number of the current set of variables. Changes when a variable is added or
+     * removed, not when a value changes. */
+    quint64 variablesRevision;
+
+    static quint64 NewVariablesRevision();
+
 private:
     Q_DISABLE_ASSIGN(VContainerData)
 };
@@ -172,6 +187,7 @@ public:
     void               AddVariable(const QSharedPointer<T> &var);
     void               RemoveVariable(const QString& name);
     void               RemovePiece(quint32 id);
+    void               RemoveGObject(quint32 id);
 
     template <class T>
     void               UpdateGObject(quint32 id, T* obj);
@@ -180,6 +196,10 @@ public:
     void               UpdatePiece(quint32 id, const VPiece &detail);
     void               UpdatePiecePath(quint32 id, const VPiecePath &path);
 
+    void               DetachModeling();
+    void               ShareModeling(const VContainer &data);
+    void               MergeModeling(const VContainer &shard, const QVector<quint32> &ids);
+
     void               Clear();
     void               ClearForFullParse();
     void               ClearGObjects();
@@ -202,6 +222,7 @@ public:
     const QHash<quint32, QSharedPointer<VGObject> >         *CalculationGObjects() const;
     const QHash<quint32, VPiece>                            *DataPieces() const;
     const QHash<QString, QSharedPointer<VInternalVariable>> *DataVariables() const;
+    quint64                                                  VariablesRevision() const;
 
     const QMap<QString, QSharedPointer<VMeasurement> >  DataMeasurements() const;
     const QMap<QString, QSharedPointer<VIncrement> >    DataIncrements() const;
@@ -230,11 +251,14 @@ private:
     static QMap<QString, qreal>   _size;
     static QMap<QString, qreal>   _height;
     static QMap<QString, QSet<QString>> uniqueNames;
-    static QMap<QString, quint32> copyCounter;
 
     QSharedDataPointer<VContainerData> d;
 
     void AddCurve(const QSharedPointer<VAbstractCurve> &curve, const quint32 &id, quint32 parentId = NULL_ID);
+    void VariablesChanged();
+    void ResetId() const;
+
+    static void AddUniqueName(const QString &nspace, const QString &name);
 
     template <class T>
     uint qHash( const QSharedPointer<T> &p );
@@ -327,7 +351,7 @@ void VContainer::AddUniqueVariable(const QSharedPointer<T> &var)
 
     if (d->variables.contains(var->GetName()))
     {
-        uniqueNames[d->nspace].insert(var->GetName());
+        AddUniqueName(d->nspace, var->GetName());
     }
 }
 
@@ -362,6 +386,7 @@ void VContainer::AddVariable(const QSharedPointer<T> &var)
     else
     {
         d->variables.insert(var->GetName(), var);
+        VariablesChanged();
     }
 }
 
@@ -391,7 +416,7 @@ void VContainer::UpdateGObject(quint32 id, const QSharedPointer<T> &obj)
 {
     SCASSERT(not obj.isNull())
     UpdateObject(id, obj);
-    uniqueNames[d->nspace].insert(obj->name());
+    AddUniqueName(d->nspace, obj->name());
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -39,7 +39,7 @@
 #include "../vmisc/def.h"
 #include "../vmisc/vabstractapplication.h"
 #include "../vmisc/vcommonsettings.h"
-#include "calculator.h"
+#include "vcalculatorcache.h"
 #include "vcontainer.h"
 #include "vtranslatevars.h"
 
@@ -233,8 +233,7 @@ void VFormula::Eval()
     {
         try
         {
-            QScopedPointer<Calculator> cal(new Calculator());
-            result = cal->EvalFormula(d->data->DataVariables(), d->formula);
+            result = VCalculatorCache::Instance()->EvalFormula(d->data, d->formula);
         }
         catch (qmu::QmuParserError &e)
         {
@@ -27,6 +27,7 @@
  *************************************************************************/
 
 #include "vpassmark.h"
+#include "vpiecegeometry.h"
 #include "../vmisc/vabstractapplication.h"
 #include "../ifc/exception/vexceptioninvalidnotch.h"
 #include "../vgeometry/vabstractcurve.h"
@@ -659,16 +660,7 @@ QVector<QLineF> VPassmark::FullPassmark(const VPiece &piece, const VContainer *d
     {
         QVector<QLineF> lines;
         lines += SAPassmark(piece, data, PassmarkSide::All);
-        if (qApp->Settings()->IsDoublePassmark()
-                && (qApp->Settings()->IsPieceShowMainPath() || not piece.IsHideMainPath())
-                && m_data.isMainPathNode
-                && m_data.passmarkAngleType != PassmarkAngleType::Intersection
-                && m_data.passmarkAngleType != PassmarkAngleType::IntersectionOnlyLeft
-                && m_data.passmarkAngleType != PassmarkAngleType::IntersectionOnlyRight
-                && m_data.passmarkAngleType != PassmarkAngleType::Intersection2
-                && m_data.passmarkAngleType != PassmarkAngleType::Intersection2OnlyLeft
-                && m_data.passmarkAngleType != PassmarkAngleType::Intersection2OnlyRight
-                && m_data.isShowSecondPassmark)
+        if (IsSecondPassmarkVisible(piece))
         {
             lines += BuiltInSAPassmark(piece, data);
         }
@@ -678,6 +670,34 @@ QVector<QLineF> VPassmark::FullPassmark(const VPiece &piece, const VContainer *d
     return BuiltInSAPassmark(piece, data);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief FullPassmark return passmark lines using already calculated geometry of the piece.
+ * @param piece piece.
+ * @param geometry geometry of the piece.
+ * @return passmark lines.
+ */
+QVector<QLineF> VPassmark::FullPassmark(const VPiece &piece, const VPieceGeometry &geometry) const
+{
+    if (m_null)
+    {
+        return QVector<QLineF>();
+    }
+
+    if (not piece.IsSeamAllowanceBuiltIn())
+    {
+        QVector<QLineF> lines;
+        lines += SAPassmark(geometry.SeamAllowanceWithRotation(m_data.passmarkIndex), PassmarkSide::All);
+        if (IsSecondPassmarkVisible(piece))
+        {
+            lines += BuiltInSAPassmark(piece, geometry.MainPath());
+        }
+        return lines;
+    }
+
+    return BuiltInSAPassmark(piece, geometry.MainPath());
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QVector<QLineF> VPassmark::SAPassmark(const VPiece &piece, const VContainer *data, PassmarkSide side) const
 {
@@ -750,6 +770,21 @@ QVector<QLineF> VPassmark::MakeSAPassmark(const QVector<QPointF> &seamAllowance,
     return lines;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool VPassmark::IsSecondPassmarkVisible(const VPiece &piece) const
+{
+    return qApp->Settings()->IsDoublePassmark()
+            && (qApp->Settings()->IsPieceShowMainPath() || not piece.IsHideMainPath())
+            && m_data.isMainPathNode
+            && m_data.passmarkAngleType != PassmarkAngleType::Intersection
+            && m_data.passmarkAngleType != PassmarkAngleType::IntersectionOnlyLeft
+            && m_data.passmarkAngleType != PassmarkAngleType::IntersectionOnlyRight
+            && m_data.passmarkAngleType != PassmarkAngleType::Intersection2
+            && m_data.passmarkAngleType != PassmarkAngleType::Intersection2OnlyLeft
+            && m_data.passmarkAngleType != PassmarkAngleType::Intersection2OnlyRight
+            && m_data.isShowSecondPassmark;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QVector<QLineF> VPassmark::BuiltInSAPassmark(const VPiece &piece, const VContainer *data) const
 {
@@ -768,6 +803,24 @@ QVector<QLineF> VPassmark::BuiltInSAPassmark(const VPiece &piece, const VContain
                                PassmarkSide::All);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QLineF> VPassmark::BuiltInSAPassmark(const VPiece &piece, const QVector<QPointF> &mainPath) const
+{
+    if (m_null)
+    {
+        return QVector<QLineF>();
+    }
+
+    const QVector<QLineF> lines = BuiltInSAPassmarkBaseLine(piece);
+    if (lines.isEmpty())
+    {
+        return QVector<QLineF>();
+    }
+
+    return CreatePassmarkLines(m_data.passmarkLineType, m_data.passmarkAngleType, lines, mainPath,
+                               PassmarkSide::All);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QVector<QLineF> VPassmark::BuiltInSAPassmarkBaseLine(const VPiece &piece) const
 {
@@ -35,6 +35,8 @@
 #include "../vgeometry/vgeometrydef.h"
 #include "../vmisc/typedef.h"
 
+class VPieceGeometry;
+
 enum class PassmarkStatus: qint8
 {
     Error = 0,
@@ -77,9 +79,11 @@ public:
     explicit VPassmark(const VPiecePassmarkData &data);
 
     QVector<QLineF> FullPassmark(const VPiece& piece, const VContainer *data) const;
+    QVector<QLineF> FullPassmark(const VPiece& piece, const VPieceGeometry &geometry) const;
     QVector<QLineF> SAPassmark(const VPiece& piece, const VContainer *data, PassmarkSide side) const;
     QVector<QLineF> SAPassmark(const QVector<QPointF> &seamAllowance, PassmarkSide side) const;
     QVector<QLineF> BuiltInSAPassmark(const VPiece &piece, const VContainer *data) const;
+    QVector<QLineF> BuiltInSAPassmark(const VPiece &piece, const QVector<QPointF> &mainPath) const;
 
     QVector<QLineF> BuiltInSAPassmarkBaseLine(const VPiece &piece) const;
     QVector<QLineF> SAPassmarkBaseLine(const VPiece &piece, const VContainer *data, PassmarkSide side) const;
@@ -100,6 +104,7 @@ private:
     bool m_null{true};
 
     QVector<QLineF> MakeSAPassmark(const QVector<QPointF> &seamAllowance, PassmarkSide side) const;
+    bool IsSecondPassmarkVisible(const VPiece &piece) const;
 
 };
 
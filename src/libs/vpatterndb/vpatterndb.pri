@@ -5,6 +5,7 @@ SOURCES += \
     $$PWD/testpassmark.cpp \
     $$PWD/vcontainer.cpp \
     $$PWD/calculator.cpp \
+    $$PWD/vcalculatorcache.cpp \
     $$PWD/vnodedetail.cpp \
     $$PWD/vtranslatevars.cpp \
     $$PWD/variables/varcradius.cpp \
@@ -28,7 +29,8 @@ SOURCES += \
     $$PWD/floatItemData/vabstractfloatitemdata.cpp \
     $$PWD/measurements.cpp \
     $$PWD/pmsystems.cpp \
-    $$PWD/vpassmark.cpp
+    $$PWD/vpassmark.cpp \
+    $$PWD/vpiecegeometry.cpp
 
 *msvc*:SOURCES += $$PWD/stable.cpp
 
@@ -37,6 +39,7 @@ HEADERS += \
     $$PWD/vcontainer.h \
     $$PWD/stable.h \
     $$PWD/calculator.h \
+    $$PWD/vcalculatorcache.h \
     $$PWD/variables.h \
     $$PWD/vnodedetail.h \
     $$PWD/vnodedetail_p.h \
@@ -79,4 +82,5 @@ HEADERS += \
     $$PWD/measurements.h \
     $$PWD/pmsystems.h \
     $$PWD/vformula_p.h \
-    $$PWD/vpassmark.h
+    $$PWD/vpassmark.h \
+    $$PWD/vpiecegeometry.h
@@ -96,17 +96,6 @@ bool IsPassmarksPossible(const QVector<VPieceNode> &path)
 
     return countPointNodes >= 3 || (countPointNodes >= 1 && countOthers >= 1);
 }
-
-//---------------------------------------------------------------------------------------------------------------------
-QVector<VPieceNode> RotatePath(const QVector<VPieceNode> &path, int index)
-{
-    if (index < 0 || index >= path.size())
-    {
-        return path;
-    }
-
-    return path.mid(index) + path.mid(0, index);
-}
 } // anonymous namespace
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -329,22 +318,29 @@ QPainterPath VPiece::SeamAllowancePath(const QVector<QPointF> &points) const
 //---------------------------------------------------------------------------------------------------------------------
 QPainterPath VPiece::PassmarksPath(const VContainer *data) const
 {
-    const QVector<QLineF> passmarks = PassmarksLines(data);
-    QPainterPath path;
-
     // seam allowence
     if (IsSeamAllowance())
     {
-        if (not passmarks.isEmpty())
-        {
-            for (qint32 i = 0; i < passmarks.count(); ++i)
-            {
-                path.moveTo(passmarks.at(i).p1());
-                path.lineTo(passmarks.at(i).p2());
-            }
+        return VPiece::PassmarksPath(PassmarksLines(data));
+    }
+
+    return QPainterPath();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QPainterPath VPiece::PassmarksPath(const QVector<QLineF> &passmarks)
+{
+    QPainterPath path;
 
-            path.setFillRule(Qt::WindingFill);
+    if (not passmarks.isEmpty())
+    {
+        for (qint32 i = 0; i < passmarks.count(); ++i)
+        {
+            path.moveTo(passmarks.at(i).p1());
+            path.lineTo(passmarks.at(i).p2());
         }
+
+        path.setFillRule(Qt::WindingFill);
     }
 
     return path;
@@ -662,16 +658,45 @@ QVector<QPointF> VPiece::SeamAllowancePointsWithRotation(const VContainer *data,
         return QVector<QPointF>();
     }
 
+    QVector<int> nodeStarts;
+    const QVector<VSAPoint> pointsEkv = SeamAllowanceEkvPoints(data, &nodeStarts);
+    return SeamAllowanceFromEkvPoints(pointsEkv, makeFirst > 0 ? nodeStarts.value(makeFirst, 0) : 0, data);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SeamAllowanceEkvPoints return points of the united path prepared for building the seam allowance.
+ *
+ * The points do not depend on a start node of the path, so a seam allowance that starts from any node can be built
+ * from one list by rotating it.
+ * @param data container with pattern objects.
+ * @param nodeStarts if not null receives for each node of the united path an index of its first point in the list.
+ * @return points for building the equidistant.
+ */
+QVector<VSAPoint> VPiece::SeamAllowanceEkvPoints(const VContainer *data, QVector<int> *nodeStarts) const
+{
+    SCASSERT(data != nullptr);
+
     const QVector<CustomSARecord> records = FilterRecords(GetValidRecords());
     int recordIndex = -1;
     bool insertingCSA = false;
     const qreal width = ToPixel(GetSAWidth(), *data->GetPatternUnit());
-    const QVector<VPieceNode> unitedPath = makeFirst > 0 ? RotatePath(GetUnitedPath(data), makeFirst)
-                                                         : GetUnitedPath(data);
+    const QVector<VPieceNode> unitedPath = GetUnitedPath(data);
+
+    if (nodeStarts != nullptr)
+    {
+        nodeStarts->clear();
+        nodeStarts->reserve(unitedPath.size());
+    }
 
     QVector<VSAPoint> pointsEkv;
     for (int i = 0; i< unitedPath.size(); ++i)
     {
+        if (nodeStarts != nullptr)
+        {
+            nodeStarts->append(pointsEkv.size());
+        }
+
         const VPieceNode &node = unitedPath.at(i);
         if (node.IsExcluded())
         {
@@ -736,7 +761,32 @@ QVector<QPointF> VPiece::SeamAllowancePointsWithRotation(const VContainer *data,
         }
     }
 
-    return Equidistant(pointsEkv, width, GetName());
+    return pointsEkv;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SeamAllowanceFromEkvPoints build the seam allowance that starts from a point of the prepared list.
+ *
+ * Rollback is calculated only for the first point, so the equidistant is built for each start point separately.
+ * @param points points returned by SeamAllowanceEkvPoints.
+ * @param start index of the first point.
+ * @param data container with pattern objects.
+ * @return seam allowance points.
+ */
+QVector<QPointF> VPiece::SeamAllowanceFromEkvPoints(const QVector<VSAPoint> &points, int start,
+                                                    const VContainer *data) const
+{
+    SCASSERT(data != nullptr);
+
+    const qreal width = ToPixel(GetSAWidth(), *data->GetPatternUnit());
+
+    if (start <= 0 || start >= points.size())
+    {
+        return Equidistant(points, width, GetName());
+    }
+
+    return Equidistant(points.mid(start) + points.mid(0, start), width, GetName());
 }
 
 //---------------------------------------------------------------------------------------------------------------------
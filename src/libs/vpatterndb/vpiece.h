@@ -81,7 +81,8 @@ public:
 
     QPainterPath SeamAllowancePath(const VContainer *data) const;
     QPainterPath SeamAllowancePath(const QVector<QPointF> &points) const;
-    QPainterPath PassmarksPath(const VContainer *data) const;
+    QPainterPath        PassmarksPath(const VContainer *data) const;
+    static QPainterPath PassmarksPath(const QVector<QLineF> &passmarks);
     QPainterPath PlaceLabelPath(const VContainer *data) const;
 
     bool IsSeamAllowanceValid(const VContainer *data) const;
@@ -133,6 +134,9 @@ public:
     QVector<VPieceNode> GetUnitedPath(const VContainer *data) const;
 
     QVector<QPointF> SeamAllowancePointsWithRotation(const VContainer *data, int makeFirst) const;
+    QVector<VSAPoint> SeamAllowanceEkvPoints(const VContainer *data, QVector<int> *nodeStarts = nullptr) const;
+    QVector<QPointF>  SeamAllowanceFromEkvPoints(const QVector<VSAPoint> &points, int start,
+                                                 const VContainer *data) const;
 
     static void DumpPiece(const VPiece &piece, const VContainer *data);
 private:
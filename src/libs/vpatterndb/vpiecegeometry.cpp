@@ -0,0 +1,172 @@
+/************************************************************************
+ **
+ **  @file   vpiecegeometry.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vpiecegeometry.h"
+#include "vpiece.h"
+#include "vpiecenode.h"
+#include "vcontainer.h"
+#include "../vmisc/vabstractapplication.h"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFuture>
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+#include <functional>
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Create calculate geometry of a piece.
+ *
+ * Independent parts are calculated in parallel. Points of the seam allowance are prepared once, rotated seam
+ * allowances are built from them once for each passmark node.
+ * @param piece piece.
+ * @param data container with pattern objects.
+ * @return geometry of the piece.
+ */
+VPieceGeometry VPieceGeometry::Create(const VPiece &piece, const VContainer *data)
+{
+    SCASSERT(data != nullptr)
+
+    VPieceGeometry geometry;
+    geometry.m_null = false;
+    geometry.m_key = Key(piece, data);
+
+    QFuture<QVector<QPointF> > futureMainPath = QtConcurrent::run(piece, &VPiece::MainPathPoints, data);
+    QFuture<QVector<VPassmark> > futurePassmarks = QtConcurrent::run(piece, &VPiece::Passmarks, data);
+
+    const bool seamAllowance = piece.IsSeamAllowance() && not piece.IsSeamAllowanceBuiltIn();
+    QVector<VSAPoint> pointsEkv;
+    QVector<int> nodeStarts;
+    if (seamAllowance)
+    {
+        QFuture<QVector<QPointF> > futureUnitedPath = QtConcurrent::run(piece, &VPiece::UniteMainPathPoints, data);
+        pointsEkv = piece.SeamAllowanceEkvPoints(data, &nodeStarts);
+        geometry.m_seamAllowance = piece.SeamAllowanceFromEkvPoints(pointsEkv, 0, data);
+        geometry.m_seamAllowanceValid = VAbstractPiece::IsAllowanceValid(futureUnitedPath.result(),
+                                                                         geometry.m_seamAllowance);
+    }
+
+    geometry.m_mainPath = futureMainPath.result();
+    geometry.m_passmarks = futurePassmarks.result();
+
+    if (seamAllowance)
+    {
+        QVector<int> indexes;
+        for (auto &passmark : geometry.m_passmarks)
+        {
+            const int index = passmark.Data().passmarkIndex;
+            if (not passmark.IsNull() && index > 0 && not indexes.contains(index))
+            {
+                indexes.append(index);
+            }
+        }
+
+        // Only the equidistant depends on the start node, points of the path are prepared once.
+        std::function<QVector<QPointF> (int index)> RotatedSeamAllowance =
+                [piece, data, &pointsEkv, &nodeStarts](int index)
+        {
+            return piece.SeamAllowanceFromEkvPoints(pointsEkv, nodeStarts.value(index, 0), data);
+        };
+
+        const QVector<QVector<QPointF>> rotated = QtConcurrent::blockingMapped(indexes, RotatedSeamAllowance);
+        for (int i = 0; i < indexes.size(); ++i)
+        {
+            geometry.m_rotatedSeamAllowance.insert(indexes.at(i), rotated.at(i));
+        }
+    }
+
+    for (auto &passmark : geometry.m_passmarks)
+    {
+        if (not passmark.IsNull())
+        {
+            geometry.m_passmarksLines += passmark.FullPassmark(piece, geometry);
+        }
+    }
+
+    return geometry;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SeamAllowanceWithRotation return seam allowance that starts from a node of the united path.
+ * @param makeFirst index of the node. Not positive index means the original seam allowance.
+ * @return seam allowance points.
+ */
+QVector<QPointF> VPieceGeometry::SeamAllowanceWithRotation(int makeFirst) const
+{
+    if (makeFirst <= 0)
+    {
+        return m_seamAllowance;
+    }
+
+    return m_rotatedSeamAllowance.value(makeFirst);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Key return description of the piece the geometry is calculated for.
+ *
+ * The key includes the piece, nodes of the united path with their formulas, the pattern unit and settings that change
+ * passmarks. Values of variables and positions of objects are not included, the owner of the geometry must drop it
+ * when the pattern is recalculated.
+ * @param piece piece.
+ * @param data container with pattern objects.
+ * @return serialized key.
+ */
+QByteArray VPieceGeometry::Key(const VPiece &piece, const VContainer *data)
+{
+    SCASSERT(data != nullptr)
+
+    QByteArray buffer;
+    QDataStream out(&buffer, QIODevice::WriteOnly);
+
+    out << static_cast<const VAbstractPiece &>(piece)
+        << static_cast<int>(*data->GetPatternUnit())
+        << qApp->Settings()->IsDoublePassmark()
+        << qApp->Settings()->IsPieceShowMainPath();
+
+    const QVector<VPieceNode> unitedPath = piece.GetUnitedPath(data);
+    for (auto &node : unitedPath)
+    {
+        out << node;
+    }
+
+    return buffer;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsActual check if the geometry was calculated for the current state of the piece.
+ * @param piece piece.
+ * @param data container with pattern objects.
+ * @return true if the geometry can be reused.
+ */
+bool VPieceGeometry::IsActual(const VPiece &piece, const VContainer *data) const
+{
+    return not m_null && m_key == Key(piece, data);
+}
@@ -0,0 +1,120 @@
+/************************************************************************
+ **
+ **  @file   vpiecegeometry.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VPIECEGEOMETRY_H
+#define VPIECEGEOMETRY_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QLineF>
+#include <QPointF>
+#include <QTypeInfo>
+#include <QVector>
+#include <QtGlobal>
+
+#include "vpassmark.h"
+
+class VPiece;
+class VContainer;
+
+/**
+ * @brief The VPieceGeometry class keeps a piece geometry calculated for one state of a pattern.
+ *
+ * Seam allowance of a passmark must start from the passmark node, so each passmark used to calculate own rotated seam
+ * allowance several times. The class calculates the main path, the seam allowance, its rotated variants and the
+ * passmarks once, so the piece tool and layout export can share the result. The geometry remembers the piece it was
+ * calculated for, the owner drops it when the pattern is recalculated.
+ */
+class VPieceGeometry
+{
+public:
+    VPieceGeometry() = default;
+
+    static VPieceGeometry Create(const VPiece &piece, const VContainer *data);
+    static QByteArray     Key(const VPiece &piece, const VContainer *data);
+
+    bool IsNull() const;
+    bool IsActual(const VPiece &piece, const VContainer *data) const;
+
+    QVector<QPointF> MainPath() const;
+    QVector<QPointF> SeamAllowance() const;
+    QVector<QPointF> SeamAllowanceWithRotation(int makeFirst) const;
+    bool             IsSeamAllowanceValid() const;
+
+    QVector<VPassmark> Passmarks() const;
+    QVector<QLineF>    PassmarksLines() const;
+
+private:
+    bool m_null{true};
+    QByteArray m_key{};
+    QVector<QPointF> m_mainPath{};
+    QVector<QPointF> m_seamAllowance{};
+    QHash<int, QVector<QPointF>> m_rotatedSeamAllowance{};
+    bool m_seamAllowanceValid{true};
+    QVector<VPassmark> m_passmarks{};
+    QVector<QLineF> m_passmarksLines{};
+};
+
+Q_DECLARE_TYPEINFO(VPieceGeometry, Q_MOVABLE_TYPE);
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool VPieceGeometry::IsNull() const
+{
+    return m_null;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QVector<QPointF> VPieceGeometry::MainPath() const
+{
+    return m_mainPath;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QVector<QPointF> VPieceGeometry::SeamAllowance() const
+{
+    return m_seamAllowance;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline bool VPieceGeometry::IsSeamAllowanceValid() const
+{
+    return m_seamAllowanceValid;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QVector<VPassmark> VPieceGeometry::Passmarks() const
+{
+    return m_passmarks;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline QVector<QLineF> VPieceGeometry::PassmarksLines() const
+{
+    return m_passmarksLines;
+}
+
+#endif // VPIECEGEOMETRY_H
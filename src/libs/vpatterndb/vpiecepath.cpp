@@ -31,7 +31,8 @@
 #include "vcontainer.h"
 #include "../vgeometry/vpointf.h"
 #include "../vlayout/vabstractpiece.h"
-#include "calculator.h"
+#include "vcalculatorcache.h"
+#include "../qmuparser/qmuparsererror.h"
 #include "../vmisc/vabstractapplication.h"
 #include "../ifc/exception/vexceptionobjecterror.h"
 
@@ -957,8 +958,7 @@ bool VPiecePath::IsVisible(const QHash<QString, QSharedPointer<VInternalVariable
     bool visible = true;
     try
     {
-        QScopedPointer<Calculator> cal(new Calculator());
-        const qreal result = cal->EvalFormula(vars, GetVisibilityTrigger());
+        const qreal result = VCalculatorCache::Instance()->EvalFormula(vars, GetVisibilityTrigger());
 
         if (qIsInf(result) || qIsNaN(result))
         {
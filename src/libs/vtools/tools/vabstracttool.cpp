@@ -49,6 +49,7 @@
 #include <QStringData>
 #include <QStringDataPtr>
 #include <QStyle>
+#include <QThread>
 #include <QUndoStack>
 #include <QVector>
 #include <new>
@@ -72,7 +73,8 @@
 #include "../vmisc/vcommonsettings.h"
 #include "../vpatterndb/vcontainer.h"
 #include "../vpatterndb/vpiecenode.h"
-#include "../vpatterndb/calculator.h"
+#include "../vpatterndb/vcalculatorcache.h"
+#include "../qmuparser/qmuparsererror.h"
 #include "../vwidgets/vgraphicssimpletextitem.h"
 #include "nodeDetails/nodedetails.h"
 #include "../dialogs/support/dialogundo.h"
@@ -132,8 +134,7 @@ qreal VAbstractTool::CheckFormula(const quint32 &toolId, QString &formula, VCont
     qreal result = 0;
     try
     {
-        QScopedPointer<Calculator> cal(new Calculator());
-        result = cal->EvalFormula(data->DataVariables(), formula);
+        result = VCalculatorCache::Instance()->EvalFormula(data, formula);
 
         if (qIsInf(result) || qIsNaN(result))
         {
@@ -149,7 +150,8 @@ qreal VAbstractTool::CheckFormula(const quint32 &toolId, QString &formula, VCont
                  << "Expression:  " << e.GetExpr() << "\n"
                  << "--------------------------------------";
 
-        if (qApp->IsAppInGUIMode())
+        // Dialogs can be shown only from the main thread. Workers of parallel parse leave the error to the caller.
+        if (qApp->IsAppInGUIMode() && QThread::currentThread() == qApp->thread())
         {
             QScopedPointer<DialogUndo> dialogUndo(new DialogUndo(qApp->getMainWindow()));
             forever
@@ -168,8 +170,7 @@ qreal VAbstractTool::CheckFormula(const quint32 &toolId, QString &formula, VCont
                             /* Need delete dialog here because parser in dialog don't allow use correct separator for
                              * parsing here. */
                             delete dialog;
-                            QScopedPointer<Calculator> cal1(new Calculator());
-                            result = cal1->EvalFormula(data->DataVariables(), formula);
+                            result = VCalculatorCache::Instance()->EvalFormula(data, formula);
 
                             if (qIsInf(result) || qIsNaN(result))
                             {
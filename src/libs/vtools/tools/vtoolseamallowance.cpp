@@ -31,7 +31,9 @@
 #include "../dialogs/tools/piece/dialogduplicatedetail.h"
 #include "../vpatterndb/vpiecenode.h"
 #include "../vpatterndb/vpiecepath.h"
-#include "../vpatterndb/calculator.h"
+#include "../vpatterndb/vpiecegeometry.h"
+#include "../vpatterndb/vcalculatorcache.h"
+#include "../qmuparser/qmuparsererror.h"
 #include "../vpatterndb/floatItemData/vpatternlabeldata.h"
 #include "../vpatterndb/floatItemData/vpiecelabeldata.h"
 #include "nodeDetails/nodedetails.h"
@@ -56,8 +58,6 @@
 #include "../qmuparser/qmutokenparser.h"
 #include "../vlayout/vlayoutdef.h"
 
-#include <QFuture>
-#include <QtConcurrent/QtConcurrentRun>
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsView>
 #include <QKeyEvent>
@@ -1275,19 +1275,9 @@ void VToolSeamAllowance::RefreshGeometry(bool updateChildren)
     this->setFlag(QGraphicsItem::ItemSendsGeometryChanges, false);
 
     const VPiece detail = VAbstractTool::data.GetPiece(m_id);
-    QFuture<QPainterPath > futurePath = QtConcurrent::run(detail,
-                                                          QOverload<const VContainer *>::of(&VPiece::MainPathPath),
-                                                          this->getData());
-    QFuture<QPainterPath > futurePassmarks = QtConcurrent::run(detail, &VPiece::PassmarksPath, this->getData());
-
-    QFuture<QVector<QPointF> > futureSeamAllowance;
-    QFuture<bool> futureSeamAllowanceValid;
-
-    if (detail.IsSeamAllowance())
-    {
-        futureSeamAllowance = QtConcurrent::run(detail, &VPiece::SeamAllowancePoints, this->getData());
-        futureSeamAllowanceValid = QtConcurrent::run(detail, &VPiece::IsSeamAllowanceValid, this->getData());
-    }
+    // Calculate the geometry once and share it with layout export. Old geometry must not survive a failed update.
+    m_geometry = VPieceGeometry();
+    m_geometry = VPieceGeometry::Create(detail, this->getData());
 
     this->setPos(detail.GetMx(), detail.GetMy());
 
@@ -1299,13 +1289,13 @@ void VToolSeamAllowance::RefreshGeometry(bool updateChildren)
         m_mainPath = QPainterPath();
         m_mainPathRect = QRectF();
         m_seamAllowance->setBrush(QBrush(Qt::Dense7Pattern));
-        path = futurePath.result();
+        path = VPiece::MainPathPath(m_geometry.MainPath());
     }
     else
     {
         m_seamAllowance->setBrush(QBrush(Qt::NoBrush)); // Disable if the main path was hidden
         // need for returning a bounding rect when main path is not visible
-        m_mainPath = futurePath.result();
+        m_mainPath = VPiece::MainPathPath(m_geometry.MainPath());
         m_mainPathRect = m_mainPath.controlPointRect();
         path = QPainterPath();
     }
@@ -1316,14 +1306,14 @@ void VToolSeamAllowance::RefreshGeometry(bool updateChildren)
 
     if (detail.IsSeamAllowance() && not detail.IsSeamAllowanceBuiltIn())
     {
-        if (not futureSeamAllowanceValid.result())
+        if (not m_geometry.IsSeamAllowanceValid())
         {
             const QString errorMsg = QObject::tr("Piece '%1'. Seam allowance is not valid.")
                     .arg(detail.GetName());
             qApp->IsPedantic() ? throw VException(errorMsg) :
                                  qWarning() << VAbstractApplication::patternMessageSignature + errorMsg;
         }
-        path.addPath(detail.SeamAllowancePath(futureSeamAllowance.result()));
+        path.addPath(detail.SeamAllowancePath(m_geometry.SeamAllowance()));
         path.setFillRule(Qt::OddEvenFill);
         m_seamAllowance->setPath(path);
     }
@@ -1360,11 +1350,34 @@ void VToolSeamAllowance::RefreshGeometry(bool updateChildren)
         }
     }
 
-    m_passmarks->setPath(futurePassmarks.result());
+    m_passmarks->setPath(VPiece::PassmarksPath(m_geometry.PassmarksLines()));
 
     this->setFlag(QGraphicsItem::ItemSendsGeometryChanges, true);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Geometry return the piece geometry calculated on the last refresh.
+ *
+ * The result is null if the tool was not refreshed since the last recalculation of the pattern.
+ */
+VPieceGeometry VToolSeamAllowance::Geometry() const
+{
+    return m_geometry;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief InvalidateGeometry drop the geometry calculated on the last refresh.
+ *
+ * The pattern calls it before recalculation. Tools that are not refreshed after that have null geometry, so layout
+ * export calculates it again.
+ */
+void VToolSeamAllowance::InvalidateGeometry()
+{
+    m_geometry = VPieceGeometry();
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VToolSeamAllowance::SaveDialogChange(const QString &undoText)
 {
@@ -1559,8 +1572,7 @@ VPieceItem::MoveTypes VToolSeamAllowance::FindLabelGeometry(const VPatternLabelD
             restrictions &= ~ VPieceItem::IsRotatable;
         }
 
-        Calculator cal1;
-        rotationAngle = cal1.EvalFormula(VAbstractTool::data.DataVariables(), labelData.GetRotation());
+        rotationAngle = VCalculatorCache::Instance()->EvalFormula(&VAbstractTool::data, labelData.GetRotation());
     }
     catch(qmu::QmuParserError &e)
     {
@@ -1601,13 +1613,11 @@ VPieceItem::MoveTypes VToolSeamAllowance::FindLabelGeometry(const VPatternLabelD
     {
         const bool widthIsSingle = qmu::QmuTokenParser::IsSingle(labelData.GetLabelWidth());
 
-        Calculator cal1;
-        labelWidth = cal1.EvalFormula(VAbstractTool::data.DataVariables(), labelData.GetLabelWidth());
+        labelWidth = VCalculatorCache::Instance()->EvalFormula(&VAbstractTool::data, labelData.GetLabelWidth());
 
         const bool heightIsSingle = qmu::QmuTokenParser::IsSingle(labelData.GetLabelHeight());
 
-        Calculator cal2;
-        labelHeight = cal2.EvalFormula(VAbstractTool::data.DataVariables(), labelData.GetLabelHeight());
+        labelHeight = VCalculatorCache::Instance()->EvalFormula(&VAbstractTool::data, labelData.GetLabelHeight());
 
         if (not widthIsSingle || not heightIsSingle)
         {
@@ -1688,16 +1698,14 @@ VPieceItem::MoveTypes VToolSeamAllowance::FindGrainlineGeometry(const VGrainline
             restrictions &= ~ VPieceItem::IsRotatable;
         }
 
-        Calculator cal1;
-        rotationAngle = cal1.EvalFormula(VAbstractTool::data.DataVariables(), geom.GetRotation());
+        rotationAngle = VCalculatorCache::Instance()->EvalFormula(&VAbstractTool::data, geom.GetRotation());
 
         if (not qmu::QmuTokenParser::IsSingle(geom.GetLength()))
         {
             restrictions &= ~ VPieceItem::IsResizable;
         }
 
-        Calculator cal2;
-        length = cal2.EvalFormula(VAbstractTool::data.DataVariables(), geom.GetLength());
+        length = VCalculatorCache::Instance()->EvalFormula(&VAbstractTool::data, geom.GetLength());
     }
     catch(qmu::QmuParserError &e)
     {
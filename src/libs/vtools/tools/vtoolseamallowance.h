@@ -37,6 +37,7 @@
 #include "vinteractivetool.h"
 #include "../vwidgets/vtextgraphicsitem.h"
 #include "../vwidgets/vgrainlineitem.h"
+#include "../vpatterndb/vpiecegeometry.h"
 
 class DialogTool;
 class VNoBrushScalePathItem;
@@ -110,6 +111,8 @@ public:
     void ConnectOutsideSignals();
     void ReinitInternals(const VPiece &detail, VMainGraphicsScene *scene);
     void RefreshGeometry(bool updateChildren = true);
+    VPieceGeometry Geometry() const;
+    void InvalidateGeometry();
 
     virtual int        type() const override {return Type;}
     enum { Type = UserType + static_cast<int>(Tool::Piece)};
@@ -191,6 +194,9 @@ private:
 
     bool m_acceptHoverEvents;
 
+    /** @brief m_geometry geometry of the piece calculated on the last refresh. */
+    VPieceGeometry m_geometry{};
+
     VToolSeamAllowance(const VToolSeamAllowanceInitData &initData, QGraphicsItem * parent = nullptr);
 
     void UpdateExcludeState();
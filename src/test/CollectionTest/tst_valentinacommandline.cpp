@@ -31,6 +31,7 @@
 
 #include <QtTest>
 #include <QGlobalStatic>
+#include <algorithm>
 
 namespace
 {
@@ -157,6 +158,22 @@ void TST_ValentinaCommandLine::ExportMode_data() const
             << "glimited_no_m.val"
             << QString("-p;;0;;-d;;%1;;--gsize;;40;;--gheight;;134;;-b;;output;;--coefficient;;1").arg(tmp)
             << V_EX_DATAERR;
+
+    QTest::newRow("Batch grading. Multisize measurements. Correct data.")
+            << "glimited_vst.val"
+            << QString("-p;;0;;-d;;%1;;--gsizes;;40;;--gheights;;134;;-b;;output_{size}_{height};;--coefficient;;1")
+               .arg(tmp)
+            << V_EX_OK;
+
+    QTest::newRow("Batch grading. Multisize measurements. Wrong data.")
+            << "glimited_vst.val"
+            << QString("-p;;0;;-d;;%1;;--gsizes;;40,46;;--gheights;;134;;-b;;output;;--coefficient;;1").arg(tmp)
+            << V_EX_DATAERR;
+
+    QTest::newRow("Batch grading. Individual measurements.")
+            << "glimited_vit.val"
+            << QString("-p;;0;;-d;;%1;;--gsizes;;40;;--gheights;;134;;-b;;output;;--coefficient;;1").arg(tmp)
+            << V_EX_DATAERR;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -176,6 +193,88 @@ void TST_ValentinaCommandLine::ExportMode()
     QVERIFY2(exit == exitCode, qUtf8Printable(error.right(350)));
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void TST_ValentinaCommandLine::ExportGradedFiles_data() const
+{
+    QTest::addColumn<QString>("folder");
+    QTest::addColumn<QString>("arguments");
+    QTest::addColumn<QStringList>("expectedLayouts");
+    QTest::addColumn<QStringList>("expectedFM");
+
+    // Layout files get the number of a sheet after the base name
+    QTest::newRow("Both placeholders")
+            << "graded_both"
+            << QString("--gsizes;;40,42;;--gheights;;134,140;;-b;;out_{size}_{height}_;;"
+                       "--csvExportFM;;fm_{size}_{height}.csv")
+            << QStringList{"out_40_134_", "out_42_134_", "out_40_140_", "out_42_140_"}
+            << QStringList{"fm_40_134.csv", "fm_42_134.csv", "fm_40_140.csv", "fm_42_140.csv"};
+
+    QTest::newRow("Only size placeholder")
+            << "graded_size"
+            << QString("--gsizes;;40;;--gheights;;134,140;;-b;;out_{size};;--csvExportFM;;fm_{size}.csv")
+            << QStringList{"out_40_134", "out_40_140"}
+            << QStringList{"fm_40_134.csv", "fm_40_140.csv"};
+
+    QTest::newRow("Only height placeholder")
+            << "graded_height"
+            << QString("--gsizes;;40,42;;--gheights;;134;;-b;;out_{height};;--csvExportFM;;fm_{height}.csv")
+            << QStringList{"out_134_40", "out_134_42"}
+            << QStringList{"fm_134_40.csv", "fm_134_42.csv"};
+
+    QTest::newRow("No placeholders")
+            << "graded_none"
+            << QString("--gsizes;;40,42;;--gheights;;134;;-b;;out;;--csvExportFM;;fm.csv")
+            << QStringList{"out_40_134", "out_42_134"}
+            << QStringList{"fm_40_134.csv", "fm_42_134.csv"};
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_ValentinaCommandLine::ExportGradedFiles()
+{
+    QFETCH(QString, folder);
+    QFETCH(QString, arguments);
+    QFETCH(QStringList, expectedLayouts);
+    QFETCH(QStringList, expectedFM);
+
+    const QString tmp = QCoreApplication::applicationDirPath() + QDir::separator() + *tmpTestFolder;
+    const QString output = tmp + QDir::separator() + folder;
+    QDir outputDir(output);
+    QVERIFY(outputDir.removeRecursively());
+    QVERIFY(QDir().mkpath(output));
+
+    QStringList args = arguments.split(";;");
+    const int fmIndex = args.indexOf("--csvExportFM") + 1;
+    args[fmIndex] = output + QDir::separator() + args.at(fmIndex);
+
+    QString error;
+    const QStringList arg = QStringList() << tmp + QDir::separator() + QLatin1String("glimited_vst.val")
+                                          << "-p" << "0" << "-d" << output << "--coefficient" << "1" << args;
+    const int exit = Run(V_EX_OK, ValentinaPath(), arg, error);
+    QVERIFY2(exit == V_EX_OK, qUtf8Printable(error.right(350)));
+
+    const QStringList files = outputDir.entryList(QDir::Files, QDir::Name);
+
+    // Each combination must have own files, otherwise later combinations overwrite earlier ones
+    for (auto &name : expectedFM)
+    {
+        QVERIFY2(files.contains(name), qUtf8Printable(QStringLiteral("Missing file %1.").arg(name)));
+    }
+
+    for (auto &base : expectedLayouts)
+    {
+        const QString firstSheet = base + QLatin1String("1.svg");
+        QVERIFY2(files.contains(firstSheet), qUtf8Printable(QStringLiteral("Missing file %1.").arg(firstSheet)));
+    }
+
+    for (auto &file : files)
+    {
+        const bool expected = expectedFM.contains(file)
+                || std::any_of(expectedLayouts.cbegin(), expectedLayouts.cend(),
+                               [file](const QString &base) {return file.startsWith(base);});
+        QVERIFY2(expected, qUtf8Printable(QStringLiteral("Unexpected file %1.").arg(file)));
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void TST_ValentinaCommandLine::TestMode_data() const
 {
@@ -295,6 +394,99 @@ void TST_ValentinaCommandLine::TestOpenCollection()
     QVERIFY2(exit == exitCode, qUtf8Printable(error.right(350)));
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void TST_ValentinaCommandLine::TestIncrementalParse_data() const
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<QString>("arguments");
+    QTest::addColumn<int>("exitCode");
+
+    // Patterns with several pattern pieces. Each pattern piece gets a changed formula.
+    const QString tmp = QCoreApplication::applicationDirPath() + QDir::separator() + *tmpTestCollectionFolder;
+    const QString testGOST = QString("--test;;--checkIncremental;;-m;;%1")
+            .arg(tmp + QDir::separator() + QLatin1String("GOST_man_ru.vst"));
+    const QString keyTest = QStringLiteral("--test;;--checkIncremental");
+
+    QTest::newRow("TShirt_test")            << "TShirt_test.val"            << keyTest  << V_EX_OK;
+    QTest::newRow("Gent Jacket with tummy") << "Gent_Jacket_with_tummy.val" << keyTest  << V_EX_OK;
+#ifdef Q_OS_WIN
+    Q_UNUSED(testGOST)
+#else
+    QTest::newRow("jacketM5_30-110")        << "jacketM5_30-110.val"        << testGOST << V_EX_OK;
+    QTest::newRow("modell_2")               << "modell_2.val"               << keyTest  << V_EX_OK;
+#endif
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_ValentinaCommandLine::TestIncrementalParse()
+{
+    QFETCH(QString, file);
+    QFETCH(QString, arguments);
+    QFETCH(int, exitCode);
+
+    QString error;
+    const QString tmp = QCoreApplication::applicationDirPath() + QDir::separator() + *tmpTestCollectionFolder;
+    const QStringList arg = QStringList() << tmp + QDir::separator() + file
+                                          << arguments.split(";;");
+    const int exit = Run(exitCode, ValentinaPath(), arg, error);
+
+    QVERIFY2(exit == exitCode, qUtf8Printable(error.right(350)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_ValentinaCommandLine::TestParallelParse_data() const
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<QString>("arguments");
+    QTest::addColumn<int>("exitCode");
+
+    // Patterns with several pattern pieces. Independent pattern pieces are parsed in parallel.
+    const QString tmp = QCoreApplication::applicationDirPath() + QDir::separator() + *tmpTestCollectionFolder;
+    const QString testGOST = QString("--test;;--checkParallel;;-m;;%1")
+            .arg(tmp + QDir::separator() + QLatin1String("GOST_man_ru.vst"));
+    const QString keyTest = QStringLiteral("--test;;--checkParallel");
+
+    QTest::newRow("TShirt_test")            << "TShirt_test.val"            << keyTest  << V_EX_OK;
+    QTest::newRow("Gent Jacket with tummy") << "Gent_Jacket_with_tummy.val" << keyTest  << V_EX_OK;
+#ifdef Q_OS_WIN
+    Q_UNUSED(testGOST)
+#else
+    QTest::newRow("jacketM5_30-110")        << "jacketM5_30-110.val"        << testGOST << V_EX_OK;
+    QTest::newRow("modell_2")               << "modell_2.val"               << keyTest  << V_EX_OK;
+#endif
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_ValentinaCommandLine::TestParallelParse()
+{
+    QFETCH(QString, file);
+    QFETCH(QString, arguments);
+    QFETCH(int, exitCode);
+
+    QString error;
+    const QString tmp = QCoreApplication::applicationDirPath() + QDir::separator() + *tmpTestCollectionFolder;
+    const QStringList arg = QStringList() << tmp + QDir::separator() + file
+                                          << arguments.split(";;");
+    const int exit = Run(exitCode, ValentinaPath(), arg, error);
+
+    QVERIFY2(exit == exitCode, qUtf8Printable(error.right(350)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_ValentinaCommandLine::TestParallelParseDependentDraws()
+{
+    // The second pattern piece uses a point of the first one, the third pattern piece is independent. If the first two
+    // get into one batch the worker doesn't find the point and the check fails.
+    QString error;
+    const QString tmp = QCoreApplication::applicationDirPath() + QDir::separator() + *tmpTestFolder;
+    const QStringList arg = QStringList() << tmp + QDir::separator() + QLatin1String("parallel_dependency.val")
+                                          << QStringLiteral("--test")
+                                          << QStringLiteral("--checkParallel");
+    const int exit = Run(V_EX_OK, ValentinaPath(), arg, error);
+
+    QVERIFY2(exit == V_EX_OK, qUtf8Printable(error.right(350)));
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 // cppcheck-suppress unusedFunction
 void TST_ValentinaCommandLine::cleanupTestCase()
@@ -43,10 +43,17 @@ private slots:
     void OpenPatterns();
     void ExportMode_data() const;
     void ExportMode();
+    void ExportGradedFiles_data() const;
+    void ExportGradedFiles();
     void TestMode_data() const;
     void TestMode();
     void TestOpenCollection_data() const;
     void TestOpenCollection();
+    void TestIncrementalParse_data() const;
+    void TestIncrementalParse();
+    void TestParallelParse_data() const;
+    void TestParallelParse();
+    void TestParallelParseDependentDraws();
     void cleanupTestCase();
 
 private:
@@ -0,0 +1,88 @@
+/************************************************************************
+ **
+ **  @file   bm_vabstractpiece.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "bm_vabstractpiece.h"
+#include "../vlayout/vabstractpiece.h"
+
+#include <QLineF>
+#include <QtTest>
+#include <algorithm>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief DensePath return a star with thousands of rays. Looks like seam allowance of a piece with long curves.
+ */
+QVector<QPointF> DensePath(qreal scale)
+{
+    const int count = 4000;
+    QVector<QPointF> path;
+    path.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        QLineF ray(0, 0, (i % 2 ? 950 : 1000) * scale, 0);
+        ray.setAngle(360.0 * i / count);
+        path.append(ray.p2());
+    }
+
+    // Seam allowance check expects clockwise paths
+    if (VAbstractPiece::SumTrapezoids(path) > 0)
+    {
+        std::reverse(path.begin(), path.end());
+    }
+    return path;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+BM_VAbstractPiece::BM_VAbstractPiece(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void BM_VAbstractPiece::BenchmarkDensePathLoops() const
+{
+    const QVector<QPointF> path = DensePath(1);
+
+    QBENCHMARK
+    {
+        VAbstractPiece::CheckLoops(path);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void BM_VAbstractPiece::BenchmarkDenseAllowanceValid() const
+{
+    const QVector<QPointF> base = DensePath(1);
+    const QVector<QPointF> allowance = DensePath(1.1);
+
+    QBENCHMARK
+    {
+        VAbstractPiece::IsAllowanceValid(base, allowance);
+    }
+}
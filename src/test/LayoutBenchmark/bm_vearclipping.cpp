@@ -0,0 +1,126 @@
+/************************************************************************
+ **
+ **  @file   bm_vearclipping.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "bm_vearclipping.h"
+#include "../vobj/vobjpaintdevice.h"
+#include "vlayoutbenchmark.h"
+
+#include <QBuffer>
+#include <QPainter>
+#include <QPainterPath>
+#include <QtTest>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+// Split each edge into equal parts to get a piece with many points
+QVector<QPointF> Detailed(const QVector<QPointF> &points, int parts)
+{
+    QVector<QPointF> detailed;
+    detailed.reserve(points.size() * parts);
+    for (int i = 0; i < points.size(); ++i)
+    {
+        const QPointF &p1 = points.at(i);
+        const QPointF &p2 = points.at((i + 1) % points.size());
+        for (int j = 0; j < parts; ++j)
+        {
+            detailed.append(p1 + (p2 - p1) * j / parts);
+        }
+    }
+    return detailed;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QStringList Corpus()
+{
+    return QStringList
+    {
+        QStringLiteral("DP_6"),
+        QStringLiteral("Issue_923_test1"),
+        QStringLiteral("Issue_937_case_1"),
+        QStringLiteral("doll"),
+        QStringLiteral("seamtest1_by_angle"),
+        QStringLiteral("seamtest2"),
+        QStringLiteral("seamtest3"),
+    };
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+BM_VEarClipping::BM_VEarClipping(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void BM_VEarClipping::BenchmarkObjExport_data() const
+{
+    QTest::addColumn<int>("parts");
+
+    QTest::newRow("Pieces") << 1;
+    QTest::newRow("Detailed pieces") << 20;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void BM_VEarClipping::BenchmarkObjExport()
+{
+    QFETCH(int, parts);
+
+    // Seam allowance with seam line inside, like a piece on a layout sheet
+    QVector<QPainterPath> pieces;
+    const QStringList corpus = Corpus();
+    for (auto &name : corpus)
+    {
+        const QString dir = QStringLiteral("://%1/").arg(name);
+
+        QPainterPath path;
+        path.addPolygon(Detailed(VLayoutBenchmark::PointsFromJson(dir + QStringLiteral("output.json")), parts));
+        path.closeSubpath();
+        path.addPolygon(Detailed(VLayoutBenchmark::PointsFromJson(dir + QStringLiteral("input.json")), parts));
+        path.closeSubpath();
+        pieces.append(path);
+    }
+
+    QBENCHMARK
+    {
+        // The engine takes ownership of the device
+        auto *buffer = new QBuffer();
+
+        VObjPaintDevice generator;
+        generator.setOutputDevice(buffer);
+        generator.setSize(QSize(4000, 4000));
+        generator.setResolution(96);
+
+        QPainter painter;
+        QVERIFY(painter.begin(&generator));
+        for (auto &piece : pieces)
+        {
+            painter.drawPath(piece);
+        }
+        QVERIFY(painter.end());
+        QVERIFY(not buffer->data().isEmpty());
+    }
+}
@@ -0,0 +1,162 @@
+/************************************************************************
+ **
+ **  @file   bm_vpositionsindex.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "bm_vpositionsindex.h"
+#include "../vlayout/vpositionsindex.h"
+#include "../vlayout/vlayoutpiece.h"
+
+#include <QtTest>
+
+namespace
+{
+const int markerColumns = 10;
+const int markerRows = 32; // 320 pieces
+const qreal pieceSize = 150;
+const qreal pieceGap = 10;
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> Octagon(const QPointF &topLeft, qreal size)
+{
+    const qreal c = size / 3.;
+    QVector<QPointF> points;
+    points += topLeft + QPointF(c, 0);
+    points += topLeft + QPointF(size - c, 0);
+    points += topLeft + QPointF(size, c);
+    points += topLeft + QPointF(size, size - c);
+    points += topLeft + QPointF(size - c, size);
+    points += topLeft + QPointF(c, size);
+    points += topLeft + QPointF(0, size - c);
+    points += topLeft + QPointF(0, c);
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QRectF MarkerArea()
+{
+    return QRectF(0, 0, markerColumns * (pieceSize + pieceGap), markerRows * (pieceSize + pieceGap));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief LargeMarker imitate a sheet with a few hundreds of arranged pieces.
+ */
+VPositionsIndex LargeMarker()
+{
+    VPositionsIndex index(MarkerArea());
+    for (int row = 0; row < markerRows; ++row)
+    {
+        for (int column = 0; column < markerColumns; ++column)
+        {
+            const QPointF topLeft(column * (pieceSize + pieceGap), row * (pieceSize + pieceGap));
+            const QVector<QPointF> points = Octagon(topLeft, pieceSize);
+
+            VCachedPositions position;
+            position.boundingRect = VLayoutPiece::BoundingRect(points);
+            position.layoutAllowance = VCollisionPolygon(points);
+            index.Append(position);
+        }
+    }
+    return index;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Probes candidate placements spread over the whole marker.
+ */
+QVector<QVector<QPointF>> Probes()
+{
+    QVector<QVector<QPointF>> probes;
+    const QRectF area = MarkerArea();
+    for (qreal y = 0; y < area.height(); y += pieceSize * 1.7)
+    {
+        for (qreal x = 0; x < area.width(); x += pieceSize * 1.3)
+        {
+            probes.append(Octagon(QPointF(x, y), pieceSize * 0.8));
+        }
+    }
+    return probes;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+BM_VPositionsIndex::BM_VPositionsIndex(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void BM_VPositionsIndex::BenchmarkCrossing_data() const
+{
+    QTest::addColumn<bool>("useIndex");
+
+    QTest::newRow("Linear walk") << false;
+    QTest::newRow("Spatial index") << true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void BM_VPositionsIndex::BenchmarkCrossing() const
+{
+    QFETCH(bool, useIndex);
+
+    const VPositionsIndex index = LargeMarker();
+    const QVector<QVector<QPointF>> probes = Probes();
+
+    int crossings = 0;
+
+    auto Test = [&crossings](const VCachedPositions &position, const QRectF &rect, const QVector<QPointF> &probe)
+    {
+        if (position.boundingRect.intersects(rect) && position.layoutAllowance.Intersects(probe, rect))
+        {
+            ++crossings;
+        }
+    };
+
+    QBENCHMARK
+    {
+        crossings = 0;
+        for (auto &probe : probes)
+        {
+            const QRectF rect = VLayoutPiece::BoundingRect(probe);
+
+            if (useIndex)
+            {
+                for (auto i : index.Candidates(rect))
+                {
+                    Test(index.at(i), rect, probe);
+                }
+            }
+            else
+            {
+                for (int i = 0; i < index.Count(); ++i)
+                {
+                    Test(index.at(i), rect, probe);
+                }
+            }
+        }
+    }
+
+    QVERIFY(crossings > 0);
+}
@@ -0,0 +1,90 @@
+/************************************************************************
+ **
+ **  @file   bm_vspline.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "bm_vspline.h"
+#include "../vgeometry/vspline.h"
+#include "../vgeometry/vsplinepath.h"
+
+#include <QtTest>
+
+//---------------------------------------------------------------------------------------------------------------------
+BM_VSpline::BM_VSpline(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void BM_VSpline::BenchmarkFlattening_data() const
+{
+    QTest::addColumn<bool>("batch");
+
+    QTest::newRow("Curve by curve") << false;
+    QTest::newRow("Path batch") << true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void BM_VSpline::BenchmarkFlattening() const
+{
+    QFETCH(bool, batch);
+
+    // Wavy path with many short segments, like a hem or a neckline after several cuts
+    QVector<VSplinePoint> points;
+    for (int i = 0; i < 64; ++i)
+    {
+        const VPointF p(i * 40.0, (i % 2) * 25.0, QString("p%1").arg(i), 5, 10);
+        const qreal angle = (i % 2) ? 330 : 30;
+        points.append(VSplinePoint(p, angle + 180, QString(), angle, QString(), 15, QString(), 15, QString()));
+    }
+
+    const VSplinePath path(points);
+    QVector<VSpline> splines;
+    for (qint32 i = 1; i <= path.CountSubSpl(); ++i)
+    {
+        splines.append(path.GetSpline(i));
+    }
+
+    // New objects each time, otherwise points come from cache
+    qint64 count = 0;
+
+    QBENCHMARK
+    {
+        if (batch)
+        {
+            count += VSplinePath(points).GetPoints().size();
+        }
+        else
+        {
+            for (auto &spl : splines)
+            {
+                const VSpline copy(spl.GetP1(), static_cast<QPointF>(spl.GetP2()), static_cast<QPointF>(spl.GetP3()),
+                                   spl.GetP4());
+                count += copy.GetPoints().size();
+            }
+        }
+    }
+
+    QVERIFY(count > 0);
+}
@@ -0,0 +1,204 @@
+/************************************************************************
+ **
+ **  @file   main.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QResource>
+#include <QTextStream>
+#include <QtTest>
+
+#include "../ifc/exception/vexception.h"
+#include "../vmisc/testvapplication.h"
+#include "bm_vabstractpiece.h"
+#include "bm_vearclipping.h"
+#include "bm_vpositionsindex.h"
+#include "bm_vspline.h"
+#include "vlayoutbenchmark.h"
+
+/*
+ * Benchmark of layout nesting.
+ *
+ * Each line of the report is one run of one marker with one engine. Default format is JSON Lines, use --csv for CSV.
+ * Examples:
+ *     LayoutBenchmark
+ *     LayoutBenchmark --csv --runs 5 --engine nfp --marker basic --marker large
+ *     LayoutBenchmark --runs 1 --marker basic --export /tmp/sheets
+ *
+ * Micro benchmarks of layout routines run with QTest, its options go after "--":
+ *     LayoutBenchmark --micro
+ *     LayoutBenchmark --micro -- -iterations 100 BenchmarkCrossing
+ */
+
+//---------------------------------------------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    Q_INIT_RESOURCE(schema);
+
+    TestVApplication app( argc, argv );
+
+    QResource::registerResource(QCoreApplication::applicationDirPath() + QStringLiteral("/test_data.rcc"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Benchmark of layout nesting."));
+    parser.addHelpOption();
+
+    const QCommandLineOption markerOption(QStringLiteral("marker"),
+                                          QStringLiteral("Marker to nest. Can be repeated. Default all markers."),
+                                          QStringLiteral("name"));
+    const QCommandLineOption engineOption(QStringLiteral("engine"),
+                                          QStringLiteral("Placement engine: edge, nfp or all (default)."),
+                                          QStringLiteral("engine"), QStringLiteral("all"));
+    const QCommandLineOption runsOption(QStringLiteral("runs"),
+                                        QStringLiteral("Number of runs of each marker. Default 3."),
+                                        QStringLiteral("number"), QStringLiteral("3"));
+    const QCommandLineOption csvOption(QStringLiteral("csv"), QStringLiteral("Report in CSV format."));
+    const QCommandLineOption listOption(QStringLiteral("list"), QStringLiteral("List markers and exit."));
+    const QCommandLineOption exportOption(QStringLiteral("export"),
+                                          QStringLiteral("Export sheets of each run to SVG files in the directory."),
+                                          QStringLiteral("directory"));
+
+    const QCommandLineOption microOption(QStringLiteral("micro"),
+                                         QStringLiteral("Run micro benchmarks instead of nesting. Options after '--' "
+                                                        "go to QTest."));
+
+    parser.addOptions({markerOption, engineOption, runsOption, csvOption, listOption, exportOption, microOption});
+    parser.process(app);
+
+    if (parser.isSet(microOption))
+    {
+        const QStringList arguments = QStringList(QCoreApplication::arguments().constFirst())
+                + parser.positionalArguments();
+
+        int status = 0;
+        auto RunBenchmark = [&status, arguments](QObject* obj)
+        {
+            status |= QTest::qExec(obj, arguments);
+            delete obj;
+        };
+
+        RunBenchmark(new BM_VPositionsIndex());
+        RunBenchmark(new BM_VSpline());
+        RunBenchmark(new BM_VAbstractPiece());
+        RunBenchmark(new BM_VEarClipping());
+
+        return status;
+    }
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    const QVector<VBenchmarkMarker> allMarkers = VLayoutBenchmark::Markers();
+
+    if (parser.isSet(listOption))
+    {
+        for (auto &marker : allMarkers)
+        {
+            out << marker.name << '\n';
+        }
+        return 0;
+    }
+
+    QVector<VBenchmarkMarker> markers;
+    const QStringList names = parser.values(markerOption);
+    for (auto &marker : allMarkers)
+    {
+        if (names.isEmpty() || names.contains(marker.name))
+        {
+            markers.append(marker);
+        }
+    }
+
+    if (markers.isEmpty())
+    {
+        err << "Unknown marker." << '\n';
+        return 1;
+    }
+
+    QVector<PlacementEngine> engines;
+    const QString engine = parser.value(engineOption);
+    if (engine == QLatin1String("edge") || engine == QLatin1String("all"))
+    {
+        engines.append(PlacementEngine::EdgeMatching);
+    }
+
+    if (engine == QLatin1String("nfp") || engine == QLatin1String("all"))
+    {
+        engines.append(PlacementEngine::NoFitPolygon);
+    }
+
+    if (engines.isEmpty())
+    {
+        err << "Unknown engine '" << engine << "'." << '\n';
+        return 1;
+    }
+
+    bool ok = false;
+    const int runs = parser.value(runsOption).toInt(&ok);
+    if (not ok || runs < 1)
+    {
+        err << "Invalid number of runs." << '\n';
+        return 1;
+    }
+
+    const QString exportPath = parser.value(exportOption);
+    if (not exportPath.isEmpty() && not QDir().mkpath(exportPath))
+    {
+        err << "Can't create directory '" << exportPath << "'." << '\n';
+        return 1;
+    }
+
+    const bool csv = parser.isSet(csvOption);
+    if (csv)
+    {
+        out << VLayoutBenchmark::CsvHeader().join(QChar(',')) << '\n';
+    }
+
+    try
+    {
+        for (auto &marker : markers)
+        {
+            for (auto placementEngine : engines)
+            {
+                for (int run = 1; run <= runs; ++run)
+                {
+                    const VBenchmarkResult result = VLayoutBenchmark::Run(marker, placementEngine, run,
+                                                                            exportPath);
+                    out << (csv ? VLayoutBenchmark::ToCsv(result) : VLayoutBenchmark::ToJson(result)) << '\n';
+                    out.flush();
+                }
+            }
+        }
+    }
+    catch (const VException &e)
+    {
+        err << e.ErrorMessage() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,396 @@
+/************************************************************************
+ **
+ **  @file   vlayoutbenchmark.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "vlayoutbenchmark.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRectF>
+
+#include "../ifc/exception/vexception.h"
+#include "../vlayout/vlayoutexporter.h"
+#include "../vlayout/vlayoutgenerator.h"
+#include "../vlayout/vlayoutpiece.h"
+#include "../vmisc/def.h"
+#include "../vpatterndb/vcontainer.h"
+#include "../vpatterndb/floatItemData/vgrainlinedata.h"
+
+namespace
+{
+// Fixed settings. Change them only together with reference results.
+const qreal fabricWidth = 150; // cm
+const qreal sheetLength = 300; // cm
+const qreal layoutWidth = 0.2; // cm, gap between pieces
+const int rotationNumber = 2;
+const int timeout = 10 * 60 * 1000; // msecs, protection from endless runs
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Markers return list of reproducible markers.
+ *
+ * Pieces are seam allowance outlines from test data. Markers cover small and big piece count, nesting of quantity and
+ * grainline constraint. Marker "huge" has more than 300 pieces and may take minutes per run.
+ */
+QVector<VBenchmarkMarker> VLayoutBenchmark::Markers()
+{
+    QVector<VBenchmarkMarker> markers;
+
+    VBenchmarkMarker basic;
+    basic.name = QStringLiteral("basic");
+    basic.pieces = QVector<VBenchmarkPiece>
+    {
+        {QStringLiteral("DP_6"), 1},
+        {QStringLiteral("Issue_646"), 1},
+        {QStringLiteral("Issue_880_Detail"), 1},
+        {QStringLiteral("Issue_642"), 1},
+        {QStringLiteral("Issue_767_Fabric_TopCollar"), 1},
+        {QStringLiteral("doll"), 1},
+        {QStringLiteral("seamtest3"), 1},
+        {QStringLiteral("Issue_923_test1"), 1}
+    };
+    markers.append(basic);
+
+    VBenchmarkMarker quantity;
+    quantity.name = QStringLiteral("quantity");
+    quantity.pieces = QVector<VBenchmarkPiece>
+    {
+        {QStringLiteral("doll"), 6},
+        {QStringLiteral("seamtest2"), 6},
+        {QStringLiteral("Issue_923_test1"), 4},
+        {QStringLiteral("Issue_937_case_4"), 4},
+        {QStringLiteral("loop_by_intersection"), 6}
+    };
+    markers.append(quantity);
+
+    VBenchmarkMarker grainline = basic;
+    grainline.name = QStringLiteral("grainline");
+    grainline.grainline = true;
+    for (auto &piece : grainline.pieces)
+    {
+        piece.quantity = 2;
+    }
+    markers.append(grainline);
+
+    VBenchmarkMarker large;
+    large.name = QStringLiteral("large");
+    large.pieces = QVector<VBenchmarkPiece>
+    {
+        {QStringLiteral("DP_6"), 2},
+        {QStringLiteral("Issue_646"), 2},
+        {QStringLiteral("Issue_880_Detail"), 2},
+        {QStringLiteral("Issue_298_case2"), 2},
+        {QStringLiteral("Issue_687"), 2},
+        {QStringLiteral("Issue_883_ledge"), 2},
+        {QStringLiteral("smart_pattern_#36"), 4},
+        {QStringLiteral("Issue_642"), 4},
+        {QStringLiteral("seamtest3"), 4},
+        {QStringLiteral("doll"), 4}
+    };
+    markers.append(large);
+
+    // Production marker scale. Placement cost grows with count of already placed pieces, so effect of placement
+    // optimizations shows only on hundreds of pieces.
+    VBenchmarkMarker huge = large;
+    huge.name = QStringLiteral("huge");
+    for (auto &piece : huge.pieces)
+    {
+        piece.quantity *= 12;
+    }
+    markers.append(huge);
+
+    return markers;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Run nest a marker once.
+ * @param marker marker.
+ * @param engine placement engine.
+ * @param run index of the run. Only goes to the report.
+ * @param exportPath if not empty, sheets of the layout are exported to SVG files in this directory.
+ * @return statistic of the run.
+ */
+VBenchmarkResult VLayoutBenchmark::Run(const VBenchmarkMarker &marker, PlacementEngine engine, int run,
+                                       const QString &exportPath)
+{
+    const QVector<VLayoutPiece> pieces = Pieces(marker);
+
+    VBenchmarkResult result;
+    result.marker = marker.name;
+    result.engine = EngineName(engine);
+    result.run = run;
+    for (auto &piece : pieces)
+    {
+        result.pieces += piece.GetQuantity();
+    }
+
+    VLayoutGenerator generator;
+    generator.SetDetails(pieces);
+    generator.SetLayoutWidth(ToPixel(layoutWidth, Unit::Cm));
+    generator.SetCaseType(Cases::CaseDesc);
+    generator.SetPaperWidth(ToPixel(fabricWidth, Unit::Cm));
+    generator.SetPaperHeight(ToPixel(sheetLength, Unit::Cm));
+    generator.SetPrinterFields(false, QMarginsF());
+    generator.SetRotate(true);
+    generator.SetRotationNumber(rotationNumber);
+    generator.SetFollowGrainline(marker.grainline);
+    generator.SetNestQuantity(true);
+    generator.SetPlacementEngine(engine);
+    generator.SetShift(-1); // Trigger first shift calculation
+
+    QElapsedTimer timer;
+    timer.start();
+    generator.Generate(timer, timeout);
+    result.wallTime = timer.elapsed();
+
+    result.placements = generator.PlacementsCount();
+    result.collisionChecks = generator.CollisionChecksCount();
+    result.state = generator.State();
+    if (result.state == LayoutErrors::NoError)
+    {
+        result.efficiency = generator.LayoutEfficiency();
+        result.sheets = generator.PapersCount();
+
+        if (not exportPath.isEmpty())
+        {
+            timer.restart();
+            Export(generator, exportPath + QLatin1Char('/') + result.marker + QLatin1Char('_') + result.engine +
+                   QLatin1Char('_') + QString::number(run));
+            result.exportTime = timer.elapsed();
+        }
+    }
+
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QString VLayoutBenchmark::EngineName(PlacementEngine engine)
+{
+    switch (engine)
+    {
+        case PlacementEngine::NoFitPolygon:
+            return QStringLiteral("nfp");
+        case PlacementEngine::EdgeMatching:
+        default:
+            return QStringLiteral("edge");
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QStringList VLayoutBenchmark::CsvHeader()
+{
+    return QStringList
+    {
+        QStringLiteral("marker"),
+        QStringLiteral("engine"),
+        QStringLiteral("run"),
+        QStringLiteral("pieces"),
+        QStringLiteral("wallTimeMs"),
+        QStringLiteral("placements"),
+        QStringLiteral("placementsPerSec"),
+        QStringLiteral("collisionChecks"),
+        QStringLiteral("efficiency"),
+        QStringLiteral("sheets"),
+        QStringLiteral("exportTimeMs"),
+        QStringLiteral("state")
+    };
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QString VLayoutBenchmark::ToCsv(const VBenchmarkResult &result)
+{
+    const qreal perSec = result.wallTime > 0 ? result.placements * 1000. / result.wallTime : 0;
+
+    return QStringList
+    {
+        result.marker,
+        result.engine,
+        QString::number(result.run),
+        QString::number(result.pieces),
+        QString::number(result.wallTime),
+        QString::number(result.placements),
+        QString::number(qRound64(perSec)),
+        QString::number(result.collisionChecks),
+        QString::number(result.efficiency, 'f', 2),
+        QString::number(result.sheets),
+        QString::number(result.exportTime),
+        StateName(result.state)
+    }.join(QChar(','));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QString VLayoutBenchmark::ToJson(const VBenchmarkResult &result)
+{
+    const qreal perSec = result.wallTime > 0 ? result.placements * 1000. / result.wallTime : 0;
+
+    QJsonObject object;
+    object[QStringLiteral("marker")] = result.marker;
+    object[QStringLiteral("engine")] = result.engine;
+    object[QStringLiteral("run")] = result.run;
+    object[QStringLiteral("pieces")] = result.pieces;
+    object[QStringLiteral("wallTimeMs")] = result.wallTime;
+    object[QStringLiteral("placements")] = result.placements;
+    object[QStringLiteral("placementsPerSec")] = qRound64(perSec);
+    object[QStringLiteral("collisionChecks")] = result.collisionChecks;
+    object[QStringLiteral("efficiency")] = result.efficiency;
+    object[QStringLiteral("sheets")] = result.sheets;
+    object[QStringLiteral("exportTimeMs")] = result.exportTime;
+    object[QStringLiteral("state")] = StateName(result.state);
+
+    return QString::fromUtf8(QJsonDocument(object).toJson(QJsonDocument::Compact));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Export writes each sheet of the layout to a SVG file. Uses only the library exporter, no scene is created.
+ * @param generator generator after successful nesting.
+ * @param baseName path and beginning of file names. Number of a sheet is appended.
+ */
+void VLayoutBenchmark::Export(const VLayoutGenerator &generator, const QString &baseName)
+{
+    const QRectF sheet(0, 0, generator.GetPaperWidth(), generator.GetPaperHeight());
+    const QVector<QVector<VLayoutPiece>> sheets = generator.GetAllDetails();
+
+    VLayoutExporter exporter;
+    exporter.SetImageRect(sheet);
+    exporter.SetTitle(baseName);
+
+    for (int i = 0; i < sheets.size(); ++i)
+    {
+        exporter.SetFileName(baseName + QLatin1Char('_') + QString::number(i+1) + QStringLiteral(".svg"));
+        if (not exporter.ExportToSVG(sheets.at(i)))
+        {
+            throw VException(tr("Can't export sheet to '%1'.").arg(exporter.FileName()));
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VLayoutPiece> VLayoutBenchmark::Pieces(const VBenchmarkMarker &marker)
+{
+    QVector<VLayoutPiece> pieces;
+    pieces.reserve(marker.pieces.size());
+
+    vidtype id = 1;
+    for (auto &piece : marker.pieces)
+    {
+        pieces.append(Piece(piece, id++, marker.grainline));
+    }
+
+    return pieces;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Piece create a layout piece from test data. Main path comes from input.json, seam allowance from output.json.
+ */
+VLayoutPiece VLayoutBenchmark::Piece(const VBenchmarkPiece &piece, vidtype id, bool grainline)
+{
+    const QString dir = QStringLiteral("://%1/").arg(piece.name);
+
+    VLayoutPiece detail;
+    detail.SetId(id);
+    detail.SetName(piece.name);
+    detail.SetQuantity(piece.quantity);
+    detail.SetCountourPoints(PointsFromJson(dir + QStringLiteral("input.json")));
+    detail.SetSeamAllowancePoints(PointsFromJson(dir + QStringLiteral("output.json")), true, false);
+
+    if (grainline)
+    {
+        Unit unit = Unit::Cm;
+        const VContainer pattern(nullptr, &unit, VContainer::UniqueNamespace());
+
+        VGrainlineData geom;
+        geom.SetVisible(true);
+        geom.SetPos(detail.DetailBoundingRect().center());
+        geom.SetLength(QStringLiteral("10"));
+        geom.SetRotation(QStringLiteral("90"));
+        geom.SetArrowType(GrainlineArrowDirection::atBoth);
+
+        detail.SetGrainline(geom, &pattern);
+    }
+
+    return detail;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PointsFromJson read points from test data. Points of type QPointF and VSAPoint are supported.
+ */
+QVector<QPointF> VLayoutBenchmark::PointsFromJson(const QString &json)
+{
+    QFile file(json);
+    if (not file.open(QIODevice::ReadOnly))
+    {
+        throw VException(tr("Cannot read file '%1'. %2").arg(json, file.errorString()));
+    }
+
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+    const QString vectorKey = QStringLiteral("vector");
+
+    if (not document.object().contains(vectorKey))
+    {
+        throw VException(tr("Invalid json file '%1'. File doesn't contain root object.").arg(json));
+    }
+
+    QVector<QPointF> points;
+    const QJsonArray vector = document.object().value(vectorKey).toArray();
+    points.reserve(vector.size());
+    for (auto item : vector)
+    {
+        const QJsonObject point = item.toObject();
+        points.append(QPointF(point.value(QStringLiteral("x")).toDouble(),
+                              point.value(QStringLiteral("y")).toDouble()));
+    }
+
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QString VLayoutBenchmark::StateName(LayoutErrors state)
+{
+    switch (state)
+    {
+        case LayoutErrors::NoError:
+            return QStringLiteral("ok");
+        case LayoutErrors::PrepareLayoutError:
+            return QStringLiteral("prepareError");
+        case LayoutErrors::ProcessStoped:
+            return QStringLiteral("stopped");
+        case LayoutErrors::EmptyPaperError:
+            return QStringLiteral("emptyPaper");
+        case LayoutErrors::Timeout:
+            return QStringLiteral("timeout");
+        case LayoutErrors::TerminatedByException:
+        default:
+            return QStringLiteral("exception");
+    }
+}
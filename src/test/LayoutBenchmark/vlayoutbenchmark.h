@@ -0,0 +1,111 @@
+/************************************************************************
+ **
+ **  @file   vlayoutbenchmark.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef VLAYOUTBENCHMARK_H
+#define VLAYOUTBENCHMARK_H
+
+#include <QCoreApplication>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QtGlobal>
+
+#include "../vlayout/vlayoutdef.h"
+
+class VLayoutGenerator;
+class VLayoutPiece;
+
+struct VBenchmarkPiece
+{
+    // Name of a directory with test data
+    QString name{};
+    // cppcheck-suppress unusedStructMember
+    quint16 quantity{1};
+};
+
+struct VBenchmarkMarker
+{
+    QString name{};
+    QVector<VBenchmarkPiece> pieces{};
+    // cppcheck-suppress unusedStructMember
+    bool grainline{false};
+};
+
+struct VBenchmarkResult
+{
+    QString marker{};
+    QString engine{};
+    // cppcheck-suppress unusedStructMember
+    int run{0};
+    // cppcheck-suppress unusedStructMember
+    int pieces{0};
+    // cppcheck-suppress unusedStructMember
+    qint64 wallTime{0}; // msecs
+    // cppcheck-suppress unusedStructMember
+    qint64 placements{0};
+    // cppcheck-suppress unusedStructMember
+    qint64 collisionChecks{0};
+    // cppcheck-suppress unusedStructMember
+    qreal efficiency{0};
+    // cppcheck-suppress unusedStructMember
+    int sheets{0};
+    // cppcheck-suppress unusedStructMember
+    qint64 exportTime{0}; // msecs
+    LayoutErrors state{LayoutErrors::NoError};
+};
+
+/**
+ * @brief The VLayoutBenchmark class runs nesting of reproducible markers and reports statistic.
+ *
+ * A marker is a fixed list of real pieces from test data with quantities. Each run uses a new generator with the same
+ * settings and one sequential pass of nesting, so two runs of the same marker give the same layout. Only time depends
+ * on the machine.
+ */
+class VLayoutBenchmark
+{
+    Q_DECLARE_TR_FUNCTIONS(VLayoutBenchmark)
+public:
+    static QVector<VBenchmarkMarker> Markers();
+
+    static VBenchmarkResult Run(const VBenchmarkMarker &marker, PlacementEngine engine, int run,
+                                const QString &exportPath = QString());
+
+    static QString     EngineName(PlacementEngine engine);
+    static QStringList CsvHeader();
+    static QString     ToCsv(const VBenchmarkResult &result);
+    static QString     ToJson(const VBenchmarkResult &result);
+
+    static QVector<QPointF> PointsFromJson(const QString &json);
+
+private:
+    static void                  Export(const VLayoutGenerator &generator, const QString &baseName);
+    static QVector<VLayoutPiece> Pieces(const VBenchmarkMarker &marker);
+    static VLayoutPiece          Piece(const VBenchmarkPiece &piece, vidtype id, bool grainline);
+    static QString               StateName(LayoutErrors state);
+};
+
+#endif // VLAYOUTBENCHMARK_H
@@ -57,10 +57,12 @@ DESTDIR = bin
 OBJECTS_DIR = obj
 
 HEADERS += \
-    stable.h
+    stable.h \
+    parserbenchmark.h
 
 SOURCES += \
-    main.cpp
+    main.cpp \
+    parserbenchmark.cpp
 
 *msvc*:SOURCES += stable.cpp
 
@@ -27,9 +27,11 @@
  *************************************************************************/
 
 #include <QCoreApplication>
+#include <QStringList>
 #include <QTimer>
 #include <QtGlobal>
 #include "../qmuparser/qmuparsertest.h"
+#include "parserbenchmark.h"
 
 //---------------------------------------------------------------------------------------------------------------------
 void testMessageOutput(QtMsgType type, const QMessageLogContext &context, const QString &msg)
@@ -59,6 +61,17 @@ int main(int argc, char *argv[])
 {
     QCoreApplication a(argc, argv);
     qInstallMessageHandler(testMessageOutput);
+
+    // ParserTest --benchmark [iterations]
+    const QStringList arguments = QCoreApplication::arguments();
+    const int benchmark = arguments.indexOf(QStringLiteral("--benchmark"));
+    if (benchmark != -1)
+    {
+        bool ok = false;
+        const int iterations = arguments.value(benchmark + 1).toInt(&ok);
+        return RunParserBenchmark(ok && iterations > 0 ? iterations : 20000);
+    }
+
     qmu::Test::QmuParserTester pt;
     QTimer::singleShot(0, &pt, &qmu::Test::QmuParserTester::Run);
     return a.exec();
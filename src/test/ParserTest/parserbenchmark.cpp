@@ -0,0 +1,241 @@
+/************************************************************************
+ **
+ **  @file   parserbenchmark.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "parserbenchmark.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+
+#include "../qmuparser/qmuformulabase.h"
+#include "../qmuparser/qmuparsererror.h"
+
+namespace
+{
+const int variablesCount = 512;
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief The FactoryFormula class evaluates a formula the way Calculator did before slots.
+ */
+class FactoryFormula : public qmu::QmuFormulaBase
+{
+public:
+    FactoryFormula()
+    {
+        InitCharSets();
+        SetVarFactory(VarFactory, this);
+        SetSepForEval();
+    }
+
+    qreal EvalFormula(const QHash<QString, qreal> *vars, const QString &formula)
+    {
+        m_vars = vars;
+        SetExpr(formula);
+        m_pTokenReader->IgnoreUndefVar(true);
+        return Eval();
+    }
+
+private:
+    Q_DISABLE_COPY(FactoryFormula)
+    QVector<QSharedPointer<qreal>> m_values{};
+    const QHash<QString, qreal> *m_vars{nullptr};
+
+    static qreal *VarFactory(const QString &name, void *userData)
+    {
+        auto *formula = static_cast<FactoryFormula *>(userData);
+        if (not formula->m_vars->contains(name))
+        {
+            throw qmu::QmuParserError(qmu::ecUNASSIGNABLE_TOKEN);
+        }
+
+        QSharedPointer<qreal> value(new qreal(formula->m_vars->value(name)));
+        formula->m_values.append(value);
+        return value.data();
+    }
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief The SlotFormula class keeps compiled formula with variables bound to slots.
+ */
+class SlotFormula : public qmu::QmuFormulaBase
+{
+public:
+    SlotFormula(const QHash<QString, int> *indexes, const QString &formula)
+        : m_indexes(indexes)
+    {
+        InitCharSets();
+        SetVarFactory(VarFactory, this);
+        SetSepForEval();
+
+        // Bytecode keeps pointers to slots, the array must not reallocate.
+        m_slots.reserve(formula.size() / 2 + 1);
+        SetExpr(formula);
+        m_pTokenReader->IgnoreUndefVar(true);
+        QmuFormulaBase::Eval(); // Compile
+    }
+
+    qreal Eval(const QVector<qreal> &values)
+    {
+        for (int i = 0; i < m_slots.size(); ++i)
+        {
+            m_slots[i] = values.at(m_slotIndexes.at(i));
+        }
+        return QmuFormulaBase::Eval();
+    }
+
+private:
+    Q_DISABLE_COPY(SlotFormula)
+    const QHash<QString, int> *m_indexes;
+    QVector<qreal> m_slots{};
+    QVector<int> m_slotIndexes{};
+
+    static qreal *VarFactory(const QString &name, void *userData)
+    {
+        auto *formula = static_cast<SlotFormula *>(userData);
+        if (not formula->m_indexes->contains(name))
+        {
+            throw qmu::QmuParserError(qmu::ecUNASSIGNABLE_TOKEN);
+        }
+
+        formula->m_slotIndexes.append(formula->m_indexes->value(name));
+        formula->m_slots.append(0);
+        return &formula->m_slots.last();
+    }
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+QString VariableName(int i)
+{
+    return QStringLiteral("#var_%1").arg(i);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QStringList Formulas()
+{
+    QStringList formulas;
+    formulas.append(VariableName(1) + QStringLiteral("/2+1.5"));
+    formulas.append(QStringLiteral("(%1+%2)*0.25-%3").arg(VariableName(7), VariableName(110), VariableName(42)));
+    formulas.append(QStringLiteral("max(%1;%2)+sqrt(%3*%3+%4*%4)")
+                    .arg(VariableName(3), VariableName(300), VariableName(17), VariableName(18)));
+    formulas.append(QStringLiteral("%1<%2?%1*2:%2/3+%3")
+                    .arg(VariableName(250), VariableName(251), VariableName(500)));
+    formulas.append(QStringLiteral("sin(%1)*%2+cos(%3)*%4+%5-%6")
+                    .arg(VariableName(11), VariableName(12), VariableName(13), VariableName(14), VariableName(15),
+                         VariableName(16)));
+    return formulas;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void PrintRate(const char *name, int evaluations, qint64 nsecs)
+{
+    const qreal seconds = qMax(static_cast<qreal>(nsecs), 1.) / 1e9;
+    fprintf(stdout, "%-8s %10d evals %10.3f ms %14.0f evals/sec\n", name, evaluations, seconds * 1000.,
+            evaluations / seconds);
+}
+} // namespace
+
+//---------------------------------------------------------------------------------------------------------------------
+int RunParserBenchmark(int iterations)
+{
+    QHash<QString, qreal> vars;
+    QHash<QString, int> indexes;
+    QVector<qreal> values(variablesCount);
+
+    for (int i = 0; i < variablesCount; ++i)
+    {
+        indexes.insert(VariableName(i), i);
+    }
+
+    const QStringList formulas = Formulas();
+    const int evaluations = iterations * formulas.size();
+
+    // Values change between evaluations like after each tool of a pattern.
+    auto UpdateValues = [&vars, &values](int iteration)
+    {
+        for (int i = 0; i < variablesCount; ++i)
+        {
+            values[i] = 1 + (i * 31 + iteration) % 97;
+            vars.insert(VariableName(i), values.at(i));
+        }
+    };
+
+    QVector<qreal> factoryResults;
+    factoryResults.reserve(evaluations);
+    qint64 factoryTime = 0;
+
+    QVector<qreal> slotResults;
+    slotResults.reserve(evaluations);
+    qint64 slotTime = 0;
+
+    QVector<QSharedPointer<SlotFormula>> compiled;
+    for (auto &formula : formulas)
+    {
+        compiled.append(QSharedPointer<SlotFormula>::create(&indexes, formula));
+    }
+
+    QElapsedTimer timer;
+    for (int iteration = 0; iteration < iterations; ++iteration)
+    {
+        UpdateValues(iteration);
+
+        timer.start();
+        for (auto &formula : formulas)
+        {
+            FactoryFormula parser;
+            factoryResults.append(parser.EvalFormula(&vars, formula));
+        }
+        factoryTime += timer.nsecsElapsed();
+
+        timer.start();
+        for (auto &parser : compiled)
+        {
+            slotResults.append(parser->Eval(values));
+        }
+        slotTime += timer.nsecsElapsed();
+    }
+
+    fprintf(stdout, "Formula evaluation, %d formulas, %d variables, %d iterations\n", formulas.size(), variablesCount,
+            iterations);
+    PrintRate("factory", evaluations, factoryTime);
+    PrintRate("slots", evaluations, slotTime);
+    fprintf(stdout, "speedup  %.2fx\n", static_cast<qreal>(factoryTime) / qMax(slotTime, static_cast<qint64>(1)));
+
+    for (int i = 0; i < evaluations; ++i)
+    {
+        if (not qFuzzyCompare(factoryResults.at(i) + 1, slotResults.at(i) + 1))
+        {
+            fprintf(stderr, "Result mismatch: %f != %f\n", factoryResults.at(i), slotResults.at(i));
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+/************************************************************************
+ **
+ **  @file   parserbenchmark.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef PARSERBENCHMARK_H
+#define PARSERBENCHMARK_H
+
+#include <QtGlobal>
+
+/**
+ * @brief RunParserBenchmark compare two ways of evaluating the same formulas with changing variables.
+ *
+ * "factory" parses a formula each time and lets variable factory allocate a copy of each value found by name. This is
+ * how a new Calculator evaluates a formula. "slots" parses a formula once, variables are resolved to indexes of a
+ * dense array of values and each evaluation only copies values into slots read by bytecode.
+ *
+ * @param iterations number of evaluations of each formula.
+ * @return 0 if both ways gave the same results.
+ */
+int RunParserBenchmark(int iterations);
+
+#endif // PARSERBENCHMARK_H
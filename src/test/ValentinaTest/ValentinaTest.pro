@@ -75,7 +75,18 @@ SOURCES += \
     tst_readval.cpp \
     tst_vtranslatevars.cpp \
     tst_vabstractpiece.cpp \
-    tst_vtooluniondetails.cpp
+    tst_vtooluniondetails.cpp \
+    tst_vpositionsindex.cpp \
+    tst_vcollisionpolygon.cpp \
+    tst_vuniformgrid.cpp \
+    tst_vpositionscheduler.cpp \
+    tst_vcontour.cpp \
+    tst_vnfpposition.cpp \
+    tst_vlayoutpiececache.cpp \
+    tst_vlayoutpiecesnapshot.cpp \
+    tst_vpngwriter.cpp \
+    tst_vearclipping.cpp \
+    tst_vcalculatorcache.cpp
 
 *msvc*:SOURCES += stable.cpp
 
@@ -104,7 +115,18 @@ HEADERS += \
     tst_readval.h \
     tst_vtranslatevars.h \
     tst_vabstractpiece.h \
-    tst_vtooluniondetails.h
+    tst_vtooluniondetails.h \
+    tst_vpositionsindex.h \
+    tst_vcollisionpolygon.h \
+    tst_vuniformgrid.h \
+    tst_vpositionscheduler.h \
+    tst_vcontour.h \
+    tst_vnfpposition.h \
+    tst_vlayoutpiececache.h \
+    tst_vlayoutpiecesnapshot.h \
+    tst_vpngwriter.h \
+    tst_vearclipping.h \
+    tst_vcalculatorcache.h
 
 # Set using ccache. Function enable_ccache() defined in common.pri.
 $$enable_ccache()
@@ -213,6 +235,15 @@ DEPENDPATH += $$PWD/../../libs/vgeometry
 win32:!win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/vgeometry/$${DESTDIR}/vgeometry.lib
 else:unix|win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/vgeometry/$${DESTDIR}/libvgeometry.a
 
+# VObj static library
+unix|win32: LIBS += -L$$OUT_PWD/../../libs/vobj/$${DESTDIR}/ -lvobj
+
+INCLUDEPATH += $$PWD/../../libs/vobj
+DEPENDPATH += $$PWD/../../libs/vobj
+
+win32:!win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/vobj/$${DESTDIR}/vobj.lib
+else:unix|win32-g++: PRE_TARGETDEPS += $$OUT_PWD/../../libs/vobj/$${DESTDIR}/libvobj.a
+
 # VDxf static library
 unix|win32: LIBS += -L$$OUT_PWD/../../libs/vdxf/$${DESTDIR}/ -lvdxf
 
@@ -52,6 +52,17 @@
 #include "tst_vtooluniondetails.h"
 #include "tst_vdomdocument.h"
 #include "tst_dxf.h"
+#include "tst_vpositionsindex.h"
+#include "tst_vcollisionpolygon.h"
+#include "tst_vuniformgrid.h"
+#include "tst_vpositionscheduler.h"
+#include "tst_vcontour.h"
+#include "tst_vnfpposition.h"
+#include "tst_vlayoutpiececache.h"
+#include "tst_vlayoutpiecesnapshot.h"
+#include "tst_vpngwriter.h"
+#include "tst_vearclipping.h"
+#include "tst_vcalculatorcache.h"
 
 #include "../vmisc/def.h"
 #include "../qmuparser/qmudef.h"
@@ -96,6 +107,17 @@ int main(int argc, char** argv)
     ASSERT_TEST(new TST_VTranslateVars());
     ASSERT_TEST(new TST_VToolUnionDetails());
     ASSERT_TEST(new TST_DXF());
+    ASSERT_TEST(new TST_VPositionsIndex());
+    ASSERT_TEST(new TST_VCollisionPolygon());
+    ASSERT_TEST(new TST_VUniformGrid());
+    ASSERT_TEST(new TST_VPositionScheduler());
+    ASSERT_TEST(new TST_VContour());
+    ASSERT_TEST(new TST_VNfpPosition());
+    ASSERT_TEST(new TST_VLayoutPieceCache());
+    ASSERT_TEST(new TST_VLayoutPieceSnapshot());
+    ASSERT_TEST(new TST_VPngWriter());
+    ASSERT_TEST(new TST_VEarClipping());
+    ASSERT_TEST(new TST_VCalculatorCache());
 
     return status;
 }
@@ -29,10 +29,12 @@
 #include "tst_vabstractpiece.h"
 #include "../vlayout/vabstractpiece.h"
 
+#include <QLineF>
 #include <QPointF>
 #include <QVector>
 
 #include <QtTest>
+#include <algorithm>
 
 //---------------------------------------------------------------------------------------------------------------------
 TST_VAbstractPiece::TST_VAbstractPiece(QObject *parent)
@@ -803,6 +805,138 @@ void TST_VAbstractPiece::PathLoopsCase() const
     Comparison(res, expect);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VAbstractPiece::DensePathWithoutLoops() const
+{
+    const QVector<QPointF> path = DensePath();
+    const QVector<QPointF> res = VAbstractPiece::CheckLoops(path);
+    Comparison(res, path);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VAbstractPiece::PathLoopsAcrossCells_data() const
+{
+    QTest::addColumn<QVector<QPointF>>("path");
+    QTest::addColumn<QVector<QPointF>>("expect");
+
+    // Dense line from short segments that occupy one cell each
+    QVector<QPointF> line;
+    for (int k = 0; k <= 100; ++k)
+    {
+        line << QPointF(k * 10, 0);
+    }
+
+    {
+        // One long segment crosses the line between points 79 and 80
+        QVector<QPointF> path = line;
+        path << QPointF(1000, 41) << QPointF(0, -159) << QPointF(0, -300);
+
+        QVector<QPointF> expect = line.mid(0, 80);
+        expect << QPointF(795, 0) << QPointF(0, -159) << QPointF(0, -300);
+
+        QTest::newRow("Long segment crosses short ones") << path << expect;
+    }
+
+    {
+        // Two long segments cross the line. The loop that starts first hides the second one.
+        QVector<QPointF> path = line;
+        path << QPointF(1000, 41) << QPointF(5, -100) << QPointF(605, 100) << QPointF(605, 300);
+
+        QVector<QPointF> expect = line.mid(0, 31);
+        expect << QPointF(305, 0) << QPointF(605, 100) << QPointF(605, 300);
+
+        QTest::newRow("Nested loops of long segments") << path << expect;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VAbstractPiece::PathLoopsAcrossCells() const
+{
+    QFETCH(QVector<QPointF>, path);
+    QFETCH(QVector<QPointF>, expect);
+
+    const QVector<QPointF> res = VAbstractPiece::CheckLoops(path);
+    Comparison(res, expect);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VAbstractPiece::DenseAllowanceValid_data() const
+{
+    QTest::addColumn<qreal>("scale");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("Allowance around the base") << 1.1 << true;
+    QTest::newRow("Allowance inside the base") << 0.9 << false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VAbstractPiece::DenseAllowanceValid() const
+{
+    QFETCH(qreal, scale);
+    QFETCH(bool, valid);
+
+    QCOMPARE(VAbstractPiece::IsAllowanceValid(ScaledDensePath(1), ScaledDensePath(scale)), valid);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VAbstractPiece::AllowanceAcrossCells_data() const
+{
+    QTest::addColumn<QVector<QPointF>>("base");
+    QTest::addColumn<QVector<QPointF>>("allowance");
+    QTest::addColumn<bool>("valid");
+
+    // Base from four long edges, each of them covers many cells of the allowance grid
+    QVector<QPointF> base;
+    base << QPointF(0, 0) << QPointF(1000, 0) << QPointF(1000, 1000) << QPointF(0, 1000);
+
+    // Dense allowance around the base
+    auto Allowance = [](bool notch)
+    {
+        QVector<QPointF> allowance;
+        for (int k = 0; k < 120; ++k)
+        {
+            allowance << QPointF(-100 + k * 10, -100);
+        }
+
+        for (int k = 0; k < 120; ++k)
+        {
+            allowance << QPointF(1100, -100 + k * 10);
+        }
+
+        for (int k = 0; k < 120; ++k)
+        {
+            if (notch && k == 59)
+            {
+                // Narrow notch crosses the top edge of the base between its corners
+                allowance << QPointF(510, 1100) << QPointF(510, 900) << QPointF(500, 900);
+            }
+            else
+            {
+                allowance << QPointF(1100 - k * 10, 1100);
+            }
+        }
+
+        for (int k = 0; k < 120; ++k)
+        {
+            allowance << QPointF(-100, 1100 - k * 10);
+        }
+        return Clockwise(allowance);
+    };
+
+    QTest::newRow("Dense allowance around long edges") << Clockwise(base) << Allowance(false) << true;
+    QTest::newRow("Notch crosses a long edge") << Clockwise(base) << Allowance(true) << false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VAbstractPiece::AllowanceAcrossCells() const
+{
+    QFETCH(QVector<QPointF>, base);
+    QFETCH(QVector<QPointF>, allowance);
+    QFETCH(bool, valid);
+
+    QCOMPARE(VAbstractPiece::IsAllowanceValid(base, allowance), valid);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void TST_VAbstractPiece::BrokenDetailEquidistant_data()
 {
@@ -1246,6 +1380,49 @@ void TST_VAbstractPiece::PossibleInfiniteClearLoops() const
 }
 #endif //#ifndef Q_OS_WIN
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief DensePath return a star with thousands of rays. Looks like seam allowance of a piece with long curves.
+ */
+QVector<QPointF> TST_VAbstractPiece::DensePath()
+{
+    const int count = 4000;
+    QVector<QPointF> path;
+    path.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        QLineF ray(0, 0, i % 2 ? 950 : 1000, 0);
+        ray.setAngle(360.0 * i / count);
+        path.append(ray.p2());
+    }
+    return path;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> TST_VAbstractPiece::ScaledDensePath(qreal scale)
+{
+    QVector<QPointF> path = DensePath();
+    for (auto &point : path)
+    {
+        point *= scale;
+    }
+
+    return Clockwise(path);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Clockwise return the path in the direction seam allowance check expects.
+ */
+QVector<QPointF> TST_VAbstractPiece::Clockwise(QVector<QPointF> path)
+{
+    if (VAbstractPiece::SumTrapezoids(path) > 0)
+    {
+        std::reverse(path.begin(), path.end());
+    }
+    return path;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void TST_VAbstractPiece::Case3() const
 {
@@ -47,6 +47,13 @@ private slots:
     void PathRemoveLoop() const;
     void PathLoopsCase_data() const;
     void PathLoopsCase() const;
+    void DensePathWithoutLoops() const;
+    void PathLoopsAcrossCells_data() const;
+    void PathLoopsAcrossCells() const;
+    void DenseAllowanceValid_data() const;
+    void DenseAllowanceValid() const;
+    void AllowanceAcrossCells_data() const;
+    void AllowanceAcrossCells() const;
     void BrokenDetailEquidistant_data();
     void BrokenDetailEquidistant() const;
     void EquidistantAngleType_data();
@@ -78,6 +85,10 @@ private:
     QVector<QPointF> InputPointsCase4a() const;
     QVector<QPointF> InputPointsCase5a() const;
 
+    static QVector<QPointF> DensePath();
+    static QVector<QPointF> ScaledDensePath(qreal scale);
+    static QVector<QPointF> Clockwise(QVector<QPointF> path);
+
     QVector<VSAPoint> InputLoopByIntersectionTest();
     QVector<QPointF>  OutputLoopByIntersectionTest();
 };
@@ -0,0 +1,205 @@
+/************************************************************************
+ **
+ **  @file   tst_vcalculatorcache.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "tst_vcalculatorcache.h"
+#include "../vpatterndb/calculator.h"
+#include "../vpatterndb/vcalculatorcache.h"
+#include "../vpatterndb/vcontainer.h"
+#include "../vpatterndb/variables/vincrement.h"
+#include "../qmuparser/qmuparsererror.h"
+
+#include <QtTest>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+void AddIncrement(VContainer &data, const QString &name, qreal value)
+{
+    auto *increment = new VIncrement(&data, name);
+    increment->SetFormula(value, QString::number(value), true);
+    data.AddVariable(increment);
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VCalculatorCache::TST_VCalculatorCache(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VCalculatorCache::init()
+{
+    VCalculatorCache::Instance()->Clear();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VCalculatorCache::RebindVariables() const
+{
+    const Unit unit = Unit::Cm;
+    const QString formula = QStringLiteral("#a*#b+width/2");
+
+    VContainer data1(nullptr, &unit, VContainer::UniqueNamespace());
+    AddIncrement(data1, QStringLiteral("#a"), 2);
+    AddIncrement(data1, QStringLiteral("#b"), 3);
+    AddIncrement(data1, QStringLiteral("width"), 10);
+
+    VContainer data2(nullptr, &unit, VContainer::UniqueNamespace());
+    AddIncrement(data2, QStringLiteral("#a"), 5);
+    AddIncrement(data2, QStringLiteral("width"), 1);
+
+    VCalculatorCache *cache = VCalculatorCache::Instance();
+
+    QCOMPARE(cache->EvalFormula(data1.DataVariables(), formula), 11.0);
+    QCOMPARE(cache->Count(), 1);
+    QCOMPARE(cache->Misses(), qint64(1));
+    QCOMPARE(cache->Hits(), qint64(0));
+
+    // Missed increment gets 0 the same way as with a new calculator.
+    Calculator cal;
+    const qreal expected = cal.EvalFormula(data2.DataVariables(), formula);
+    QCOMPARE(cache->EvalFormula(data2.DataVariables(), formula), expected);
+    QCOMPARE(cache->EvalFormula(data1.DataVariables(), formula), 11.0);
+
+    QCOMPARE(cache->Count(), 1);
+    QCOMPARE(cache->Misses(), qint64(1));
+    QCOMPARE(cache->Hits(), qint64(2));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VCalculatorCache::SingleValue() const
+{
+    const Unit unit = Unit::Cm;
+    VContainer data(nullptr, &unit, VContainer::UniqueNamespace());
+
+    VCalculatorCache *cache = VCalculatorCache::Instance();
+    QCOMPARE(cache->EvalFormula(data.DataVariables(), QStringLiteral("12.5")), 12.5);
+    QCOMPARE(cache->Count(), 0);
+    QCOMPARE(cache->Misses(), qint64(0));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VCalculatorCache::UnknownVariable() const
+{
+    const Unit unit = Unit::Cm;
+    const QString formula = QStringLiteral("width*2");
+
+    VContainer data1(nullptr, &unit, VContainer::UniqueNamespace());
+    AddIncrement(data1, QStringLiteral("width"), 3);
+
+    VContainer data2(nullptr, &unit, VContainer::UniqueNamespace());
+
+    VCalculatorCache *cache = VCalculatorCache::Instance();
+
+    // Broken formula is not cached.
+    QVERIFY_EXCEPTION_THROWN(cache->EvalFormula(data2.DataVariables(), formula), qmu::QmuParserError);
+    QCOMPARE(cache->Count(), 0);
+
+    QCOMPARE(cache->EvalFormula(data1.DataVariables(), formula), 6.0);
+    QCOMPARE(cache->Count(), 1);
+
+    // Compiled formula cannot be used without its variable.
+    QVERIFY_EXCEPTION_THROWN(cache->EvalFormula(data2.DataVariables(), formula), qmu::QmuParserError);
+    QCOMPARE(cache->EvalFormula(data1.DataVariables(), formula), 6.0);
+    QCOMPARE(cache->Hits(), qint64(1));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VCalculatorCache::ContainerVariables() const
+{
+    const Unit unit = Unit::Cm;
+    const QString formula = QStringLiteral("#a+#c*2");
+
+    VContainer data(nullptr, &unit, VContainer::UniqueNamespace());
+    AddIncrement(data, QStringLiteral("#a"), 1);
+
+    VCalculatorCache *cache = VCalculatorCache::Instance();
+    QCOMPARE(cache->EvalFormula(&data, formula), 1.0);
+
+    // Value changed in place, revision is the same.
+    quint64 revision = data.VariablesRevision();
+    data.GetVariable<VIncrement>(QStringLiteral("#a"))->SetFormula(5, QStringLiteral("5"), true);
+    QCOMPARE(data.VariablesRevision(), revision);
+    QCOMPARE(cache->EvalFormula(&data, formula), 5.0);
+
+    // New variable must be found.
+    AddIncrement(data, QStringLiteral("#c"), 3);
+    QVERIFY(data.VariablesRevision() != revision);
+    QCOMPARE(cache->EvalFormula(&data, formula), 11.0);
+
+    revision = data.VariablesRevision();
+    data.RemoveVariable(QStringLiteral("#c"));
+    QVERIFY(data.VariablesRevision() != revision);
+    QCOMPARE(cache->EvalFormula(&data, formula), 5.0);
+
+    // Copy has own set of variables.
+    VContainer copy(data);
+    AddIncrement(copy, QStringLiteral("#c"), 1);
+    QCOMPARE(cache->EvalFormula(&copy, formula), 7.0);
+    QCOMPARE(cache->EvalFormula(&data, formula), 5.0);
+
+    QCOMPARE(cache->Count(), 1);
+    QCOMPARE(cache->Hits(), qint64(5));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VCalculatorCache::CompiledExpressions_data() const
+{
+    QTest::addColumn<QString>("formula");
+
+    // Cover optimized variable tokens, functions and branches. They all read variables from relocated slots.
+    QTest::newRow("Sum") << QStringLiteral("#a+#b");
+    QTest::newRow("Multiplication") << QStringLiteral("#a*2+#b*3-1");
+    QTest::newRow("Power") << QStringLiteral("#a^2+#b^3+#a^4");
+    QTest::newRow("Functions") << QStringLiteral("sqrt(#a)+max(#a;#b;width)");
+    QTest::newRow("Condition") << QStringLiteral("#a>#b?#a*width:#b/2");
+    QTest::newRow("Same variable") << QStringLiteral("#a*#a-#a/width");
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VCalculatorCache::CompiledExpressions() const
+{
+    QFETCH(QString, formula);
+
+    const Unit unit = Unit::Cm;
+    VCalculatorCache *cache = VCalculatorCache::Instance();
+
+    const QVector<QVector<qreal>> sets{{2, 3, 10}, {7, 1, 4}, {0.5, 0.25, 100}};
+    for (auto &set : sets)
+    {
+        VContainer data(nullptr, &unit, VContainer::UniqueNamespace());
+        AddIncrement(data, QStringLiteral("#a"), set.at(0));
+        AddIncrement(data, QStringLiteral("#b"), set.at(1));
+        AddIncrement(data, QStringLiteral("width"), set.at(2));
+
+        Calculator cal;
+        QCOMPARE(cache->EvalFormula(&data, formula), cal.EvalFormula(data.DataVariables(), formula));
+    }
+
+    QCOMPARE(cache->Count(), 1);
+    QCOMPARE(cache->Misses(), qint64(1));
+    QCOMPARE(cache->Hits(), qint64(sets.size() - 1));
+}
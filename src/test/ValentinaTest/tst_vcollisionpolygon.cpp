@@ -0,0 +1,138 @@
+/************************************************************************
+ **
+ **  @file   tst_vcollisionpolygon.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vcollisionpolygon.h"
+#include "../vlayout/vcollisionpolygon.h"
+#include "../vlayout/vflatpolygon.h"
+#include "../vlayout/vlayoutpiece.h"
+
+#include <QtTest>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> Translate(const QVector<QPointF> &points, qreal dx, qreal dy)
+{
+    QVector<QPointF> translated;
+    translated.reserve(points.size());
+    for (auto &point : points)
+    {
+        translated.append(point + QPointF(dx, dy));
+    }
+    return translated;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> Scale(const QVector<QPointF> &points, qreal factor)
+{
+    const QPointF center = VLayoutPiece::BoundingRect(points).center();
+    QVector<QPointF> scaled;
+    scaled.reserve(points.size());
+    for (auto &point : points)
+    {
+        scaled.append(center + (point - center) * factor);
+    }
+    return scaled;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VCollisionPolygon::TST_VCollisionPolygon(QObject *parent)
+    : AbstractTest(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VCollisionPolygon::CompareWithPainterPath_data()
+{
+    QTest::addColumn<QVector<QPointF>>("subject");
+    QTest::addColumn<QVector<QPointF>>("clip");
+
+    const QStringList corpus
+    {
+        QStringLiteral("DP_6"),
+        QStringLiteral("Issue_548"),
+        QStringLiteral("Issue_923_test1"),
+        QStringLiteral("Issue_937_case_1"),
+        QStringLiteral("doll"),
+        QStringLiteral("seamtest1_by_angle"),
+        QStringLiteral("seamtest2"),
+        QStringLiteral("seamtest3"),
+    };
+
+    for (auto &name : corpus)
+    {
+        QVector<QPointF> subject;
+        VectorFromJson(QStringLiteral("://%1/output.json").arg(name), subject);
+
+        const QRectF rect = VLayoutPiece::BoundingRect(subject);
+
+        auto AddRow = [name, subject](const QString &tag, const QVector<QPointF> &clip)
+        {
+            QTest::newRow(qUtf8Printable(QStringLiteral("%1. %2.").arg(name, tag))) << subject << clip;
+        };
+
+        AddRow(QStringLiteral("Same"), subject);
+        AddRow(QStringLiteral("Inside"), Scale(subject, 0.3));
+        AddRow(QStringLiteral("Around"), Scale(subject, 3));
+
+        const QVector<qreal> shifts{0.1, 0.25, 0.5, 0.75, 0.99, 1.0, 1.01, 2.0};
+        for (auto shift : shifts)
+        {
+            AddRow(QStringLiteral("Shift x %1").arg(shift), Translate(subject, rect.width() * shift, 0));
+            AddRow(QStringLiteral("Shift y %1").arg(shift), Translate(subject, 0, rect.height() * shift));
+            AddRow(QStringLiteral("Shift xy %1").arg(shift),
+                   Translate(subject, rect.width() * shift, rect.height() * shift));
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VCollisionPolygon::CompareWithPainterPath() const
+{
+    QFETCH(QVector<QPointF>, subject);
+    QFETCH(QVector<QPointF>, clip);
+
+    const VCollisionPolygon polygon(subject);
+    const QRectF clipRect = VLayoutPiece::BoundingRect(clip);
+
+    const QPainterPath subjectPath = VLayoutPiece::PainterPath(subject);
+    const QPainterPath clipPath = VLayoutPiece::PainterPath(clip);
+
+    QCOMPARE(polygon.Intersects(clip, clipRect), subjectPath.intersects(clipPath));
+    QCOMPARE(polygon.Contains(clip, clipRect), subjectPath.contains(clipPath));
+
+    const VFlatPolygon flatClip(clip);
+    QCOMPARE(flatClip.BoundingRect(), clipRect);
+    QCOMPARE(polygon.Intersects(flatClip), subjectPath.intersects(clipPath));
+    QCOMPARE(polygon.Contains(flatClip), subjectPath.contains(clipPath));
+
+    for (auto &point : clip)
+    {
+        QCOMPARE(polygon.ContainsPoint(point), subjectPath.contains(point));
+    }
+}
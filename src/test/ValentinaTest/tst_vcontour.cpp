@@ -0,0 +1,163 @@
+/************************************************************************
+ **
+ **  @file   tst_vcontour.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "tst_vcontour.h"
+#include "../vlayout/vcontour.h"
+#include "../vlayout/vlayoutpiece.h"
+#include "../vgeometry/vgeometrydef.h"
+
+#include <QtTest>
+
+namespace
+{
+const int sheetWidth = 2000;
+const int sheetHeight = 3000;
+const qreal layoutWidth = 10;
+const qreal shift = 37.8;
+
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutPiece Piece(const QPointF &topLeft, qreal width, qreal height)
+{
+    const qreal c = qMin(width, height) / 4.;
+    QVector<QPointF> points;
+    points += topLeft + QPointF(c, 0);
+    points += topLeft + QPointF(width - c, 0);
+    points += topLeft + QPointF(width, c);
+    points += topLeft + QPointF(width, height - c);
+    points += topLeft + QPointF(width - c, height);
+    points += topLeft + QPointF(c, height);
+    points += topLeft + QPointF(0, height - c);
+    points += topLeft + QPointF(0, c);
+
+    VLayoutPiece piece;
+    piece.SetCountourPoints(points);
+    piece.SetLayoutWidth(layoutWidth);
+    piece.SetLayoutAllowancePoints();
+    return piece;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VContour Sheet()
+{
+    VContour contour(sheetHeight, sheetWidth, layoutWidth);
+    contour.SetShift(shift);
+    return contour;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QLineF EdgeFromContour(const QVector<QPointF> &points, int i)
+{
+    return i < points.size() ? QLineF(points.at(i-1), points.at(i)) : QLineF(points.last(), points.first());
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VContour::TST_VContour(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContour::GlobalEdges() const
+{
+    VContour contour = Sheet();
+    QVERIFY(contour.GlobalEdgesCount() > 0);
+
+    const QVector<QPointF> cut = contour.CutEmptySheetEdge();
+    for (int i = 1; i <= contour.GlobalEdgesCount(); ++i)
+    {
+        const QLineF edge = contour.GlobalEdge(i);
+        QVERIFY(VFuzzyComparePoints(edge.p1(), cut.at(i-1)));
+        QVERIFY(VFuzzyComparePoints(edge.p2(), cut.at(i)));
+    }
+
+    contour.SetContour(contour.UniteWithContour(Piece(QPointF(100, 0), 300, 500), 0, 0, BestFrom::Combine));
+    const QVector<QPointF> points = contour.GetContour();
+    QCOMPARE(contour.GlobalEdgesCount(), points.size());
+
+    for (int i = 1; i <= contour.GlobalEdgesCount(); ++i)
+    {
+        QCOMPARE(contour.GlobalEdge(i), EdgeFromContour(points, i));
+    }
+
+    QCOMPARE(contour.GlobalEdge(0), QLineF());
+    QCOMPARE(contour.GlobalEdge(contour.GlobalEdgesCount() + 1), QLineF());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContour::UnitedBoundingRect_data() const
+{
+    QTest::addColumn<bool>("blankSheet");
+    QTest::addColumn<bool>("saveLength");
+
+    QTest::newRow("Blank sheet") << true << false;
+    QTest::newRow("Blank sheet, save length") << true << true;
+    QTest::newRow("Sheet with pieces") << false << false;
+    QTest::newRow("Sheet with pieces, save length") << false << true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContour::UnitedBoundingRect() const
+{
+    QFETCH(bool, blankSheet);
+    QFETCH(bool, saveLength);
+
+    VContour contour = Sheet();
+    if (not blankSheet)
+    {
+        contour.SetContour(contour.UniteWithContour(Piece(QPointF(100, 0), 300, 500), 0, 0, BestFrom::Combine));
+        contour.SetContour(contour.UniteWithContour(Piece(QPointF(450, 0), 200, 700), 1, 1, BestFrom::Rotation));
+    }
+
+    // Scoring contour is prepared the same way VPosition does
+    if (saveLength)
+    {
+        contour.CeateEmptySheetContour();
+    }
+
+    const VLayoutPiece piece = Piece(QPointF(900, 40), 250, 350);
+    const QVector<BestFrom> types{BestFrom::Combine, BestFrom::Rotation};
+
+    for (int globalI = 1; globalI <= contour.GlobalEdgesCount(); ++globalI)
+    {
+        for (int detJ = 1; detJ <= piece.LayoutEdgesCount(); ++detJ)
+        {
+            for (auto type : types)
+            {
+                QVector<QPointF> united = contour.UniteWithContour(piece, globalI, detJ, type);
+                QVERIFY(not united.isEmpty());
+                united.append(united.first());
+
+                const QSizeF expected = QPolygonF(united).boundingRect().size();
+                const QSizeF size = contour.UnitedBoundingRect(piece, globalI, detJ, type).size();
+
+                QVERIFY2(qAbs(size.width() - expected.width()) < accuracyPointOnLine
+                         && qAbs(size.height() - expected.height()) < accuracyPointOnLine,
+                         qUtf8Printable(QStringLiteral("Edge %1, piece edge %2.").arg(globalI).arg(detJ)));
+            }
+        }
+    }
+}
@@ -0,0 +1,167 @@
+/************************************************************************
+ **
+ **  @file   tst_vearclipping.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "tst_vearclipping.h"
+#include "../vobj/vearclipping.h"
+
+#include <QtTest>
+#include <algorithm>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+qreal Area(const QVector<QPointF> &points)
+{
+    qreal area = 0;
+    for (int i = 0, j = points.size() - 1; i < points.size(); j = i++)
+    {
+        area += points.at(j).x() * points.at(i).y() - points.at(i).x() * points.at(j).y();
+    }
+    return area / 2;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Split each edge into equal parts to get a piece with many points
+QVector<QPointF> Detailed(const QVector<QPointF> &points, int parts)
+{
+    QVector<QPointF> detailed;
+    detailed.reserve(points.size() * parts);
+    for (int i = 0; i < points.size(); ++i)
+    {
+        const QPointF &p1 = points.at(i);
+        const QPointF &p2 = points.at((i + 1) % points.size());
+        for (int j = 0; j < parts; ++j)
+        {
+            detailed.append(p1 + (p2 - p1) * j / parts);
+        }
+    }
+    return detailed;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> Square(qreal left, qreal top, qreal side)
+{
+    return QVector<QPointF>{QPointF(left, top), QPointF(left + side, top), QPointF(left + side, top + side),
+                            QPointF(left, top + side)};
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> Reversed(QVector<QPointF> points)
+{
+    std::reverse(points.begin(), points.end());
+    return points;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VEarClipping::TST_VEarClipping(QObject *parent)
+    : AbstractTest(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VEarClipping::Triangulate_data()
+{
+    QTest::addColumn<QVector<QPointF>>("points");
+    QTest::addColumn<QVector<int>>("holes");
+    QTest::addColumn<qreal>("area");
+
+    const QStringList corpus = Corpus();
+    for (auto &name : corpus)
+    {
+        QVector<QPointF> contour;
+        VectorFromJson(QStringLiteral("://%1/output.json").arg(name), contour);
+
+        const qreal area = qAbs(Area(contour));
+
+        QTest::newRow(qUtf8Printable(name)) << contour << QVector<int>() << area;
+        QTest::newRow(qUtf8Printable(name + QStringLiteral(". Reversed."))) << Reversed(contour) << QVector<int>()
+                                                                             << area;
+        QTest::newRow(qUtf8Printable(name + QStringLiteral(". Detailed."))) << Detailed(contour, 50)
+                                                                             << QVector<int>() << area;
+    }
+
+    const QVector<QPointF> outer = Square(0, 0, 100);
+
+    QTest::newRow("Holes") << outer + Square(20, 20, 20) + Reversed(Square(60, 20, 20)) + Square(20, 60, 20)
+                           << QVector<int>{4, 8, 12} << 8800.0;
+
+    QTest::newRow("Hole and collinear points") << Detailed(outer, 2) + Square(20, 20, 20) << QVector<int>{8}
+                                               << 9600.0;
+
+    QTest::newRow("Closed contours") << outer + outer.first() + Square(20, 20, 20) + QPointF(20, 20)
+                                     << QVector<int>{5} << 9600.0;
+
+    QTest::newRow("Detailed holes") << Detailed(outer, 50) + Detailed(Square(20, 20, 20), 50)
+                                       + Reversed(Detailed(Square(60, 60, 20), 50))
+                                    << QVector<int>{200, 400} << 9200.0;
+
+    QTest::newRow("Hole touches the outer contour") << outer + Square(0, 40, 20) << QVector<int>{4} << 9600.0;
+
+    QTest::newRow("Line") << QVector<QPointF>{QPointF(0, 0), QPointF(50, 0), QPointF(100, 0)} << QVector<int>()
+                          << 0.0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VEarClipping::Triangulate() const
+{
+    QFETCH(QVector<QPointF>, points);
+    QFETCH(QVector<int>, holes);
+    QFETCH(qreal, area);
+
+    const QVector<int> triangles = EarClipping(points, holes);
+
+    QCOMPARE(triangles.size() % 3, 0);
+    QVERIFY(triangles.size() / 3 <= qMax(0, points.size() - 2 + holes.size() * 2));
+
+    qreal sum = 0;
+    for (int i = 0; i < triangles.size(); i += 3)
+    {
+        const qreal triangleArea = Area({points.at(triangles.at(i)),
+                                         points.at(triangles.at(i + 1)),
+                                         points.at(triangles.at(i + 2))});
+        QVERIFY2(triangleArea > 0, "All triangles must be counterclockwise.");
+        sum += triangleArea;
+    }
+
+    QVERIFY2(qAbs(sum - area) <= area * 1e-9, qUtf8Printable(QStringLiteral("Area of triangles %1, expected %2.")
+                                                               .arg(sum).arg(area)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QStringList TST_VEarClipping::Corpus() const
+{
+    return QStringList
+    {
+        QStringLiteral("DP_6"),
+        QStringLiteral("Issue_923_test1"),
+        QStringLiteral("Issue_937_case_1"),
+        QStringLiteral("doll"),
+        QStringLiteral("seamtest1_by_angle"),
+        QStringLiteral("seamtest2"),
+        QStringLiteral("seamtest3"),
+    };
+}
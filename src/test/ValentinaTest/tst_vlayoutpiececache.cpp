@@ -0,0 +1,213 @@
+/************************************************************************
+ **
+ **  @file   tst_vlayoutpiececache.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "tst_vlayoutpiececache.h"
+#include "../vlayout/vlayoutpiece.h"
+#include "../vlayout/vlayoutpiececache.h"
+
+#include <QPolygonF>
+#include <QtTest>
+#include <algorithm>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutPiece Piece()
+{
+    QVector<QPointF> points;
+    points += QPointF(30, 0);
+    points += QPointF(270, 0);
+    points += QPointF(300, 30);
+    points += QPointF(300, 170);
+    points += QPointF(150, 260);
+    points += QPointF(0, 170);
+    points += QPointF(0, 30);
+
+    VLayoutPiece piece;
+    piece.SetCountourPoints(points);
+    piece.SetLayoutWidth(10);
+    piece.SetLayoutAllowancePoints();
+    return piece;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> Map(const QVector<QPointF> &points, const QTransform &matrix, bool mirror)
+{
+    QVector<QPointF> mapped;
+    for (auto &point : points)
+    {
+        mapped.append(matrix.map(point));
+    }
+
+    if (mirror)
+    {
+        std::reverse(mapped.begin(), mapped.end());
+    }
+    return mapped;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VLayoutPieceCache::TST_VLayoutPieceCache(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutPieceCache::MappedPaths_data() const
+{
+    QTest::addColumn<qreal>("angle");
+    QTest::addColumn<bool>("mirror");
+    QTest::addColumn<QPointF>("offset");
+
+    QTest::newRow("Identity") << 0. << false << QPointF();
+    QTest::newRow("Translation") << 0. << false << QPointF(120.5, -33.25);
+    QTest::newRow("Rotation") << 37.5 << false << QPointF(500, 400);
+    QTest::newRow("Mirror") << 90. << true << QPointF(-10, 250);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutPieceCache::MappedPaths() const
+{
+    QFETCH(qreal, angle);
+    QFETCH(bool, mirror);
+    QFETCH(QPointF, offset);
+
+    VLayoutPiece piece = Piece();
+    const QVector<QPointF> contour = piece.GetContourPoints();
+    const QVector<QPointF> layoutAllowance = piece.GetLayoutAllowancePoints();
+
+    if (mirror)
+    {
+        piece.Mirror(QLineF(10, 10, 10, 100));
+    }
+    piece.Rotate(QPointF(150, 100), angle);
+    piece.Translate(offset.x(), offset.y());
+
+    const QTransform matrix = piece.GetMatrix();
+    const QVector<QPointF> expectedLayout = Map(layoutAllowance, matrix, piece.IsMirror());
+    const QVector<QPointF> expectedContour = Map(contour, matrix, piece.IsMirror());
+
+    QCOMPARE(piece.GetLayoutAllowancePoints(), expectedLayout);
+    QCOMPARE(piece.GetMappedContourPoints(), expectedContour);
+    QCOMPARE(piece.LayoutBoundingRect(), QPolygonF(expectedLayout).boundingRect());
+    QCOMPARE(piece.DetailBoundingRect(), QPolygonF(expectedContour).boundingRect());
+
+    for (int i = 1; i <= expectedLayout.size(); ++i)
+    {
+        const QLineF edge(expectedLayout.at(i-1), expectedLayout.at(i < expectedLayout.size() ? i : 0));
+        QCOMPARE(piece.LayoutEdge(i), edge);
+        QCOMPARE(piece.LayoutEdgeByPoint(edge.p1()), i);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutPieceCache::ReuseOrientation() const
+{
+    const VLayoutPiece piece = Piece();
+    const QVector<QPointF> contour = piece.GetContourPoints();
+    const QVector<QPointF> layoutAllowance = piece.GetLayoutAllowancePoints();
+
+    VLayoutPieceCache cache;
+
+    QTransform matrix;
+    matrix.rotate(30);
+    const VMappedGeometry first = cache.Geometry(matrix, false, contour, QVector<QPointF>(), layoutAllowance);
+    QCOMPARE(cache.Count(), 1);
+    QCOMPARE(cache.Misses(), qint64(1));
+
+    // Only translation differs
+    QTransform moved = matrix * QTransform::fromTranslate(100, 200);
+    const VMappedGeometry second = cache.Geometry(moved, false, contour, QVector<QPointF>(), layoutAllowance);
+    QCOMPARE(cache.Count(), 1);
+    QCOMPARE(cache.Hits(), qint64(1));
+    QCOMPARE(second.offset, QPointF(100, 200));
+    QCOMPARE(second.layoutAllowance.Translated(second.offset), Map(layoutAllowance, moved, false));
+    QCOMPARE(first.layoutAllowance.points, second.layoutAllowance.points);
+
+    // Mirror flag changes order of points
+    cache.Geometry(matrix, true, contour, QVector<QPointF>(), layoutAllowance);
+    QCOMPARE(cache.Count(), 2);
+
+    matrix.rotate(15);
+    cache.Geometry(matrix, false, contour, QVector<QPointF>(), layoutAllowance);
+    QCOMPARE(cache.Count(), 3);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutPieceCache::EvictLeastRecentlyUsed() const
+{
+    // Six orientations of such contour almost fill the cache
+    const QVector<QPointF> contour(10000, QPointF(10, 20));
+
+    VLayoutPieceCache cache;
+
+    auto Orientation = [](int i)
+    {
+        QTransform matrix;
+        matrix.rotate(i * 10);
+        return matrix;
+    };
+
+    for (int i = 0; i < 6; ++i)
+    {
+        cache.Geometry(Orientation(i), false, contour, QVector<QPointF>(), QVector<QPointF>());
+    }
+    QCOMPARE(cache.Count(), 6);
+
+    // The first orientation becomes the most recently used
+    cache.Geometry(Orientation(0), false, contour, QVector<QPointF>(), QVector<QPointF>());
+    QCOMPARE(cache.Hits(), qint64(1));
+
+    // Does not fit, the oldest orientations are dropped, not all of them
+    cache.Geometry(Orientation(6), false, contour, QVector<QPointF>(), QVector<QPointF>());
+    QCOMPARE(cache.Count(), 4);
+
+    cache.Geometry(Orientation(0), false, contour, QVector<QPointF>(), QVector<QPointF>());
+    QCOMPARE(cache.Hits(), qint64(2));
+
+    cache.Geometry(Orientation(5), false, contour, QVector<QPointF>(), QVector<QPointF>());
+    QCOMPARE(cache.Hits(), qint64(3));
+
+    cache.Geometry(Orientation(1), false, contour, QVector<QPointF>(), QVector<QPointF>());
+    QCOMPARE(cache.Hits(), qint64(3));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutPieceCache::DetachOnChange() const
+{
+    VLayoutPiece piece = Piece();
+    piece.Rotate(QPointF(), 90);
+    const QVector<QPointF> contour = piece.GetMappedContourPoints();
+
+    VLayoutPiece copy = piece;
+    QVector<QPointF> points = copy.GetContourPoints();
+    points.removeLast();
+    copy.SetCountourPoints(points);
+
+    QCOMPARE(copy.GetMappedContourPoints(), Map(points, copy.GetMatrix(), copy.IsMirror()));
+    QCOMPARE(piece.GetMappedContourPoints(), contour);
+}
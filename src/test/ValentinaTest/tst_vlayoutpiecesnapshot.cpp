@@ -0,0 +1,133 @@
+/************************************************************************
+ **
+ **  @file   tst_vlayoutpiecesnapshot.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "tst_vlayoutpiecesnapshot.h"
+#include "../vlayout/vflatpolygon.h"
+#include "../vlayout/vlayoutpiece.h"
+#include "../vlayout/vlayoutpiecesnapshot.h"
+
+#include <QPolygonF>
+#include <QtTest>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutPiece Piece()
+{
+    QVector<QPointF> points;
+    points += QPointF(30, 0);
+    points += QPointF(270, 0);
+    points += QPointF(300, 30);
+    points += QPointF(300, 170);
+    points += QPointF(150, 260);
+    points += QPointF(0, 170);
+    points += QPointF(0, 30);
+
+    VLayoutPiece piece;
+    piece.SetCountourPoints(points);
+    piece.SetLayoutWidth(10);
+    piece.SetLayoutAllowancePoints();
+    return piece;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VLayoutPieceSnapshot::TST_VLayoutPieceSnapshot(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutPieceSnapshot::MapLikePiece_data() const
+{
+    QTest::addColumn<qreal>("angle");
+    QTest::addColumn<bool>("mirror");
+    QTest::addColumn<QPointF>("offset");
+
+    QTest::newRow("Identity") << 0. << false << QPointF();
+    QTest::newRow("Translation") << 0. << false << QPointF(120.5, -33.25);
+    QTest::newRow("Rotation") << 37.5 << false << QPointF(500, 400);
+    QTest::newRow("Mirror") << 90. << true << QPointF(-10, 250);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutPieceSnapshot::MapLikePiece() const
+{
+    QFETCH(qreal, angle);
+    QFETCH(bool, mirror);
+    QFETCH(QPointF, offset);
+
+    VLayoutPiece piece = Piece();
+    const VLayoutPieceSnapshot snapshot(piece);
+
+    if (mirror)
+    {
+        piece.Mirror(QLineF(10, 10, 10, 100));
+    }
+    piece.Rotate(QPointF(150, 100), angle);
+    piece.Translate(offset.x(), offset.y());
+
+    VFlatPolygon layoutAllowance;
+    VFlatPolygon outline;
+    snapshot.Map(piece.GetMatrix(), piece.IsMirror(), layoutAllowance, outline);
+
+    const QVector<QPointF> expectedLayout = piece.GetLayoutAllowancePoints();
+    const QVector<QPointF> expectedOutline = piece.GetMappedContourPoints();
+
+    QCOMPARE(layoutAllowance.Points(), expectedLayout);
+    QCOMPARE(outline.Points(), expectedOutline);
+    QCOMPARE(layoutAllowance.BoundingRect(), QPolygonF(expectedLayout).boundingRect());
+    QCOMPARE(outline.BoundingRect(), QPolygonF(expectedOutline).boundingRect());
+
+    for (int i = 0; i < layoutAllowance.Count(); ++i)
+    {
+        const QPointF next = layoutAllowance.Point(i + 1 < layoutAllowance.Count() ? i + 1 : 0);
+        QCOMPARE(layoutAllowance.Edge(i), next - layoutAllowance.Point(i));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutPieceSnapshot::ReuseBuffers() const
+{
+    VLayoutPiece piece = Piece();
+    const VLayoutPieceSnapshot snapshot(piece);
+
+    VFlatPolygon layoutAllowance;
+    VFlatPolygon outline;
+    snapshot.Map(piece.GetMatrix(), piece.IsMirror(), layoutAllowance, outline);
+
+    const qreal *x = layoutAllowance.X();
+    const qreal *edgeY = layoutAllowance.EdgeY();
+
+    piece.Rotate(QPointF(150, 100), 90);
+    piece.Translate(1000, 0);
+    snapshot.Map(piece.GetMatrix(), piece.IsMirror(), layoutAllowance, outline);
+
+    // The same buffers, no new allocation
+    QCOMPARE(layoutAllowance.X(), x);
+    QCOMPARE(layoutAllowance.EdgeY(), edgeY);
+    QCOMPARE(layoutAllowance.Points(), piece.GetLayoutAllowancePoints());
+}
@@ -0,0 +1,307 @@
+/************************************************************************
+ **
+ **  @file   tst_vnfpposition.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "tst_vnfpposition.h"
+#include "../vlayout/vnfpcache.h"
+#include "../vlayout/vnfpposition.h"
+#include "../vlayout/vlayoutpiece.h"
+#include "../vgeometry/vgeometrydef.h"
+
+#include <QPainterPath>
+#include <QtTest>
+
+namespace
+{
+const int sheetWidth = 1000;
+const int sheetHeight = 3000;
+const qreal layoutWidth = 10;
+
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutPiece Piece(vidtype id, const QVector<QPointF> &points)
+{
+    VLayoutPiece piece;
+    piece.SetId(id);
+    piece.SetCountourPoints(points);
+    piece.SetLayoutWidth(layoutWidth);
+    piece.SetLayoutAllowancePoints();
+    return piece;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutPiece Piece(vidtype id, qreal width, qreal height)
+{
+    const qreal c = qMin(width, height) / 4.;
+    QVector<QPointF> points;
+    points += QPointF(c, 0);
+    points += QPointF(width - c, 0);
+    points += QPointF(width, c);
+    points += QPointF(width, height - c);
+    points += QPointF(width - c, height);
+    points += QPointF(c, height);
+    points += QPointF(0, height - c);
+    points += QPointF(0, c);
+
+    return Piece(id, points);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal Area(const QVector<QPointF> &points)
+{
+    qreal area = 0;
+    for (int i = 0, j = points.size() - 1; i < points.size(); j = i++)
+    {
+        area += points.at(j).x() * points.at(i).y() - points.at(i).x() * points.at(j).y();
+    }
+    return area / 2;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QPainterPath ContourPath(const VLayoutPiece &piece)
+{
+    QPainterPath path;
+    path.addPolygon(QPolygonF(piece.GetMappedContourPoints()));
+    path.closeSubpath();
+    return path;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VNfpPosition::TST_VNfpPosition(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VNfpPosition::ConvexHull() const
+{
+    // L shape. Inner corner and a point on the edge must be dropped.
+    const QVector<QPointF> points{QPointF(0, 0), QPointF(50, 0), QPointF(100, 0), QPointF(100, 50), QPointF(50, 50),
+                                  QPointF(50, 100), QPointF(0, 100)};
+
+    const QVector<QPointF> hull = VNfpCache::ConvexHull(points);
+    QCOMPARE(hull.size(), 5);
+    QVERIFY(not hull.contains(QPointF(50, 50)));
+    QVERIFY(not hull.contains(QPointF(50, 0)));
+
+    for (auto &point : points)
+    {
+        QVERIFY(not VNfpCache::StrictlyInside(hull, point, accuracyPointOnLine) || point == QPointF(50, 50));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VNfpPosition::MinkowskiSum() const
+{
+    const QVector<QPointF> square = VNfpCache::ConvexHull({QPointF(0, 0), QPointF(10, 0), QPointF(10, 10),
+                                                           QPointF(0, 10)});
+    const QVector<QPointF> triangle = VNfpCache::ConvexHull({QPointF(0, 0), QPointF(20, 0), QPointF(0, 20)});
+
+    const QVector<QPointF> sum = VNfpCache::MinkowskiSum(square, triangle);
+    QCOMPARE(sum.size(), 5);
+    QCOMPARE(VLayoutPiece::BoundingRect(sum), QRectF(0, 0, 30, 30));
+    QVERIFY(VNfpCache::StrictlyInside(sum, QPointF(15, 15), accuracyPointOnLine));
+    QVERIFY(not VNfpCache::StrictlyInside(sum, QPointF(25, 25), accuracyPointOnLine));
+    QVERIFY(not VNfpCache::StrictlyInside(sum, QPointF(30, 10), accuracyPointOnLine)); // Touching is allowed
+
+    QVERIFY(VNfpCache::MinkowskiSum(square, QVector<QPointF>{QPointF(), QPointF(1, 1)}).isEmpty());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VNfpPosition::ConvexParts() const
+{
+    const QVector<QPointF> square{QPointF(0, 0), QPointF(100, 0), QPointF(100, 100), QPointF(0, 100)};
+    QCOMPARE(VNfpCache::ConvexParts(square).size(), 1);
+
+    // U shape needs at least three parts
+    const QVector<QPointF> points{QPointF(0, 0), QPointF(100, 0), QPointF(100, 200), QPointF(200, 200),
+                                  QPointF(200, 0), QPointF(300, 0), QPointF(300, 300), QPointF(0, 300)};
+
+    const QVector<QVector<QPointF>> parts = VNfpCache::ConvexParts(points);
+    QCOMPARE(parts.size(), 3);
+
+    qreal area = 0;
+    for (auto &part : parts)
+    {
+        QVERIFY2(VNfpCache::ConvexHull(part).size() == part.size(), "Each part must be convex.");
+        QVERIFY(Area(part) > 0);
+        area += Area(part);
+
+        // Notch is not covered
+        QVERIFY(not VNfpCache::StrictlyInside(part, QPointF(150, 100), accuracyPointOnLine));
+    }
+    QCOMPARE(area, qAbs(Area(points)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VNfpPosition::ArrangeDetail_data() const
+{
+    QTest::addColumn<bool>("rotate");
+    QTest::addColumn<int>("expectedPolygons");
+
+    QTest::newRow("No rotation") << false << 1;
+    QTest::newRow("Rotation") << true << 4; // Maximum, pairs of two orientations
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VNfpPosition::ArrangeDetail() const
+{
+    QFETCH(bool, rotate);
+    QFETCH(int, expectedPolygons);
+
+    std::atomic_bool stop(false);
+    const VLayoutPiece piece = Piece(1, 300, 200);
+
+    VNfpPositionData data;
+    data.detail = piece;
+    data.cache = QSharedPointer<VNfpCache>(new VNfpCache());
+    data.width = sheetWidth;
+    data.height = sheetHeight;
+    data.rotate = rotate;
+    data.rotationNumber = 2;
+
+    QVector<VLayoutPiece> placed;
+    for (int i = 0; i < 8; ++i)
+    {
+        const VNfpResult result = VNfpPosition::ArrangeDetail(data, &stop);
+        QVERIFY(result.valid);
+
+        VLayoutPiece workDetail = piece;
+        workDetail.SetMatrix(result.matrix);
+        workDetail.SetMirror(result.mirror);
+
+        const QRectF rect = workDetail.DetailBoundingRect();
+        QVERIFY(QRectF(0, 0, sheetWidth, sheetHeight).adjusted(-accuracyPointOnLine, -accuracyPointOnLine,
+                                                               accuracyPointOnLine, accuracyPointOnLine)
+                .contains(rect));
+
+        if (i == 0)
+        {
+            QVERIFY(VFuzzyComparePoints(rect.topLeft(), QPointF()));
+        }
+
+        for (auto &other : placed)
+        {
+            QVERIFY2(not ContourPath(other).intersects(ContourPath(workDetail)),
+                     qUtf8Printable(QStringLiteral("Piece %1 overlaps a placed piece.").arg(i)));
+        }
+
+        placed.append(workDetail);
+        data.placements.append(result.placement);
+    }
+
+    // Three pieces fit in one row, so eight pieces take three rows
+    const QRectF last = placed.last().DetailBoundingRect();
+    QVERIFY(last.bottom() < 3 * (200 + layoutWidth * 2) + accuracyPointOnLine);
+
+    QVERIFY(data.cache->PolygonsCount() > 0);
+    QVERIFY(data.cache->PolygonsCount() <= expectedPolygons);
+    QVERIFY(data.cache->Hits() > 0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VNfpPosition::NestConcavePiece() const
+{
+    std::atomic_bool stop(false);
+
+    // Notch 100 wide and 200 deep opens to the top of the sheet
+    const VLayoutPiece uPiece = Piece(1, {QPointF(0, 0), QPointF(100, 0), QPointF(100, 200), QPointF(200, 200),
+                                          QPointF(200, 0), QPointF(300, 0), QPointF(300, 300), QPointF(0, 300)});
+    const VLayoutPiece square = Piece(2, {QPointF(0, 0), QPointF(50, 0), QPointF(50, 50), QPointF(0, 50)});
+
+    VNfpPositionData data;
+    data.detail = uPiece;
+    data.cache = QSharedPointer<VNfpCache>(new VNfpCache());
+    data.width = sheetWidth;
+    data.height = sheetHeight;
+
+    const VNfpResult first = VNfpPosition::ArrangeDetail(data, &stop);
+    QVERIFY(first.valid);
+    data.placements.append(first.placement);
+
+    data.detail = square;
+    const VNfpResult second = VNfpPosition::ArrangeDetail(data, &stop);
+    QVERIFY(second.valid);
+
+    // Convex hull of the U piece would push the square to the right of it
+    const QRectF rect = second.placement.detailRect;
+    QVERIFY2(rect.right() < first.placement.detailRect.right(), "The square must be nested inside the notch.");
+
+    VLayoutPiece placedU = uPiece;
+    placedU.SetMatrix(first.matrix);
+    VLayoutPiece placedSquare = square;
+    placedSquare.SetMatrix(second.matrix);
+    QVERIFY(not ContourPath(placedU).intersects(ContourPath(placedSquare)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VNfpPosition::EvictLeastRecentlyUsed() const
+{
+    // Big convex piece gives polygons with tens of thousands points. Several dozens of them fill the cache.
+    QVector<QPointF> points;
+    const int count = 20000;
+    for (int i = 0; i < count; ++i)
+    {
+        QLineF ray(0, 0, 10000, 0);
+        ray.setAngle(-360.0 * i / count);
+        points.append(ray.p2());
+    }
+    const VLayoutPiece piece = Piece(1, points);
+
+    VNfpCache cache;
+
+    auto Key = [&cache, piece](int i)
+    {
+        const VNfpShapeKey key = VNfpCache::ShapeKey(piece, i, false);
+        cache.Shape(piece, key);
+        return key;
+    };
+
+    const VNfpShapeKey moving = Key(0);
+    cache.NoFitPolygon(Key(1), moving);
+
+    int i = 2;
+    for (; i < 360; ++i)
+    {
+        cache.NoFitPolygon(Key(i), moving);
+        cache.NoFitPolygon(Key(1), moving); // Stays the most recently used
+
+        if (cache.PolygonsCount() < i)
+        {
+            break; // Eviction
+        }
+    }
+    QVERIFY2(i < 360, "The cache must be full.");
+
+    // Only the oldest polygons are dropped, not all of them
+    QVERIFY(cache.PolygonsCount() > i / 2);
+
+    const qint64 hits = cache.Hits();
+    cache.NoFitPolygon(Key(1), moving);
+    QCOMPARE(cache.Hits(), hits + 1);
+
+    cache.NoFitPolygon(Key(2), moving);
+    QCOMPARE(cache.Hits(), hits + 1);
+}
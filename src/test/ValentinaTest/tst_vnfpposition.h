@@ -0,0 +1,49 @@
+/************************************************************************
+ **
+ **  @file   tst_vnfpposition.h
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#ifndef TST_VNFPPOSITION_H
+#define TST_VNFPPOSITION_H
+
+#include <QObject>
+
+class TST_VNfpPosition : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TST_VNfpPosition(QObject *parent = nullptr);
+
+private slots:
+    void ConvexHull() const;
+    void MinkowskiSum() const;
+    void ConvexParts() const;
+    void ArrangeDetail_data() const;
+    void ArrangeDetail() const;
+    void NestConcavePiece() const;
+    void EvictLeastRecentlyUsed() const;
+};
+
+#endif // TST_VNFPPOSITION_H
@@ -30,6 +30,7 @@
 #include "../vpatterndb/vcontainer.h"
 #include "../vpatterndb/vpiece.h"
 #include "../vpatterndb/vpassmark.h"
+#include "../vpatterndb/vpiecegeometry.h"
 #include "../vpatterndb/vpiecenode.h"
 #include "../vpatterndb/vpiecepath.h"
 #include "../vgeometry/vsplinepath.h"
@@ -65,6 +66,55 @@ void TST_VPiece::Issue620()
     Comparison(pointsEkv, origPoints);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VPiece::TestGeometry()
+{
+    // Geometry calculated once must be the same as geometry calculated by parts
+    const Unit unit = Unit::Cm;
+    QSharedPointer<VContainer> data(new VContainer(nullptr, &unit, VContainer::UniqueNamespace()));
+    qApp->setPatternUnit(unit);
+
+    VPiece detail;
+    AbstractTest::PieceFromJson(QStringLiteral("://Issue_620/input.json"), detail, data);
+
+    const VPieceGeometry geometry = VPieceGeometry::Create(detail, data.data());
+
+    QVERIFY(not geometry.IsNull());
+    Comparison(geometry.MainPath(), detail.MainPathPoints(data.data()));
+    Comparison(geometry.SeamAllowance(), detail.SeamAllowancePoints(data.data()));
+    QCOMPARE(geometry.IsSeamAllowanceValid(), detail.IsSeamAllowanceValid(data.data()));
+    Comparison(geometry.PassmarksLines(), detail.PassmarksLines(data.data()));
+
+    QVERIFY(geometry.IsActual(detail, data.data()));
+    detail.SetSAWidth(detail.GetSAWidth() + 1);
+    QVERIFY(not geometry.IsActual(detail, data.data()));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VPiece::TestGeometryNodeFormula()
+{
+    // Changed formula of a node must not reuse geometry calculated for the old formula
+    const Unit unit = Unit::Cm;
+    QSharedPointer<VContainer> data(new VContainer(nullptr, &unit, VContainer::UniqueNamespace()));
+    qApp->setPatternUnit(unit);
+
+    VPiece detail;
+    AbstractTest::PieceFromJson(QStringLiteral("://Issue_620/input.json"), detail, data);
+
+    const VPieceGeometry geometry = VPieceGeometry::Create(detail, data.data());
+    QVERIFY(geometry.IsActual(detail, data.data()));
+
+    VPiece changed = detail;
+    changed.GetPath()[0].SetFormulaSABefore(QStringLiteral("2"));
+    QVERIFY(not geometry.IsActual(changed, data.data()));
+
+    // Layout export rebuilds the geometry in this case
+    const VPieceGeometry rebuilt = geometry.IsActual(changed, data.data())
+            ? geometry : VPieceGeometry::Create(changed, data.data());
+    QVERIFY(rebuilt.IsActual(changed, data.data()));
+    Comparison(rebuilt.SeamAllowance(), changed.SeamAllowancePoints(data.data()));
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void TST_VPiece::TestSAPassmark_data()
 {
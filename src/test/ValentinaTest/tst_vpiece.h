@@ -39,6 +39,8 @@ public:
 
 private slots:
     void Issue620();
+    void TestGeometry();
+    void TestGeometryNodeFormula();
     void TestSAPassmark_data();
     void TestSAPassmark();
 
@@ -0,0 +1,153 @@
+/************************************************************************
+ **
+ **  @file   tst_vpngwriter.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "tst_vpngwriter.h"
+#include "../vlayout/vpngwriter.h"
+
+#include <QBuffer>
+#include <QImage>
+#include <QPainter>
+#include <QtTest>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+QImage TestImage(const QString &kind, int width, int height)
+{
+    QImage image(width, height, QImage::Format_RGB32);
+    image.fill(Qt::white);
+
+    if (kind == QLatin1String("noise"))
+    {
+        quint32 seed = 1;
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                seed = seed * 1103515245U + 12345U;
+                image.setPixel(x, y, qRgb((seed >> 8) & 0xFF, (seed >> 16) & 0xFF, (seed >> 24) & 0xFF));
+            }
+        }
+    }
+    else if (kind == QLatin1String("lines"))
+    {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.setPen(QPen(Qt::black, 1.5));
+        painter.drawEllipse(QRectF(2, 2, width - 4, height - 4));
+        painter.drawLine(QPointF(0, 0), QPointF(width, height));
+        painter.setPen(QPen(Qt::red, 3));
+        painter.drawLine(QPointF(width, 0), QPointF(0, height));
+    }
+
+    return image;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VPngWriter::TST_VPngWriter(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VPngWriter::RoundTrip_data() const
+{
+    QTest::addColumn<QString>("kind");
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<int>("bandHeight");
+
+    QTest::newRow("White, one band") << QStringLiteral("white") << 600 << 40 << 40;
+    QTest::newRow("White, long rows") << QStringLiteral("white") << 3000 << 7 << 3;
+    QTest::newRow("Lines, bands of one row") << QStringLiteral("lines") << 97 << 61 << 1;
+    QTest::newRow("Lines, last band is short") << QStringLiteral("lines") << 320 << 250 << 64;
+    QTest::newRow("Noise") << QStringLiteral("noise") << 131 << 29 << 8;
+    QTest::newRow("One pixel") << QStringLiteral("lines") << 1 << 1 << 1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VPngWriter::RoundTrip() const
+{
+    QFETCH(QString, kind);
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, bandHeight);
+
+    const QImage image = TestImage(kind, width, height);
+    const qreal dpi = 300;
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+    VPngWriter writer(&buffer, width, height, dpi);
+    QVERIFY(writer.Begin());
+
+    for (int top = 0; top < height; top += bandHeight)
+    {
+        const int rows = qMin(bandHeight, height - top);
+        // Band is bigger than rows, the writer must take only first rows
+        QImage band(width, bandHeight, QImage::Format_RGB32);
+        band.fill(Qt::green);
+        QPainter painter(&band);
+        painter.drawImage(0, 0, image, 0, top, width, rows);
+        painter.end();
+
+        QVERIFY(writer.WriteRows(band, rows));
+    }
+
+    QCOMPARE(writer.RowsWritten(), height);
+    QVERIFY(writer.End());
+    buffer.close();
+
+    const QImage result = QImage::fromData(buffer.data(), "PNG");
+    QVERIFY(not result.isNull());
+    QCOMPARE(result.size(), image.size());
+    QCOMPARE(result.dotsPerMeterX(), qRound(dpi / 0.0254));
+    QVERIFY(result.convertToFormat(QImage::Format_RGB32) == image);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VPngWriter::WrongRows() const
+{
+    const QImage image = TestImage(QStringLiteral("white"), 10, 10);
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+
+    VPngWriter writer(&buffer, 10, 15, 96);
+    QVERIFY(writer.Begin());
+
+    QVERIFY2(not writer.WriteRows(image.copy(0, 0, 9, 10), 10), "Width of a band must be the same.");
+    QVERIFY2(not writer.WriteRows(image, 11), "Band has no so many rows.");
+
+    QVERIFY(writer.WriteRows(image, 10));
+    QVERIFY2(not writer.WriteRows(image, 10), "Image has no so many rows.");
+    QVERIFY2(not writer.End(), "Not all rows were written.");
+
+    QVERIFY(writer.WriteRows(image, 5));
+    QVERIFY(writer.End());
+}
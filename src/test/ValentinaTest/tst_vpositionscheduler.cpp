@@ -0,0 +1,135 @@
+/************************************************************************
+ **
+ **  @file   tst_vpositionscheduler.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "tst_vpositionscheduler.h"
+#include "../vlayout/vpositionscheduler.h"
+
+#include <QThread>
+#include <QtTest>
+#include <atomic>
+#include <memory>
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VPositionScheduler::TST_VPositionScheduler(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VPositionScheduler::RunsEachTaskOnce_data() const
+{
+    QTest::addColumn<int>("tasks");
+    QTest::addColumn<int>("workers");
+
+    QTest::newRow("No tasks") << 0 << 4;
+    QTest::newRow("One task") << 1 << 4;
+    QTest::newRow("Less tasks than workers") << 3 << 8;
+    QTest::newRow("One worker") << 1000 << 1;
+    QTest::newRow("Many tasks") << 10007 << 8;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VPositionScheduler::RunsEachTaskOnce() const
+{
+    QFETCH(int, tasks);
+    QFETCH(int, workers);
+
+    std::unique_ptr<std::atomic_int[]> counters(new std::atomic_int[static_cast<size_t>(qMax(tasks, 1))]);
+    for (int i = 0; i < tasks; ++i)
+    {
+        counters[static_cast<size_t>(i)].store(0);
+    }
+
+    std::atomic_bool stop(false);
+    VPositionScheduler scheduler(tasks, workers);
+    QVERIFY(scheduler.WorkersCount() >= 1);
+    QVERIFY(scheduler.WorkersCount() <= qMax(1, qMin(tasks, workers)));
+
+    QFuture<void> future = scheduler.Start([&counters](int worker, int task)
+    {
+        Q_UNUSED(worker)
+        ++counters[static_cast<size_t>(task)];
+    }, &stop);
+    future.waitForFinished();
+
+    for (int i = 0; i < tasks; ++i)
+    {
+        QCOMPARE(counters[static_cast<size_t>(i)].load(), 1);
+    }
+
+    QCOMPARE(scheduler.ExecutedCount(), static_cast<qint64>(tasks));
+    QCOMPARE(scheduler.QueueDepth(), 0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VPositionScheduler::StealsFromBusyWorker() const
+{
+    if (QThreadPool::globalInstance()->maxThreadCount() < 2)
+    {
+        QSKIP("Need at least two threads.");
+    }
+
+    const int tasks = 64;
+    std::atomic_bool stop(false);
+    VPositionScheduler scheduler(tasks, 2);
+
+    // All slow tasks belong to the first worker at start. The second worker must take part of them.
+    QVector<int> owners(tasks, -1);
+    int *ownersData = owners.data();
+    QFuture<void> future = scheduler.Start([ownersData](int worker, int task)
+    {
+        ownersData[task] = worker;
+        if (task < tasks / 2)
+        {
+            QThread::msleep(5);
+        }
+    }, &stop);
+    future.waitForFinished();
+
+    QVERIFY(scheduler.StealsCount() > 0);
+    QVERIFY(owners.mid(0, tasks / 2).contains(1));
+    QVERIFY(not owners.contains(-1));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VPositionScheduler::Stop() const
+{
+    const int tasks = 1000;
+    std::atomic_bool stop(false);
+    VPositionScheduler scheduler(tasks, 4);
+
+    QFuture<void> future = scheduler.Start([&stop](int worker, int task)
+    {
+        Q_UNUSED(worker)
+        Q_UNUSED(task)
+        stop.store(true);
+    }, &stop);
+    future.waitForFinished();
+
+    // Each worker can finish only the task it already took
+    QVERIFY(scheduler.ExecutedCount() <= scheduler.WorkersCount());
+    QVERIFY(scheduler.QueueDepth() > 0);
+}
@@ -0,0 +1,133 @@
+/************************************************************************
+ **
+ **  @file   tst_vpositionsindex.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vpositionsindex.h"
+#include "../vlayout/vpositionsindex.h"
+#include "../vlayout/vlayoutpiece.h"
+
+#include <QtTest>
+
+namespace
+{
+const int markerColumns = 10;
+const int markerRows = 32; // 320 pieces
+const qreal pieceSize = 150;
+const qreal pieceGap = 10;
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> Octagon(const QPointF &topLeft, qreal size)
+{
+    const qreal c = size / 3.;
+    QVector<QPointF> points;
+    points += topLeft + QPointF(c, 0);
+    points += topLeft + QPointF(size - c, 0);
+    points += topLeft + QPointF(size, c);
+    points += topLeft + QPointF(size, size - c);
+    points += topLeft + QPointF(size - c, size);
+    points += topLeft + QPointF(c, size);
+    points += topLeft + QPointF(0, size - c);
+    points += topLeft + QPointF(0, c);
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QRectF MarkerArea()
+{
+    return QRectF(0, 0, markerColumns * (pieceSize + pieceGap), markerRows * (pieceSize + pieceGap));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief LargeMarker imitate a sheet with a few hundreds of arranged pieces.
+ */
+VPositionsIndex LargeMarker()
+{
+    VPositionsIndex index(MarkerArea());
+    for (int row = 0; row < markerRows; ++row)
+    {
+        for (int column = 0; column < markerColumns; ++column)
+        {
+            const QPointF topLeft(column * (pieceSize + pieceGap), row * (pieceSize + pieceGap));
+            const QVector<QPointF> points = Octagon(topLeft, pieceSize);
+
+            VCachedPositions position;
+            position.boundingRect = VLayoutPiece::BoundingRect(points);
+            position.layoutAllowance = VCollisionPolygon(points);
+            index.Append(position);
+        }
+    }
+    return index;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Probes candidate placements spread over the whole marker.
+ */
+QVector<QVector<QPointF>> Probes()
+{
+    QVector<QVector<QPointF>> probes;
+    const QRectF area = MarkerArea();
+    for (qreal y = 0; y < area.height(); y += pieceSize * 1.7)
+    {
+        for (qreal x = 0; x < area.width(); x += pieceSize * 1.3)
+        {
+            probes.append(Octagon(QPointF(x, y), pieceSize * 0.8));
+        }
+    }
+    return probes;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VPositionsIndex::TST_VPositionsIndex(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VPositionsIndex::CandidatesSuperset() const
+{
+    const VPositionsIndex index = LargeMarker();
+    QCOMPARE(index.Count(), markerColumns * markerRows);
+
+    for (auto &probe : Probes())
+    {
+        const QRectF rect = VLayoutPiece::BoundingRect(probe);
+        const QVector<int> candidates = index.Candidates(rect);
+
+        QVERIFY(candidates.size() < index.Count());
+        QVERIFY(std::is_sorted(candidates.begin(), candidates.end()));
+
+        for (int i = 0; i < index.Count(); ++i)
+        {
+            if (index.at(i).boundingRect.intersects(rect))
+            {
+                QVERIFY2(candidates.contains(i), qUtf8Printable(QStringLiteral("Missed position %1.").arg(i)));
+            }
+        }
+    }
+}
@@ -28,6 +28,7 @@
 
 #include "tst_vspline.h"
 #include "../vgeometry/vspline.h"
+#include "../vmisc/def.h"
 
 #include <QtTest>
 
@@ -731,6 +732,164 @@ void TST_VSpline::TestParametrT()
     QVERIFY(qAbs(halfLength - resLength) < UnitConvertor(0.5, Unit::Mm, Unit::Px));
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+// Bisection from the previous version of VAbstractCubicBezier::GetParmT
+qreal BaselineParmT(const VSpline &spl, qreal length)
+{
+    if (length < 0)
+    {
+        return 0;
+    }
+    else if (length > spl.GetLength())
+    {
+        length = spl.GetLength();
+    }
+
+    const qreal eps = 0.001 * length;
+    qreal parT = 0.5;
+    qreal step = parT;
+    qreal splLength = spl.LengthT(parT);
+
+    while (qAbs(splLength - length) > eps)
+    {
+        step /= 2.0;
+        splLength > length ? parT -= step : parT += step;
+        splLength = spl.LengthT(parT);
+    }
+    return parT;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QPointF SplinePointByT(const VSpline &spl, qreal t)
+{
+    const QPointF p1 = static_cast<QPointF>(spl.GetP1());
+    const QPointF p2 = static_cast<QPointF>(spl.GetP2());
+    const QPointF p3 = static_cast<QPointF>(spl.GetP3());
+    const QPointF p4 = static_cast<QPointF>(spl.GetP4());
+
+    const qreal mt = 1 - t;
+    return mt*mt*mt*p1 + 3*mt*mt*t*p2 + 3*mt*t*t*p3 + t*t*t*p4;
+}
+} // anonymous namespace
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::CutLengthsData() const
+{
+    QTest::addColumn<VSpline>("spl");
+    QTest::addColumn<qreal>("length");
+
+    VPointF p1(1168.8582803149607, 39.999874015748034, "p1", 5.0000125984251973, 9.9999874015748045);
+    VPointF p4(681.33729132409951, 1815.7969526662778, "p4", 5.0000125984251973, 9.9999874015748045);
+
+    VSpline spl(p1, p4, 229.381, 41.6325, 0.96294100000000005, 1.00054, 1);
+    spl.SetApproximationScale(defCurveApproximationScale);
+
+    VSpline precise = spl;
+    precise.SetApproximationScale(maxCurveApproximationScale);
+
+    const QVector<qreal> parts {0.01, 0.1, 1.0/3.0, 0.5, 2.0/3.0, 0.9, 0.99};
+    for (auto part : parts)
+    {
+        QTest::newRow(qUtf8Printable(QStringLiteral("Default scale, %1 of length").arg(part)))
+                << spl << spl.GetLength() * part;
+        QTest::newRow(qUtf8Printable(QStringLiteral("Max scale, %1 of length").arg(part)))
+                << precise << precise.GetLength() * part;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::TestParametrTBaseline_data()
+{
+    CutLengthsData();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::TestParametrTBaseline()
+{
+    QFETCH(VSpline, spl);
+    QFETCH(qreal, length);
+
+    const qreal t = spl.GetParmT(length);
+    QVERIFY(qAbs(t - BaselineParmT(spl, length)) < 1e-12);
+
+    // LengthT must stay the exact length of the part before t
+    QLineF seg1_2(static_cast<QPointF>(spl.GetP1()), static_cast<QPointF>(spl.GetP2()));
+    seg1_2.setLength(seg1_2.length() * t);
+    QLineF seg2_3(static_cast<QPointF>(spl.GetP2()), static_cast<QPointF>(spl.GetP3()));
+    seg2_3.setLength(seg2_3.length() * t);
+    QLineF seg12_23(seg1_2.p2(), seg2_3.p2());
+    seg12_23.setLength(seg12_23.length() * t);
+
+    VSpline part(spl.GetP1(), seg1_2.p2(), seg12_23.p2(), VPointF(SplinePointByT(spl, t)));
+    part.SetApproximationScale(spl.GetApproximationScale());
+    QVERIFY(qAbs(spl.LengthT(t) - part.GetLength()) < 1e-6);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::TestCutSplineBaseline_data()
+{
+    CutLengthsData();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::TestCutSplineBaseline()
+{
+    QFETCH(VSpline, spl);
+    QFETCH(qreal, length);
+
+    QPointF spl1p2, spl1p3, spl2p2, spl2p3;
+    const QPointF p = spl.CutSpline(length, spl1p2, spl1p3, spl2p2, spl2p3);
+
+    const QPointF expected = SplinePointByT(spl, BaselineParmT(spl, length));
+    QVERIFY2(QLineF(p, expected).length() < 1e-6,
+             qUtf8Printable(QStringLiteral("Got (%1; %2), expected (%3; %4).")
+                            .arg(p.x()).arg(p.y()).arg(expected.x()).arg(expected.y())));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::TestLengthAfterChange()
+{
+    VPointF p1(1168.8582803149607, 39.999874015748034, "p1", 5.0000125984251973, 9.9999874015748045);
+    VPointF p4(681.33729132409951, 1815.7969526662778, "p4", 5.0000125984251973, 9.9999874015748045);
+
+    VSpline spl(p1, p4, 229.381, 41.6325, 0.96294100000000005, 1.00054, 1);
+
+    const qreal length = spl.GetLength();
+    QCOMPARE(length, VAbstractCurve::PathLength(spl.GetPoints()));
+
+    // Length must follow the new shape of the curve
+    spl.SetC1Length(spl.GetC1Length()*2, QString());
+    QCOMPARE(spl.GetLength(), VAbstractCurve::PathLength(spl.GetPoints()));
+    QVERIFY(not VFuzzyComparePossibleNulls(spl.GetLength(), length));
+
+    const qreal halfLength = spl.GetLength()/2.0;
+    QVERIFY(qAbs(halfLength - spl.LengthT(spl.GetParmT(halfLength))) < UnitConvertor(0.5, Unit::Mm, Unit::Px));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::TestPointsAfterChange()
+{
+    VPointF p1(1168.8582803149607, 39.999874015748034, "p1", 5.0000125984251973, 9.9999874015748045);
+    VPointF p4(681.33729132409951, 1815.7969526662778, "p4", 5.0000125984251973, 9.9999874015748045);
+
+    const VSpline spl(p1, p4, 229.381, 41.6325, 0.96294100000000005, 1.00054, 1);
+    const QVector<QPointF> points = spl.GetPoints();
+
+    // Copy shares cached points until it changes
+    VSpline copy = spl;
+    QCOMPARE(copy.GetPoints(), points);
+
+    copy.SetC2Length(copy.GetC2Length()/2, QString());
+    const VSpline fresh(copy.GetP1(), static_cast<QPointF>(copy.GetP2()), static_cast<QPointF>(copy.GetP3()),
+                       copy.GetP4());
+    QCOMPARE(copy.GetPoints(), fresh.GetPoints());
+    QVERIFY(copy.GetPoints() != points);
+    QCOMPARE(spl.GetPoints(), points);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void TST_VSpline::TestLengthByPoint_data()
 {
@@ -50,6 +50,12 @@ private slots:
     void GetSegmentPoints_issue767();
     void CompareThreeWays();
     void TestParametrT();
+    void TestParametrTBaseline_data();
+    void TestParametrTBaseline();
+    void TestCutSplineBaseline_data();
+    void TestCutSplineBaseline();
+    void TestLengthAfterChange();
+    void TestPointsAfterChange();
     void TestLengthByPoint_data();
     void TestLengthByPoint();
     void TestFlip_data();
@@ -58,6 +64,7 @@ private slots:
 private:
     Q_DISABLE_COPY(TST_VSpline)
     void CompareSplines(const VSpline &spl1, const VSpline &spl2) const;
+    void CutLengthsData() const;
 };
 
 #endif // TST_VSPLINE_H
@@ -0,0 +1,131 @@
+/************************************************************************
+ **
+ **  @file   tst_vuniformgrid.cpp
+ **  @author Roman Telezhynskyi <dismine(at)gmail.com>
+ **  @date   17 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentina project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Valentina project
+ **  <https://gitlab.com/smart-pattern/valentina> All Rights Reserved.
+ **
+ **  Valentina is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Valentina is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Valentina.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+#include "tst_vuniformgrid.h"
+#include "../vlayout/vuniformgrid.h"
+
+#include <QtTest>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Rects return rectangles in a row with a step. Some of them go out of the area.
+ */
+QVector<QRectF> Rects(const QRectF &area, qreal size)
+{
+    QVector<QRectF> rects;
+    for (qreal y = area.top() - size; y < area.bottom() + size; y += size * 0.7)
+    {
+        for (qreal x = area.left() - size; x < area.right() + size; x += size * 1.3)
+        {
+            rects.append(QRectF(x, y, size, size * 0.5));
+        }
+    }
+    return rects;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VUniformGrid::TST_VUniformGrid(QObject *parent)
+    : QObject(parent)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VUniformGrid::CandidatesSuperset_data() const
+{
+    QTest::addColumn<QRectF>("gridArea");
+    QTest::addColumn<qreal>("cellSize");
+    QTest::addColumn<int>("maxCells");
+    QTest::addColumn<int>("columns");
+    QTest::addColumn<int>("rows");
+
+    const QRectF area(-100, 50, 1000, 600);
+
+    // Zero cell size means fixed number of columns and rows
+    QTest::newRow("Square cells") << area << 75. << (1 << 16) << 0 << 0;
+    QTest::newRow("Limited cells count") << area << 1. << 50 << 0 << 0;
+    QTest::newRow("Bands") << area << 0. << 0 << 1 << 40;
+    QTest::newRow("Flat area") << QRectF(area.left(), area.top(), area.width(), 0) << 0. << 0 << 10 << 10;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VUniformGrid::CandidatesSuperset() const
+{
+    QFETCH(QRectF, gridArea);
+    QFETCH(qreal, cellSize);
+    QFETCH(int, maxCells);
+    QFETCH(int, columns);
+    QFETCH(int, rows);
+
+    const QRectF area(-100, 50, 1000, 600);
+    VUniformGrid grid = cellSize > 0 ? VUniformGrid::WithCellSize(gridArea, cellSize, maxCells)
+                                     : VUniformGrid(gridArea, columns, rows);
+
+    const QVector<QRectF> rects = Rects(area, 60);
+    for (int i = 0; i < rects.size(); ++i)
+    {
+        grid.Insert(i, rects.at(i));
+    }
+
+    for (auto &probe : Rects(area, 45))
+    {
+        const QVector<int> candidates = grid.Candidates(probe);
+        QVERIFY(std::is_sorted(candidates.begin(), candidates.end()));
+        QVERIFY(std::adjacent_find(candidates.begin(), candidates.end()) == candidates.end());
+
+        for (int i = 0; i < rects.size(); ++i)
+        {
+            if (rects.at(i).intersects(probe))
+            {
+                QVERIFY2(candidates.contains(i), qUtf8Printable(QStringLiteral("Missed rect %1.").arg(i)));
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VUniformGrid::VisitStops() const
+{
+    VUniformGrid grid(QRectF(0, 0, 100, 100), 4, 4);
+    for (int i = 0; i < 10; ++i)
+    {
+        grid.Insert(i, QRectF(0, 0, 100, 100));
+    }
+
+    int visited = 0;
+    const bool stopped = grid.Visit(QRectF(10, 10, 1, 1), [&visited](int item)
+    {
+        ++visited;
+        return item == 4;
+    });
+
+    QVERIFY(stopped);
+    QCOMPARE(visited, 5);
+
+    QVERIFY(not VUniformGrid().Visit(QRectF(10, 10, 1, 1), [](int) {return true;}));
+}
@@ -3,4 +3,5 @@ SUBDIRS = \
     ParserTest \
     ValentinaTest \
     TranslationsTest \
-    CollectionTest
+    CollectionTest \
+    LayoutBenchmark